@@ -134,6 +134,30 @@ Vector<String> ResourceLoader::list_directory(const String &p_directory) {
 	return ::ResourceLoader::list_directory(p_directory);
 }
 
+void ResourceLoader::start_prefetch_recording() {
+	::ResourceLoader::start_prefetch_recording();
+}
+
+void ResourceLoader::stop_prefetch_recording() {
+	::ResourceLoader::stop_prefetch_recording();
+}
+
+bool ResourceLoader::is_prefetch_recording() const {
+	return ::ResourceLoader::is_prefetch_recording();
+}
+
+Error ResourceLoader::save_prefetch_manifest(const String &p_path) {
+	return ::ResourceLoader::save_prefetch_manifest(p_path);
+}
+
+Error ResourceLoader::prefetch(const String &p_manifest_path) {
+	return ::ResourceLoader::prefetch(p_manifest_path);
+}
+
+void ResourceLoader::clear_prefetch() {
+	::ResourceLoader::clear_prefetch();
+}
+
 void ResourceLoader::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("load_threaded_request", "path", "type_hint", "use_sub_threads", "cache_mode"), &ResourceLoader::load_threaded_request, DEFVAL(""), DEFVAL(false), DEFVAL(CACHE_MODE_REUSE));
 	ClassDB::bind_method(D_METHOD("load_threaded_get_status", "path", "progress"), &ResourceLoader::load_threaded_get_status, DEFVAL_ARRAY);
@@ -151,6 +175,13 @@ void ResourceLoader::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_resource_uid", "path"), &ResourceLoader::get_resource_uid);
 	ClassDB::bind_method(D_METHOD("list_directory", "directory_path"), &ResourceLoader::list_directory);
 
+	ClassDB::bind_method(D_METHOD("start_prefetch_recording"), &ResourceLoader::start_prefetch_recording);
+	ClassDB::bind_method(D_METHOD("stop_prefetch_recording"), &ResourceLoader::stop_prefetch_recording);
+	ClassDB::bind_method(D_METHOD("is_prefetch_recording"), &ResourceLoader::is_prefetch_recording);
+	ClassDB::bind_method(D_METHOD("save_prefetch_manifest", "path"), &ResourceLoader::save_prefetch_manifest);
+	ClassDB::bind_method(D_METHOD("prefetch", "manifest_path"), &ResourceLoader::prefetch);
+	ClassDB::bind_method(D_METHOD("clear_prefetch"), &ResourceLoader::clear_prefetch);
+
 	BIND_ENUM_CONSTANT(THREAD_LOAD_INVALID_RESOURCE);
 	BIND_ENUM_CONSTANT(THREAD_LOAD_IN_PROGRESS);
 	BIND_ENUM_CONSTANT(THREAD_LOAD_FAILED);
@@ -1670,6 +1701,23 @@ bool ClassDB::is_class_enabled(const StringName &p_class) const {
 	return ::ClassDB::is_class_enabled(p_class);
 }
 
+void ClassDB::class_set_pooled(const StringName &p_class, bool p_pooled) {
+	::ClassDB::set_class_pooled(p_class, p_pooled);
+}
+
+bool ClassDB::class_is_pooled(const StringName &p_class) const {
+	return ::ClassDB::is_class_pooled(p_class);
+}
+
+Dictionary ClassDB::class_get_pool_counters(const StringName &p_class) const {
+	::ClassDB::PoolCounters counters = ::ClassDB::get_class_pool_counters(p_class);
+	Dictionary ret;
+	ret["live"] = counters.live;
+	ret["pooled"] = counters.pooled;
+	ret["peak"] = counters.peak;
+	return ret;
+}
+
 #ifdef TOOLS_ENABLED
 void ClassDB::get_argument_options(const StringName &p_function, int p_idx, List<String> *r_options) const {
 	const String pf = p_function;
@@ -1682,7 +1730,8 @@ void ClassDB::get_argument_options(const StringName &p_function, int p_idx, List
 				pf == "class_has_method" || pf == "class_get_method_list" ||
 				pf == "class_get_integer_constant_list" || pf == "class_has_integer_constant" || pf == "class_get_integer_constant" ||
 				pf == "class_has_enum" || pf == "class_get_enum_list" || pf == "class_get_enum_constants" || pf == "class_get_integer_constant_enum" ||
-				pf == "is_class_enabled" || pf == "is_class_enum_bitfield" || pf == "class_get_api_type");
+				pf == "is_class_enabled" || pf == "is_class_enum_bitfield" || pf == "class_get_api_type" ||
+				pf == "class_set_pooled" || pf == "class_is_pooled" || pf == "class_get_pool_counters");
 	}
 	if (first_argument_is_class || pf == "is_parent_class") {
 		for (const String &E : get_class_list()) {
@@ -1739,6 +1788,10 @@ void ClassDB::_bind_methods() {
 
 	::ClassDB::bind_method(D_METHOD("is_class_enabled", "class"), &ClassDB::is_class_enabled);
 
+	::ClassDB::bind_method(D_METHOD("class_set_pooled", "class", "pooled"), &ClassDB::class_set_pooled);
+	::ClassDB::bind_method(D_METHOD("class_is_pooled", "class"), &ClassDB::class_is_pooled);
+	::ClassDB::bind_method(D_METHOD("class_get_pool_counters", "class"), &ClassDB::class_get_pool_counters);
+
 	BIND_ENUM_CONSTANT(API_CORE);
 	BIND_ENUM_CONSTANT(API_EDITOR);
 	BIND_ENUM_CONSTANT(API_EXTENSION);
@@ -86,6 +86,13 @@ public:
 
 	Vector<String> list_directory(const String &p_directory);
 
+	void start_prefetch_recording();
+	void stop_prefetch_recording();
+	bool is_prefetch_recording() const;
+	Error save_prefetch_manifest(const String &p_path);
+	Error prefetch(const String &p_manifest_path);
+	void clear_prefetch();
+
 	ResourceLoader() { singleton = this; }
 };
 
@@ -516,6 +523,10 @@ public:
 
 	bool is_class_enabled(const StringName &p_class) const;
 
+	void class_set_pooled(const StringName &p_class, bool p_pooled);
+	bool class_is_pooled(const StringName &p_class) const;
+	Dictionary class_get_pool_counters(const StringName &p_class) const;
+
 #ifdef TOOLS_ENABLED
 	virtual void get_argument_options(const StringName &p_function, int p_idx, List<String> *r_options) const override;
 #endif
@@ -1325,6 +1325,41 @@ static void gdextension_object_method_bind_ptrcall(GDExtensionMethodBindPtr p_me
 	mb->ptrcall(o, (const void **)p_args, p_ret);
 }
 
+static void gdextension_object_method_bind_ptrcall_batch(GDExtensionMethodBindPtr p_method_bind, const GDExtensionObjectPtr *p_instances, GDExtensionInt p_count, const GDExtensionConstTypePtr *p_args, const GDExtensionInt *p_arg_strides, GDExtensionTypePtr r_rets, GDExtensionInt p_ret_stride) {
+	const MethodBind *mb = reinterpret_cast<const MethodBind *>(p_method_bind);
+	ERR_FAIL_COND(p_count < 0);
+	if (p_count == 0) {
+		return;
+	}
+	ERR_FAIL_COND_MSG(mb->is_vararg(), vformat("Cannot batch ptrcalls of vararg method '%s'.", mb->get_name()));
+	ERR_FAIL_COND_MSG(!p_instances && !mb->is_static(), vformat("Cannot batch ptrcalls of non-static method '%s' without instances.", mb->get_name()));
+	ERR_FAIL_COND_MSG(!r_rets && mb->has_return(), vformat("Cannot batch ptrcalls of method '%s' without return values, as it returns one.", mb->get_name()));
+
+	const int argc = mb->get_argument_count();
+	ERR_FAIL_COND(argc > 0 && p_args == nullptr);
+
+	// Cursors into the caller's buffers, advanced by their stride after each call.
+	const uint8_t **args = (const uint8_t **)alloca(sizeof(uint8_t *) * MAX(argc, 1));
+	for (int i = 0; i < argc; i++) {
+		args[i] = (const uint8_t *)p_args[i];
+	}
+	uint8_t *ret = (uint8_t *)r_rets;
+
+	for (GDExtensionInt i = 0; i < p_count; i++) {
+		Object *o = p_instances ? (Object *)p_instances[i] : nullptr;
+		mb->ptrcall(o, (const void **)args, ret);
+
+		if (p_arg_strides) {
+			for (int j = 0; j < argc; j++) {
+				args[j] += p_arg_strides[j];
+			}
+		}
+		if (ret) {
+			ret += p_ret_stride;
+		}
+	}
+}
+
 static void gdextension_object_destroy(GDExtensionObjectPtr p_o) {
 	memdelete((Object *)p_o);
 }
@@ -1787,6 +1822,7 @@ void gdextension_setup_interface() {
 	REGISTER_INTERFACE_FUNC(dictionary_set_typed);
 	REGISTER_INTERFACE_FUNC(object_method_bind_call);
 	REGISTER_INTERFACE_FUNC(object_method_bind_ptrcall);
+	REGISTER_INTERFACE_FUNC(object_method_bind_ptrcall_batch);
 	REGISTER_INTERFACE_FUNC(object_destroy);
 	REGISTER_INTERFACE_FUNC(global_get_singleton);
 	REGISTER_INTERFACE_FUNC(object_get_instance_binding);
@@ -2453,6 +2453,26 @@ typedef void (*GDExtensionInterfaceObjectMethodBindCall)(GDExtensionMethodBindPt
  */
 typedef void (*GDExtensionInterfaceObjectMethodBindPtrcall)(GDExtensionMethodBindPtr p_method_bind, GDExtensionObjectPtr p_instance, const GDExtensionConstTypePtr *p_args, GDExtensionTypePtr r_ret);
 
+/**
+ * @name object_method_bind_ptrcall_batch
+ * @since 4.4
+ *
+ * Calls a method on several Objects (using a "ptrcall"), crossing into the engine only once.
+ *
+ * Call i uses `p_instances[i]` and, for each argument j, `(const uint8_t *)p_args[j] + i * p_arg_strides[j]`.
+ * A stride of 0 passes the same value to every call. Return values are written the same way, so like
+ * with object_method_bind_ptrcall they must point to initialized values. A stride of 0 keeps only the last one.
+ *
+ * @param p_method_bind A pointer to the MethodBind representing the method on the Objects' class. It can't be vararg.
+ * @param p_instances A pointer to a C array of p_count Objects, or NULL for static methods.
+ * @param p_count The number of calls.
+ * @param p_args A pointer to a C array with the first value of each argument.
+ * @param p_arg_strides A pointer to a C array with the stride in bytes of each argument, or NULL if all are 0.
+ * @param r_rets A pointer to the first return value, or NULL if the method doesn't return a value.
+ * @param p_ret_stride The stride in bytes of the return values.
+ */
+typedef void (*GDExtensionInterfaceObjectMethodBindPtrcallBatch)(GDExtensionMethodBindPtr p_method_bind, const GDExtensionObjectPtr *p_instances, GDExtensionInt p_count, const GDExtensionConstTypePtr *p_args, const GDExtensionInt *p_arg_strides, GDExtensionTypePtr r_rets, GDExtensionInt p_ret_stride);
+
 /**
  * @name object_destroy
  * @since 4.1
@@ -38,6 +38,16 @@
 #include "core/string/ustring.h"
 #include "core/typedefs.h"
 
+/**
+ * Read-only mapping of a whole file into memory, unmapped when the last reference is gone.
+ */
+
+class FileMapping : public RefCounted {
+public:
+	virtual const uint8_t *get_data() const = 0;
+	virtual uint64_t get_size() const = 0;
+};
+
 /**
  * Multi-Platform abstraction for accessing to files.
  */
@@ -179,6 +189,7 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const = 0; ///< get an array of bytes, needs to be overwritten by children.
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
+	virtual const uint8_t *get_buffer_view(uint64_t p_length) const { return nullptr; } ///< get the next bytes in place and skip them, valid until the file is closed; nullptr when unsupported, then nothing is consumed
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
@@ -224,6 +235,8 @@ public:
 
 	virtual bool file_exists(const String &p_name) = 0; ///< return true if a file exists
 
+	virtual Ref<FileMapping> map() const { return Ref<FileMapping>(); } ///< map the whole open file read-only into memory, null when unsupported
+
 	virtual Error reopen(const String &p_path, int p_mode_flags); ///< does not change the AccessType
 
 	static Ref<FileAccess> create(AccessType p_access); /// Create a file access (for the current platform) this is the only portable way of accessing files.
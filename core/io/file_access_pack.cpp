@@ -32,6 +32,7 @@
 
 #include "core/io/file_access_encrypted.h"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "core/version.h"
 
@@ -45,7 +46,7 @@ Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t
 	return ERR_FILE_UNRECOGNIZED;
 }
 
-void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted) {
+void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_compressed) {
 	String simplified_path = p_path.simplify_path().trim_prefix("res://");
 	PathMD5 pmd5(simplified_path.md5_buffer());
 
@@ -53,6 +54,7 @@ void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64
 
 	PackedFile pf;
 	pf.encrypted = p_encrypted;
+	pf.compressed = p_compressed;
 	pf.pack = p_pkg_path;
 	pf.offset = p_ofs;
 	pf.size = p_size;
@@ -136,6 +138,19 @@ uint8_t *PackedData::get_file_hash(const String &p_path) {
 	return E->value.md5;
 }
 
+bool PackedData::get_file_location(const String &p_path, String &r_pack, uint64_t &r_offset) const {
+	String simplified_path = p_path.simplify_path().trim_prefix("res://");
+	PathMD5 pmd5(simplified_path.md5_buffer());
+	HashMap<PathMD5, PackedFile, PathMD5>::ConstIterator E = files.find(pmd5);
+	if (!E || E->value.offset == 0) {
+		return false;
+	}
+
+	r_pack = E->value.pack;
+	r_offset = E->value.offset;
+	return true;
+}
+
 HashSet<String> PackedData::get_file_paths() const {
 	HashSet<String> file_paths;
 	_get_file_paths(root, root->name, file_paths);
@@ -263,7 +278,7 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	uint32_t ver_minor = f->get_32();
 	f->get_32(); // patch number, not used for validation.
 
-	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION, false, vformat("Pack version unsupported: %d.", version));
+	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION && version != PACK_FORMAT_VERSION_COMPRESSED, false, vformat("Pack version unsupported: %d.", version));
 	ERR_FAIL_COND_V_MSG(ver_major > VERSION_MAJOR || (ver_major == VERSION_MAJOR && ver_minor > VERSION_MINOR), false, vformat("Pack created with a newer version of the engine: %d.%d.", ver_major, ver_minor));
 
 	uint32_t pack_flags = f->get_32();
@@ -272,7 +287,11 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	bool enc_directory = (pack_flags & PACK_DIR_ENCRYPTED);
 	bool rel_filebase = (pack_flags & PACK_REL_FILEBASE);
 
-	for (int i = 0; i < 16; i++) {
+	// Dictionary of the compressed files, see PCKCompression.
+	uint64_t dictionary_ofs = f->get_64();
+	uint32_t dictionary_size = f->get_32();
+
+	for (int i = 0; i < 13; i++) {
 		//reserved
 		f->get_32();
 	}
@@ -283,6 +302,35 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		file_base += pck_start_pos;
 	}
 
+	if (dictionary_size > 0) {
+		uint64_t directory_pos = f->get_position();
+		f->seek(file_base + dictionary_ofs + p_offset);
+		Vector<uint8_t> dictionary = f->get_buffer(dictionary_size);
+		ERR_FAIL_COND_V_MSG(dictionary.size() != dictionary_size, false, "Can't read the compression dictionary of the pack.");
+		MutexLock lock(mutex);
+		dictionaries[p_path] = dictionary;
+		f->seek(directory_pos);
+	} else {
+		MutexLock lock(mutex);
+		dictionaries.erase(p_path);
+	}
+
+	// Unencrypted files are then read from memory, without opening the pack again for each of them.
+	// Mapped again every time, since the pack may have been replaced since it was last opened.
+	PackMapping mapping;
+	if (PackedData::get_singleton()->is_memory_mapping_enabled()) {
+		mapping.mapping = f->map();
+		mapping.modified_time = FileAccess::get_modified_time(p_path);
+	}
+	{
+		MutexLock lock(mutex);
+		if (mapping.mapping.is_valid()) {
+			mappings[p_path] = mapping;
+		} else {
+			mappings.erase(p_path);
+		}
+	}
+
 	if (enc_directory) {
 		Ref<FileAccessEncrypted> fae;
 		fae.instantiate();
@@ -318,7 +366,7 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		if (flags & PACK_FILE_REMOVAL) { // The file was removed.
 			PackedData::get_singleton()->remove_path(path);
 		} else {
-			PackedData::get_singleton()->add_path(p_path, path, file_base + ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED));
+			PackedData::get_singleton()->add_path(p_path, path, file_base + ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), (flags & PACK_FILE_COMPRESSED));
 		}
 	}
 
@@ -326,7 +374,24 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 }
 
 Ref<FileAccess> PackedSourcePCK::get_file(const String &p_path, PackedData::PackedFile *p_file) {
-	return memnew(FileAccessPack(p_path, *p_file));
+	PackMapping mapping;
+	Vector<uint8_t> dictionary;
+	{
+		MutexLock lock(mutex);
+		HashMap<String, PackMapping>::ConstIterator E = mappings.find(p_file->pack);
+		if (E) {
+			mapping = E->value;
+		}
+		HashMap<String, Vector<uint8_t>>::ConstIterator D = dictionaries.find(p_file->pack);
+		if (D) {
+			dictionary = D->value;
+		}
+	}
+	if (mapping.mapping.is_valid() && FileAccess::get_modified_time(p_file->pack) != mapping.modified_time) {
+		// Rewritten since it was mapped, so the mapping may now reach past its end.
+		mapping.mapping = Ref<FileMapping>();
+	}
+	return memnew(FileAccessPack(p_path, *p_file, mapping.mapping, dictionary));
 }
 
 //////////////////////////////////////////////////////////////////
@@ -337,7 +402,9 @@ Error FileAccessPack::open_internal(const String &p_path, int p_mode_flags) {
 }
 
 bool FileAccessPack::is_open() const {
-	if (f.is_valid()) {
+	if (data) {
+		return true;
+	} else if (f.is_valid()) {
 		return f->is_open();
 	} else {
 		return false;
@@ -345,7 +412,7 @@ bool FileAccessPack::is_open() const {
 }
 
 void FileAccessPack::seek(uint64_t p_position) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(f.is_null() && !data, "File must be opened before use.");
 
 	if (p_position > pf.size) {
 		eof = true;
@@ -353,7 +420,9 @@ void FileAccessPack::seek(uint64_t p_position) {
 		eof = false;
 	}
 
-	f->seek(off + p_position);
+	if (f.is_valid()) {
+		f->seek(off + p_position);
+	}
 	pos = p_position;
 }
 
@@ -374,7 +443,7 @@ bool FileAccessPack::eof_reached() const {
 }
 
 uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
-	ERR_FAIL_COND_V_MSG(f.is_null(), -1, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(f.is_null() && !data, -1, "File must be opened before use.");
 	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
 
 	if (eof) {
@@ -387,21 +456,42 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 		to_read = (int64_t)pf.size - (int64_t)pos;
 	}
 
-	pos += to_read;
-
 	if (to_read <= 0) {
 		return 0;
 	}
-	f->get_buffer(p_dst, to_read);
+	if (compressed_data && !_decode(pos, to_read)) {
+		return 0;
+	}
+	if (data) {
+		memcpy(p_dst, data + pos, to_read);
+	} else {
+		f->get_buffer(p_dst, to_read);
+	}
+	pos += to_read;
 
 	return to_read;
 }
 
+const uint8_t *FileAccessPack::get_buffer_view(uint64_t p_length) const {
+	if (!data || eof || p_length > pf.size - pos) {
+		return nullptr;
+	}
+	if (compressed_data && !_decode(pos, p_length)) {
+		return nullptr;
+	}
+
+	const uint8_t *view = data + pos;
+	pos += p_length;
+	return view;
+}
+
 void FileAccessPack::set_big_endian(bool p_big_endian) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(f.is_null() && !data, "File must be opened before use.");
 
 	FileAccess::set_big_endian(p_big_endian);
-	f->set_big_endian(p_big_endian);
+	if (f.is_valid()) {
+		f->set_big_endian(p_big_endian);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -425,11 +515,145 @@ bool FileAccessPack::file_exists(const String &p_name) {
 
 void FileAccessPack::close() {
 	f = Ref<FileAccess>();
+	mapping = Ref<FileMapping>();
+	data = nullptr;
+	compressed = Vector<uint8_t>();
+	compressed_data = nullptr;
+	decompressed = Vector<uint8_t>();
+	frames_decoded.clear();
+}
+
+void FileAccessPack::_open_compressed(const Ref<FileMapping> &p_mapping, const Vector<uint8_t> &p_dictionary) {
+	ERR_FAIL_COND_MSG(pf.encrypted, vformat("Pack-referenced file '%s' can't be both compressed and encrypted.", String(pf.pack)));
+
+	// Either point into the mapped pack, or read the seek table and then the frames.
+	const bool mapped = p_mapping.is_valid() && pf.offset <= p_mapping->get_size() && p_mapping->get_size() - pf.offset >= PCKCompression::SEEK_TABLE_HEADER_SIZE;
+	Ref<FileAccess> file;
+	Vector<uint8_t> entry;
+	const uint8_t *src = nullptr;
+	uint32_t table_size = 0;
+	if (mapped) {
+		src = p_mapping->get_data() + pf.offset;
+		table_size = PCKCompression::get_seek_table_size(src);
+		ERR_FAIL_COND_MSG(table_size > p_mapping->get_size() - pf.offset, vformat("Corrupt compressed pack-referenced file '%s'.", String(pf.pack)));
+	} else {
+		file = FileAccess::open(pf.pack, FileAccess::READ);
+		ERR_FAIL_COND_MSG(file.is_null(), vformat("Can't open pack-referenced file '%s'.", String(pf.pack)));
+		file->seek(pf.offset);
+
+		entry = file->get_buffer(PCKCompression::SEEK_TABLE_HEADER_SIZE);
+		ERR_FAIL_COND_MSG(entry.size() != PCKCompression::SEEK_TABLE_HEADER_SIZE, vformat("Corrupt compressed pack-referenced file '%s'.", String(pf.pack)));
+		table_size = PCKCompression::get_seek_table_size(entry.ptr());
+		if (table_size > PCKCompression::SEEK_TABLE_HEADER_SIZE) {
+			const uint32_t rest = table_size - PCKCompression::SEEK_TABLE_HEADER_SIZE;
+			entry.resize(table_size);
+			ERR_FAIL_COND_MSG(file->get_buffer(entry.ptrw() + PCKCompression::SEEK_TABLE_HEADER_SIZE, rest) != rest, vformat("Corrupt compressed pack-referenced file '%s'.", String(pf.pack)));
+		}
+		src = entry.ptr();
+	}
+
+	Error err = PCKCompression::parse_seek_table(src, table_size, pf.size, seek_table);
+	ERR_FAIL_COND_MSG(err != OK, vformat("Corrupt compressed pack-referenced file '%s'.", String(pf.pack)));
+	const uint64_t compressed_size = seek_table.frame_offsets[seek_table.get_frame_count()];
+
+	if (mapped) {
+		ERR_FAIL_COND_MSG(compressed_size > p_mapping->get_size() - pf.offset, vformat("Corrupt compressed pack-referenced file '%s'.", String(pf.pack)));
+		mapping = p_mapping;
+	} else {
+		ERR_FAIL_COND_MSG(entry.resize(compressed_size) != OK, vformat("Can't allocate memory for pack-referenced file '%s'.", String(pf.pack)));
+		const uint64_t rest = compressed_size - table_size;
+		ERR_FAIL_COND_MSG(file->get_buffer(entry.ptrw() + table_size, rest) != rest, vformat("Corrupt compressed pack-referenced file '%s'.", String(pf.pack)));
+		compressed = entry;
+		src = compressed.ptr();
+	}
+
+	dictionary = p_dictionary;
+	decompressed.resize(pf.size);
+	frames_decoded.resize(seek_table.get_frame_count());
+	for (bool &decoded : frames_decoded) {
+		decoded = false;
+	}
+	compressed_data = src;
+	data = decompressed.ptr();
+	off = pf.offset;
+
+	if (WorkerThreadPool::get_thread_index() != -1) {
+		_decode(0, pf.size);
+	}
+}
+
+bool FileAccessPack::_decode_frame(uint32_t p_frame, uint8_t *p_dst) const {
+	const uint64_t dst_ofs = uint64_t(p_frame) * seek_table.frame_size;
+	const uint64_t src_ofs = seek_table.frame_offsets[p_frame];
+	const uint32_t dst_size = MIN(pf.size - dst_ofs, uint64_t(seek_table.frame_size));
+	frames_decoded[p_frame] = PCKCompression::decompress_frame(p_dst + dst_ofs, dst_size, compressed_data + src_ofs, seek_table.frame_offsets[p_frame + 1] - src_ofs, dictionary);
+	return frames_decoded[p_frame];
+}
+
+struct PackDecodeFrames {
+	const FileAccessPack *file = nullptr;
+	const uint32_t *frames = nullptr;
+	uint8_t *dst = nullptr;
+};
+
+void FileAccessPack::_decode_frames_task(void *p_userdata, uint32_t p_index) {
+	PackDecodeFrames *decode = (PackDecodeFrames *)p_userdata;
+	decode->file->_decode_frame(decode->frames[p_index], decode->dst);
+}
+
+bool FileAccessPack::_decode(uint64_t p_from, uint64_t p_length) const {
+	if (p_length == 0) {
+		return true;
+	}
+
+	LocalVector<uint32_t> frames;
+	const uint32_t last = (p_from + p_length - 1) / seek_table.frame_size;
+	for (uint32_t i = p_from / seek_table.frame_size; i <= last; i++) {
+		if (!frames_decoded[i]) {
+			frames.push_back(i);
+		}
+	}
+
+	// Frames are independent, so several of them get decoded in parallel. Not from pool
+	// threads, which would block waiting for the group instead of running tasks.
+	uint8_t *dst = decompressed.ptrw();
+	if (frames.size() == 1 || WorkerThreadPool::get_thread_index() != -1) {
+		for (uint32_t frame : frames) {
+			_decode_frame(frame, dst);
+		}
+	} else if (frames.size() > 1) {
+		PackDecodeFrames decode;
+		decode.file = this;
+		decode.frames = frames.ptr();
+		decode.dst = dst;
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&_decode_frames_task, &decode, frames.size(), -1, true, SNAME("DecompressPackFile"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	for (uint32_t frame : frames) {
+		ERR_FAIL_COND_V_MSG(!frames_decoded[frame], false, vformat("Corrupt compressed pack-referenced file '%s'.", String(pf.pack)));
+	}
+	return true;
 }
 
-FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) :
-		pf(p_file),
-		f(FileAccess::open(pf.pack, FileAccess::READ)) {
+FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const Ref<FileMapping> &p_mapping, const Vector<uint8_t> &p_dictionary) :
+		pf(p_file) {
+	pos = 0;
+	eof = false;
+
+	if (pf.compressed) {
+		_open_compressed(p_mapping, p_dictionary);
+		return;
+	}
+
+	if (p_mapping.is_valid() && !pf.encrypted && pf.offset <= p_mapping->get_size() && pf.size <= p_mapping->get_size() - pf.offset) {
+		mapping = p_mapping;
+		data = mapping->get_data() + pf.offset;
+		off = pf.offset;
+		return;
+	}
+
+	f = FileAccess::open(pf.pack, FileAccess::READ);
 	ERR_FAIL_COND_MSG(f.is_null(), vformat("Can't open pack-referenced file '%s'.", String(pf.pack)));
 
 	f->seek(pf.offset);
@@ -451,8 +675,6 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 		f = fae;
 		off = 0;
 	}
-	pos = 0;
-	eof = false;
 }
 
 //////////////////////////////////////////////////////////////////////////////////
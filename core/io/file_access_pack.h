@@ -33,14 +33,19 @@
 
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/io/pck_compression.h"
+#include "core/os/mutex.h"
 #include "core/string/print_string.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
 
 // Godot's packed file magic header ("GDPC" in ASCII).
 #define PACK_HEADER_MAGIC 0x43504447
 // The current packed file format version number.
 #define PACK_FORMAT_VERSION 2
+// The version of packs with compressed files, so that engines unable to read them reject the pack.
+#define PACK_FORMAT_VERSION_COMPRESSED 3
 
 enum PackFlags {
 	PACK_DIR_ENCRYPTED = 1 << 0,
@@ -50,6 +55,7 @@ enum PackFlags {
 enum PackFileFlags {
 	PACK_FILE_ENCRYPTED = 1 << 0,
 	PACK_FILE_REMOVAL = 1 << 1,
+	PACK_FILE_COMPRESSED = 1 << 2, // See PCKCompression, the stored size is the uncompressed one.
 };
 
 class PackSource;
@@ -67,6 +73,7 @@ public:
 		uint8_t md5[16];
 		PackSource *src = nullptr;
 		bool encrypted;
+		bool compressed = false;
 	};
 
 private:
@@ -105,20 +112,30 @@ private:
 
 	static PackedData *singleton;
 	bool disabled = false;
+	bool memory_mapping = true;
 
 	void _free_packed_dirs(PackedDir *p_dir);
 	void _get_file_paths(PackedDir *p_dir, const String &p_parent_dir, HashSet<String> &r_paths) const;
 
 public:
 	void add_pack_source(PackSource *p_source);
-	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false); // for PackSource
+	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_compressed = false); // for PackSource
 	void remove_path(const String &p_path);
 	uint8_t *get_file_hash(const String &p_path);
+	// Returns false for files not provided by a pack.
+	bool get_file_location(const String &p_path, String &r_pack, uint64_t &r_offset) const;
 	HashSet<String> get_file_paths() const;
 
 	void set_disabled(bool p_disabled) { disabled = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled() const { return disabled; }
 
+	// Packs opened afterwards are read through a memory mapping where the platform supports it.
+	// A pack must not be truncated while mapped: on Unix, reading the missing pages raises SIGBUS.
+	// Files are no longer opened from the mapping once the pack's modification time changes, but
+	// files that are already open, or a rewrite within the timestamp's resolution, are not covered.
+	void set_memory_mapping_enabled(bool p_enabled) { memory_mapping = p_enabled; }
+	_FORCE_INLINE_ bool is_memory_mapping_enabled() const { return memory_mapping; }
+
 	static PackedData *get_singleton() { return singleton; }
 	Error add_pack(const String &p_path, bool p_replace_files, uint64_t p_offset);
 
@@ -142,6 +159,16 @@ public:
 };
 
 class PackedSourcePCK : public PackSource {
+	struct PackMapping {
+		Ref<FileMapping> mapping;
+		uint64_t modified_time = 0;
+	};
+
+	// Packs can be added while loader threads open files.
+	Mutex mutex;
+	HashMap<String, PackMapping> mappings;
+	HashMap<String, Vector<uint8_t>> dictionaries;
+
 public:
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) override;
 	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file) override;
@@ -155,6 +182,24 @@ class FileAccessPack : public FileAccess {
 	uint64_t off;
 
 	Ref<FileAccess> f;
+	// Set instead of `f` when reading from a mapped pack.
+	Ref<FileMapping> mapping;
+	const uint8_t *data = nullptr;
+
+	// Compressed entries are decoded into `decompressed` a frame at a time as they get read,
+	// or all at once from threaded loads, which read everything anyway.
+	Vector<uint8_t> compressed; // Unless mapped.
+	const uint8_t *compressed_data = nullptr;
+	Vector<uint8_t> dictionary;
+	PCKCompression::SeekTable seek_table;
+	mutable Vector<uint8_t> decompressed;
+	mutable LocalVector<bool> frames_decoded;
+
+	void _open_compressed(const Ref<FileMapping> &p_mapping, const Vector<uint8_t> &p_dictionary);
+	bool _decode_frame(uint32_t p_frame, uint8_t *p_dst) const;
+	static void _decode_frames_task(void *p_userdata, uint32_t p_index);
+	bool _decode(uint64_t p_from, uint64_t p_length) const;
+
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
 	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
 	virtual BitField<FileAccess::UnixPermissionFlags> _get_unix_permissions(const String &p_file) override { return 0; }
@@ -176,6 +221,7 @@ public:
 	virtual bool eof_reached() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_buffer_view(uint64_t p_length) const override;
 
 	virtual void set_big_endian(bool p_big_endian) override;
 
@@ -189,7 +235,7 @@ public:
 
 	virtual void close() override;
 
-	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file);
+	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const Ref<FileMapping> &p_mapping = Ref<FileMapping>(), const Vector<uint8_t> &p_dictionary = Vector<uint8_t>());
 };
 
 Ref<FileAccess> PackedData::try_open_path(const String &p_path) {
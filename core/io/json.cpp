@@ -31,6 +31,7 @@
 #include "json.h"
 
 #include "core/config/engine.h"
+#include "core/io/json_stream_parser.h"
 #include "core/object/script_language.h"
 #include "core/variant/container_type_validate.h"
 
@@ -1618,9 +1619,29 @@ Ref<Resource> ResourceFormatLoaderJSON::load(const String &p_path, const String
 	Ref<JSON> json;
 	json.instantiate();
 
-	Error err = json->parse(FileAccess::get_file_as_string(p_path), Engine::get_singleton()->is_editor_hint());
+	Error err;
+	int err_line = 0;
+	String err_message;
+	if (Engine::get_singleton()->is_editor_hint()) {
+		// Keep the text, so the code editor can edit it.
+		err = json->parse(FileAccess::get_file_as_string(p_path), true);
+		err_line = json->get_error_line();
+		err_message = json->get_error_message();
+	} else {
+		// Parse the UTF-8 bytes as they're read, without decoding the whole text first.
+		Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
+		ERR_FAIL_COND_V_MSG(f.is_null(), Ref<Resource>(), "Cannot open file '" + p_path + "'.");
+
+		JSONStreamParser parser;
+		Variant data;
+		err = parser.parse_file(f, data);
+		json->set_data(data);
+		err_line = parser.get_error_line();
+		err_message = parser.get_error_message();
+	}
+
 	if (err != OK) {
-		String err_text = "Error parsing JSON file at '" + p_path + "', on line " + itos(json->get_error_line()) + ": " + json->get_error_message();
+		String err_text = "Error parsing JSON file at '" + p_path + "', on line " + itos(err_line) + ": " + err_message;
 
 		if (Engine::get_singleton()->is_editor_hint()) {
 			// If running on editor, still allow opening the JSON so the code editor can edit it.
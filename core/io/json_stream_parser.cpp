@@ -0,0 +1,870 @@
+/**************************************************************************/
+/*  json_stream_parser.cpp                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "json_stream_parser.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define JSON_STREAM_PARSER_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define JSON_STREAM_PARSER_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+const char *JSONStreamParser::tk_name[TK_MAX] = {
+	"'{'",
+	"'}'",
+	"'['",
+	"']'",
+	"identifier",
+	"string",
+	"number",
+	"':'",
+	"','",
+	"EOF",
+};
+
+// 16 input bytes classified at once; masks hold the matching bytes, lowest first.
+struct JSONScanBlock {
+	static constexpr uint32_t SIZE = 16;
+#ifdef JSON_STREAM_PARSER_NEON
+	// One bit every four, see _to_mask().
+	static constexpr uint32_t SHIFT = 2;
+	static constexpr uint64_t ALL = 0x8888888888888888ull;
+#else
+	static constexpr uint32_t SHIFT = 0;
+	static constexpr uint64_t ALL = 0xffff;
+#endif
+
+	static _FORCE_INLINE_ uint32_t lowest(uint64_t p_bits) {
+#if defined(__GNUC__) || defined(__clang__)
+		return uint32_t(__builtin_ctzll(p_bits)) >> SHIFT;
+#elif defined(_MSC_VER) && defined(_WIN64)
+		unsigned long index;
+		_BitScanForward64(&index, p_bits);
+		return uint32_t(index) >> SHIFT;
+#else
+		uint32_t index = 0;
+		while (!(p_bits & (uint64_t(1) << index))) {
+			index++;
+		}
+		return index >> SHIFT;
+#endif
+	}
+
+	// Line breaks are rare, so clearing them one by one beats a popcount.
+	static _FORCE_INLINE_ int count(uint64_t p_bits) {
+		int count = 0;
+		while (p_bits) {
+			p_bits &= p_bits - 1;
+			count++;
+		}
+		return count;
+	}
+
+	// The bits of `p_bits` below its lowest set bit.
+	static _FORCE_INLINE_ uint64_t below_lowest(uint64_t p_bits) {
+		return (p_bits & (~p_bits + 1)) - 1;
+	}
+
+#if defined(JSON_STREAM_PARSER_SSE2)
+	__m128i bytes;
+
+	_FORCE_INLINE_ explicit JSONScanBlock(const uint8_t *p_bytes) {
+		bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_bytes));
+	}
+	_FORCE_INLINE_ uint64_t match(uint8_t p_byte) const {
+		return uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(char(p_byte)))));
+	}
+	// Bytes 1 to 32, the ones JSON::parse() skips: `byte - 1 <= 31` as unsigned.
+	_FORCE_INLINE_ uint64_t match_whitespace() const {
+		__m128i offset = _mm_sub_epi8(bytes, _mm_set1_epi8(1));
+		return uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_subs_epu8(offset, _mm_set1_epi8(31)), _mm_setzero_si128())));
+	}
+	// Quotes, backslashes and NUL, where a plain run of string bytes stops.
+	_FORCE_INLINE_ uint64_t match_string_stop() const {
+		__m128i stop = _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('"')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\\')));
+		return uint32_t(_mm_movemask_epi8(_mm_or_si128(stop, _mm_cmpeq_epi8(bytes, _mm_setzero_si128()))));
+	}
+#elif defined(JSON_STREAM_PARSER_NEON)
+	uint8x16_t bytes;
+
+	// NEON has no movemask; narrowing by 4 bits leaves one nibble per byte.
+	static _FORCE_INLINE_ uint64_t _to_mask(uint8x16_t p_cmp) {
+		return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(p_cmp), 4)), 0) & ALL;
+	}
+
+	_FORCE_INLINE_ explicit JSONScanBlock(const uint8_t *p_bytes) {
+		bytes = vld1q_u8(p_bytes);
+	}
+	_FORCE_INLINE_ uint64_t match(uint8_t p_byte) const {
+		return _to_mask(vceqq_u8(bytes, vdupq_n_u8(p_byte)));
+	}
+	_FORCE_INLINE_ uint64_t match_whitespace() const {
+		return _to_mask(vcleq_u8(vsubq_u8(bytes, vdupq_n_u8(1)), vdupq_n_u8(31)));
+	}
+	_FORCE_INLINE_ uint64_t match_string_stop() const {
+		uint8x16_t stop = vorrq_u8(vceqq_u8(bytes, vdupq_n_u8('"')), vceqq_u8(bytes, vdupq_n_u8('\\')));
+		return _to_mask(vorrq_u8(stop, vceqzq_u8(bytes)));
+	}
+#else
+	const uint8_t *bytes = nullptr;
+
+	_FORCE_INLINE_ explicit JSONScanBlock(const uint8_t *p_bytes) {
+		bytes = p_bytes;
+	}
+	_FORCE_INLINE_ uint64_t match(uint8_t p_byte) const {
+		uint64_t bits = 0;
+		for (uint32_t i = 0; i < SIZE; i++) {
+			bits |= uint64_t(bytes[i] == p_byte) << i;
+		}
+		return bits;
+	}
+	_FORCE_INLINE_ uint64_t match_whitespace() const {
+		uint64_t bits = 0;
+		for (uint32_t i = 0; i < SIZE; i++) {
+			bits |= uint64_t(uint8_t(bytes[i] - 1) <= 31) << i;
+		}
+		return bits;
+	}
+	_FORCE_INLINE_ uint64_t match_string_stop() const {
+		uint64_t bits = 0;
+		for (uint32_t i = 0; i < SIZE; i++) {
+			bits |= uint64_t(bytes[i] == '"' || bytes[i] == '\\' || bytes[i] == 0) << i;
+		}
+		return bits;
+	}
+#endif
+};
+
+// Returns the first byte in [p_from, p_end) that isn't whitespace, or `p_end`.
+static _FORCE_INLINE_ const uint8_t *_skip_whitespace(const uint8_t *p_from, const uint8_t *p_end, int &r_line) {
+	const uint8_t *p = p_from;
+	// Tokens are mostly separated by a single space or none at all.
+	if (p < p_end && *p > 32) {
+		return p;
+	}
+	while (p_end - p >= JSONScanBlock::SIZE) {
+		JSONScanBlock block(p);
+		uint64_t stop = ~block.match_whitespace() & JSONScanBlock::ALL;
+		uint64_t newlines = block.match('\n');
+		if (stop) {
+			r_line += JSONScanBlock::count(newlines & JSONScanBlock::below_lowest(stop));
+			return p + JSONScanBlock::lowest(stop);
+		}
+		r_line += JSONScanBlock::count(newlines);
+		p += JSONScanBlock::SIZE;
+	}
+	while (p < p_end && uint8_t(*p - 1) <= 31) {
+		if (*p == '\n') {
+			r_line++;
+		}
+		p++;
+	}
+	return p;
+}
+
+// Returns the first quote, backslash or NUL in [p_from, p_end), or `p_end`.
+static _FORCE_INLINE_ const uint8_t *_scan_string(const uint8_t *p_from, const uint8_t *p_end, int &r_line) {
+	const uint8_t *p = p_from;
+	while (p_end - p >= JSONScanBlock::SIZE) {
+		JSONScanBlock block(p);
+		uint64_t stop = block.match_string_stop();
+		uint64_t newlines = block.match('\n');
+		if (stop) {
+			r_line += JSONScanBlock::count(newlines & JSONScanBlock::below_lowest(stop));
+			return p + JSONScanBlock::lowest(stop);
+		}
+		r_line += JSONScanBlock::count(newlines);
+		p += JSONScanBlock::SIZE;
+	}
+	while (p < p_end && *p != '"' && *p != '\\' && *p != 0) {
+		if (*p == '\n') {
+			r_line++;
+		}
+		p++;
+	}
+	return p;
+}
+
+static String _decode_utf8(const uint8_t *p_utf8, uint32_t p_size) {
+	String str;
+	if (p_size == 0) {
+		return str;
+	}
+	// String::parse_utf8() takes a leading U+FEFF for a byte order mark.
+	if (p_size >= 3 && p_utf8[0] == 0xef && p_utf8[1] == 0xbb && p_utf8[2] == 0xbf) {
+		str.parse_utf8((const char *)p_utf8 + 3, p_size - 3);
+		return String::chr(0xfeff) + str;
+	}
+	str.parse_utf8((const char *)p_utf8, p_size);
+	return str;
+}
+
+// Assembles the events of a parse into Arrays and Dictionaries, in place.
+class JSONVariantBuilder : public JSONStreamParser::Handler {
+	struct Container {
+		Array array;
+		Dictionary dictionary;
+		String key;
+		bool is_object = false;
+	};
+
+	LocalVector<Container> stack;
+
+	void _add(const Variant &p_value) {
+		if (stack.is_empty()) {
+			data = p_value;
+			return;
+		}
+		Container &top = stack[stack.size() - 1];
+		if (top.is_object) {
+			top.dictionary[top.key] = p_value;
+		} else {
+			top.array.push_back(p_value);
+		}
+	}
+
+public:
+	Variant data;
+
+	virtual Error begin_object() override {
+		Dictionary dictionary;
+		_add(dictionary);
+		stack.push_back(Container());
+		stack[stack.size() - 1].dictionary = dictionary;
+		stack[stack.size() - 1].is_object = true;
+		return OK;
+	}
+	virtual Error key(const String &p_key) override {
+		stack[stack.size() - 1].key = p_key;
+		return OK;
+	}
+	virtual Error end_object() override {
+		stack.resize(stack.size() - 1);
+		return OK;
+	}
+	virtual Error begin_array() override {
+		Array array;
+		_add(array);
+		stack.push_back(Container());
+		stack[stack.size() - 1].array = array;
+		return OK;
+	}
+	virtual Error end_array() override {
+		stack.resize(stack.size() - 1);
+		return OK;
+	}
+	virtual Error value(const Variant &p_value) override {
+		_add(p_value);
+		return OK;
+	}
+};
+
+bool JSONStreamParser::_refill() {
+	pos = nullptr;
+	end = nullptr;
+	if (input_ended) {
+		return false;
+	}
+
+	uint64_t received = 0;
+	if (file.is_valid()) {
+		// Memory mapped and in-memory files hand out the rest of the file in place.
+		uint64_t remaining = file->get_length() - file->get_position();
+		const uint8_t *view = remaining > 0 ? file->get_buffer_view(remaining) : nullptr;
+		if (view) {
+			pos = view;
+			end = view + remaining;
+			return true;
+		}
+		chunk.resize(chunk_size);
+		received = file->get_buffer(chunk.ptr(), chunk_size);
+	} else if (stream.is_valid()) {
+		chunk.resize(chunk_size);
+		int stream_received = 0;
+		if (stream->get_partial_data(chunk.ptr(), chunk_size, stream_received) == OK && stream_received > 0) {
+			received = stream_received;
+		}
+	}
+
+	if (received == 0) {
+		input_ended = true;
+		return false;
+	}
+	pos = chunk.ptr();
+	end = pos + received;
+	return true;
+}
+
+void JSONStreamParser::_append_utf8(char32_t p_char) {
+	if (p_char < 0x80) {
+		scratch.push_back(uint8_t(p_char));
+	} else if (p_char < 0x800) {
+		scratch.push_back(uint8_t(0xc0 | (p_char >> 6)));
+		scratch.push_back(uint8_t(0x80 | (p_char & 0x3f)));
+	} else if (p_char < 0x10000) {
+		scratch.push_back(uint8_t(0xe0 | (p_char >> 12)));
+		scratch.push_back(uint8_t(0x80 | ((p_char >> 6) & 0x3f)));
+		scratch.push_back(uint8_t(0x80 | (p_char & 0x3f)));
+	} else {
+		scratch.push_back(uint8_t(0xf0 | (p_char >> 18)));
+		scratch.push_back(uint8_t(0x80 | ((p_char >> 12) & 0x3f)));
+		scratch.push_back(uint8_t(0x80 | ((p_char >> 6) & 0x3f)));
+		scratch.push_back(uint8_t(0x80 | (p_char & 0x3f)));
+	}
+}
+
+Error JSONStreamParser::_read_hex(char32_t &r_value) {
+	r_value = 0;
+	for (int i = 0; i < 4; i++) {
+		int c = _peek_byte();
+		if (c <= 0) {
+			err_str = "Unterminated String";
+			return ERR_PARSE_ERROR;
+		}
+		if (!is_hex_digit(c)) {
+			err_str = "Malformed hex constant in string";
+			return ERR_PARSE_ERROR;
+		}
+		pos++;
+		r_value = (r_value << 4) | (is_digit(c) ? c - '0' : (c | 0x20) - 'a' + 10);
+	}
+	return OK;
+}
+
+// Decodes the escape sequence after a backslash into `scratch`.
+Error JSONStreamParser::_read_escape() {
+	int next = _peek_byte();
+	if (next <= 0) {
+		err_str = "Unterminated String";
+		return ERR_PARSE_ERROR;
+	}
+	pos++;
+
+	char32_t res = 0;
+	switch (next) {
+		case 'b':
+			res = 8;
+			break;
+		case 't':
+			res = 9;
+			break;
+		case 'n':
+			res = 10;
+			break;
+		case 'f':
+			res = 12;
+			break;
+		case 'r':
+			res = 13;
+			break;
+		case 'u': {
+			Error err = _read_hex(res);
+			if (err != OK) {
+				return err;
+			}
+
+			if ((res & 0xfffffc00) == 0xd800) {
+				if (_peek_byte() != '\\') {
+					err_str = "Invalid UTF-16 sequence in string, unpaired lead surrogate";
+					return ERR_PARSE_ERROR;
+				}
+				pos++;
+				if (_peek_byte() != 'u') {
+					err_str = "Invalid UTF-16 sequence in string, unpaired lead surrogate";
+					return ERR_PARSE_ERROR;
+				}
+				pos++;
+				char32_t trail = 0;
+				err = _read_hex(trail);
+				if (err != OK) {
+					return err;
+				}
+				if ((trail & 0xfffffc00) != 0xdc00) {
+					err_str = "Invalid UTF-16 sequence in string, unpaired lead surrogate";
+					return ERR_PARSE_ERROR;
+				}
+				res = (res << 10UL) + trail - ((0xd800 << 10UL) + 0xdc00 - 0x10000);
+			} else if ((res & 0xfffffc00) == 0xdc00) {
+				err_str = "Invalid UTF-16 sequence in string, unpaired trail surrogate";
+				return ERR_PARSE_ERROR;
+			}
+		} break;
+		case '"':
+		case '\\':
+		case '/': {
+			res = next;
+		} break;
+		default: {
+			err_str = "Invalid escape sequence.";
+			return ERR_PARSE_ERROR;
+		}
+	}
+
+	_append_utf8(res);
+	return OK;
+}
+
+Error JSONStreamParser::_read_string(Token &r_token) {
+	r_token.type = TK_STRING;
+
+	// Most strings have no escapes and lie within the chunk, so are decoded in place.
+	const uint8_t *from = pos;
+	const uint8_t *stop = _scan_string(from, end, line);
+	if (stop < end && *stop == '"') {
+		pos = stop + 1;
+		r_token.value = _decode_utf8(from, stop - from);
+		return OK;
+	}
+
+	scratch.clear();
+	while (true) {
+		if (stop > from) {
+			uint32_t size = scratch.size();
+			scratch.resize(size + (stop - from));
+			memcpy(scratch.ptr() + size, from, stop - from);
+		}
+		pos = stop;
+
+		if (pos == end) {
+			if (!_refill()) {
+				err_str = "Unterminated String";
+				return ERR_PARSE_ERROR;
+			}
+		} else {
+			uint8_t c = *pos++;
+			if (c == '"') {
+				break;
+			} else if (c == 0) {
+				err_str = "Unterminated String";
+				return ERR_PARSE_ERROR;
+			}
+			Error err = _read_escape();
+			if (err != OK) {
+				return err;
+			}
+		}
+
+		if (pos == end && !_refill()) {
+			err_str = "Unterminated String";
+			return ERR_PARSE_ERROR;
+		}
+		from = pos;
+		stop = _scan_string(from, end, line);
+	}
+
+	r_token.value = _decode_utf8(scratch.ptr(), scratch.size());
+	return OK;
+}
+
+// Takes the longest prefix String::to_float() would, which JSON::parse() does.
+Error JSONStreamParser::_read_number(Token &r_token) {
+	scratch.clear();
+	bool has_digits = false;
+	int c = _peek_byte();
+	if (c == '-') {
+		scratch.push_back(c);
+		pos++;
+		c = _peek_byte();
+	}
+	while (is_digit(c)) {
+		scratch.push_back(c);
+		has_digits = true;
+		pos++;
+		c = _peek_byte();
+	}
+	if (c == '.') {
+		scratch.push_back(c);
+		pos++;
+		c = _peek_byte();
+		while (is_digit(c)) {
+			scratch.push_back(c);
+			has_digits = true;
+			pos++;
+			c = _peek_byte();
+		}
+	}
+	if (has_digits && (c == 'e' || c == 'E')) {
+		scratch.push_back(c);
+		pos++;
+		c = _peek_byte();
+		if (c == '+' || c == '-') {
+			scratch.push_back(c);
+			pos++;
+			c = _peek_byte();
+		}
+		// JSON::parse() would leave the 'e' to the next token, which can't follow a number.
+		has_digits = is_digit(c);
+		while (is_digit(c)) {
+			scratch.push_back(c);
+			pos++;
+			c = _peek_byte();
+		}
+	}
+	if (!has_digits) {
+		err_str = "Malformed number.";
+		return ERR_PARSE_ERROR;
+	}
+
+	scratch.push_back(0);
+	r_token.type = TK_NUMBER;
+	r_token.value = String::to_float((const char *)scratch.ptr());
+	return OK;
+}
+
+void JSONStreamParser::_read_identifier(Token &r_token) {
+	scratch.clear();
+	int c = _peek_byte();
+	while (is_ascii_alphabet_char(c)) {
+		scratch.push_back(c);
+		pos++;
+		c = _peek_byte();
+	}
+
+	r_token.type = TK_IDENTIFIER;
+	const char *id = (const char *)scratch.ptr();
+	if (scratch.size() == 4 && memcmp(id, "true", 4) == 0) {
+		r_token.value = true;
+	} else if (scratch.size() == 5 && memcmp(id, "false", 5) == 0) {
+		r_token.value = false;
+	} else if (scratch.size() == 4 && memcmp(id, "null", 4) == 0) {
+		r_token.value = Variant();
+	} else {
+		r_token.value = String::utf8(id, scratch.size());
+	}
+}
+
+Error JSONStreamParser::_get_token(Token &r_token) {
+	while (true) {
+		if (!_has_input()) {
+			r_token.type = TK_EOF;
+			return OK;
+		}
+		pos = _skip_whitespace(pos, end, line);
+		if (pos < end) {
+			break;
+		}
+	}
+
+	switch (*pos) {
+		case 0: {
+			// Like JSON::parse(), ignore anything after a NUL.
+			r_token.type = TK_EOF;
+			return OK;
+		}
+		case '{': {
+			r_token.type = TK_CURLY_BRACKET_OPEN;
+			pos++;
+			return OK;
+		}
+		case '}': {
+			r_token.type = TK_CURLY_BRACKET_CLOSE;
+			pos++;
+			return OK;
+		}
+		case '[': {
+			r_token.type = TK_BRACKET_OPEN;
+			pos++;
+			return OK;
+		}
+		case ']': {
+			r_token.type = TK_BRACKET_CLOSE;
+			pos++;
+			return OK;
+		}
+		case ':': {
+			r_token.type = TK_COLON;
+			pos++;
+			return OK;
+		}
+		case ',': {
+			r_token.type = TK_COMMA;
+			pos++;
+			return OK;
+		}
+		case '"': {
+			pos++;
+			return _read_string(r_token);
+		}
+		default: {
+			if (*pos == '-' || is_digit(*pos)) {
+				return _read_number(r_token);
+			} else if (is_ascii_alphabet_char(*pos)) {
+				_read_identifier(r_token);
+				return OK;
+			}
+			err_str = "Unexpected character.";
+			return ERR_PARSE_ERROR;
+		}
+	}
+}
+
+Error JSONStreamParser::_fail(Error p_error, const String &p_message) {
+	err_str = p_message;
+	err_line = line;
+	return p_error;
+}
+
+Error JSONStreamParser::_parse(Handler *p_handler) {
+	ERR_FAIL_NULL_V(p_handler, ERR_INVALID_PARAMETER);
+
+	line = 0;
+	err_line = 0;
+	err_str = String();
+	stack.clear();
+
+	// Skip the UTF-8 byte order mark, as String::parse_utf8() does. Checked byte by byte, since
+	// it can span chunks. Bytes of an incomplete one are invalid JSON anyway.
+	static const uint8_t bom[3] = { 0xef, 0xbb, 0xbf };
+	for (int i = 0; i < 3 && _peek_byte() == bom[i]; i++) {
+		pos++;
+	}
+
+	enum State {
+		STATE_VALUE,
+		STATE_ARRAY,
+		STATE_OBJECT,
+		STATE_COLON,
+		STATE_OBJECT_VALUE,
+		STATE_END,
+	};
+
+	// Instead of recursing like JSON::parse(), the open containers are on `stack`.
+	State state = STATE_VALUE;
+	bool need_comma = false;
+	Token token;
+	while (true) {
+		Error err = _get_token(token);
+		if (err != OK) {
+			if (state == STATE_END) {
+				return _fail(ERR_PARSE_ERROR, "Expected 'EOF'");
+			}
+			err_line = line;
+			return err;
+		}
+
+		bool closed = false;
+		switch (state) {
+			case STATE_VALUE:
+				break;
+			case STATE_ARRAY: {
+				if (token.type == TK_BRACKET_CLOSE) {
+					err = p_handler->end_array();
+					closed = true;
+					break;
+				}
+				if (token.type == TK_EOF) {
+					return _fail(ERR_PARSE_ERROR, "Expected ']'");
+				}
+				if (need_comma) {
+					if (token.type != TK_COMMA) {
+						return _fail(ERR_PARSE_ERROR, "Expected ','");
+					}
+					need_comma = false;
+					continue;
+				}
+			} break;
+			case STATE_OBJECT: {
+				if (token.type == TK_CURLY_BRACKET_CLOSE) {
+					err = p_handler->end_object();
+					closed = true;
+					break;
+				}
+				if (token.type == TK_EOF) {
+					return _fail(ERR_PARSE_ERROR, "Expected '}'");
+				}
+				if (need_comma) {
+					if (token.type != TK_COMMA) {
+						return _fail(ERR_PARSE_ERROR, "Expected '}' or ','");
+					}
+					need_comma = false;
+					continue;
+				}
+				if (token.type != TK_STRING) {
+					return _fail(ERR_PARSE_ERROR, "Expected key");
+				}
+				err = p_handler->key(token.value);
+				if (err != OK) {
+					return _fail(err, "Parsing stopped by the handler.");
+				}
+				state = STATE_COLON;
+				continue;
+			}
+			case STATE_COLON: {
+				if (token.type != TK_COLON) {
+					return _fail(ERR_PARSE_ERROR, "Expected ':'");
+				}
+				state = STATE_OBJECT_VALUE;
+				continue;
+			}
+			case STATE_OBJECT_VALUE: {
+				if (token.type == TK_EOF) {
+					return _fail(ERR_PARSE_ERROR, "Expected '}'");
+				}
+			} break;
+			case STATE_END: {
+				if (token.type != TK_EOF) {
+					return _fail(ERR_PARSE_ERROR, "Expected 'EOF'");
+				}
+				return OK;
+			}
+		}
+
+		if (closed) {
+			stack.resize(stack.size() - 1);
+		} else {
+			if (stack.size() > Variant::MAX_RECURSION_DEPTH) {
+				return _fail(ERR_OUT_OF_MEMORY, "JSON structure is too deep. Bailing.");
+			}
+
+			switch (token.type) {
+				case TK_CURLY_BRACKET_OPEN: {
+					err = p_handler->begin_object();
+					stack.push_back(true);
+					state = STATE_OBJECT;
+					need_comma = false;
+				} break;
+				case TK_BRACKET_OPEN: {
+					err = p_handler->begin_array();
+					stack.push_back(false);
+					state = STATE_ARRAY;
+					need_comma = false;
+				} break;
+				case TK_IDENTIFIER: {
+					if (token.value.get_type() == Variant::STRING) {
+						return _fail(ERR_PARSE_ERROR, "Expected 'true','false' or 'null', got '" + String(token.value) + "'.");
+					}
+					err = p_handler->value(token.value);
+				} break;
+				case TK_NUMBER:
+				case TK_STRING: {
+					err = p_handler->value(token.value);
+				} break;
+				default: {
+					return _fail(ERR_PARSE_ERROR, "Expected value, got " + String(tk_name[token.type]) + ".");
+				}
+			}
+			if (token.type == TK_CURLY_BRACKET_OPEN || token.type == TK_BRACKET_OPEN) {
+				if (err != OK) {
+					return _fail(err, "Parsing stopped by the handler.");
+				}
+				continue;
+			}
+		}
+		if (err != OK) {
+			return _fail(err, "Parsing stopped by the handler.");
+		}
+
+		// A value is complete, see what it's in.
+		if (stack.is_empty()) {
+			state = STATE_END;
+		} else {
+			state = stack[stack.size() - 1] ? STATE_OBJECT : STATE_ARRAY;
+			need_comma = true;
+		}
+	}
+}
+
+Error JSONStreamParser::_parse_into(Variant &r_data) {
+	JSONVariantBuilder builder;
+	Error err = _parse(&builder);
+	r_data = err == OK ? builder.data : Variant();
+	return err;
+}
+
+void JSONStreamParser::_reset_input() {
+	pos = nullptr;
+	end = nullptr;
+	input_ended = false;
+	file.unref();
+	stream.unref();
+}
+
+void JSONStreamParser::set_chunk_size(uint32_t p_size) {
+	ERR_FAIL_COND(p_size == 0);
+	chunk_size = p_size;
+}
+
+Error JSONStreamParser::parse_buffer(const uint8_t *p_utf8, uint64_t p_length, Handler *p_handler) {
+	_reset_input();
+	input_ended = true;
+	pos = p_utf8;
+	end = p_utf8 + p_length;
+	return _parse(p_handler);
+}
+
+Error JSONStreamParser::parse_file(const Ref<FileAccess> &p_file, Handler *p_handler) {
+	ERR_FAIL_COND_V(p_file.is_null(), ERR_INVALID_PARAMETER);
+	_reset_input();
+	file = p_file;
+	Error err = _parse(p_handler);
+	_reset_input();
+	return err;
+}
+
+Error JSONStreamParser::parse_stream(const Ref<StreamPeer> &p_stream, Handler *p_handler) {
+	ERR_FAIL_COND_V(p_stream.is_null(), ERR_INVALID_PARAMETER);
+	_reset_input();
+	stream = p_stream;
+	Error err = _parse(p_handler);
+	_reset_input();
+	return err;
+}
+
+Error JSONStreamParser::parse_buffer(const uint8_t *p_utf8, uint64_t p_length, Variant &r_data) {
+	_reset_input();
+	input_ended = true;
+	pos = p_utf8;
+	end = p_utf8 + p_length;
+	return _parse_into(r_data);
+}
+
+Error JSONStreamParser::parse_file(const Ref<FileAccess> &p_file, Variant &r_data) {
+	ERR_FAIL_COND_V(p_file.is_null(), ERR_INVALID_PARAMETER);
+	_reset_input();
+	file = p_file;
+	Error err = _parse_into(r_data);
+	_reset_input();
+	return err;
+}
+
+Error JSONStreamParser::parse_stream(const Ref<StreamPeer> &p_stream, Variant &r_data) {
+	ERR_FAIL_COND_V(p_stream.is_null(), ERR_INVALID_PARAMETER);
+	_reset_input();
+	stream = p_stream;
+	Error err = _parse_into(r_data);
+	_reset_input();
+	return err;
+}
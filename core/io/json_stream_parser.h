@@ -0,0 +1,140 @@
+/**************************************************************************/
+/*  json_stream_parser.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef JSON_STREAM_PARSER_H
+#define JSON_STREAM_PARSER_H
+
+#include "core/io/file_access.h"
+#include "core/io/stream_peer.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/variant.h"
+
+// Parses JSON straight from UTF-8 bytes, pulling them from memory, a file or a
+// stream peer a chunk at a time, so the document never has to be decoded to a
+// String first. Accepts the same documents as JSON::parse() and reports the same
+// error messages and (zero-based) lines, except for malformed numbers.
+//
+// Events go to a Handler (SAX style), or are assembled into a Variant tree.
+class JSONStreamParser {
+public:
+	// Every callback may return an error to stop parsing.
+	class Handler {
+	public:
+		virtual Error begin_object() { return OK; }
+		virtual Error key(const String &p_key) { return OK; }
+		virtual Error end_object() { return OK; }
+		virtual Error begin_array() { return OK; }
+		virtual Error end_array() { return OK; }
+		// `null`, a bool, a float (for every number) or a String.
+		virtual Error value(const Variant &p_value) { return OK; }
+
+		virtual ~Handler() {}
+	};
+
+	static constexpr uint32_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+private:
+	enum TokenType {
+		TK_CURLY_BRACKET_OPEN,
+		TK_CURLY_BRACKET_CLOSE,
+		TK_BRACKET_OPEN,
+		TK_BRACKET_CLOSE,
+		TK_IDENTIFIER,
+		TK_STRING,
+		TK_NUMBER,
+		TK_COLON,
+		TK_COMMA,
+		TK_EOF,
+		TK_MAX
+	};
+
+	struct Token {
+		TokenType type = TK_EOF;
+		Variant value; // For identifiers, the keyword's value, or its name when it isn't one.
+	};
+
+	static const char *tk_name[];
+
+	// Input: the bytes in [pos, end) are pending, more come from the file or stream.
+	const uint8_t *pos = nullptr;
+	const uint8_t *end = nullptr;
+	bool input_ended = false;
+	Ref<FileAccess> file;
+	Ref<StreamPeer> stream;
+	uint32_t chunk_size = DEFAULT_CHUNK_SIZE;
+	LocalVector<uint8_t> chunk;
+
+	// Bytes of a number, identifier or string that can't be used in place.
+	LocalVector<uint8_t> scratch;
+	LocalVector<bool> stack; // true for objects.
+
+	int line = 0;
+	int err_line = 0;
+	String err_str;
+
+	bool _refill();
+	_FORCE_INLINE_ bool _has_input() { return pos < end || _refill(); }
+	_FORCE_INLINE_ int _peek_byte() { return _has_input() ? *pos : -1; }
+
+	void _append_utf8(char32_t p_char);
+	Error _read_hex(char32_t &r_value);
+	Error _read_escape();
+	Error _read_string(Token &r_token);
+	Error _read_number(Token &r_token);
+	void _read_identifier(Token &r_token);
+	Error _get_token(Token &r_token);
+
+	Error _fail(Error p_error, const String &p_message);
+	Error _parse(Handler *p_handler);
+	Error _parse_into(Variant &r_data);
+	void _reset_input();
+
+public:
+	// Sets how many bytes are read at a time from files and stream peers.
+	void set_chunk_size(uint32_t p_size);
+	uint32_t get_chunk_size() const { return chunk_size; }
+
+	Error parse_buffer(const uint8_t *p_utf8, uint64_t p_length, Handler *p_handler);
+	// Reads from the current position to the end of the file.
+	Error parse_file(const Ref<FileAccess> &p_file, Handler *p_handler);
+	// Reads until the peer has no more data available, so network peers should
+	// already hold the whole document.
+	Error parse_stream(const Ref<StreamPeer> &p_stream, Handler *p_handler);
+
+	// Same as above, but builds the parsed Variant, like JSON::get_data().
+	Error parse_buffer(const uint8_t *p_utf8, uint64_t p_length, Variant &r_data);
+	Error parse_file(const Ref<FileAccess> &p_file, Variant &r_data);
+	Error parse_stream(const Ref<StreamPeer> &p_stream, Variant &r_data);
+
+	int get_error_line() const { return err_line; }
+	String get_error_message() const { return err_str; }
+};
+
+#endif // JSON_STREAM_PARSER_H
@@ -0,0 +1,268 @@
+/**************************************************************************/
+/*  pck_compression.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "pck_compression.h"
+
+#include "core/io/compression.h"
+#include "core/io/marshalls.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+#include <zstd.h>
+
+// Magic of the skippable frame the zstd seekable format stores its seek table in.
+#define SEEK_TABLE_MAGIC 0x184D2A5E
+
+// Dictionary training follows zstd's COVER algorithm: data is compared through
+// the d-mers (DMER_SIZE byte sequences) it contains, and the dictionary is made
+// of the SEGMENT_SIZE byte segments covering the d-mers shared by most samples.
+static const int DMER_SIZE = 8;
+static const int SEGMENT_SIZE = 256;
+static const int SAMPLES_MIN = 8;
+
+static _FORCE_INLINE_ uint64_t _get_dmer(const uint8_t *p_src) {
+	uint64_t dmer;
+	memcpy(&dmer, p_src, sizeof(dmer));
+	return dmer;
+}
+
+bool PCKCompression::is_dictionary_sample(const String &p_path) {
+	const String extension = p_path.get_extension().to_lower();
+	return extension == "res" || extension == "scn";
+}
+
+Vector<uint8_t> PCKCompression::train_dictionary(const Vector<Vector<uint8_t>> &p_samples, int p_max_size) {
+	ERR_FAIL_COND_V(p_max_size < SEGMENT_SIZE, Vector<uint8_t>());
+
+	// Like zstd, train over about a hundred times the dictionary size.
+	const uint64_t data_max = uint64_t(p_max_size) * 100;
+	LocalVector<uint8_t> data;
+	LocalVector<uint32_t> sample_ends;
+	for (const Vector<uint8_t> &sample : p_samples) {
+		const uint32_t size = MIN(sample.size(), int64_t(SAMPLE_MAX_SIZE));
+		if (size < SEGMENT_SIZE) {
+			continue;
+		}
+		if (data.size() + size > data_max) {
+			break;
+		}
+		const uint32_t ofs = data.size();
+		data.resize(ofs + size);
+		memcpy(data.ptr() + ofs, sample.ptr(), size);
+		sample_ends.push_back(data.size());
+	}
+	if (sample_ends.size() < SAMPLES_MIN) {
+		return Vector<uint8_t>();
+	}
+
+	// Weight of each d-mer: how many samples besides the first one contain it.
+	struct DmerInfo {
+		uint32_t weight = 0;
+		uint32_t last_sample = UINT32_MAX;
+	};
+	HashMap<uint64_t, DmerInfo> dmers;
+	uint32_t sample_begin = 0;
+	for (uint32_t i = 0; i < sample_ends.size(); i++) {
+		for (uint32_t j = sample_begin; j + DMER_SIZE <= sample_ends[i]; j++) {
+			DmerInfo &info = dmers[_get_dmer(&data[j])];
+			if (info.last_sample != i) {
+				info.weight += info.last_sample != UINT32_MAX;
+				info.last_sample = i;
+			}
+		}
+		sample_begin = sample_ends[i];
+	}
+
+	// Split the data into one epoch per segment and keep the best segment of each,
+	// where a segment scores the weight of the distinct d-mers it contains. Once
+	// kept, these d-mers are worth nothing to the following epochs.
+	struct Segment {
+		uint32_t begin = 0;
+		uint64_t score = 0;
+
+		bool operator<(const Segment &p_other) const { return score < p_other.score; }
+	};
+	LocalVector<Segment> segments;
+	const uint32_t dmers_per_segment = SEGMENT_SIZE - DMER_SIZE + 1;
+	const uint32_t epoch_size = MAX(uint32_t(SEGMENT_SIZE), data.size() / (p_max_size / SEGMENT_SIZE));
+	HashMap<uint64_t, uint32_t> window;
+	for (uint32_t epoch_begin = 0; epoch_begin + SEGMENT_SIZE <= data.size(); epoch_begin += epoch_size) {
+		const uint32_t epoch_end = MIN(epoch_begin + epoch_size, data.size());
+		Segment best;
+		uint64_t score = 0;
+		window.clear();
+
+		for (uint32_t i = epoch_begin; i + DMER_SIZE <= epoch_end; i++) {
+			const uint64_t dmer = _get_dmer(&data[i]);
+			uint32_t &count = window[dmer];
+			if (count++ == 0) {
+				const DmerInfo *info = dmers.getptr(dmer);
+				score += info ? info->weight : 0;
+			}
+
+			if (i >= epoch_begin + dmers_per_segment) {
+				const uint64_t old_dmer = _get_dmer(&data[i - dmers_per_segment]);
+				uint32_t *old_count = window.getptr(old_dmer);
+				if (--(*old_count) == 0) {
+					const DmerInfo *info = dmers.getptr(old_dmer);
+					score -= info ? info->weight : 0;
+				}
+			}
+
+			if (i + 1 >= epoch_begin + dmers_per_segment && score > best.score) {
+				best.begin = i + 1 - dmers_per_segment;
+				best.score = score;
+			}
+		}
+
+		if (best.score == 0) {
+			continue;
+		}
+		segments.push_back(best);
+		for (uint32_t i = best.begin; i < best.begin + dmers_per_segment; i++) {
+			DmerInfo *info = dmers.getptr(_get_dmer(&data[i]));
+			if (info) {
+				info->weight = 0;
+			}
+		}
+	}
+
+	// The best segments go last, where matches are the cheapest to encode.
+	segments.sort();
+	const uint32_t segment_count = MIN(segments.size(), uint32_t(p_max_size / SEGMENT_SIZE));
+	Vector<uint8_t> dictionary;
+	dictionary.resize(segment_count * SEGMENT_SIZE);
+	uint8_t *w = dictionary.ptrw();
+	for (uint32_t i = 0; i < segment_count; i++) {
+		memcpy(w + i * SEGMENT_SIZE, &data[segments[segments.size() - segment_count + i].begin], SEGMENT_SIZE);
+	}
+	return dictionary;
+}
+
+Vector<uint8_t> PCKCompression::compress(const uint8_t *p_src, uint64_t p_size, const Vector<uint8_t> &p_dictionary) {
+	if (p_size == 0) {
+		return Vector<uint8_t>();
+	}
+
+	const uint64_t frame_count = (p_size + FRAME_SIZE - 1) / FRAME_SIZE;
+	const uint64_t table_size = SEEK_TABLE_HEADER_SIZE + frame_count * 4;
+	if (table_size >= p_size) {
+		return Vector<uint8_t>();
+	}
+
+	Vector<uint8_t> dst;
+	dst.resize(table_size + frame_count * ZSTD_compressBound(FRAME_SIZE));
+	uint8_t *w = dst.ptrw();
+	encode_uint32(SEEK_TABLE_MAGIC, w);
+	encode_uint32(table_size - 8, w + 4);
+	encode_uint32(frame_count, w + 8);
+	encode_uint32(FRAME_SIZE, w + 12);
+
+	ZSTD_CCtx *cctx = ZSTD_createCCtx();
+	ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, Compression::zstd_level);
+	uint64_t ofs = table_size;
+	for (uint64_t i = 0; i < frame_count; i++) {
+		if (!p_dictionary.is_empty()) {
+			// A prefix is only used for the next frame.
+			ZSTD_CCtx_refPrefix(cctx, p_dictionary.ptr(), p_dictionary.size());
+		}
+		const uint64_t src_ofs = i * FRAME_SIZE;
+		const size_t ret = ZSTD_compress2(cctx, w + ofs, dst.size() - ofs, p_src + src_ofs, MIN(p_size - src_ofs, uint64_t(FRAME_SIZE)));
+		if (ZSTD_isError(ret)) {
+			ZSTD_freeCCtx(cctx);
+			ERR_FAIL_V_MSG(Vector<uint8_t>(), vformat("Zstandard compression failed: %s.", ZSTD_getErrorName(ret)));
+		}
+		encode_uint32(ret, w + SEEK_TABLE_HEADER_SIZE + i * 4);
+		ofs += ret;
+	}
+	ZSTD_freeCCtx(cctx);
+
+	if (ofs >= p_size) {
+		return Vector<uint8_t>();
+	}
+	dst.resize(ofs);
+	return dst;
+}
+
+uint32_t PCKCompression::get_seek_table_size(const uint8_t *p_header) {
+	if (decode_uint32(p_header) != SEEK_TABLE_MAGIC) {
+		return 0;
+	}
+	const uint64_t size = uint64_t(decode_uint32(p_header + 4)) + 8;
+	if (size < SEEK_TABLE_HEADER_SIZE || size > UINT32_MAX) {
+		return 0;
+	}
+	return size;
+}
+
+Error PCKCompression::parse_seek_table(const uint8_t *p_src, uint32_t p_table_size, uint64_t p_uncompressed_size, SeekTable &r_table) {
+	ERR_FAIL_COND_V(p_table_size < SEEK_TABLE_HEADER_SIZE || get_seek_table_size(p_src) != p_table_size, ERR_FILE_CORRUPT);
+
+	const uint32_t frame_count = decode_uint32(p_src + 8);
+	const uint32_t frame_size = decode_uint32(p_src + 12);
+	ERR_FAIL_COND_V(frame_size == 0 || p_table_size != SEEK_TABLE_HEADER_SIZE + uint64_t(frame_count) * 4, ERR_FILE_CORRUPT);
+	ERR_FAIL_COND_V(frame_count == 0 || (p_uncompressed_size + frame_size - 1) / frame_size != frame_count, ERR_FILE_CORRUPT);
+
+	r_table.frame_size = frame_size;
+	r_table.frame_offsets.resize(frame_count + 1);
+	uint64_t *offsets = r_table.frame_offsets.ptrw();
+	uint64_t ofs = p_table_size;
+	for (uint32_t i = 0; i < frame_count; i++) {
+		offsets[i] = ofs;
+		ofs += decode_uint32(p_src + SEEK_TABLE_HEADER_SIZE + i * 4);
+	}
+	offsets[frame_count] = ofs;
+	return OK;
+}
+
+// Frees the decompression context of a thread when it exits.
+struct DCtxHolder {
+	ZSTD_DCtx *dctx = nullptr;
+
+	~DCtxHolder() {
+		ZSTD_freeDCtx(dctx);
+	}
+};
+
+bool PCKCompression::decompress_frame(uint8_t *p_dst, uint32_t p_dst_size, const uint8_t *p_src, uint32_t p_src_size, const Vector<uint8_t> &p_dictionary) {
+	// Each thread reuses its context, reset so nothing from its previous frame applies.
+	thread_local DCtxHolder holder;
+	if (!holder.dctx) {
+		holder.dctx = ZSTD_createDCtx();
+		ERR_FAIL_NULL_V(holder.dctx, false);
+	} else {
+		ZSTD_DCtx_reset(holder.dctx, ZSTD_reset_session_and_parameters);
+	}
+	if (!p_dictionary.is_empty()) {
+		ZSTD_DCtx_refPrefix(holder.dctx, p_dictionary.ptr(), p_dictionary.size());
+	}
+	const size_t ret = ZSTD_decompressDCtx(holder.dctx, p_dst, p_dst_size, p_src, p_src_size);
+	return !ZSTD_isError(ret) && ret == p_dst_size;
+}
@@ -0,0 +1,74 @@
+/**************************************************************************/
+/*  pck_compression.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef PCK_COMPRESSION_H
+#define PCK_COMPRESSION_H
+
+#include "core/string/ustring.h"
+#include "core/templates/vector.h"
+
+// Zstandard compression of PCK entries (PACK_FILE_COMPRESSED).
+//
+// A compressed entry is a zstd stream made of independent frames of FRAME_SIZE
+// uncompressed bytes, preceded by a skippable frame holding the seek table:
+//
+//   u32 0x184D2A5E, u32 table size, u32 frame count, u32 frame size, u32 compressed size of each frame.
+//
+// Every frame is compressed against the pack's dictionary (if any), which is raw
+// content trained over the pack's binary resources and referenced as a prefix.
+class PCKCompression {
+public:
+	enum {
+		FRAME_SIZE = 64 * 1024,
+		DICTIONARY_MAX_SIZE = 110 * 1024,
+		SEEK_TABLE_HEADER_SIZE = 16,
+		SAMPLE_MAX_SIZE = 64 * 1024, // Only the start of each sample is used for training.
+	};
+
+	struct SeekTable {
+		uint32_t frame_size = 0;
+		Vector<uint64_t> frame_offsets; // Frame count + 1, relative to the start of the entry.
+
+		uint32_t get_frame_count() const { return frame_offsets.size() - 1; }
+	};
+
+	static bool is_dictionary_sample(const String &p_path);
+	static Vector<uint8_t> train_dictionary(const Vector<Vector<uint8_t>> &p_samples, int p_max_size = DICTIONARY_MAX_SIZE);
+
+	// Returns an empty vector if the compressed entry would not be smaller.
+	static Vector<uint8_t> compress(const uint8_t *p_src, uint64_t p_size, const Vector<uint8_t> &p_dictionary);
+
+	// Size of the whole seek table given its first SEEK_TABLE_HEADER_SIZE bytes, 0 if they aren't one.
+	static uint32_t get_seek_table_size(const uint8_t *p_header);
+	static Error parse_seek_table(const uint8_t *p_src, uint32_t p_table_size, uint64_t p_uncompressed_size, SeekTable &r_table);
+	static bool decompress_frame(uint8_t *p_dst, uint32_t p_dst_size, const uint8_t *p_src, uint32_t p_src_size, const Vector<uint8_t> &p_dictionary);
+};
+
+#endif // PCK_COMPRESSION_H
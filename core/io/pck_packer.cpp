@@ -33,7 +33,8 @@
 #include "core/crypto/crypto_core.h"
 #include "core/io/file_access.h"
 #include "core/io/file_access_encrypted.h"
-#include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
+#include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION, PACK_FORMAT_VERSION_COMPRESSED
+#include "core/io/pck_compression.h"
 #include "core/version.h"
 
 static int _get_pad(int p_alignment, int p_n) {
@@ -51,6 +52,11 @@ void PCKPacker::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("add_file", "target_path", "source_path", "encrypt"), &PCKPacker::add_file, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("add_file_removal", "target_path"), &PCKPacker::add_file_removal);
 	ClassDB::bind_method(D_METHOD("flush", "verbose"), &PCKPacker::flush, DEFVAL(false));
+
+	ClassDB::bind_method(D_METHOD("set_compression_enabled", "enabled"), &PCKPacker::set_compression_enabled);
+	ClassDB::bind_method(D_METHOD("is_compression_enabled"), &PCKPacker::is_compression_enabled);
+
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "compression_enabled"), "set_compression_enabled", "is_compression_enabled");
 }
 
 Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const String &p_key, bool p_encrypt_directory) {
@@ -163,6 +169,8 @@ Error PCKPacker::add_file(const String &p_target_path, const String &p_source_pa
 		_size += 16; // iv
 	}
 
+	pf.stored_size = _size;
+
 	int pad = _get_pad(alignment, ofs + _size);
 	ofs = ofs + _size + pad;
 
@@ -171,13 +179,75 @@ Error PCKPacker::add_file(const String &p_target_path, const String &p_source_pa
 	return OK;
 }
 
+Error PCKPacker::_compress_files(Vector<uint8_t> &r_dictionary, Ref<FileAccess> &r_compressed) {
+	Vector<Vector<uint8_t>> samples;
+	for (const File &pf : files) {
+		if (pf.removal || pf.encrypted || !PCKCompression::is_dictionary_sample(pf.path)) {
+			continue;
+		}
+		Ref<FileAccess> src = FileAccess::open(pf.src_path, FileAccess::READ);
+		ERR_FAIL_COND_V(src.is_null(), ERR_FILE_CANT_OPEN);
+		samples.push_back(src->get_buffer(MIN(src->get_length(), uint64_t(PCKCompression::SAMPLE_MAX_SIZE))));
+	}
+	r_dictionary = PCKCompression::train_dictionary(samples);
+
+	r_compressed = FileAccess::create_temp(FileAccess::READ_WRITE, "pck");
+	ERR_FAIL_COND_V(r_compressed.is_null(), ERR_CANT_CREATE);
+
+	// Files now follow the dictionary, and compressed ones take less space.
+	ofs = r_dictionary.size() + _get_pad(alignment, r_dictionary.size());
+	for (File &pf : files) {
+		if (pf.removal) {
+			pf.ofs = ofs;
+			continue;
+		}
+
+		if (!pf.encrypted) {
+			Vector<uint8_t> data = FileAccess::get_file_as_bytes(pf.src_path);
+			Vector<uint8_t> compressed = PCKCompression::compress(data.ptr(), data.size(), r_dictionary);
+			if (!compressed.is_empty()) {
+				pf.compressed = true;
+				pf.compressed_ofs = r_compressed->get_position();
+				pf.stored_size = compressed.size();
+				r_compressed->store_buffer(compressed);
+			}
+		}
+
+		pf.ofs = ofs;
+		ofs = ofs + pf.stored_size + _get_pad(alignment, ofs + pf.stored_size);
+	}
+
+	return OK;
+}
+
 Error PCKPacker::flush(bool p_verbose) {
 	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
 
+	// Done first, since the index holds the final offsets.
+	Vector<uint8_t> dictionary;
+	Ref<FileAccess> compressed;
+	if (compression_enabled) {
+		Error err = _compress_files(dictionary, compressed);
+		ERR_FAIL_COND_V(err != OK, err);
+
+		for (const File &pf : files) {
+			if (pf.compressed) {
+				uint64_t pos = file->get_position();
+				file->seek(4); // Right after the magic number written by pck_start().
+				file->store_32(PACK_FORMAT_VERSION_COMPRESSED);
+				file->seek(pos);
+				break;
+			}
+		}
+	}
+
 	int64_t file_base_ofs = file->get_position();
 	file->store_64(0); // files base
 
-	for (int i = 0; i < 16; i++) {
+	file->store_64(0); // dictionary offset, from the files base
+	file->store_32(dictionary.size()); // dictionary size
+
+	for (int i = 0; i < 13; i++) {
 		file->store_32(0); // reserved
 	}
 
@@ -218,6 +288,9 @@ Error PCKPacker::flush(bool p_verbose) {
 		if (files[i].removal) {
 			flags |= PACK_FILE_REMOVAL;
 		}
+		if (files[i].compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
 		fhead->store_32(flags);
 	}
 
@@ -236,6 +309,14 @@ Error PCKPacker::flush(bool p_verbose) {
 	file->store_64(file_base); // update files base
 	file->seek(file_base);
 
+	if (!dictionary.is_empty()) {
+		file->store_buffer(dictionary);
+		int pad = _get_pad(alignment, file->get_position());
+		for (int j = 0; j < pad; j++) {
+			file->store_8(0);
+		}
+	}
+
 	const uint32_t buf_max = 65536;
 	uint8_t *buf = memnew_arr(uint8_t, buf_max);
 
@@ -245,8 +326,15 @@ Error PCKPacker::flush(bool p_verbose) {
 			continue;
 		}
 
-		Ref<FileAccess> src = FileAccess::open(files[i].src_path, FileAccess::READ);
+		Ref<FileAccess> src;
 		uint64_t to_write = files[i].size;
+		if (files[i].compressed) {
+			src = compressed;
+			src->seek(files[i].compressed_ofs);
+			to_write = files[i].stored_size;
+		} else {
+			src = FileAccess::open(files[i].src_path, FileAccess::READ);
+		}
 
 		Ref<FileAccess> ftmp = file;
 		if (files[i].encrypted) {
@@ -286,3 +374,11 @@ Error PCKPacker::flush(bool p_verbose) {
 
 	return OK;
 }
+
+void PCKPacker::set_compression_enabled(bool p_enabled) {
+	compression_enabled = p_enabled;
+}
+
+bool PCKPacker::is_compression_enabled() const {
+	return compression_enabled;
+}
@@ -44,6 +44,7 @@ class PCKPacker : public RefCounted {
 
 	Vector<uint8_t> key;
 	bool enc_dir = false;
+	bool compression_enabled = false;
 
 	static void _bind_methods();
 
@@ -52,18 +53,26 @@ class PCKPacker : public RefCounted {
 		String src_path;
 		uint64_t ofs = 0;
 		uint64_t size = 0;
+		uint64_t stored_size = 0;
 		bool encrypted = false;
 		bool removal = false;
+		bool compressed = false;
+		uint64_t compressed_ofs = 0; // In the temporary file holding the compressed files.
 		Vector<uint8_t> md5;
 	};
 	Vector<File> files;
 
+	Error _compress_files(Vector<uint8_t> &r_dictionary, Ref<FileAccess> &r_compressed);
+
 public:
 	Error pck_start(const String &p_pck_path, int p_alignment = 32, const String &p_key = "0000000000000000000000000000000000000000000000000000000000000000", bool p_encrypt_directory = false);
 	Error add_file(const String &p_target_path, const String &p_source_path, bool p_encrypt = false);
 	Error add_file_removal(const String &p_target_path);
 	Error flush(bool p_verbose = false);
 
+	void set_compression_enabled(bool p_enabled);
+	bool is_compression_enabled() const;
+
 	PCKPacker() {}
 };
 
@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access_compressed.h"
+#include "core/io/file_access_memory.h"
 #include "core/io/missing_resource.h"
 #include "core/object/script_language.h"
 #include "core/version.h"
@@ -98,11 +99,11 @@ enum {
 	FORMAT_VERSION_NO_NODEPATH_PROPERTY = 3,
 };
 
-void ResourceLoaderBinary::_advance_padding(uint32_t p_len) {
+void ResourceLoaderBinary::_advance_padding(Ref<FileAccess> &p_f, uint32_t p_len) {
 	uint32_t extra = 4 - (p_len % 4);
 	if (extra < 4) {
 		for (uint32_t i = 0; i < extra; i++) {
-			f->get_8(); //pad to 32
+			p_f->get_8(); //pad to 32
 		}
 	}
 }
@@ -151,27 +152,41 @@ static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
 	return OK;
 }
 
-StringName ResourceLoaderBinary::_get_string() {
-	uint32_t id = f->get_32();
+String ResourceLoaderBinary::_read_utf8(Ref<FileAccess> &p_f, uint32_t p_len) {
+	String s;
+	// Parse in place when the file is mapped, skipping the copy into `str_buf`.
+	const char *view = (const char *)p_f->get_buffer_view(p_len);
+	if (view) {
+		s.parse_utf8(view, p_len);
+		return s;
+	}
+
+	// Internal resources decoded in parallel can't share `str_buf`.
+	Vector<char> own_buf;
+	Vector<char> &buf = p_f == f ? str_buf : own_buf;
+	if ((int)p_len > buf.size()) {
+		buf.resize(p_len);
+	}
+	p_f->get_buffer((uint8_t *)&buf[0], p_len);
+	s.parse_utf8(&buf[0], p_len);
+	return s;
+}
+
+StringName ResourceLoaderBinary::_get_string(Ref<FileAccess> &p_f) {
+	uint32_t id = p_f->get_32();
 	if (id & 0x80000000) {
 		uint32_t len = id & 0x7FFFFFFF;
-		if ((int)len > str_buf.size()) {
-			str_buf.resize(len);
-		}
 		if (len == 0) {
 			return StringName();
 		}
-		f->get_buffer((uint8_t *)&str_buf[0], len);
-		String s;
-		s.parse_utf8(&str_buf[0], len);
-		return s;
+		return _read_utf8(p_f, len);
 	}
 
 	return string_map[id];
 }
 
-Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
-	uint32_t prop_type = f->get_32();
+Error ResourceLoaderBinary::parse_variant(Ref<FileAccess> &p_f, Variant &r_v, int p_resource_index) {
+	uint32_t prop_type = p_f->get_32();
 	print_bl("find property of type: " + itos(prop_type));
 
 	switch (prop_type) {
@@ -179,185 +194,185 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			r_v = Variant();
 		} break;
 		case VARIANT_BOOL: {
-			r_v = bool(f->get_32());
+			r_v = bool(p_f->get_32());
 		} break;
 		case VARIANT_INT: {
-			r_v = int(f->get_32());
+			r_v = int(p_f->get_32());
 		} break;
 		case VARIANT_INT64: {
-			r_v = int64_t(f->get_64());
+			r_v = int64_t(p_f->get_64());
 		} break;
 		case VARIANT_FLOAT: {
-			r_v = f->get_real();
+			r_v = p_f->get_real();
 		} break;
 		case VARIANT_DOUBLE: {
-			r_v = f->get_double();
+			r_v = p_f->get_double();
 		} break;
 		case VARIANT_STRING: {
-			r_v = get_unicode_string();
+			r_v = get_unicode_string(p_f);
 		} break;
 		case VARIANT_VECTOR2: {
 			Vector2 v;
-			v.x = f->get_real();
-			v.y = f->get_real();
+			v.x = p_f->get_real();
+			v.y = p_f->get_real();
 			r_v = v;
 
 		} break;
 		case VARIANT_VECTOR2I: {
 			Vector2i v;
-			v.x = f->get_32();
-			v.y = f->get_32();
+			v.x = p_f->get_32();
+			v.y = p_f->get_32();
 			r_v = v;
 
 		} break;
 		case VARIANT_RECT2: {
 			Rect2 v;
-			v.position.x = f->get_real();
-			v.position.y = f->get_real();
-			v.size.x = f->get_real();
-			v.size.y = f->get_real();
+			v.position.x = p_f->get_real();
+			v.position.y = p_f->get_real();
+			v.size.x = p_f->get_real();
+			v.size.y = p_f->get_real();
 			r_v = v;
 
 		} break;
 		case VARIANT_RECT2I: {
 			Rect2i v;
-			v.position.x = f->get_32();
-			v.position.y = f->get_32();
-			v.size.x = f->get_32();
-			v.size.y = f->get_32();
+			v.position.x = p_f->get_32();
+			v.position.y = p_f->get_32();
+			v.size.x = p_f->get_32();
+			v.size.y = p_f->get_32();
 			r_v = v;
 
 		} break;
 		case VARIANT_VECTOR3: {
 			Vector3 v;
-			v.x = f->get_real();
-			v.y = f->get_real();
-			v.z = f->get_real();
+			v.x = p_f->get_real();
+			v.y = p_f->get_real();
+			v.z = p_f->get_real();
 			r_v = v;
 		} break;
 		case VARIANT_VECTOR3I: {
 			Vector3i v;
-			v.x = f->get_32();
-			v.y = f->get_32();
-			v.z = f->get_32();
+			v.x = p_f->get_32();
+			v.y = p_f->get_32();
+			v.z = p_f->get_32();
 			r_v = v;
 		} break;
 		case VARIANT_VECTOR4: {
 			Vector4 v;
-			v.x = f->get_real();
-			v.y = f->get_real();
-			v.z = f->get_real();
-			v.w = f->get_real();
+			v.x = p_f->get_real();
+			v.y = p_f->get_real();
+			v.z = p_f->get_real();
+			v.w = p_f->get_real();
 			r_v = v;
 		} break;
 		case VARIANT_VECTOR4I: {
 			Vector4i v;
-			v.x = f->get_32();
-			v.y = f->get_32();
-			v.z = f->get_32();
-			v.w = f->get_32();
+			v.x = p_f->get_32();
+			v.y = p_f->get_32();
+			v.z = p_f->get_32();
+			v.w = p_f->get_32();
 			r_v = v;
 		} break;
 		case VARIANT_PLANE: {
 			Plane v;
-			v.normal.x = f->get_real();
-			v.normal.y = f->get_real();
-			v.normal.z = f->get_real();
-			v.d = f->get_real();
+			v.normal.x = p_f->get_real();
+			v.normal.y = p_f->get_real();
+			v.normal.z = p_f->get_real();
+			v.d = p_f->get_real();
 			r_v = v;
 		} break;
 		case VARIANT_QUATERNION: {
 			Quaternion v;
-			v.x = f->get_real();
-			v.y = f->get_real();
-			v.z = f->get_real();
-			v.w = f->get_real();
+			v.x = p_f->get_real();
+			v.y = p_f->get_real();
+			v.z = p_f->get_real();
+			v.w = p_f->get_real();
 			r_v = v;
 
 		} break;
 		case VARIANT_AABB: {
 			AABB v;
-			v.position.x = f->get_real();
-			v.position.y = f->get_real();
-			v.position.z = f->get_real();
-			v.size.x = f->get_real();
-			v.size.y = f->get_real();
-			v.size.z = f->get_real();
+			v.position.x = p_f->get_real();
+			v.position.y = p_f->get_real();
+			v.position.z = p_f->get_real();
+			v.size.x = p_f->get_real();
+			v.size.y = p_f->get_real();
+			v.size.z = p_f->get_real();
 			r_v = v;
 
 		} break;
 		case VARIANT_TRANSFORM2D: {
 			Transform2D v;
-			v.columns[0].x = f->get_real();
-			v.columns[0].y = f->get_real();
-			v.columns[1].x = f->get_real();
-			v.columns[1].y = f->get_real();
-			v.columns[2].x = f->get_real();
-			v.columns[2].y = f->get_real();
+			v.columns[0].x = p_f->get_real();
+			v.columns[0].y = p_f->get_real();
+			v.columns[1].x = p_f->get_real();
+			v.columns[1].y = p_f->get_real();
+			v.columns[2].x = p_f->get_real();
+			v.columns[2].y = p_f->get_real();
 			r_v = v;
 
 		} break;
 		case VARIANT_BASIS: {
 			Basis v;
-			v.rows[0].x = f->get_real();
-			v.rows[0].y = f->get_real();
-			v.rows[0].z = f->get_real();
-			v.rows[1].x = f->get_real();
-			v.rows[1].y = f->get_real();
-			v.rows[1].z = f->get_real();
-			v.rows[2].x = f->get_real();
-			v.rows[2].y = f->get_real();
-			v.rows[2].z = f->get_real();
+			v.rows[0].x = p_f->get_real();
+			v.rows[0].y = p_f->get_real();
+			v.rows[0].z = p_f->get_real();
+			v.rows[1].x = p_f->get_real();
+			v.rows[1].y = p_f->get_real();
+			v.rows[1].z = p_f->get_real();
+			v.rows[2].x = p_f->get_real();
+			v.rows[2].y = p_f->get_real();
+			v.rows[2].z = p_f->get_real();
 			r_v = v;
 
 		} break;
 		case VARIANT_TRANSFORM3D: {
 			Transform3D v;
-			v.basis.rows[0].x = f->get_real();
-			v.basis.rows[0].y = f->get_real();
-			v.basis.rows[0].z = f->get_real();
-			v.basis.rows[1].x = f->get_real();
-			v.basis.rows[1].y = f->get_real();
-			v.basis.rows[1].z = f->get_real();
-			v.basis.rows[2].x = f->get_real();
-			v.basis.rows[2].y = f->get_real();
-			v.basis.rows[2].z = f->get_real();
-			v.origin.x = f->get_real();
-			v.origin.y = f->get_real();
-			v.origin.z = f->get_real();
+			v.basis.rows[0].x = p_f->get_real();
+			v.basis.rows[0].y = p_f->get_real();
+			v.basis.rows[0].z = p_f->get_real();
+			v.basis.rows[1].x = p_f->get_real();
+			v.basis.rows[1].y = p_f->get_real();
+			v.basis.rows[1].z = p_f->get_real();
+			v.basis.rows[2].x = p_f->get_real();
+			v.basis.rows[2].y = p_f->get_real();
+			v.basis.rows[2].z = p_f->get_real();
+			v.origin.x = p_f->get_real();
+			v.origin.y = p_f->get_real();
+			v.origin.z = p_f->get_real();
 			r_v = v;
 		} break;
 		case VARIANT_PROJECTION: {
 			Projection v;
-			v.columns[0].x = f->get_real();
-			v.columns[0].y = f->get_real();
-			v.columns[0].z = f->get_real();
-			v.columns[0].w = f->get_real();
-			v.columns[1].x = f->get_real();
-			v.columns[1].y = f->get_real();
-			v.columns[1].z = f->get_real();
-			v.columns[1].w = f->get_real();
-			v.columns[2].x = f->get_real();
-			v.columns[2].y = f->get_real();
-			v.columns[2].z = f->get_real();
-			v.columns[2].w = f->get_real();
-			v.columns[3].x = f->get_real();
-			v.columns[3].y = f->get_real();
-			v.columns[3].z = f->get_real();
-			v.columns[3].w = f->get_real();
+			v.columns[0].x = p_f->get_real();
+			v.columns[0].y = p_f->get_real();
+			v.columns[0].z = p_f->get_real();
+			v.columns[0].w = p_f->get_real();
+			v.columns[1].x = p_f->get_real();
+			v.columns[1].y = p_f->get_real();
+			v.columns[1].z = p_f->get_real();
+			v.columns[1].w = p_f->get_real();
+			v.columns[2].x = p_f->get_real();
+			v.columns[2].y = p_f->get_real();
+			v.columns[2].z = p_f->get_real();
+			v.columns[2].w = p_f->get_real();
+			v.columns[3].x = p_f->get_real();
+			v.columns[3].y = p_f->get_real();
+			v.columns[3].z = p_f->get_real();
+			v.columns[3].w = p_f->get_real();
 			r_v = v;
 		} break;
 		case VARIANT_COLOR: {
 			Color v; // Colors should always be in single-precision.
-			v.r = f->get_float();
-			v.g = f->get_float();
-			v.b = f->get_float();
-			v.a = f->get_float();
+			v.r = p_f->get_float();
+			v.g = p_f->get_float();
+			v.b = p_f->get_float();
+			v.a = p_f->get_float();
 			r_v = v;
 
 		} break;
 		case VARIANT_STRING_NAME: {
-			r_v = StringName(get_unicode_string());
+			r_v = StringName(get_unicode_string(p_f));
 		} break;
 
 		case VARIANT_NODE_PATH: {
@@ -365,8 +380,8 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			Vector<StringName> subnames;
 			bool absolute;
 
-			int name_count = f->get_16();
-			uint32_t subname_count = f->get_16();
+			int name_count = p_f->get_16();
+			uint32_t subname_count = p_f->get_16();
 			absolute = subname_count & 0x8000;
 			subname_count &= 0x7FFF;
 			if (ver_format < FORMAT_VERSION_NO_NODEPATH_PROPERTY) {
@@ -374,10 +389,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			}
 
 			for (int i = 0; i < name_count; i++) {
-				names.push_back(_get_string());
+				names.push_back(_get_string(p_f));
 			}
 			for (uint32_t i = 0; i < subname_count; i++) {
-				subnames.push_back(_get_string());
+				subnames.push_back(_get_string(p_f));
 			}
 
 			NodePath np = NodePath(names, subnames, absolute);
@@ -386,10 +401,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 
 		} break;
 		case VARIANT_RID: {
-			r_v = f->get_32();
+			r_v = p_f->get_32();
 		} break;
 		case VARIANT_OBJECT: {
-			uint32_t objtype = f->get_32();
+			uint32_t objtype = p_f->get_32();
 
 			switch (objtype) {
 				case OBJECT_EMPTY: {
@@ -397,29 +412,36 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 
 				} break;
 				case OBJECT_INTERNAL_RESOURCE: {
-					uint32_t index = f->get_32();
+					uint32_t index = p_f->get_32();
 					String path;
 
 					if (using_named_scene_ids) { // New format.
 						ERR_FAIL_INDEX_V((int)index, internal_resources.size(), ERR_PARSE_ERROR);
+						if ((int)index >= p_resource_index) {
+							// Not loaded yet, even if already instantiated to be read in parallel.
+							WARN_PRINT(vformat("Couldn't load resource (no cache): %s.", internal_resources[index].path));
+							r_v = Variant();
+							break;
+						}
 						path = internal_resources[index].path;
 					} else {
 						path += res_path + "::" + itos(index);
 					}
 
 					//always use internal cache for loading internal resources
-					if (!internal_index_cache.has(path)) {
+					HashMap<String, Ref<Resource>>::ConstIterator E = internal_index_cache.find(path);
+					if (!E) {
 						WARN_PRINT(vformat("Couldn't load resource (no cache): %s.", path));
 						r_v = Variant();
 					} else {
-						r_v = internal_index_cache[path];
+						r_v = E->value;
 					}
 				} break;
 				case OBJECT_EXTERNAL_RESOURCE: {
 					//old file format, still around for compatibility
 
-					String exttype = get_unicode_string();
-					String path = get_unicode_string();
+					String exttype = get_unicode_string(p_f);
+					String path = get_unicode_string(p_f);
 
 					if (!path.contains("://") && path.is_relative_path()) {
 						// path is relative to file being loaded, so convert to a resource path
@@ -440,28 +462,21 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 				} break;
 				case OBJECT_EXTERNAL_RESOURCE_INDEX: {
 					//new file format, just refers to an index in the external list
-					int erindex = f->get_32();
+					int erindex = p_f->get_32();
 
 					if (erindex < 0 || erindex >= external_resources.size()) {
 						WARN_PRINT("Broken external resource! (index out of size)");
 						r_v = Variant();
+					} else if (external_resources_completed) {
+						r_v = external_resources[erindex].resource;
 					} else {
-						Ref<ResourceLoader::LoadToken> &load_token = external_resources.write[erindex].load_token;
-						if (load_token.is_valid()) { // If not valid, it's OK since then we know this load accepts broken dependencies.
-							Error err;
-							Ref<Resource> res = ResourceLoader::_load_complete(*load_token.ptr(), &err);
-							if (res.is_null()) {
-								if (!ResourceLoader::is_cleaning_tasks()) {
-									if (!ResourceLoader::get_abort_on_missing_resources()) {
-										ResourceLoader::notify_dependency_error(local_path, external_resources[erindex].path, external_resources[erindex].type);
-									} else {
-										error = ERR_FILE_MISSING_DEPENDENCIES;
-										ERR_FAIL_V_MSG(error, vformat("Can't load dependency: '%s'.", external_resources[erindex].path));
-									}
-								}
-							} else {
-								r_v = res;
-							}
+						Ref<Resource> res;
+						Error err = _complete_external_resource(erindex, res);
+						if (err != OK) {
+							return err;
+						}
+						if (res.is_valid()) {
+							r_v = res;
 						}
 					}
 				} break;
@@ -478,28 +493,28 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 
 		case VARIANT_DICTIONARY: {
-			uint32_t len = f->get_32();
+			uint32_t len = p_f->get_32();
 			Dictionary d; //last bit means shared
 			len &= 0x7FFFFFFF;
 			for (uint32_t i = 0; i < len; i++) {
 				Variant key;
-				Error err = parse_variant(key);
+				Error err = parse_variant(p_f, key, p_resource_index);
 				ERR_FAIL_COND_V_MSG(err, ERR_FILE_CORRUPT, "Error when trying to parse Variant.");
 				Variant value;
-				err = parse_variant(value);
+				err = parse_variant(p_f, value, p_resource_index);
 				ERR_FAIL_COND_V_MSG(err, ERR_FILE_CORRUPT, "Error when trying to parse Variant.");
 				d[key] = value;
 			}
 			r_v = d;
 		} break;
 		case VARIANT_ARRAY: {
-			uint32_t len = f->get_32();
+			uint32_t len = p_f->get_32();
 			Array a; //last bit means shared
 			len &= 0x7FFFFFFF;
 			a.resize(len);
 			for (uint32_t i = 0; i < len; i++) {
 				Variant val;
-				Error err = parse_variant(val);
+				Error err = parse_variant(p_f, val, p_resource_index);
 				ERR_FAIL_COND_V_MSG(err, ERR_FILE_CORRUPT, "Error when trying to parse Variant.");
 				a[i] = val;
 			}
@@ -507,24 +522,24 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 
 		} break;
 		case VARIANT_PACKED_BYTE_ARRAY: {
-			uint32_t len = f->get_32();
+			uint32_t len = p_f->get_32();
 
 			Vector<uint8_t> array;
 			array.resize(len);
 			uint8_t *w = array.ptrw();
-			f->get_buffer(w, len);
-			_advance_padding(len);
+			p_f->get_buffer(w, len);
+			_advance_padding(p_f, len);
 
 			r_v = array;
 
 		} break;
 		case VARIANT_PACKED_INT32_ARRAY: {
-			uint32_t len = f->get_32();
+			uint32_t len = p_f->get_32();
 
 			Vector<int32_t> array;
 			array.resize(len);
 			int32_t *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(int32_t));
+			p_f->get_buffer((uint8_t *)w, len * sizeof(int32_t));
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint32_t *ptr = (uint32_t *)w.ptr();
@@ -538,12 +553,12 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			r_v = array;
 		} break;
 		case VARIANT_PACKED_INT64_ARRAY: {
-			uint32_t len = f->get_32();
+			uint32_t len = p_f->get_32();
 
 			Vector<int64_t> array;
 			array.resize(len);
 			int64_t *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(int64_t));
+			p_f->get_buffer((uint8_t *)w, len * sizeof(int64_t));
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint64_t *ptr = (uint64_t *)w.ptr();
@@ -557,12 +572,12 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			r_v = array;
 		} break;
 		case VARIANT_PACKED_FLOAT32_ARRAY: {
-			uint32_t len = f->get_32();
+			uint32_t len = p_f->get_32();
 
 			Vector<float> array;
 			array.resize(len);
 			float *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(float));
+			p_f->get_buffer((uint8_t *)w, len * sizeof(float));
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint32_t *ptr = (uint32_t *)w.ptr();
@@ -576,12 +591,12 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			r_v = array;
 		} break;
 		case VARIANT_PACKED_FLOAT64_ARRAY: {
-			uint32_t len = f->get_32();
+			uint32_t len = p_f->get_32();
 
 			Vector<double> array;
 			array.resize(len);
 			double *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(double));
+			p_f->get_buffer((uint8_t *)w, len * sizeof(double));
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint64_t *ptr = (uint64_t *)w.ptr();
@@ -595,52 +610,52 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			r_v = array;
 		} break;
 		case VARIANT_PACKED_STRING_ARRAY: {
-			uint32_t len = f->get_32();
+			uint32_t len = p_f->get_32();
 			Vector<String> array;
 			array.resize(len);
 			String *w = array.ptrw();
 			for (uint32_t i = 0; i < len; i++) {
-				w[i] = get_unicode_string();
+				w[i] = get_unicode_string(p_f);
 			}
 
 			r_v = array;
 
 		} break;
 		case VARIANT_PACKED_VECTOR2_ARRAY: {
-			uint32_t len = f->get_32();
+			uint32_t len = p_f->get_32();
 
 			Vector<Vector2> array;
 			array.resize(len);
 			Vector2 *w = array.ptrw();
 			static_assert(sizeof(Vector2) == 2 * sizeof(real_t));
-			const Error err = read_reals(reinterpret_cast<real_t *>(w), f, len * 2);
+			const Error err = read_reals(reinterpret_cast<real_t *>(w), p_f, len * 2);
 			ERR_FAIL_COND_V(err != OK, err);
 
 			r_v = array;
 
 		} break;
 		case VARIANT_PACKED_VECTOR3_ARRAY: {
-			uint32_t len = f->get_32();
+			uint32_t len = p_f->get_32();
 
 			Vector<Vector3> array;
 			array.resize(len);
 			Vector3 *w = array.ptrw();
 			static_assert(sizeof(Vector3) == 3 * sizeof(real_t));
-			const Error err = read_reals(reinterpret_cast<real_t *>(w), f, len * 3);
+			const Error err = read_reals(reinterpret_cast<real_t *>(w), p_f, len * 3);
 			ERR_FAIL_COND_V(err != OK, err);
 
 			r_v = array;
 
 		} break;
 		case VARIANT_PACKED_COLOR_ARRAY: {
-			uint32_t len = f->get_32();
+			uint32_t len = p_f->get_32();
 
 			Vector<Color> array;
 			array.resize(len);
 			Color *w = array.ptrw();
 			// Colors always use `float` even with double-precision support enabled
 			static_assert(sizeof(Color) == 4 * sizeof(float));
-			f->get_buffer((uint8_t *)w, len * sizeof(float) * 4);
+			p_f->get_buffer((uint8_t *)w, len * sizeof(float) * 4);
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint32_t *ptr = (uint32_t *)w.ptr();
@@ -654,13 +669,13 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			r_v = array;
 		} break;
 		case VARIANT_PACKED_VECTOR4_ARRAY: {
-			uint32_t len = f->get_32();
+			uint32_t len = p_f->get_32();
 
 			Vector<Vector4> array;
 			array.resize(len);
 			Vector4 *w = array.ptrw();
 			static_assert(sizeof(Vector4) == 4 * sizeof(real_t));
-			const Error err = read_reals(reinterpret_cast<real_t *>(w), f, len * 4);
+			const Error err = read_reals(reinterpret_cast<real_t *>(w), p_f, len * 4);
 			ERR_FAIL_COND_V(err != OK, err);
 
 			r_v = array;
@@ -674,226 +689,377 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 	return OK; //never reach anyway
 }
 
+Error ResourceLoaderBinary::_complete_external_resource(int p_index, Ref<Resource> &r_resource) {
+	Ref<ResourceLoader::LoadToken> &load_token = external_resources.write[p_index].load_token;
+	if (load_token.is_null()) { // If not valid, it's OK since then we know this load accepts broken dependencies.
+		return OK;
+	}
+
+	Error err;
+	r_resource = ResourceLoader::_load_complete(*load_token.ptr(), &err);
+	if (r_resource.is_null() && !ResourceLoader::is_cleaning_tasks()) {
+		if (!ResourceLoader::get_abort_on_missing_resources()) {
+			ResourceLoader::notify_dependency_error(local_path, external_resources[p_index].path, external_resources[p_index].type);
+		} else {
+			error = ERR_FILE_MISSING_DEPENDENCIES;
+			ERR_FAIL_V_MSG(error, vformat("Can't load dependency: '%s'.", external_resources[p_index].path));
+		}
+	}
+	return OK;
+}
+
 Ref<Resource> ResourceLoaderBinary::get_resource() {
 	return resource;
 }
 
-Error ResourceLoaderBinary::load() {
-	if (error != OK) {
-		return error;
-	}
+Error ResourceLoaderBinary::_instantiate_internal_resource(int p_index, IntResourceLoad &r_load) {
+	bool main = p_index == (internal_resources.size() - 1);
 
-	for (int i = 0; i < external_resources.size(); i++) {
-		String path = external_resources[i].path;
+	//maybe it is loaded already
+	String path;
+	String id;
 
-		if (remaps.has(path)) {
-			path = remaps[path];
-		}
+	if (!main) {
+		path = internal_resources[p_index].path;
 
-		if (!path.contains("://") && path.is_relative_path()) {
-			// path is relative to file being loaded, so convert to a resource path
-			path = ProjectSettings::get_singleton()->localize_path(path.get_base_dir().path_join(external_resources[i].path));
+		if (path.begins_with("local://")) {
+			path = path.replace_first("local://", "");
+			id = path;
+			path = res_path + "::" + path;
+
+			internal_resources.write[p_index].path = path; // Update path.
 		}
 
-		external_resources.write[i].path = path; //remap happens here, not on load because on load it can actually be used for filesystem dock resource remap
-		external_resources.write[i].load_token = ResourceLoader::_load_start(path, external_resources[i].type, use_sub_threads ? ResourceLoader::LOAD_THREAD_DISTRIBUTE : ResourceLoader::LOAD_THREAD_FROM_CURRENT, cache_mode_for_external);
-		if (!external_resources[i].load_token.is_valid()) {
-			if (!ResourceLoader::get_abort_on_missing_resources()) {
-				ResourceLoader::notify_dependency_error(local_path, path, external_resources[i].type);
-			} else {
-				error = ERR_FILE_MISSING_DEPENDENCIES;
-				ERR_FAIL_V_MSG(error, vformat("Can't load dependency: '%s'.", path));
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
+			Ref<Resource> cached = ResourceCache::get_ref(path);
+			if (cached.is_valid()) {
+				//already loaded, don't do anything
+				error = OK;
+				internal_index_cache[path] = cached;
+				return OK;
 			}
 		}
+	} else {
+		if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
+			path = res_path;
+		}
 	}
 
-	for (int i = 0; i < internal_resources.size(); i++) {
-		bool main = i == (internal_resources.size() - 1);
+	uint64_t offset = internal_resources[p_index].offset;
 
-		//maybe it is loaded already
-		String path;
-		String id;
+	f->seek(offset);
 
-		if (!main) {
-			path = internal_resources[i].path;
+	String t = get_unicode_string(f);
 
-			if (path.begins_with("local://")) {
-				path = path.replace_first("local://", "");
-				id = path;
-				path = res_path + "::" + path;
+	Ref<Resource> res;
+	Resource *r = nullptr;
 
-				internal_resources.write[i].path = path; // Update path.
+	MissingResource *missing_resource = nullptr;
+
+	if (main) {
+		res = ResourceLoader::get_resource_ref_override(local_path);
+		r = res.ptr();
+	}
+	if (!r) {
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
+			//use the existing one
+			Ref<Resource> cached = ResourceCache::get_ref(path);
+			if (cached->get_class() == t) {
+				cached->reset_state();
+				res = cached;
 			}
+		}
 
-			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
-				Ref<Resource> cached = ResourceCache::get_ref(path);
-				if (cached.is_valid()) {
-					//already loaded, don't do anything
-					error = OK;
-					internal_index_cache[path] = cached;
-					continue;
+		if (res.is_null()) {
+			//did not replace
+
+			Object *obj = ClassDB::instantiate(t);
+			if (!obj) {
+				if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
+					//create a missing resource
+					missing_resource = memnew(MissingResource);
+					missing_resource->set_original_class(t);
+					missing_resource->set_recording_properties(true);
+					obj = missing_resource;
+				} else {
+					error = ERR_FILE_CORRUPT;
+					ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, vformat("'%s': Resource of unrecognized type in file: '%s'.", local_path, t));
 				}
 			}
-		} else {
-			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
-				path = res_path;
+
+			r = Object::cast_to<Resource>(obj);
+			if (!r) {
+				String obj_class = obj->get_class();
+				error = ERR_FILE_CORRUPT;
+				memdelete(obj); //bye
+				ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, vformat("'%s': Resource type in resource field not a resource, type is: %s.", local_path, obj_class));
+			}
+
+			res = Ref<Resource>(r);
+		}
+	}
+
+	if (r) {
+		if (!path.is_empty()) {
+			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
+				r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); // If got here because the resource with same path has different type, replace it.
+			} else {
+				r->set_path_cache(path);
 			}
 		}
+		r->set_scene_unique_id(id);
+	}
+
+	if (!main) {
+		internal_index_cache[path] = res;
+	}
 
-		uint64_t offset = internal_resources[i].offset;
+	r_load.resource = res;
+	r_load.missing_resource = missing_resource;
+	r_load.properties_offset = f->get_position();
+	return OK;
+}
+
+Error ResourceLoaderBinary::_read_properties(Ref<FileAccess> &p_f, int p_index, IntResourceLoad &r_load) {
+	p_f->seek(r_load.properties_offset);
 
-		f->seek(offset);
+	int pc = p_f->get_32();
 
-		String t = get_unicode_string();
+	for (int j = 0; j < pc; j++) {
+		StringName name = _get_string(p_f);
 
-		Ref<Resource> res;
-		Resource *r = nullptr;
+		if (name == StringName()) {
+			ERR_FAIL_V(ERR_FILE_CORRUPT);
+		}
 
-		MissingResource *missing_resource = nullptr;
+		Variant value;
 
-		if (main) {
-			res = ResourceLoader::get_resource_ref_override(local_path);
-			r = res.ptr();
+		Error err = parse_variant(p_f, value, p_index);
+		if (err) {
+			return err;
 		}
-		if (!r) {
-			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
-				//use the existing one
-				Ref<Resource> cached = ResourceCache::get_ref(path);
-				if (cached->get_class() == t) {
-					cached->reset_state();
-					res = cached;
-				}
-			}
 
-			if (res.is_null()) {
-				//did not replace
-
-				Object *obj = ClassDB::instantiate(t);
-				if (!obj) {
-					if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
-						//create a missing resource
-						missing_resource = memnew(MissingResource);
-						missing_resource->set_original_class(t);
-						missing_resource->set_recording_properties(true);
-						obj = missing_resource;
-					} else {
-						error = ERR_FILE_CORRUPT;
-						ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, vformat("'%s': Resource of unrecognized type in file: '%s'.", local_path, t));
-					}
-				}
+		r_load.properties.push_back(Pair<StringName, Variant>(name, value));
+	}
 
-				r = Object::cast_to<Resource>(obj);
-				if (!r) {
-					String obj_class = obj->get_class();
-					error = ERR_FILE_CORRUPT;
-					memdelete(obj); //bye
-					ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, vformat("'%s': Resource type in resource field not a resource, type is: %s.", local_path, obj_class));
-				}
+	return OK;
+}
 
-				res = Ref<Resource>(r);
-			}
+void ResourceLoaderBinary::_read_properties_task(void *p_userdata, uint32_t p_index) {
+	ParallelRead *read = (ParallelRead *)p_userdata;
+
+	Ref<FileAccessMemory> fa;
+	fa.instantiate();
+	fa->open_custom(read->data, read->length);
+	fa->set_big_endian(read->big_endian);
+	fa->real_is_double = read->real_is_double;
+
+	Ref<FileAccess> file = fa;
+	const uint32_t index = read->indices[p_index];
+	read->loads[index].error = read->loader->_read_properties(file, index, read->loads[index]);
+}
+
+Error ResourceLoaderBinary::_read_properties_parallel(LocalVector<IntResourceLoad> &r_loads) {
+	// Waiting for dependencies is not something the tasks can do, so it's done upfront.
+	for (int i = 0; i < external_resources.size(); i++) {
+		Error err = _complete_external_resource(i, external_resources.write[i].resource);
+		if (err != OK) {
+			return err;
 		}
+	}
+	external_resources_completed = true;
 
-		if (r) {
-			if (!path.is_empty()) {
-				if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
-					r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); // If got here because the resource with same path has different type, replace it.
-				} else {
-					r->set_path_cache(path);
-				}
-			}
-			r->set_scene_unique_id(id);
+	ParallelRead read;
+	for (uint32_t i = 0; i < r_loads.size(); i++) {
+		if (r_loads[i].resource.is_valid()) {
+			read.indices.push_back(i);
 		}
+	}
+	if (read.indices.is_empty()) {
+		return OK;
+	}
+
+	// Each task reads at its own position from memory, so the file is mapped or read whole.
+	Vector<uint8_t> buffer;
+	read.length = f->get_length();
+	f->seek(0);
+	read.data = f->get_buffer_view(read.length);
+	if (!read.data) {
+		buffer.resize(read.length);
+		ERR_FAIL_COND_V(f->get_buffer(buffer.ptrw(), read.length) != read.length, ERR_FILE_CORRUPT);
+		read.data = buffer.ptr();
+	}
 
-		if (!main) {
-			internal_index_cache[path] = res;
+	read.loader = this;
+	read.big_endian = f->is_big_endian();
+	read.real_is_double = f->real_is_double;
+	read.loads = r_loads.ptr();
+
+	// Pool threads would block waiting for the group instead of running tasks, so loads
+	// already running on the pool read the properties themselves.
+	if (WorkerThreadPool::get_thread_index() != -1) {
+		for (uint32_t i = 0; i < read.indices.size(); i++) {
+			_read_properties_task(&read, i);
 		}
+		return OK;
+	}
 
-		int pc = f->get_32();
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&_read_properties_task, &read, read.indices.size(), -1, true, SNAME("ResourceLoaderBinary"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
-		//set properties
+	return OK;
+}
 
-		Dictionary missing_resource_properties;
+void ResourceLoaderBinary::_set_properties(IntResourceLoad &p_load) {
+	Ref<Resource> &res = p_load.resource;
 
-		for (int j = 0; j < pc; j++) {
-			StringName name = _get_string();
+	Dictionary missing_resource_properties;
 
-			if (name == StringName()) {
-				error = ERR_FILE_CORRUPT;
-				ERR_FAIL_V(ERR_FILE_CORRUPT);
-			}
+	for (Pair<StringName, Variant> &property : p_load.properties) {
+		const StringName &name = property.first;
+		Variant &value = property.second;
 
-			Variant value;
+		bool set_valid = true;
+		if (value.get_type() == Variant::OBJECT && p_load.missing_resource == nullptr && ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
+			// If the property being set is a missing resource (and the parent is not),
+			// then setting it will most likely not work.
+			// Instead, save it as metadata.
 
-			error = parse_variant(value);
-			if (error) {
-				return error;
+			Ref<MissingResource> mr = value;
+			if (mr.is_valid()) {
+				missing_resource_properties[name] = mr;
+				set_valid = false;
 			}
+		}
 
-			bool set_valid = true;
-			if (value.get_type() == Variant::OBJECT && missing_resource == nullptr && ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
-				// If the property being set is a missing resource (and the parent is not),
-				// then setting it will most likely not work.
-				// Instead, save it as metadata.
-
-				Ref<MissingResource> mr = value;
-				if (mr.is_valid()) {
-					missing_resource_properties[name] = mr;
-					set_valid = false;
+		if (value.get_type() == Variant::ARRAY) {
+			Array set_array = value;
+			bool is_get_valid = false;
+			Variant get_value = res->get(name, &is_get_valid);
+			if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
+				Array get_array = get_value;
+				if (!set_array.is_same_typed(get_array)) {
+					value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
 				}
 			}
+		}
 
-			if (value.get_type() == Variant::ARRAY) {
-				Array set_array = value;
-				bool is_get_valid = false;
-				Variant get_value = res->get(name, &is_get_valid);
-				if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
-					Array get_array = get_value;
-					if (!set_array.is_same_typed(get_array)) {
-						value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
-					}
+		if (value.get_type() == Variant::DICTIONARY) {
+			Dictionary set_dict = value;
+			bool is_get_valid = false;
+			Variant get_value = res->get(name, &is_get_valid);
+			if (is_get_valid && get_value.get_type() == Variant::DICTIONARY) {
+				Dictionary get_dict = get_value;
+				if (!set_dict.is_same_typed(get_dict)) {
+					value = Dictionary(set_dict, get_dict.get_typed_key_builtin(), get_dict.get_typed_key_class_name(), get_dict.get_typed_key_script(),
+							get_dict.get_typed_value_builtin(), get_dict.get_typed_value_class_name(), get_dict.get_typed_value_script());
 				}
 			}
+		}
 
-			if (value.get_type() == Variant::DICTIONARY) {
-				Dictionary set_dict = value;
-				bool is_get_valid = false;
-				Variant get_value = res->get(name, &is_get_valid);
-				if (is_get_valid && get_value.get_type() == Variant::DICTIONARY) {
-					Dictionary get_dict = get_value;
-					if (!set_dict.is_same_typed(get_dict)) {
-						value = Dictionary(set_dict, get_dict.get_typed_key_builtin(), get_dict.get_typed_key_class_name(), get_dict.get_typed_key_script(),
-								get_dict.get_typed_value_builtin(), get_dict.get_typed_value_class_name(), get_dict.get_typed_value_script());
-					}
-				}
+		if (set_valid) {
+			res->set(name, value);
+		}
+	}
+	p_load.properties.clear();
+
+	if (p_load.missing_resource) {
+		p_load.missing_resource->set_recording_properties(false);
+	}
+
+	if (!missing_resource_properties.is_empty()) {
+		res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+	}
+
+#ifdef TOOLS_ENABLED
+	res->set_edited(false);
+#endif
+}
+
+Error ResourceLoaderBinary::load() {
+	if (error != OK) {
+		return error;
+	}
+
+	for (int i = 0; i < external_resources.size(); i++) {
+		String path = external_resources[i].path;
+
+		if (remaps.has(path)) {
+			path = remaps[path];
+		}
+
+		if (!path.contains("://") && path.is_relative_path()) {
+			// path is relative to file being loaded, so convert to a resource path
+			path = ProjectSettings::get_singleton()->localize_path(path.get_base_dir().path_join(external_resources[i].path));
+		}
+
+		external_resources.write[i].path = path; //remap happens here, not on load because on load it can actually be used for filesystem dock resource remap
+		external_resources.write[i].load_token = ResourceLoader::_load_start(path, external_resources[i].type, use_sub_threads ? ResourceLoader::LOAD_THREAD_DISTRIBUTE : ResourceLoader::LOAD_THREAD_FROM_CURRENT, cache_mode_for_external);
+		if (!external_resources[i].load_token.is_valid()) {
+			if (!ResourceLoader::get_abort_on_missing_resources()) {
+				ResourceLoader::notify_dependency_error(local_path, path, external_resources[i].type);
+			} else {
+				error = ERR_FILE_MISSING_DEPENDENCIES;
+				ERR_FAIL_V_MSG(error, vformat("Can't load dependency: '%s'.", path));
 			}
+		}
+	}
+
+	// With sub-threads, internal resources are all instantiated first so their properties,
+	// which only refer to each other through `internal_index_cache`, can be read in parallel.
+	// Properties are still set in file order, as setters may depend on earlier resources.
+	const bool parallel = use_sub_threads && using_named_scene_ids && internal_resources.size() > 1;
+
+	LocalVector<IntResourceLoad> loads;
+	loads.resize(internal_resources.size());
 
-			if (set_valid) {
-				res->set(name, value);
+	if (parallel) {
+		for (int i = 0; i < internal_resources.size(); i++) {
+			error = _instantiate_internal_resource(i, loads[i]);
+			if (error) {
+				return error;
 			}
 		}
 
-		if (missing_resource) {
-			missing_resource->set_recording_properties(false);
+		error = _read_properties_parallel(loads);
+		if (error) {
+			return error;
 		}
+	}
+
+	for (int i = 0; i < internal_resources.size(); i++) {
+		bool main = i == (internal_resources.size() - 1);
+		IntResourceLoad &load = loads[i];
 
-		if (!missing_resource_properties.is_empty()) {
-			res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+		if (!parallel) {
+			error = _instantiate_internal_resource(i, load);
+			if (error) {
+				return error;
+			}
+			if (load.resource.is_valid()) {
+				load.error = _read_properties(f, i, load);
+			}
 		}
 
-#ifdef TOOLS_ENABLED
-		res->set_edited(false);
-#endif
+		if (load.resource.is_null()) {
+			continue; // Already loaded.
+		}
+		if (load.error) {
+			error = load.error;
+			return error;
+		}
+
+		_set_properties(load);
 
 		if (progress) {
 			*progress = (i + 1) / float(internal_resources.size());
 		}
 
-		resource_cache.push_back(res);
+		resource_cache.push_back(load.resource);
 
 		if (main) {
 			f.unref();
-			resource = res;
+			resource = load.resource;
 			resource->set_as_translation_remapped(translation_remapped);
 			error = OK;
 			return OK;
@@ -923,18 +1089,12 @@ static String get_ustring(Ref<FileAccess> f) {
 	return s;
 }
 
-String ResourceLoaderBinary::get_unicode_string() {
-	int len = f->get_32();
-	if (len > str_buf.size()) {
-		str_buf.resize(len);
-	}
-	if (len == 0) {
+String ResourceLoaderBinary::get_unicode_string(Ref<FileAccess> &p_f) {
+	int len = p_f->get_32();
+	if (len <= 0) {
 		return String();
 	}
-	f->get_buffer((uint8_t *)&str_buf[0], len);
-	String s;
-	s.parse_utf8(&str_buf[0], len);
-	return s;
+	return _read_utf8(p_f, len);
 }
 
 void ResourceLoaderBinary::get_classes_used(Ref<FileAccess> p_f, HashSet<StringName> *p_classes) {
@@ -945,7 +1105,7 @@ void ResourceLoaderBinary::get_classes_used(Ref<FileAccess> p_f, HashSet<StringN
 
 	for (int i = 0; i < internal_resources.size(); i++) {
 		p_f->seek(internal_resources[i].offset);
-		String t = get_unicode_string();
+		String t = get_unicode_string(f);
 		ERR_FAIL_COND(p_f->get_error() != OK);
 		if (t != String()) {
 			p_classes->insert(t);
@@ -1034,7 +1194,7 @@ void ResourceLoaderBinary::open(Ref<FileAccess> p_f, bool p_no_resources, bool p
 				local_path, ver_format, ver_major, ver_minor, VERSION_BRANCH));
 	}
 
-	type = get_unicode_string();
+	type = get_unicode_string(f);
 
 	print_bl("type: " + type);
 
@@ -1056,7 +1216,7 @@ void ResourceLoaderBinary::open(Ref<FileAccess> p_f, bool p_no_resources, bool p
 	}
 
 	if (flags & ResourceFormatSaverBinaryInstance::FORMAT_FLAG_HAS_SCRIPT_CLASS) {
-		script_class = get_unicode_string();
+		script_class = get_unicode_string(f);
 	}
 
 	for (int i = 0; i < ResourceFormatSaverBinaryInstance::RESERVED_FIELDS; i++) {
@@ -1070,7 +1230,7 @@ void ResourceLoaderBinary::open(Ref<FileAccess> p_f, bool p_no_resources, bool p
 	uint32_t string_table_size = f->get_32();
 	string_map.resize(string_table_size);
 	for (uint32_t i = 0; i < string_table_size; i++) {
-		StringName s = get_unicode_string();
+		StringName s = get_unicode_string(f);
 		string_map.write[i] = s;
 	}
 
@@ -1079,8 +1239,8 @@ void ResourceLoaderBinary::open(Ref<FileAccess> p_f, bool p_no_resources, bool p
 	uint32_t ext_resources_size = f->get_32();
 	for (uint32_t i = 0; i < ext_resources_size; i++) {
 		ExtResource er;
-		er.type = get_unicode_string();
-		er.path = get_unicode_string();
+		er.type = get_unicode_string(f);
+		er.path = get_unicode_string(f);
 		if (using_uids) {
 			er.uid = ResourceUID::ID(f->get_64());
 			if (!p_keep_uuid_paths && er.uid != ResourceUID::INVALID_ID) {
@@ -1108,7 +1268,7 @@ void ResourceLoaderBinary::open(Ref<FileAccess> p_f, bool p_no_resources, bool p
 
 	for (uint32_t i = 0; i < int_resources_size; i++) {
 		IntResource ir;
-		ir.path = get_unicode_string();
+		ir.path = get_unicode_string(f);
 		ir.offset = f->get_64();
 		internal_resources.push_back(ir);
 	}
@@ -1160,7 +1320,7 @@ String ResourceLoaderBinary::recognize(Ref<FileAccess> p_f) {
 		return "";
 	}
 
-	return get_unicode_string();
+	return get_unicode_string(f);
 }
 
 String ResourceLoaderBinary::recognize_script_class(Ref<FileAccess> p_f) {
@@ -1201,14 +1361,14 @@ String ResourceLoaderBinary::recognize_script_class(Ref<FileAccess> p_f) {
 		return "";
 	}
 
-	get_unicode_string(); // type
+	get_unicode_string(f); // type
 
 	f->get_64(); // Metadata offset
 	uint32_t flags = f->get_32();
 	f->get_64(); // UID
 
 	if (flags & ResourceFormatSaverBinaryInstance::FORMAT_FLAG_HAS_SCRIPT_CLASS) {
-		return get_unicode_string();
+		return get_unicode_string(f);
 	} else {
 		return String();
 	}
@@ -35,6 +35,8 @@
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
 
+class MissingResource;
+
 class ResourceLoaderBinary {
 	bool translation_remapped = false;
 	String local_path;
@@ -54,13 +56,15 @@ class ResourceLoaderBinary {
 
 	Vector<StringName> string_map;
 
-	StringName _get_string();
+	StringName _get_string(Ref<FileAccess> &p_f);
+	String _read_utf8(Ref<FileAccess> &p_f, uint32_t p_len);
 
 	struct ExtResource {
 		String path;
 		String type;
 		ResourceUID::ID uid = ResourceUID::INVALID_ID;
 		Ref<ResourceLoader::LoadToken> load_token;
+		Ref<Resource> resource; // Once completed.
 	};
 
 	bool using_named_scene_ids = false;
@@ -69,6 +73,7 @@ class ResourceLoaderBinary {
 	bool use_sub_threads = false;
 	float *progress = nullptr;
 	Vector<ExtResource> external_resources;
+	bool external_resources_completed = false; // Before reading properties in parallel.
 
 	struct IntResource {
 		String path;
@@ -78,8 +83,28 @@ class ResourceLoaderBinary {
 	Vector<IntResource> internal_resources;
 	HashMap<String, Ref<Resource>> internal_index_cache;
 
-	String get_unicode_string();
-	void _advance_padding(uint32_t p_len);
+	// An internal resource between being instantiated and getting its properties set.
+	struct IntResourceLoad {
+		Ref<Resource> resource; // Null when reused from the cache.
+		MissingResource *missing_resource = nullptr;
+		uint64_t properties_offset = 0;
+		LocalVector<Pair<StringName, Variant>> properties;
+		Error error = OK;
+	};
+
+	// Shared by the tasks reading the properties of internal resources.
+	struct ParallelRead {
+		ResourceLoaderBinary *loader = nullptr;
+		const uint8_t *data = nullptr;
+		uint64_t length = 0;
+		bool big_endian = false;
+		bool real_is_double = false;
+		IntResourceLoad *loads = nullptr;
+		LocalVector<uint32_t> indices;
+	};
+
+	String get_unicode_string(Ref<FileAccess> &p_f);
+	void _advance_padding(Ref<FileAccess> &p_f, uint32_t p_len);
 
 	HashMap<String, String> remaps;
 	Error error = OK;
@@ -89,7 +114,15 @@ class ResourceLoaderBinary {
 
 	friend class ResourceFormatLoaderBinary;
 
-	Error parse_variant(Variant &r_v);
+	// Internal resources from `p_resource_index` on are not loaded yet.
+	Error parse_variant(Ref<FileAccess> &p_f, Variant &r_v, int p_resource_index);
+
+	Error _complete_external_resource(int p_index, Ref<Resource> &r_resource);
+	Error _instantiate_internal_resource(int p_index, IntResourceLoad &r_load);
+	Error _read_properties(Ref<FileAccess> &p_f, int p_index, IntResourceLoad &r_load);
+	static void _read_properties_task(void *p_userdata, uint32_t p_index);
+	Error _read_properties_parallel(LocalVector<IntResourceLoad> &r_loads);
+	void _set_properties(IntResourceLoad &p_load);
 
 	HashMap<String, Ref<Resource>> dependency_cache;
 
@@ -34,6 +34,7 @@
 #include "core/core_bind.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/io/file_access_pack.h"
 #include "core/io/resource_importer.h"
 #include "core/object/script_language.h"
 #include "core/os/condition_variable.h"
@@ -294,6 +295,10 @@ Ref<Resource> ResourceLoader::_load(const String &p_path, const String &p_origin
 	}
 	load_paths_stack.push_back(original_path);
 
+	if (prefetch_recording.is_set()) {
+		_record_load(p_path, original_path, p_type_hint);
+	}
+
 	print_verbose(vformat("Loading resource: %s", p_path));
 
 	// Try all loaders and pick the first match for the type hint
@@ -536,7 +541,7 @@ Ref<Resource> ResourceLoader::load(const String &p_path, const String &p_type_hi
 	return res;
 }
 
-Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path, const String &p_type_hint, LoadThreadMode p_thread_mode, ResourceFormatLoader::CacheMode p_cache_mode, bool p_for_user) {
+Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path, const String &p_type_hint, LoadThreadMode p_thread_mode, ResourceFormatLoader::CacheMode p_cache_mode, bool p_for_user, bool p_for_prefetch) {
 	String local_path = _validate_local_path(p_path);
 
 	bool ignoring_cache = p_cache_mode == ResourceFormatLoader::CACHE_MODE_IGNORE || p_cache_mode == ResourceFormatLoader::CACHE_MODE_IGNORE_DEEP;
@@ -557,6 +562,12 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 		if (!ignoring_cache && thread_load_tasks.has(local_path)) {
 			load_token = Ref<LoadToken>(thread_load_tasks[local_path].load_token);
 			if (load_token.is_valid()) {
+				if (p_for_prefetch) {
+					prefetch_tokens[local_path] = load_token;
+				} else {
+					// Someone else holds the load now, so a prefetch of it is done.
+					prefetch_tokens.erase(local_path);
+				}
 				if (p_for_user) {
 					// Load task exists, with no user tokens at the moment.
 					// Let's "attach" to it.
@@ -615,6 +626,11 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 		// the token anymore so it's released.
 		load_task_ptr->load_token->reference();
 
+		// Held under the same lock a load claiming the path releases it with.
+		if (p_for_prefetch) {
+			prefetch_tokens[local_path] = load_token;
+		}
+
 		if (p_thread_mode == LOAD_THREAD_FROM_CURRENT) {
 			// The current thread may happen to be a thread from the pool.
 			WorkerThreadPool::TaskID tid = WorkerThreadPool::get_singleton()->get_caller_task_id();
@@ -1329,6 +1345,8 @@ void ResourceLoader::clear_translation_remaps() {
 void ResourceLoader::clear_thread_load_tasks() {
 	// Bring the thing down as quickly as possible without causing deadlocks or leaks.
 
+	clear_prefetch();
+
 	MutexLock thread_load_lock(thread_load_mutex);
 	cleaning_tasks = true;
 
@@ -1367,6 +1385,136 @@ void ResourceLoader::clear_thread_load_tasks() {
 	cleaning_tasks = false;
 }
 
+void ResourceLoader::_record_load(const String &p_path, const String &p_original_path, const String &p_type_hint) {
+	MutexLock lock(prefetch_record_mutex);
+	HashMap<String, uint32_t>::Iterator E = prefetch_entry_indices.find(p_original_path);
+	if (E) {
+		// Imported resources are loaded again from their remapped path, which is what gets read.
+		if (p_path != p_original_path) {
+			prefetch_entries[E->value].source_path = p_path;
+		}
+		return;
+	}
+
+	PrefetchEntry entry;
+	entry.path = p_original_path;
+	entry.type_hint = p_type_hint;
+	entry.source_path = p_path;
+	entry.usec = OS::get_singleton()->get_ticks_usec() - prefetch_recording_start;
+	prefetch_entry_indices.insert(p_original_path, prefetch_entries.size());
+	prefetch_entries.push_back(entry);
+}
+
+void ResourceLoader::start_prefetch_recording() {
+	MutexLock lock(prefetch_record_mutex);
+	prefetch_entries.clear();
+	prefetch_entry_indices.clear();
+	prefetch_recording_start = OS::get_singleton()->get_ticks_usec();
+	prefetch_recording.set();
+}
+
+void ResourceLoader::stop_prefetch_recording() {
+	prefetch_recording.clear();
+}
+
+Error ResourceLoader::save_prefetch_manifest(const String &p_path) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, vformat("Cannot save prefetch manifest to: %s.", p_path));
+
+	// One tab-separated line per resource, in order of first use.
+	MutexLock lock(prefetch_record_mutex);
+	for (const PrefetchEntry &entry : prefetch_entries) {
+		f->store_line(String::num_uint64(entry.usec) + "\t" + entry.type_hint + "\t" + entry.path + "\t" + entry.source_path);
+	}
+
+	return OK;
+}
+
+Error ResourceLoader::prefetch(const String &p_manifest_path) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_manifest_path, FileAccess::READ, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, vformat("Cannot open prefetch manifest: %s.", p_manifest_path));
+
+	// Resources first used close together are requested by their position in the pack,
+	// so the loads that run in parallel read it mostly sequentially.
+	struct Request {
+		String path;
+		String type_hint;
+		uint64_t window = 0;
+		uint32_t pack = UINT32_MAX; // Files outside of packs go last in their window.
+		uint64_t offset = 0;
+		uint32_t order = 0;
+
+		bool operator<(const Request &p_other) const {
+			if (window != p_other.window) {
+				return window < p_other.window;
+			}
+			if (pack != p_other.pack) {
+				return pack < p_other.pack;
+			}
+			if (offset != p_other.offset) {
+				return offset < p_other.offset;
+			}
+			return order < p_other.order;
+		}
+	};
+
+	const uint64_t window_usec = 100000;
+	PackedData *packed_data = PackedData::get_singleton();
+	HashMap<String, uint32_t> packs;
+	LocalVector<Request> requests;
+
+	while (!f->eof_reached()) {
+		String line = f->get_line();
+		if (line.is_empty()) {
+			continue;
+		}
+
+		Vector<String> fields = line.split("\t");
+		ERR_FAIL_COND_V_MSG(fields.size() != 4, ERR_PARSE_ERROR, vformat("Invalid prefetch manifest: %s.", p_manifest_path));
+
+		Request request;
+		request.window = fields[0].to_int() / window_usec;
+		request.type_hint = fields[1];
+		request.path = fields[2];
+		request.order = requests.size();
+
+		String pack;
+		uint64_t offset = 0;
+		if (packed_data && !packed_data->is_disabled() && packed_data->get_file_location(fields[3], pack, offset)) {
+			HashMap<String, uint32_t>::Iterator E = packs.find(pack);
+			if (!E) {
+				E = packs.insert(pack, packs.size());
+			}
+			request.pack = E->value;
+			request.offset = offset;
+		}
+		requests.push_back(request);
+	}
+
+	requests.sort();
+
+	for (const Request &request : requests) {
+		if (ResourceCache::has(request.path)) {
+			continue;
+		}
+		_load_start(request.path, request.type_hint, LOAD_THREAD_SPAWN_SINGLE, ResourceFormatLoader::CACHE_MODE_REUSE, false, true);
+	}
+
+	return OK;
+}
+
+void ResourceLoader::clear_prefetch() {
+	HashMap<String, Ref<LoadToken>> tokens;
+	{
+		MutexLock thread_load_lock(thread_load_mutex);
+		tokens = prefetch_tokens;
+		prefetch_tokens.clear();
+	}
+	// Tokens are released out of the lock, since the last reference clears the load task.
+}
+
 void ResourceLoader::load_path_remaps() {
 	if (!ProjectSettings::get_singleton()->has_setting("path_remap/remapped_paths")) {
 		return;
@@ -1547,6 +1695,13 @@ bool ResourceLoader::cleaning_tasks = false;
 
 HashMap<String, ResourceLoader::LoadToken *> ResourceLoader::user_load_tokens;
 
+SafeFlag ResourceLoader::prefetch_recording;
+uint64_t ResourceLoader::prefetch_recording_start = 0;
+Mutex ResourceLoader::prefetch_record_mutex;
+LocalVector<ResourceLoader::PrefetchEntry> ResourceLoader::prefetch_entries;
+HashMap<String, uint32_t> ResourceLoader::prefetch_entry_indices;
+HashMap<String, Ref<ResourceLoader::LoadToken>> ResourceLoader::prefetch_tokens;
+
 SelfList<Resource>::List ResourceLoader::remapped_list;
 HashMap<String, Vector<String>> ResourceLoader::translation_remaps;
 HashMap<String, String> ResourceLoader::path_remaps;
@@ -135,7 +135,7 @@ public:
 
 	static const int BINARY_MUTEX_TAG = 1;
 
-	static Ref<LoadToken> _load_start(const String &p_path, const String &p_type_hint, LoadThreadMode p_thread_mode, ResourceFormatLoader::CacheMode p_cache_mode, bool p_for_user = false);
+	static Ref<LoadToken> _load_start(const String &p_path, const String &p_type_hint, LoadThreadMode p_thread_mode, ResourceFormatLoader::CacheMode p_cache_mode, bool p_for_user = false, bool p_for_prefetch = false);
 	static Ref<Resource> _load_complete(LoadToken &p_load_token, Error *r_error);
 
 private:
@@ -213,6 +213,22 @@ private:
 
 	static HashMap<String, LoadToken *> user_load_tokens;
 
+	struct PrefetchEntry {
+		String path;
+		String type_hint;
+		String source_path; // File holding the payload, which differs for imported resources.
+		uint64_t usec = 0; // First use, relative to the start of the recording.
+	};
+
+	static SafeFlag prefetch_recording;
+	static uint64_t prefetch_recording_start;
+	static Mutex prefetch_record_mutex;
+	static LocalVector<PrefetchEntry> prefetch_entries;
+	static HashMap<String, uint32_t> prefetch_entry_indices;
+	static HashMap<String, Ref<LoadToken>> prefetch_tokens; // Released once someone else claims the load.
+
+	static void _record_load(const String &p_path, const String &p_original_path, const String &p_type_hint);
+
 	static float _dependency_get_progress(const String &p_path);
 
 	static bool _ensure_load_progress();
@@ -224,6 +240,15 @@ public:
 
 	static bool is_within_load() { return load_nesting > 0; }
 
+	// A prefetch manifest lists what a session loaded and when, so later runs can
+	// start loading it all in parallel, in the order it will be needed.
+	static void start_prefetch_recording();
+	static void stop_prefetch_recording();
+	static bool is_prefetch_recording() { return prefetch_recording.is_set(); }
+	static Error save_prefetch_manifest(const String &p_path);
+	static Error prefetch(const String &p_manifest_path);
+	static void clear_prefetch();
+
 	static void resource_changed_connect(Resource *p_source, const Callable &p_callable, uint32_t p_flags);
 	static void resource_changed_disconnect(Resource *p_source, const Callable &p_callable);
 	static void resource_changed_emit(Resource *p_source);
@@ -0,0 +1,516 @@
+/**************************************************************************/
+/*  bulk_math.cpp                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "bulk_math.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BULK_MATH_SSE
+#include <emmintrin.h>
+#if defined(__AVX__)
+#define BULK_MATH_AVX
+#include <immintrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define BULK_MATH_NEON
+#include <arm_neon.h>
+#endif
+
+static_assert(sizeof(Vector3) == sizeof(real_t) * 3, "Vector3 arrays must be tightly packed for bulk kernels.");
+
+#ifdef BULK_MATH_SSE
+
+static _FORCE_INLINE_ float _hsum(__m128 p_v) {
+	__m128 shuf = _mm_shuffle_ps(p_v, p_v, _MM_SHUFFLE(2, 3, 0, 1));
+	__m128 sums = _mm_add_ps(p_v, shuf);
+	shuf = _mm_movehl_ps(shuf, sums);
+	sums = _mm_add_ss(sums, shuf);
+	return _mm_cvtss_f32(sums);
+}
+
+static _FORCE_INLINE_ float _hmin(__m128 p_v) {
+	__m128 shuf = _mm_shuffle_ps(p_v, p_v, _MM_SHUFFLE(2, 3, 0, 1));
+	__m128 mins = _mm_min_ps(p_v, shuf);
+	shuf = _mm_movehl_ps(shuf, mins);
+	mins = _mm_min_ss(mins, shuf);
+	return _mm_cvtss_f32(mins);
+}
+
+static _FORCE_INLINE_ float _hmax(__m128 p_v) {
+	__m128 shuf = _mm_shuffle_ps(p_v, p_v, _MM_SHUFFLE(2, 3, 0, 1));
+	__m128 maxs = _mm_max_ps(p_v, shuf);
+	shuf = _mm_movehl_ps(shuf, maxs);
+	maxs = _mm_max_ss(maxs, shuf);
+	return _mm_cvtss_f32(maxs);
+}
+
+#endif // BULK_MATH_SSE
+
+#ifdef BULK_MATH_AVX
+
+static _FORCE_INLINE_ __m128 _fold(__m256 p_v) {
+	return _mm_add_ps(_mm256_castps256_ps128(p_v), _mm256_extractf128_ps(p_v, 1));
+}
+
+#endif // BULK_MATH_AVX
+
+void BulkMath::add(const float *p_a, const float *p_b, float *r_dst, int64_t p_count) {
+	int64_t i = 0;
+#if defined(BULK_MATH_AVX)
+	for (; i + 8 <= p_count; i += 8) {
+		_mm256_storeu_ps(r_dst + i, _mm256_add_ps(_mm256_loadu_ps(p_a + i), _mm256_loadu_ps(p_b + i)));
+	}
+#endif
+#if defined(BULK_MATH_SSE)
+	for (; i + 4 <= p_count; i += 4) {
+		_mm_storeu_ps(r_dst + i, _mm_add_ps(_mm_loadu_ps(p_a + i), _mm_loadu_ps(p_b + i)));
+	}
+#elif defined(BULK_MATH_NEON)
+	for (; i + 4 <= p_count; i += 4) {
+		vst1q_f32(r_dst + i, vaddq_f32(vld1q_f32(p_a + i), vld1q_f32(p_b + i)));
+	}
+#endif
+	for (; i < p_count; i++) {
+		r_dst[i] = p_a[i] + p_b[i];
+	}
+}
+
+void BulkMath::multiply(const float *p_a, const float *p_b, float *r_dst, int64_t p_count) {
+	int64_t i = 0;
+#if defined(BULK_MATH_AVX)
+	for (; i + 8 <= p_count; i += 8) {
+		_mm256_storeu_ps(r_dst + i, _mm256_mul_ps(_mm256_loadu_ps(p_a + i), _mm256_loadu_ps(p_b + i)));
+	}
+#endif
+#if defined(BULK_MATH_SSE)
+	for (; i + 4 <= p_count; i += 4) {
+		_mm_storeu_ps(r_dst + i, _mm_mul_ps(_mm_loadu_ps(p_a + i), _mm_loadu_ps(p_b + i)));
+	}
+#elif defined(BULK_MATH_NEON)
+	for (; i + 4 <= p_count; i += 4) {
+		vst1q_f32(r_dst + i, vmulq_f32(vld1q_f32(p_a + i), vld1q_f32(p_b + i)));
+	}
+#endif
+	for (; i < p_count; i++) {
+		r_dst[i] = p_a[i] * p_b[i];
+	}
+}
+
+void BulkMath::scale(const float *p_src, float p_scale, float *r_dst, int64_t p_count) {
+	int64_t i = 0;
+#if defined(BULK_MATH_AVX)
+	const __m256 s8 = _mm256_set1_ps(p_scale);
+	for (; i + 8 <= p_count; i += 8) {
+		_mm256_storeu_ps(r_dst + i, _mm256_mul_ps(_mm256_loadu_ps(p_src + i), s8));
+	}
+#endif
+#if defined(BULK_MATH_SSE)
+	const __m128 s = _mm_set1_ps(p_scale);
+	for (; i + 4 <= p_count; i += 4) {
+		_mm_storeu_ps(r_dst + i, _mm_mul_ps(_mm_loadu_ps(p_src + i), s));
+	}
+#elif defined(BULK_MATH_NEON)
+	const float32x4_t s = vdupq_n_f32(p_scale);
+	for (; i + 4 <= p_count; i += 4) {
+		vst1q_f32(r_dst + i, vmulq_f32(vld1q_f32(p_src + i), s));
+	}
+#endif
+	for (; i < p_count; i++) {
+		r_dst[i] = p_src[i] * p_scale;
+	}
+}
+
+void BulkMath::lerp(const float *p_from, const float *p_to, float p_weight, float *r_dst, int64_t p_count) {
+	// Same formula as Math::lerp(), so results match the per-element version.
+	int64_t i = 0;
+#if defined(BULK_MATH_AVX)
+	const __m256 w8 = _mm256_set1_ps(p_weight);
+	for (; i + 8 <= p_count; i += 8) {
+		const __m256 from = _mm256_loadu_ps(p_from + i);
+		_mm256_storeu_ps(r_dst + i, _mm256_add_ps(from, _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(p_to + i), from), w8)));
+	}
+#endif
+#if defined(BULK_MATH_SSE)
+	const __m128 w = _mm_set1_ps(p_weight);
+	for (; i + 4 <= p_count; i += 4) {
+		const __m128 from = _mm_loadu_ps(p_from + i);
+		_mm_storeu_ps(r_dst + i, _mm_add_ps(from, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(p_to + i), from), w)));
+	}
+#elif defined(BULK_MATH_NEON)
+	const float32x4_t w = vdupq_n_f32(p_weight);
+	for (; i + 4 <= p_count; i += 4) {
+		const float32x4_t from = vld1q_f32(p_from + i);
+		vst1q_f32(r_dst + i, vaddq_f32(from, vmulq_f32(vsubq_f32(vld1q_f32(p_to + i), from), w)));
+	}
+#endif
+	for (; i < p_count; i++) {
+		r_dst[i] = p_from[i] + (p_to[i] - p_from[i]) * p_weight;
+	}
+}
+
+float BulkMath::sum(const float *p_src, int64_t p_count) {
+	// Vector paths accumulate in several lanes, so the result may differ from
+	// a sequential sum by rounding.
+	float ret = 0.0f;
+	int64_t i = 0;
+#if defined(BULK_MATH_AVX)
+	if (p_count >= 8) {
+		__m256 acc = _mm256_setzero_ps();
+		for (; i + 8 <= p_count; i += 8) {
+			acc = _mm256_add_ps(acc, _mm256_loadu_ps(p_src + i));
+		}
+		ret += _hsum(_fold(acc));
+	}
+#endif
+#if defined(BULK_MATH_SSE)
+	if (i + 4 <= p_count) {
+		__m128 acc = _mm_setzero_ps();
+		for (; i + 4 <= p_count; i += 4) {
+			acc = _mm_add_ps(acc, _mm_loadu_ps(p_src + i));
+		}
+		ret += _hsum(acc);
+	}
+#elif defined(BULK_MATH_NEON)
+	if (i + 4 <= p_count) {
+		float32x4_t acc = vdupq_n_f32(0.0f);
+		for (; i + 4 <= p_count; i += 4) {
+			acc = vaddq_f32(acc, vld1q_f32(p_src + i));
+		}
+		ret += vaddvq_f32(acc);
+	}
+#endif
+	for (; i < p_count; i++) {
+		ret += p_src[i];
+	}
+	return ret;
+}
+
+float BulkMath::dot(const float *p_a, const float *p_b, int64_t p_count) {
+	float ret = 0.0f;
+	int64_t i = 0;
+#if defined(BULK_MATH_AVX)
+	if (p_count >= 8) {
+		__m256 acc = _mm256_setzero_ps();
+		for (; i + 8 <= p_count; i += 8) {
+			acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(p_a + i), _mm256_loadu_ps(p_b + i)));
+		}
+		ret += _hsum(_fold(acc));
+	}
+#endif
+#if defined(BULK_MATH_SSE)
+	if (i + 4 <= p_count) {
+		__m128 acc = _mm_setzero_ps();
+		for (; i + 4 <= p_count; i += 4) {
+			acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(p_a + i), _mm_loadu_ps(p_b + i)));
+		}
+		ret += _hsum(acc);
+	}
+#elif defined(BULK_MATH_NEON)
+	if (i + 4 <= p_count) {
+		float32x4_t acc = vdupq_n_f32(0.0f);
+		for (; i + 4 <= p_count; i += 4) {
+			acc = vaddq_f32(acc, vmulq_f32(vld1q_f32(p_a + i), vld1q_f32(p_b + i)));
+		}
+		ret += vaddvq_f32(acc);
+	}
+#endif
+	for (; i < p_count; i++) {
+		ret += p_a[i] * p_b[i];
+	}
+	return ret;
+}
+
+void BulkMath::get_min_max(const float *p_src, int64_t p_count, float &r_min, float &r_max) {
+	if (p_count <= 0) {
+		return;
+	}
+
+	float min = p_src[0];
+	float max = p_src[0];
+	int64_t i = 0;
+#if defined(BULK_MATH_SSE)
+	if (p_count >= 4) {
+		__m128 vmin = _mm_loadu_ps(p_src);
+		__m128 vmax = vmin;
+		for (i = 4; i + 4 <= p_count; i += 4) {
+			const __m128 v = _mm_loadu_ps(p_src + i);
+			vmin = _mm_min_ps(vmin, v);
+			vmax = _mm_max_ps(vmax, v);
+		}
+		min = _hmin(vmin);
+		max = _hmax(vmax);
+	}
+#elif defined(BULK_MATH_NEON)
+	if (p_count >= 4) {
+		float32x4_t vmin = vld1q_f32(p_src);
+		float32x4_t vmax = vmin;
+		for (i = 4; i + 4 <= p_count; i += 4) {
+			const float32x4_t v = vld1q_f32(p_src + i);
+			vmin = vminq_f32(vmin, v);
+			vmax = vmaxq_f32(vmax, v);
+		}
+		min = vminvq_f32(vmin);
+		max = vmaxvq_f32(vmax);
+	}
+#endif
+	for (; i < p_count; i++) {
+		min = MIN(min, p_src[i]);
+		max = MAX(max, p_src[i]);
+	}
+	r_min = min;
+	r_max = max;
+}
+
+#ifndef REAL_T_IS_DOUBLE
+
+// Computes `p_rows * (p_src[i] - p_pre) + p_post` for each point. Covers
+// both Transform3D::xform() and Transform3D::xform_inv() (with transposed rows).
+static void _xform_points(const float p_rows[3][3], bool p_has_pre, const float p_pre[3], const float p_post[3], const float *p_src, float *r_dst, int64_t p_count) {
+	int64_t i = 0;
+#if defined(BULK_MATH_SSE)
+	// Works on the interleaved layout directly: four points are three registers
+	// holding (x0 y0 z0 x1) (y1 z1 x2 y2) (z2 x3 y3 z3), and each output register
+	// is built from broadcasts of its inputs and rotated copies of the matrix.
+	const __m128 k0a = _mm_setr_ps(p_rows[0][0], p_rows[1][0], p_rows[2][0], p_rows[0][0]);
+	const __m128 k1a = _mm_setr_ps(p_rows[0][1], p_rows[1][1], p_rows[2][1], p_rows[0][1]);
+	const __m128 k2a = _mm_setr_ps(p_rows[0][2], p_rows[1][2], p_rows[2][2], p_rows[0][2]);
+	const __m128 k0b = _mm_setr_ps(p_rows[1][0], p_rows[2][0], p_rows[0][0], p_rows[1][0]);
+	const __m128 k1b = _mm_setr_ps(p_rows[1][1], p_rows[2][1], p_rows[0][1], p_rows[1][1]);
+	const __m128 k2b = _mm_setr_ps(p_rows[1][2], p_rows[2][2], p_rows[0][2], p_rows[1][2]);
+	const __m128 k0c = _mm_setr_ps(p_rows[2][0], p_rows[0][0], p_rows[1][0], p_rows[2][0]);
+	const __m128 k1c = _mm_setr_ps(p_rows[2][1], p_rows[0][1], p_rows[1][1], p_rows[2][1]);
+	const __m128 k2c = _mm_setr_ps(p_rows[2][2], p_rows[0][2], p_rows[1][2], p_rows[2][2]);
+	const __m128 pre_a = _mm_setr_ps(p_pre[0], p_pre[1], p_pre[2], p_pre[0]);
+	const __m128 pre_b = _mm_setr_ps(p_pre[1], p_pre[2], p_pre[0], p_pre[1]);
+	const __m128 pre_c = _mm_setr_ps(p_pre[2], p_pre[0], p_pre[1], p_pre[2]);
+	const __m128 post_a = _mm_setr_ps(p_post[0], p_post[1], p_post[2], p_post[0]);
+	const __m128 post_b = _mm_setr_ps(p_post[1], p_post[2], p_post[0], p_post[1]);
+	const __m128 post_c = _mm_setr_ps(p_post[2], p_post[0], p_post[1], p_post[2]);
+	for (; i + 4 <= p_count; i += 4) {
+		__m128 a = _mm_loadu_ps(p_src + i * 3);
+		__m128 b = _mm_loadu_ps(p_src + i * 3 + 4);
+		__m128 c = _mm_loadu_ps(p_src + i * 3 + 8);
+		if (p_has_pre) {
+			a = _mm_sub_ps(a, pre_a);
+			b = _mm_sub_ps(b, pre_b);
+			c = _mm_sub_ps(c, pre_c);
+		}
+
+		const __m128 ab_y = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)); // y0 y0 y1 y1
+		const __m128 ab_z = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)); // z0 z0 z1 z1
+		const __m128 x_a = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 0, 0)); // x0 x0 x0 x1
+		const __m128 y_a = _mm_shuffle_ps(ab_y, ab_y, _MM_SHUFFLE(2, 0, 0, 0));
+		const __m128 z_a = _mm_shuffle_ps(ab_z, ab_z, _MM_SHUFFLE(2, 0, 0, 0));
+
+		const __m128 x_b = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 2, 3, 3)); // x1 x1 x2 x2
+		const __m128 y_b = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 3, 0, 0)); // y1 y1 y2 y2
+		const __m128 z_b = _mm_shuffle_ps(b, c, _MM_SHUFFLE(0, 0, 1, 1)); // z1 z1 z2 z2
+
+		const __m128 bc_x = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)); // x2 x2 x3 x3
+		const __m128 bc_y = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)); // y2 y2 y3 y3
+		const __m128 x_c = _mm_shuffle_ps(bc_x, bc_x, _MM_SHUFFLE(2, 2, 2, 0));
+		const __m128 y_c = _mm_shuffle_ps(bc_y, bc_y, _MM_SHUFFLE(2, 2, 2, 0));
+		const __m128 z_c = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 3, 0)); // z2 z3 z3 z3
+
+		_mm_storeu_ps(r_dst + i * 3, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(k0a, x_a), _mm_mul_ps(k1a, y_a)), _mm_mul_ps(k2a, z_a)), post_a));
+		_mm_storeu_ps(r_dst + i * 3 + 4, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(k0b, x_b), _mm_mul_ps(k1b, y_b)), _mm_mul_ps(k2b, z_b)), post_b));
+		_mm_storeu_ps(r_dst + i * 3 + 8, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(k0c, x_c), _mm_mul_ps(k1c, y_c)), _mm_mul_ps(k2c, z_c)), post_c));
+	}
+#elif defined(BULK_MATH_NEON)
+	const float32x4_t m00 = vdupq_n_f32(p_rows[0][0]), m01 = vdupq_n_f32(p_rows[0][1]), m02 = vdupq_n_f32(p_rows[0][2]);
+	const float32x4_t m10 = vdupq_n_f32(p_rows[1][0]), m11 = vdupq_n_f32(p_rows[1][1]), m12 = vdupq_n_f32(p_rows[1][2]);
+	const float32x4_t m20 = vdupq_n_f32(p_rows[2][0]), m21 = vdupq_n_f32(p_rows[2][1]), m22 = vdupq_n_f32(p_rows[2][2]);
+	const float32x4_t pre_x = vdupq_n_f32(p_pre[0]), pre_y = vdupq_n_f32(p_pre[1]), pre_z = vdupq_n_f32(p_pre[2]);
+	const float32x4_t post_x = vdupq_n_f32(p_post[0]), post_y = vdupq_n_f32(p_post[1]), post_z = vdupq_n_f32(p_post[2]);
+	for (; i + 4 <= p_count; i += 4) {
+		float32x4x3_t v = vld3q_f32(p_src + i * 3);
+		const float32x4_t x = vsubq_f32(v.val[0], pre_x);
+		const float32x4_t y = vsubq_f32(v.val[1], pre_y);
+		const float32x4_t z = vsubq_f32(v.val[2], pre_z);
+		v.val[0] = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_f32(m00, x), vmulq_f32(m01, y)), vmulq_f32(m02, z)), post_x);
+		v.val[1] = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_f32(m10, x), vmulq_f32(m11, y)), vmulq_f32(m12, z)), post_y);
+		v.val[2] = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_f32(m20, x), vmulq_f32(m21, y)), vmulq_f32(m22, z)), post_z);
+		vst3q_f32(r_dst + i * 3, v);
+	}
+#endif
+	for (; i < p_count; i++) {
+		const float x = p_src[i * 3 + 0] - p_pre[0];
+		const float y = p_src[i * 3 + 1] - p_pre[1];
+		const float z = p_src[i * 3 + 2] - p_pre[2];
+		r_dst[i * 3 + 0] = p_rows[0][0] * x + p_rows[0][1] * y + p_rows[0][2] * z + p_post[0];
+		r_dst[i * 3 + 1] = p_rows[1][0] * x + p_rows[1][1] * y + p_rows[1][2] * z + p_post[1];
+		r_dst[i * 3 + 2] = p_rows[2][0] * x + p_rows[2][1] * y + p_rows[2][2] * z + p_post[2];
+	}
+}
+
+static void _xform_points(const Basis &p_basis, bool p_transpose, const Vector3 &p_pre, const Vector3 &p_post, const Vector3 *p_src, Vector3 *r_dst, int64_t p_count) {
+	float rows[3][3];
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 3; j++) {
+			rows[i][j] = p_transpose ? p_basis.rows[j][i] : p_basis.rows[i][j];
+		}
+	}
+	const float pre[3] = { p_pre.x, p_pre.y, p_pre.z };
+	const float post[3] = { p_post.x, p_post.y, p_post.z };
+	_xform_points(rows, p_pre != Vector3(), pre, post, (const float *)p_src, (float *)r_dst, p_count);
+}
+
+#endif // REAL_T_IS_DOUBLE
+
+void BulkMath::add(const Vector3 *p_a, const Vector3 *p_b, Vector3 *r_dst, int64_t p_count) {
+#ifdef REAL_T_IS_DOUBLE
+	for (int64_t i = 0; i < p_count; i++) {
+		r_dst[i] = p_a[i] + p_b[i];
+	}
+#else
+	add((const float *)p_a, (const float *)p_b, (float *)r_dst, p_count * 3);
+#endif
+}
+
+void BulkMath::multiply(const Vector3 *p_a, const Vector3 *p_b, Vector3 *r_dst, int64_t p_count) {
+#ifdef REAL_T_IS_DOUBLE
+	for (int64_t i = 0; i < p_count; i++) {
+		r_dst[i] = p_a[i] * p_b[i];
+	}
+#else
+	multiply((const float *)p_a, (const float *)p_b, (float *)r_dst, p_count * 3);
+#endif
+}
+
+void BulkMath::scale(const Vector3 *p_src, real_t p_scale, Vector3 *r_dst, int64_t p_count) {
+#ifdef REAL_T_IS_DOUBLE
+	for (int64_t i = 0; i < p_count; i++) {
+		r_dst[i] = p_src[i] * p_scale;
+	}
+#else
+	scale((const float *)p_src, p_scale, (float *)r_dst, p_count * 3);
+#endif
+}
+
+void BulkMath::lerp(const Vector3 *p_from, const Vector3 *p_to, real_t p_weight, Vector3 *r_dst, int64_t p_count) {
+#ifdef REAL_T_IS_DOUBLE
+	for (int64_t i = 0; i < p_count; i++) {
+		r_dst[i] = p_from[i].lerp(p_to[i], p_weight);
+	}
+#else
+	lerp((const float *)p_from, (const float *)p_to, p_weight, (float *)r_dst, p_count * 3);
+#endif
+}
+
+void BulkMath::xform(const Transform3D &p_transform, const Vector3 *p_src, Vector3 *r_dst, int64_t p_count) {
+#ifdef REAL_T_IS_DOUBLE
+	for (int64_t i = 0; i < p_count; i++) {
+		r_dst[i] = p_transform.xform(p_src[i]);
+	}
+#else
+	_xform_points(p_transform.basis, false, Vector3(), p_transform.origin, p_src, r_dst, p_count);
+#endif
+}
+
+void BulkMath::xform_inv(const Transform3D &p_transform, const Vector3 *p_src, Vector3 *r_dst, int64_t p_count) {
+#ifdef REAL_T_IS_DOUBLE
+	for (int64_t i = 0; i < p_count; i++) {
+		r_dst[i] = p_transform.xform_inv(p_src[i]);
+	}
+#else
+	_xform_points(p_transform.basis, true, p_transform.origin, Vector3(), p_src, r_dst, p_count);
+#endif
+}
+
+AABB BulkMath::get_aabb(const Vector3 *p_src, int64_t p_count) {
+	if (p_count <= 0) {
+		return AABB();
+	}
+
+	Vector3 min = p_src[0];
+	Vector3 max = p_src[0];
+	int64_t i = 1;
+#if !defined(REAL_T_IS_DOUBLE) && (defined(BULK_MATH_SSE) || defined(BULK_MATH_NEON))
+	if (p_count >= 4) {
+		const float *src = (const float *)p_src;
+#if defined(BULK_MATH_SSE)
+		// Same interleaved layout as _xform_points(): lanes of the three
+		// accumulators hold (x y z x) (y z x y) (z x y z).
+		__m128 min_a = _mm_loadu_ps(src), min_b = _mm_loadu_ps(src + 4), min_c = _mm_loadu_ps(src + 8);
+		__m128 max_a = min_a, max_b = min_b, max_c = min_c;
+		for (i = 4; i + 4 <= p_count; i += 4) {
+			const __m128 a = _mm_loadu_ps(src + i * 3);
+			const __m128 b = _mm_loadu_ps(src + i * 3 + 4);
+			const __m128 c = _mm_loadu_ps(src + i * 3 + 8);
+			min_a = _mm_min_ps(min_a, a);
+			min_b = _mm_min_ps(min_b, b);
+			min_c = _mm_min_ps(min_c, c);
+			max_a = _mm_max_ps(max_a, a);
+			max_b = _mm_max_ps(max_b, b);
+			max_c = _mm_max_ps(max_c, c);
+		}
+		float lanes[2][12];
+		_mm_storeu_ps(lanes[0], min_a);
+		_mm_storeu_ps(lanes[0] + 4, min_b);
+		_mm_storeu_ps(lanes[0] + 8, min_c);
+		_mm_storeu_ps(lanes[1], max_a);
+		_mm_storeu_ps(lanes[1] + 4, max_b);
+		_mm_storeu_ps(lanes[1] + 8, max_c);
+		for (int j = 0; j < 12; j += 3) {
+			min = min.min(Vector3(lanes[0][j], lanes[0][j + 1], lanes[0][j + 2]));
+			max = max.max(Vector3(lanes[1][j], lanes[1][j + 1], lanes[1][j + 2]));
+		}
+#else
+		float32x4x3_t vmin = vld3q_f32(src);
+		float32x4x3_t vmax = vmin;
+		for (i = 4; i + 4 <= p_count; i += 4) {
+			const float32x4x3_t v = vld3q_f32(src + i * 3);
+			for (int j = 0; j < 3; j++) {
+				vmin.val[j] = vminq_f32(vmin.val[j], v.val[j]);
+				vmax.val[j] = vmaxq_f32(vmax.val[j], v.val[j]);
+			}
+		}
+		min = Vector3(vminvq_f32(vmin.val[0]), vminvq_f32(vmin.val[1]), vminvq_f32(vmin.val[2]));
+		max = Vector3(vmaxvq_f32(vmax.val[0]), vmaxvq_f32(vmax.val[1]), vmaxvq_f32(vmax.val[2]));
+#endif
+	}
+#endif
+	for (; i < p_count; i++) {
+		min = min.min(p_src[i]);
+		max = max.max(p_src[i]);
+	}
+	return AABB(min, max - min);
+}
+
+const char *BulkMath::get_instruction_set() {
+#if defined(BULK_MATH_AVX)
+	return "AVX";
+#elif defined(BULK_MATH_SSE)
+	return "SSE2";
+#elif defined(BULK_MATH_NEON)
+	return "NEON";
+#else
+	return "Scalar";
+#endif
+}
@@ -0,0 +1,70 @@
+/**************************************************************************/
+/*  bulk_math.h                                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BULK_MATH_H
+#define BULK_MATH_H
+
+#include "core/math/aabb.h"
+#include "core/math/transform_3d.h"
+#include "core/math/vector3.h"
+
+// Bulk kernels over contiguous arrays (the storage behind packed arrays).
+// SSE2, AVX or NEON paths are used when the compiler targets them, with a
+// scalar fallback otherwise. When `real_t` is `double` the Vector3 kernels
+// always use the scalar path.
+// Destination arrays may alias a source array, but must not partially overlap.
+class BulkMath {
+public:
+	static void add(const float *p_a, const float *p_b, float *r_dst, int64_t p_count);
+	static void multiply(const float *p_a, const float *p_b, float *r_dst, int64_t p_count);
+	static void scale(const float *p_src, float p_scale, float *r_dst, int64_t p_count);
+	static void lerp(const float *p_from, const float *p_to, float p_weight, float *r_dst, int64_t p_count);
+
+	static float sum(const float *p_src, int64_t p_count);
+	static float dot(const float *p_a, const float *p_b, int64_t p_count);
+	// Both results are left untouched if `p_count` is zero.
+	static void get_min_max(const float *p_src, int64_t p_count, float &r_min, float &r_max);
+
+	static void add(const Vector3 *p_a, const Vector3 *p_b, Vector3 *r_dst, int64_t p_count);
+	static void multiply(const Vector3 *p_a, const Vector3 *p_b, Vector3 *r_dst, int64_t p_count);
+	static void scale(const Vector3 *p_src, real_t p_scale, Vector3 *r_dst, int64_t p_count);
+	static void lerp(const Vector3 *p_from, const Vector3 *p_to, real_t p_weight, Vector3 *r_dst, int64_t p_count);
+
+	static void xform(const Transform3D &p_transform, const Vector3 *p_src, Vector3 *r_dst, int64_t p_count);
+	static void xform_inv(const Transform3D &p_transform, const Vector3 *p_src, Vector3 *r_dst, int64_t p_count);
+
+	// Returns an empty AABB if `p_count` is zero.
+	static AABB get_aabb(const Vector3 *p_src, int64_t p_count);
+
+	// Name of the widest instruction set the kernels were compiled for.
+	static const char *get_instruction_set();
+};
+
+#endif // BULK_MATH_H
@@ -31,6 +31,7 @@
 #include "expression.h"
 
 #include "core/object/class_db.h"
+#include "core/variant/variant_internal.h"
 
 Error Expression::_get_token(Token &r_token) {
 	while (true) {
@@ -1232,6 +1233,7 @@ bool Expression::_compile_expression() {
 		return true;
 	}
 
+	_compile_code();
 	expression_dirty = false;
 	return false;
 }
@@ -1464,12 +1466,374 @@ bool Expression::_execute(const Array &p_inputs, Object *p_instance, Expression:
 	return false;
 }
 
+void Expression::_clear_code() {
+	code.clear();
+	code_arguments.clear();
+	constants.clear();
+	input_order.clear();
+	required_inputs = 0;
+	max_arguments = 0;
+	result_address = 0;
+}
+
+void Expression::_compile_code() {
+	_clear_code();
+	if (root) {
+		result_address = _compile_node(root);
+	}
+}
+
+// Containers are shared between copies of a Variant, so each execution must build its own.
+bool Expression::_is_shared_type(Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::OBJECT:
+		case Variant::DICTIONARY:
+		case Variant::ARRAY:
+		case Variant::PACKED_BYTE_ARRAY:
+		case Variant::PACKED_INT32_ARRAY:
+		case Variant::PACKED_INT64_ARRAY:
+		case Variant::PACKED_FLOAT32_ARRAY:
+		case Variant::PACKED_FLOAT64_ARRAY:
+		case Variant::PACKED_STRING_ARRAY:
+		case Variant::PACKED_VECTOR2_ARRAY:
+		case Variant::PACKED_VECTOR3_ARRAY:
+		case Variant::PACKED_COLOR_ARRAY:
+		case Variant::PACKED_VECTOR4_ARRAY:
+			return true;
+		default:
+			return false;
+	}
+}
+
+int Expression::_add_constant(const Variant &p_value) {
+	constants.push_back(p_value);
+	return (ADDRESS_TYPE_CONSTANT << ADDRESS_BITS) | (constants.size() - 1);
+}
+
+int Expression::_add_instruction(const Instruction &p_instruction, const Vector<ENode *> &p_arguments) {
+	Instruction instruction = p_instruction;
+
+	// Compiled before being appended, since they can add arguments of their own.
+	LocalVector<int> arguments;
+	for (ENode *argument : p_arguments) {
+		arguments.push_back(_compile_node(argument));
+	}
+	instruction.arguments = code_arguments.size();
+	instruction.argument_count = arguments.size();
+	for (int address : arguments) {
+		code_arguments.push_back(address);
+	}
+	max_arguments = MAX(max_arguments, instruction.argument_count);
+
+	// Fold pure instructions whose operands are all constant. Errors are left for execution to report.
+	bool foldable = false;
+	switch (instruction.opcode) {
+		case OPCODE_OPERATOR:
+		case OPCODE_INDEX:
+			foldable = (instruction.a >> ADDRESS_BITS) == ADDRESS_TYPE_CONSTANT && (instruction.b >> ADDRESS_BITS) == ADDRESS_TYPE_CONSTANT;
+			break;
+		case OPCODE_NAMED_INDEX:
+			foldable = (instruction.a >> ADDRESS_BITS) == ADDRESS_TYPE_CONSTANT;
+			break;
+		case OPCODE_CONSTRUCT: {
+			foldable = !_is_shared_type(instruction.type);
+			for (int address : arguments) {
+				foldable = foldable && (address >> ADDRESS_BITS) == ADDRESS_TYPE_CONSTANT;
+			}
+		} break;
+		default:
+			break;
+	}
+
+	if (foldable) {
+		LocalVector<const Variant *> argptrs;
+		argptrs.resize(MAX(instruction.argument_count, 1));
+		Variant value;
+		String error;
+		if (!_execute_instruction(instruction, nullptr, nullptr, nullptr, true, argptrs.ptr(), value, error) && !_is_shared_type(value.get_type())) {
+			code_arguments.resize(instruction.arguments);
+			return _add_constant(value);
+		}
+	}
+
+	code.push_back(instruction);
+	return (ADDRESS_TYPE_REGISTER << ADDRESS_BITS) | (code.size() - 1);
+}
+
+int Expression::_compile_node(ENode *p_node) {
+	Instruction instruction;
+
+	switch (p_node->type) {
+		case Expression::ENode::TYPE_INPUT: {
+			const Expression::InputNode *in = static_cast<const Expression::InputNode *>(p_node);
+			input_order.push_back(in->index);
+			required_inputs = MAX(required_inputs, in->index + 1);
+			return (ADDRESS_TYPE_INPUT << ADDRESS_BITS) | in->index;
+		}
+		case Expression::ENode::TYPE_CONSTANT: {
+			const Expression::ConstantNode *c = static_cast<const Expression::ConstantNode *>(p_node);
+			return _add_constant(c->value);
+		}
+		case Expression::ENode::TYPE_SELF: {
+			instruction.opcode = OPCODE_SELF;
+			return _add_instruction(instruction);
+		}
+		case Expression::ENode::TYPE_OPERATOR: {
+			const Expression::OperatorNode *op = static_cast<const Expression::OperatorNode *>(p_node);
+			instruction.opcode = OPCODE_OPERATOR;
+			instruction.op = op->op;
+			instruction.a = _compile_node(op->nodes[0]);
+			instruction.b = op->nodes[1] ? _compile_node(op->nodes[1]) : _add_constant(Variant());
+			return _add_instruction(instruction);
+		}
+		case Expression::ENode::TYPE_INDEX: {
+			const Expression::IndexNode *index = static_cast<const Expression::IndexNode *>(p_node);
+			instruction.opcode = OPCODE_INDEX;
+			instruction.a = _compile_node(index->base);
+			instruction.b = _compile_node(index->index);
+			return _add_instruction(instruction);
+		}
+		case Expression::ENode::TYPE_NAMED_INDEX: {
+			const Expression::NamedIndexNode *index = static_cast<const Expression::NamedIndexNode *>(p_node);
+			instruction.opcode = OPCODE_NAMED_INDEX;
+			instruction.name = index->name;
+			instruction.a = _compile_node(index->base);
+			return _add_instruction(instruction);
+		}
+		case Expression::ENode::TYPE_ARRAY: {
+			const Expression::ArrayNode *array = static_cast<const Expression::ArrayNode *>(p_node);
+			instruction.opcode = OPCODE_ARRAY;
+			return _add_instruction(instruction, array->array);
+		}
+		case Expression::ENode::TYPE_DICTIONARY: {
+			const Expression::DictionaryNode *dictionary = static_cast<const Expression::DictionaryNode *>(p_node);
+			instruction.opcode = OPCODE_DICTIONARY;
+			return _add_instruction(instruction, dictionary->dict);
+		}
+		case Expression::ENode::TYPE_CONSTRUCTOR: {
+			const Expression::ConstructorNode *constructor = static_cast<const Expression::ConstructorNode *>(p_node);
+			instruction.opcode = OPCODE_CONSTRUCT;
+			instruction.type = constructor->data_type;
+			return _add_instruction(instruction, constructor->arguments);
+		}
+		case Expression::ENode::TYPE_BUILTIN_FUNC: {
+			const Expression::BuiltinFuncNode *bifunc = static_cast<const Expression::BuiltinFuncNode *>(p_node);
+			instruction.opcode = OPCODE_BUILTIN_FUNC;
+			instruction.name = bifunc->func;
+			return _add_instruction(instruction, bifunc->arguments);
+		}
+		case Expression::ENode::TYPE_CALL: {
+			const Expression::CallNode *call = static_cast<const Expression::CallNode *>(p_node);
+			instruction.opcode = OPCODE_CALL;
+			instruction.name = call->method;
+			instruction.a = _compile_node(call->base);
+			return _add_instruction(instruction, call->arguments);
+		}
+	}
+
+	ERR_FAIL_V(_add_constant(Variant()));
+}
+
+const Variant *Expression::_get_address(int p_address, const Variant *p_registers, const Variant *const *p_inputs) const {
+	const int index = p_address & ADDRESS_MASK;
+	switch (p_address >> ADDRESS_BITS) {
+		case ADDRESS_TYPE_REGISTER:
+			return &p_registers[index];
+		case ADDRESS_TYPE_CONSTANT:
+			return &constants[index];
+		default:
+			return p_inputs[index];
+	}
+}
+
+bool Expression::_execute_instruction(Instruction &p_instruction, const Variant *p_registers, const Variant *const *p_inputs, Object *p_instance, bool p_const_calls_only, const Variant **p_argptrs, Variant &r_ret, String &r_error_str) {
+	for (int i = 0; i < p_instruction.argument_count; i++) {
+		p_argptrs[i] = _get_address(code_arguments[p_instruction.arguments + i], p_registers, p_inputs);
+	}
+
+	switch (p_instruction.opcode) {
+		case OPCODE_OPERATOR: {
+			const Variant *a = _get_address(p_instruction.a, p_registers, p_inputs);
+			const Variant *b = _get_address(p_instruction.b, p_registers, p_inputs);
+			const Variant::Type type_a = a->get_type();
+			const Variant::Type type_b = b->get_type();
+
+			if (type_a == p_instruction.cached_type_a && type_b == p_instruction.cached_type_b) {
+				if (r_ret.get_type() != p_instruction.cached_return_type) {
+					VariantInternal::initialize(&r_ret, p_instruction.cached_return_type);
+				}
+				p_instruction.cached_evaluator(a, b, &r_ret);
+				break;
+			}
+
+			bool valid = true;
+			Variant::evaluate(p_instruction.op, *a, *b, r_ret, valid);
+			if (!valid) {
+				r_error_str = vformat(RTR("Invalid operands to operator %s, %s and %s."), Variant::get_operator_name(p_instruction.op), Variant::get_type_name(type_a), Variant::get_type_name(type_b));
+				return true;
+			}
+
+			// Validated evaluators don't check for integer division by zero, so those keep going through evaluate().
+			bool cacheable = type_a != Variant::OBJECT && type_b != Variant::OBJECT;
+			if (p_instruction.op == Variant::OP_DIVIDE || p_instruction.op == Variant::OP_MODULE) {
+				switch (type_a) {
+					case Variant::INT:
+					case Variant::VECTOR2I:
+					case Variant::VECTOR3I:
+					case Variant::VECTOR4I:
+						cacheable = false;
+						break;
+					default:
+						break;
+				}
+			}
+			if (cacheable) {
+				Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator(p_instruction.op, type_a, type_b);
+				Variant::Type return_type = Variant::get_operator_return_type(p_instruction.op, type_a, type_b);
+				if (evaluator && return_type != Variant::NIL) {
+					p_instruction.cached_type_a = type_a;
+					p_instruction.cached_type_b = type_b;
+					p_instruction.cached_return_type = return_type;
+					p_instruction.cached_evaluator = evaluator;
+				}
+			}
+		} break;
+		case OPCODE_INDEX: {
+			const Variant *base = _get_address(p_instruction.a, p_registers, p_inputs);
+			const Variant *idx = _get_address(p_instruction.b, p_registers, p_inputs);
+
+			bool valid;
+			r_ret = base->get(*idx, &valid);
+			if (!valid) {
+				r_error_str = vformat(RTR("Invalid index of type %s for base type %s"), Variant::get_type_name(idx->get_type()), Variant::get_type_name(base->get_type()));
+				return true;
+			}
+		} break;
+		case OPCODE_NAMED_INDEX: {
+			const Variant *base = _get_address(p_instruction.a, p_registers, p_inputs);
+
+			bool valid;
+			r_ret = base->get_named(p_instruction.name, valid);
+			if (!valid) {
+				r_error_str = vformat(RTR("Invalid named index '%s' for base type %s"), String(p_instruction.name), Variant::get_type_name(base->get_type()));
+				return true;
+			}
+		} break;
+		case OPCODE_SELF: {
+			if (!p_instance) {
+				r_error_str = RTR("self can't be used because instance is null (not passed)");
+				return true;
+			}
+			r_ret = p_instance;
+		} break;
+		case OPCODE_ARRAY: {
+			Array arr;
+			arr.resize(p_instruction.argument_count);
+			for (int i = 0; i < p_instruction.argument_count; i++) {
+				arr[i] = *p_argptrs[i];
+			}
+			r_ret = arr;
+		} break;
+		case OPCODE_DICTIONARY: {
+			Dictionary d;
+			for (int i = 0; i < p_instruction.argument_count; i += 2) {
+				d[*p_argptrs[i + 0]] = *p_argptrs[i + 1];
+			}
+			r_ret = d;
+		} break;
+		case OPCODE_CONSTRUCT: {
+			Callable::CallError ce;
+			Variant::construct(p_instruction.type, r_ret, p_argptrs, p_instruction.argument_count, ce);
+			if (ce.error != Callable::CallError::CALL_OK) {
+				r_error_str = vformat(RTR("Invalid arguments to construct '%s'"), Variant::get_type_name(p_instruction.type));
+				return true;
+			}
+		} break;
+		case OPCODE_BUILTIN_FUNC: {
+			r_ret = Variant(); //may not return anything
+			Callable::CallError ce;
+			Variant::call_utility_function(p_instruction.name, &r_ret, p_argptrs, p_instruction.argument_count, ce);
+			if (ce.error != Callable::CallError::CALL_OK) {
+				r_error_str = "Builtin call failed: " + Variant::get_call_error_text(p_instruction.name, p_argptrs, p_instruction.argument_count, ce);
+				return true;
+			}
+		} break;
+		case OPCODE_CALL: {
+			// Like the tree walker, call on a copy unless the base is a temporary.
+			Variant base_copy;
+			Variant *base;
+			if ((p_instruction.a >> ADDRESS_BITS) == ADDRESS_TYPE_REGISTER) {
+				base = const_cast<Variant *>(_get_address(p_instruction.a, p_registers, p_inputs));
+			} else {
+				base_copy = *_get_address(p_instruction.a, p_registers, p_inputs);
+				base = &base_copy;
+			}
+
+			Callable::CallError ce;
+			if (p_const_calls_only) {
+				base->call_const(p_instruction.name, p_argptrs, p_instruction.argument_count, r_ret, ce);
+			} else {
+				base->callp(p_instruction.name, p_argptrs, p_instruction.argument_count, r_ret, ce);
+			}
+
+			if (ce.error != Callable::CallError::CALL_OK) {
+				r_error_str = vformat(RTR("On call to '%s':"), String(p_instruction.name));
+				return true;
+			}
+		} break;
+	}
+	return false;
+}
+
+bool Expression::_execute_code(const Variant *const *p_inputs, int p_input_count, Object *p_instance, bool p_const_calls_only, Variant *p_registers, Variant &r_ret, String &r_error_str) {
+	if (unlikely(p_input_count < required_inputs)) {
+		for (int index : input_order) {
+			if (index >= p_input_count) {
+				r_error_str = vformat(RTR("Invalid input %d (not passed) in expression"), index);
+				return true;
+			}
+		}
+	}
+
+	const Variant **argptrs = (const Variant **)alloca(sizeof(Variant *) * MAX(max_arguments, 1));
+	for (uint32_t i = 0; i < code.size(); i++) {
+		if (_execute_instruction(code[i], p_registers, p_inputs, p_instance, p_const_calls_only, argptrs, p_registers[i], r_error_str)) {
+			return true;
+		}
+	}
+
+	r_ret = *_get_address(result_address, p_registers, p_inputs);
+	return false;
+}
+
+bool Expression::_run(const Array &p_inputs, Object *p_instance, bool p_const_calls_only, Variant *p_registers, Variant &r_ret, String &r_error_str) {
+	const int input_count = MIN(p_inputs.size(), required_inputs);
+	const Variant **input_ptrs = (const Variant **)alloca(sizeof(Variant *) * MAX(input_count, 1));
+
+	// Read-only arrays return every element through the same temporary, so they need copies.
+	LocalVector<Variant> input_copies;
+	if (p_inputs.is_read_only()) {
+		input_copies.resize(input_count);
+		for (int i = 0; i < input_count; i++) {
+			input_copies[i] = p_inputs[i];
+			input_ptrs[i] = &input_copies[i];
+		}
+	} else {
+		for (int i = 0; i < input_count; i++) {
+			input_ptrs[i] = &p_inputs[i];
+		}
+	}
+
+	return _execute_code(input_ptrs, p_inputs.size(), p_instance, p_const_calls_only, p_registers, r_ret, r_error_str);
+}
+
 Error Expression::parse(const String &p_expression, const Vector<String> &p_input_names) {
 	if (nodes) {
 		memdelete(nodes);
 		nodes = nullptr;
 		root = nullptr;
 	}
+	_clear_code();
 
 	error_str = String();
 	error_set = false;
@@ -1488,6 +1852,7 @@ Error Expression::parse(const String &p_expression, const Vector<String> &p_inpu
 		return ERR_INVALID_PARAMETER;
 	}
 
+	_compile_code();
 	return OK;
 }
 
@@ -1495,9 +1860,11 @@ Variant Expression::execute(const Array &p_inputs, Object *p_base, bool p_show_e
 	ERR_FAIL_COND_V_MSG(error_set, Variant(), vformat("There was previously a parse error: %s.", error_str));
 
 	execution_error = false;
+	LocalVector<Variant> registers;
+	registers.resize(code.size());
 	Variant output;
 	String error_txt;
-	bool err = _execute(p_inputs, p_base, root, output, p_const_calls_only, error_txt);
+	bool err = _run(p_inputs, p_base, p_const_calls_only, registers.ptr(), output, error_txt);
 	if (err) {
 		execution_error = true;
 		error_str = error_txt;
@@ -1507,6 +1874,35 @@ Variant Expression::execute(const Array &p_inputs, Object *p_base, bool p_show_e
 	return output;
 }
 
+Array Expression::execute_batch(const Array &p_inputs, Object *p_base, bool p_show_error, bool p_const_calls_only) {
+	ERR_FAIL_COND_V_MSG(error_set, Array(), vformat("There was previously a parse error: %s.", error_str));
+
+	execution_error = false;
+	// Registers are shared by all rows, so their types and the operator caches stay warm.
+	LocalVector<Variant> registers;
+	registers.resize(code.size());
+	Array results;
+	results.resize(p_inputs.size());
+	String error_txt;
+	for (int i = 0; i < p_inputs.size(); i++) {
+		const Variant &row = p_inputs[i];
+		bool err = row.get_type() != Variant::ARRAY;
+		if (err) {
+			error_txt = vformat(RTR("Inputs at index %d are not an Array."), i);
+		} else {
+			err = _run(*VariantInternal::get_array(&row), p_base, p_const_calls_only, registers.ptr(), results[i], error_txt);
+		}
+		if (err) {
+			execution_error = true;
+			error_str = error_txt;
+			ERR_FAIL_COND_V_MSG(p_show_error, Array(), error_str);
+			return Array();
+		}
+	}
+
+	return results;
+}
+
 bool Expression::has_execute_failed() const {
 	return execution_error;
 }
@@ -1515,9 +1911,25 @@ String Expression::get_error_text() const {
 	return error_str;
 }
 
+#ifdef TESTS_ENABLED
+Variant Expression::execute_tree(const Array &p_inputs, Object *p_base, bool p_const_calls_only) {
+	ERR_FAIL_COND_V_MSG(error_set, Variant(), vformat("There was previously a parse error: %s.", error_str));
+
+	execution_error = false;
+	Variant output;
+	String error_txt;
+	if (_execute(p_inputs, p_base, root, output, p_const_calls_only, error_txt)) {
+		execution_error = true;
+		error_str = error_txt;
+	}
+	return output;
+}
+#endif
+
 void Expression::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("parse", "expression", "input_names"), &Expression::parse, DEFVAL(Vector<String>()));
 	ClassDB::bind_method(D_METHOD("execute", "inputs", "base_instance", "show_error", "const_calls_only"), &Expression::execute, DEFVAL(Array()), DEFVAL(Variant()), DEFVAL(true), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("execute_batch", "inputs", "base_instance", "show_error", "const_calls_only"), &Expression::execute_batch, DEFVAL(Variant()), DEFVAL(true), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("has_execute_failed"), &Expression::has_execute_failed);
 	ClassDB::bind_method(D_METHOD("get_error_text"), &Expression::get_error_text);
 }
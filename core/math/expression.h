@@ -32,6 +32,7 @@
 #define EXPRESSION_H
 
 #include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
 
 class Expression : public RefCounted {
 	GDCLASS(Expression, RefCounted);
@@ -259,15 +260,79 @@ private:
 	bool execution_error = false;
 	bool _execute(const Array &p_inputs, Object *p_instance, Expression::ENode *p_node, Variant &r_ret, bool p_const_calls_only, String &r_error_str);
 
+	// The tree is compiled after parsing to a flat list of instructions, each writing to its own
+	// register. Operands are addresses of a register, a constant or an input.
+	enum Opcode {
+		OPCODE_OPERATOR,
+		OPCODE_INDEX,
+		OPCODE_NAMED_INDEX,
+		OPCODE_SELF,
+		OPCODE_ARRAY,
+		OPCODE_DICTIONARY,
+		OPCODE_CONSTRUCT,
+		OPCODE_BUILTIN_FUNC,
+		OPCODE_CALL,
+	};
+
+	enum {
+		ADDRESS_BITS = 24,
+		ADDRESS_MASK = (1 << ADDRESS_BITS) - 1,
+		ADDRESS_TYPE_REGISTER = 0,
+		ADDRESS_TYPE_CONSTANT = 1,
+		ADDRESS_TYPE_INPUT = 2,
+	};
+
+	struct Instruction {
+		Opcode opcode = OPCODE_OPERATOR;
+		int a = 0;
+		int b = 0;
+		int arguments = 0; // First address in `code_arguments`.
+		int argument_count = 0;
+		Variant::Operator op = Variant::OP_ADD;
+		Variant::Type type = Variant::NIL;
+		StringName name;
+
+		// Operator evaluator for the operand types seen last.
+		Variant::Type cached_type_a = Variant::VARIANT_MAX;
+		Variant::Type cached_type_b = Variant::VARIANT_MAX;
+		Variant::Type cached_return_type = Variant::NIL;
+		Variant::ValidatedOperatorEvaluator cached_evaluator = nullptr;
+	};
+
+	LocalVector<Instruction> code;
+	LocalVector<int> code_arguments;
+	LocalVector<Variant> constants;
+	LocalVector<int> input_order; // Inputs in evaluation order, to report the first missing one.
+	int required_inputs = 0;
+	int max_arguments = 0;
+	int result_address = 0;
+
+	static bool _is_shared_type(Variant::Type p_type);
+	void _clear_code();
+	void _compile_code();
+	int _compile_node(ENode *p_node);
+	int _add_constant(const Variant &p_value);
+	int _add_instruction(const Instruction &p_instruction, const Vector<ENode *> &p_arguments = Vector<ENode *>());
+	_FORCE_INLINE_ const Variant *_get_address(int p_address, const Variant *p_registers, const Variant *const *p_inputs) const;
+	bool _execute_instruction(Instruction &p_instruction, const Variant *p_registers, const Variant *const *p_inputs, Object *p_instance, bool p_const_calls_only, const Variant **p_argptrs, Variant &r_ret, String &r_error_str);
+	bool _execute_code(const Variant *const *p_inputs, int p_input_count, Object *p_instance, bool p_const_calls_only, Variant *p_registers, Variant &r_ret, String &r_error_str);
+	bool _run(const Array &p_inputs, Object *p_instance, bool p_const_calls_only, Variant *p_registers, Variant &r_ret, String &r_error_str);
+
 protected:
 	static void _bind_methods();
 
 public:
 	Error parse(const String &p_expression, const Vector<String> &p_input_names = Vector<String>());
 	Variant execute(const Array &p_inputs = Array(), Object *p_base = nullptr, bool p_show_error = true, bool p_const_calls_only = false);
+	Array execute_batch(const Array &p_inputs, Object *p_base = nullptr, bool p_show_error = true, bool p_const_calls_only = false);
 	bool has_execute_failed() const;
 	String get_error_text() const;
 
+#ifdef TESTS_ENABLED
+	// Evaluates by walking the syntax tree instead of running the compiled code, to compare both.
+	Variant execute_tree(const Array &p_inputs = Array(), Object *p_base = nullptr, bool p_const_calls_only = false);
+#endif
+
 	Expression() {}
 	~Expression();
 };
@@ -30,6 +30,7 @@
 
 #include "transform_3d.h"
 
+#include "core/math/bulk_math.h"
 #include "core/string/ustring.h"
 
 void Transform3D::affine_invert() {
@@ -169,6 +170,20 @@ Transform3D Transform3D::orthogonalized() const {
 	return _copy;
 }
 
+Vector<Vector3> Transform3D::xform(const Vector<Vector3> &p_array) const {
+	Vector<Vector3> array;
+	array.resize(p_array.size());
+	BulkMath::xform(*this, p_array.ptr(), array.ptrw(), p_array.size());
+	return array;
+}
+
+Vector<Vector3> Transform3D::xform_inv(const Vector<Vector3> &p_array) const {
+	Vector<Vector3> array;
+	array.resize(p_array.size());
+	BulkMath::xform_inv(*this, p_array.ptr(), array.ptrw(), p_array.size());
+	return array;
+}
+
 bool Transform3D::is_equal_approx(const Transform3D &p_transform) const {
 	return basis.is_equal_approx(p_transform.basis) && origin.is_equal_approx(p_transform.origin);
 }
@@ -82,14 +82,14 @@ struct [[nodiscard]] Transform3D {
 
 	_FORCE_INLINE_ Vector3 xform(const Vector3 &p_vector) const;
 	_FORCE_INLINE_ AABB xform(const AABB &p_aabb) const;
-	_FORCE_INLINE_ Vector<Vector3> xform(const Vector<Vector3> &p_array) const;
+	Vector<Vector3> xform(const Vector<Vector3> &p_array) const;
 
 	// NOTE: These are UNSAFE with non-uniform scaling, and will produce incorrect results.
 	// They use the transpose.
 	// For safe inverse transforms, xform by the affine_inverse.
 	_FORCE_INLINE_ Vector3 xform_inv(const Vector3 &p_vector) const;
 	_FORCE_INLINE_ AABB xform_inv(const AABB &p_aabb) const;
-	_FORCE_INLINE_ Vector<Vector3> xform_inv(const Vector<Vector3> &p_array) const;
+	Vector<Vector3> xform_inv(const Vector<Vector3> &p_array) const;
 
 	// Safe with non-uniform scaling (uses affine_inverse).
 	_FORCE_INLINE_ Plane xform(const Plane &p_plane) const;
@@ -211,32 +211,6 @@ _FORCE_INLINE_ AABB Transform3D::xform_inv(const AABB &p_aabb) const {
 	return ret;
 }
 
-Vector<Vector3> Transform3D::xform(const Vector<Vector3> &p_array) const {
-	Vector<Vector3> array;
-	array.resize(p_array.size());
-
-	const Vector3 *r = p_array.ptr();
-	Vector3 *w = array.ptrw();
-
-	for (int i = 0; i < p_array.size(); ++i) {
-		w[i] = xform(r[i]);
-	}
-	return array;
-}
-
-Vector<Vector3> Transform3D::xform_inv(const Vector<Vector3> &p_array) const {
-	Vector<Vector3> array;
-	array.resize(p_array.size());
-
-	const Vector3 *r = p_array.ptr();
-	Vector3 *w = array.ptrw();
-
-	for (int i = 0; i < p_array.size(); ++i) {
-		w[i] = xform_inv(r[i]);
-	}
-	return array;
-}
-
 _FORCE_INLINE_ Plane Transform3D::xform_fast(const Plane &p_plane, const Basis &p_basis_inverse_transpose) const {
 	// Transform a single point on the plane.
 	Vector3 point = p_plane.normal * p_plane.d;
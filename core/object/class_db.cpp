@@ -36,7 +36,10 @@
 #include "core/version.h"
 
 #define OBJTYPE_RLOCK RWLockRead _rw_lockr_(lock);
-#define OBJTYPE_WLOCK RWLockWrite _rw_lockw_(lock);
+// Every write may change what a class name resolves to, see get_revision().
+#define OBJTYPE_WLOCK            \
+	RWLockWrite _rw_lockw_(lock); \
+	revision.increment();
 
 #ifdef DEBUG_METHODS_ENABLED
 
@@ -65,6 +68,7 @@ ClassDB::APIType ClassDB::get_current_api() {
 }
 
 HashMap<StringName, ClassDB::ClassInfo> ClassDB::classes;
+SafeNumeric<uint32_t> ClassDB::revision;
 HashMap<StringName, StringName> ClassDB::resource_base_extensions;
 HashMap<StringName, StringName> ClassDB::compat_classes;
 
@@ -538,6 +542,7 @@ StringName ClassDB::get_compatibility_class(const StringName &p_class) {
 
 Object *ClassDB::_instantiate_internal(const StringName &p_class, bool p_require_real_class, bool p_notify_postinitialize) {
 	ClassInfo *ti;
+	ObjectPool *pool = nullptr;
 	{
 		OBJTYPE_RLOCK;
 		ti = classes.getptr(p_class);
@@ -549,6 +554,7 @@ Object *ClassDB::_instantiate_internal(const StringName &p_class, bool p_require
 		ERR_FAIL_NULL_V_MSG(ti, nullptr, vformat("Cannot get class '%s'.", String(p_class)));
 		ERR_FAIL_COND_V_MSG(ti->disabled, nullptr, vformat("Class '%s' is disabled.", String(p_class)));
 		ERR_FAIL_NULL_V_MSG(ti->creation_func, nullptr, vformat("Class '%s' or its base class cannot be instantiated.", String(p_class)));
+		pool = ti->pooled ? ti->pool : nullptr;
 	}
 
 #ifdef TOOLS_ENABLED
@@ -594,7 +600,9 @@ Object *ClassDB::_instantiate_internal(const StringName &p_class, bool p_require
 		return (Object *)extension->create_instance(extension->class_userdata);
 	}
 #endif // DISABLE_DEPRECATED
-	else {
+	else if (pool) {
+		return ti->pooled_creation_func(pool, p_notify_postinitialize);
+	} else {
 		return ti->creation_func(p_notify_postinitialize);
 	}
 }
@@ -1778,6 +1786,52 @@ StringName ClassDB::get_property_getter(const StringName &p_class, const StringN
 	return StringName();
 }
 
+MethodBind *ClassDB::get_property_accessor(const StringName &p_class, const StringName &p_property, bool p_setter, int *r_index) {
+	OBJTYPE_RLOCK;
+
+	ClassInfo *type = classes.getptr(p_class);
+	if (type && type->gdextension && (p_setter ? type->gdextension->set != nullptr : type->gdextension->get != nullptr)) {
+		// Object::set() and Object::get() ask the extension first.
+		return nullptr;
+	}
+
+	ClassInfo *check = type;
+	while (check) {
+		const PropertySetGet *psg = check->property_setget.getptr(p_property);
+		if (psg) {
+			if (r_index) {
+				*r_index = psg->index;
+			}
+			if (p_setter) {
+				return psg->setter ? psg->_setptr : nullptr;
+			}
+			if (!psg->getter) {
+				return nullptr;
+			}
+			if (psg->index < 0) {
+				return psg->_getptr;
+			}
+			// Indexed getters are called by name, so they resolve like Object::callp() does.
+			for (ClassInfo *method_type = type; method_type; method_type = method_type->inherits_ptr) {
+				MethodBind **method = method_type->method_map.getptr(psg->getter);
+				if (method && *method) {
+					return *method;
+				}
+			}
+			return nullptr;
+		}
+
+		if (!p_setter && (check->constant_map.has(p_property) || check->method_map.has(p_property) || check->signal_map.has(p_property))) {
+			// Shadowed for get_property().
+			return nullptr;
+		}
+
+		check = check->inherits_ptr;
+	}
+
+	return nullptr;
+}
+
 bool ClassDB::has_property(const StringName &p_class, const StringName &p_property, bool p_no_inheritance) {
 	ClassInfo *type = classes.getptr(p_class);
 	ClassInfo *check = type;
@@ -2079,6 +2133,41 @@ bool ClassDB::is_class_enabled(const StringName &p_class) {
 	return !ti->disabled;
 }
 
+void ClassDB::set_class_pooled(const StringName &p_class, bool p_pooled) {
+	OBJTYPE_WLOCK;
+
+	ClassInfo *ti = classes.getptr(p_class);
+	ERR_FAIL_NULL_MSG(ti, vformat("Request for nonexistent class '%s'.", p_class));
+	ERR_FAIL_COND_MSG(p_pooled && (!ti->pooled_creation_func || ti->gdextension), vformat("Class '%s' can't be pooled.", p_class));
+
+	if (p_pooled && !ti->pool) {
+		ti->pool = memnew(ObjectPool(ti->instance_size));
+	}
+	ti->pooled = p_pooled;
+}
+
+bool ClassDB::is_class_pooled(const StringName &p_class) {
+	OBJTYPE_RLOCK;
+
+	ClassInfo *ti = classes.getptr(p_class);
+	ERR_FAIL_NULL_V_MSG(ti, false, vformat("Cannot get class '%s'.", String(p_class)));
+	return ti->pooled;
+}
+
+ClassDB::PoolCounters ClassDB::get_class_pool_counters(const StringName &p_class) {
+	OBJTYPE_RLOCK;
+
+	PoolCounters counters;
+	ClassInfo *ti = classes.getptr(p_class);
+	ERR_FAIL_NULL_V_MSG(ti, counters, vformat("Cannot get class '%s'.", String(p_class)));
+	if (ti->pool) {
+		counters.live = ti->pool->get_live_count();
+		counters.pooled = ti->pool->get_pooled_count();
+		counters.peak = ti->pool->get_peak_live_count();
+	}
+	return counters;
+}
+
 bool ClassDB::is_class_exposed(const StringName &p_class) {
 	OBJTYPE_RLOCK;
 
@@ -2208,6 +2297,7 @@ Variant ClassDB::class_get_default_property_value(const StringName &p_class, con
 
 void ClassDB::register_extension_class(ObjectGDExtension *p_extension) {
 	GLOBAL_LOCK_FUNCTION;
+	revision.increment();
 
 	ERR_FAIL_COND_MSG(classes.has(p_extension->class_name), vformat("Class already registered: '%s'.", String(p_extension->class_name)));
 	ERR_FAIL_COND_MSG(!classes.has(p_extension->parent_class_name), vformat("Parent class name for extension class not found: '%s'.", String(p_extension->parent_class_name)));
@@ -2257,6 +2347,7 @@ void ClassDB::register_extension_class(ObjectGDExtension *p_extension) {
 void ClassDB::unregister_extension_class(const StringName &p_class, bool p_free_method_binds) {
 	ClassInfo *c = classes.getptr(p_class);
 	ERR_FAIL_NULL_MSG(c, vformat("Class '%s' does not exist.", String(p_class)));
+	revision.increment();
 	if (p_free_method_binds) {
 		for (KeyValue<StringName, MethodBind *> &F : c->method_map) {
 			memdelete(F.value);
@@ -2315,6 +2406,10 @@ void ClassDB::cleanup() {
 				memdelete(F.value[i]);
 			}
 		}
+		// Leaked instances still point to their pool, which is kept then.
+		if (ti.pool && ti.pool->get_live_count() == 0) {
+			memdelete(ti.pool);
+		}
 	}
 
 	classes.clear();
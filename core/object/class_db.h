@@ -33,6 +33,7 @@
 
 #include "core/object/method_bind.h"
 #include "core/object/object.h"
+#include "core/object/object_pool.h"
 #include "core/string/print_string.h"
 
 // Makes callable_mp readily available in all classes connecting signals.
@@ -137,6 +138,12 @@ public:
 		bool is_runtime = false;
 		// The bool argument indicates the need to postinitialize.
 		Object *(*creation_func)(bool) = nullptr;
+		// Same as creation_func, with the instance allocated from a pool. Only set for classes that can be pooled.
+		Object *(*pooled_creation_func)(ObjectPool *, bool) = nullptr;
+		uint32_t instance_size = 0;
+		// Kept once created, as pooled instances give their memory back to it when freed.
+		ObjectPool *pool = nullptr;
+		bool pooled = false;
 
 		ClassInfo() {}
 		~ClassInfo() {}
@@ -152,8 +159,24 @@ public:
 		return ret;
 	}
 
+	template <typename T>
+	static Object *pooled_creator(ObjectPool *p_pool, bool p_notify_postinitialize) {
+		void *slot = p_pool->alloc();
+		ERR_FAIL_NULL_V(slot, nullptr);
+		Object *ret = ::new (slot) T;
+		// Freeing gives the Object pointer back to the pool.
+		DEV_ASSERT((void *)ret == slot);
+		ret->_pool = p_pool;
+		ret->_initialize();
+		if (p_notify_postinitialize) {
+			ret->_postinitialize();
+		}
+		return ret;
+	}
+
 	static RWLock lock;
 	static HashMap<StringName, ClassInfo> classes;
+	static SafeNumeric<uint32_t> revision;
 	static HashMap<StringName, StringName> resource_base_extensions;
 	static HashMap<StringName, StringName> compat_classes;
 
@@ -212,6 +235,8 @@ public:
 		ClassInfo *t = classes.getptr(T::get_class_static());
 		ERR_FAIL_NULL(t);
 		t->creation_func = &creator<T>;
+		t->pooled_creation_func = &pooled_creator<T>;
+		t->instance_size = sizeof(T);
 		t->exposed = true;
 		t->is_virtual = p_virtual;
 		t->class_ptr = T::get_class_ptr_static();
@@ -240,6 +265,8 @@ public:
 		ClassInfo *t = classes.getptr(T::get_class_static());
 		ERR_FAIL_NULL(t);
 		t->creation_func = &creator<T>;
+		t->pooled_creation_func = &pooled_creator<T>;
+		t->instance_size = sizeof(T);
 		t->exposed = false;
 		t->is_virtual = false;
 		t->class_ptr = T::get_class_ptr_static();
@@ -256,6 +283,8 @@ public:
 		ERR_FAIL_NULL(t);
 		ERR_FAIL_COND_MSG(t->inherits_ptr && !t->inherits_ptr->creation_func, vformat("Cannot register runtime class '%s' that descends from an abstract parent class.", T::get_class_static()));
 		t->creation_func = &creator<T>;
+		t->pooled_creation_func = &pooled_creator<T>;
+		t->instance_size = sizeof(T);
 		t->exposed = true;
 		t->is_virtual = false;
 		t->is_runtime = true;
@@ -439,6 +468,12 @@ public:
 	static Variant::Type get_property_type(const StringName &p_class, const StringName &p_property, bool *r_is_valid = nullptr);
 	static StringName get_property_setter(const StringName &p_class, const StringName &p_property);
 	static StringName get_property_getter(const StringName &p_class, const StringName &p_property);
+	// Method set_property() or get_property() calls for `p_property` on objects of `p_class`, or nullptr when
+	// the access doesn't end in a method call (read-only, extension callbacks, constants, signals...).
+	static MethodBind *get_property_accessor(const StringName &p_class, const StringName &p_property, bool p_setter, int *r_index = nullptr);
+	// Changes whenever classes, methods or properties are registered or removed, so anything cached from
+	// lookups by name can tell it's stale.
+	static uint32_t get_revision() { return revision.get(); }
 
 	static bool has_method(const StringName &p_class, const StringName &p_method, bool p_no_inheritance = false);
 	static void set_method_flags(const StringName &p_class, const StringName &p_method, int p_flags);
@@ -474,6 +509,17 @@ public:
 	static void set_class_enabled(const StringName &p_class, bool p_enable);
 	static bool is_class_enabled(const StringName &p_class);
 
+	struct PoolCounters {
+		uint32_t live = 0;
+		uint32_t pooled = 0;
+		uint32_t peak = 0;
+	};
+
+	// Instances created through ClassDB are allocated from a per-class pool while enabled.
+	static void set_class_pooled(const StringName &p_class, bool p_pooled);
+	static bool is_class_pooled(const StringName &p_class);
+	static PoolCounters get_class_pool_counters(const StringName &p_class);
+
 	static bool is_class_exposed(const StringName &p_class);
 	static bool is_class_reloadable(const StringName &p_class);
 	static bool is_class_runtime(const StringName &p_class);
@@ -33,38 +33,106 @@
 #include "core/config/project_settings.h"
 #include "core/object/class_db.h"
 #include "core/object/script_language.h"
+#include "core/os/os.h"
 
 #include <stdio.h>
 
 #ifdef DEV_ENABLED
-// Includes safety checks to ensure that a queue set as a thread singleton override
-// is only ever called from the thread it was set for.
-#define LOCK_MUTEX                                \
-	if (this != MessageQueue::thread_singleton) { \
-		DEV_ASSERT(!is_current_thread_override);  \
-		mutex.lock();                             \
-	} else {                                      \
-		DEV_ASSERT(is_current_thread_override);   \
-	}
+// Ensures that a queue set as a thread singleton override
+// is only ever pushed to from the thread it was set for.
+#define CHECK_THREAD_OVERRIDE DEV_ASSERT((this == MessageQueue::thread_singleton) == is_current_thread_override)
 #else
-#define LOCK_MUTEX                                \
-	if (this != MessageQueue::thread_singleton) { \
-		mutex.lock();                             \
-	}
+#define CHECK_THREAD_OVERRIDE
 #endif
 
-#define UNLOCK_MUTEX                              \
-	if (this != MessageQueue::thread_singleton) { \
-		mutex.unlock();                           \
+SAFE_NUMERIC_TYPE_PUN_GUARANTEES(uint32_t)
+
+void CallQueue::_lock_counting_contention() {
+	if (!mutex.try_lock()) {
+		stat_lock_contentions.increment();
+		mutex.lock();
+	}
+}
+
+void CallQueue::_allocate_page(uint32_t p_page) {
+	PageSlot *&chunk = page_chunks[p_page / PAGES_PER_CHUNK];
+	if (!chunk) {
+		chunk = memnew_arr(PageSlot, PAGES_PER_CHUNK);
 	}
 
-void CallQueue::_add_page() {
-	if (pages_used == page_bytes.size()) {
-		pages.push_back(allocator->alloc());
-		page_bytes.push_back(0);
+	PageSlot &slot = chunk[p_page % PAGES_PER_CHUNK];
+	if (!slot.page) {
+		slot.page = allocator->alloc();
+		// Ready flags are read before their messages are written, so they must start cleared.
+		// Consumed messages are zeroed back, so this is only needed once.
+		memset(slot.page->data, 0, PAGE_SIZE_BYTES);
+		pages_allocated++;
 	}
-	page_bytes[pages_used] = 0;
-	pages_used++;
+	slot.end.set(PAGE_END_UNKNOWN);
+}
+
+uint8_t *CallQueue::_reserve(uint32_t p_room_needed) {
+	if (unlikely(!first_page_allocated.is_set())) {
+		_lock_counting_contention();
+		if (!first_page_allocated.is_set()) {
+			_allocate_page(0);
+			first_page_allocated.set();
+		}
+		mutex.unlock();
+	}
+
+	while (true) {
+		uint64_t prev_tail = tail.load(std::memory_order_acquire);
+		if (unlikely((uint32_t)(prev_tail >> 32) == max_pages - 1 && (uint32_t)prev_tail + p_room_needed > uint32_t(PAGE_SIZE_BYTES))) {
+			// Out of pages. Bail out before reserving, so failed attempts don't keep growing the offset.
+			stat_out_of_memory.increment();
+			return nullptr;
+		}
+
+		uint64_t reserved = tail.fetch_add(p_room_needed, std::memory_order_acq_rel);
+		uint32_t page = reserved >> 32;
+		uint32_t offset = (uint32_t)reserved;
+
+		if (likely(offset + p_room_needed <= uint32_t(PAGE_SIZE_BYTES))) {
+			return &_get_page_slot(page).page->data[offset];
+		}
+
+		if (offset <= uint32_t(PAGE_SIZE_BYTES)) {
+			// This is the first reservation not fitting in the page, so the page's data ends here.
+			// Any later one starts past the end of the page.
+			_get_page_slot(page).end.set(offset);
+		}
+
+		if (_advance_page(page) != OK) {
+			stat_out_of_memory.increment();
+			return nullptr;
+		}
+	}
+}
+
+Error CallQueue::_advance_page(uint32_t p_full_page) {
+	_lock_counting_contention();
+	stat_page_switches.increment();
+
+	if ((uint32_t)(tail.load(std::memory_order_acquire) >> 32) != p_full_page) {
+		// Another thread got here first, or the queue was flushed meanwhile. Just retry.
+		stat_page_switch_collisions.increment();
+		mutex.unlock();
+		return OK;
+	}
+
+	uint32_t next_page = p_full_page + 1;
+	if (next_page == max_pages) {
+		mutex.unlock();
+		return ERR_OUT_OF_MEMORY;
+	}
+
+	_allocate_page(next_page);
+	// Every reservation made since the page got full has failed, so nothing valid is lost by overwriting.
+	tail.store((uint64_t)next_page << 32, std::memory_order_release);
+
+	mutex.unlock();
+	return OK;
 }
 
 Error CallQueue::push_callp(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
@@ -88,25 +156,16 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 
 	ERR_FAIL_COND_V_MSG(room_needed > uint32_t(PAGE_SIZE_BYTES), ERR_INVALID_PARAMETER, "Message is too large to fit on a page (" + itos(PAGE_SIZE_BYTES) + " bytes), consider passing less arguments.");
 
-	LOCK_MUTEX;
+	CHECK_THREAD_OVERRIDE;
 
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
-		}
-		_add_page();
+	uint8_t *buffer_end = _reserve(room_needed);
+	if (unlikely(!buffer_end)) {
+		fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
-	Message *msg = memnew_placement(buffer_end, Message);
+	Message *msg = _construct_message(buffer_end);
 	msg->args = p_argcount;
 	msg->callable = p_callable;
 	msg->type = TYPE_CALL;
@@ -126,38 +185,27 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 		*v = *p_args[i];
 	}
 
-	page_bytes[pages_used - 1] += room_needed;
-
-	UNLOCK_MUTEX;
+	msg->ready.store(1, std::memory_order_release);
 
 	return OK;
 }
 
 Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
-	LOCK_MUTEX;
+	CHECK_THREAD_OVERRIDE;
 	uint32_t room_needed = sizeof(Message) + sizeof(Variant);
 
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			String type;
-			if (ObjectDB::get_instance(p_id)) {
-				type = ObjectDB::get_instance(p_id)->get_class();
-			}
-			fprintf(stderr, "Failed set: %s: %s target ID: %s. Message queue out of memory. %s\n", type.utf8().get_data(), String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
+	uint8_t *buffer_end = _reserve(room_needed);
+	if (unlikely(!buffer_end)) {
+		String type;
+		if (ObjectDB::get_instance(p_id)) {
+			type = ObjectDB::get_instance(p_id)->get_class();
 		}
-		_add_page();
+		fprintf(stderr, "Failed set: %s: %s target ID: %s. Message queue out of memory. %s\n", type.utf8().get_data(), String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
-	Message *msg = memnew_placement(buffer_end, Message);
+	Message *msg = _construct_message(buffer_end);
 	msg->args = 1;
 	msg->callable = Callable(p_id, p_prop);
 	msg->type = TYPE_SET;
@@ -167,41 +215,31 @@ Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant
 	Variant *v = memnew_placement(buffer_end, Variant);
 	*v = p_value;
 
-	page_bytes[pages_used - 1] += room_needed;
-	UNLOCK_MUTEX;
+	msg->ready.store(1, std::memory_order_release);
 
 	return OK;
 }
 
 Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
-	LOCK_MUTEX;
+	CHECK_THREAD_OVERRIDE;
 	uint32_t room_needed = sizeof(Message);
 
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			fprintf(stderr, "Failed notification: %d target ID: %s. Message queue out of memory. %s\n", p_notification, itos(p_id).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
-		}
-		_add_page();
+	uint8_t *buffer_end = _reserve(room_needed);
+	if (unlikely(!buffer_end)) {
+		fprintf(stderr, "Failed notification: %d target ID: %s. Message queue out of memory. %s\n", p_notification, itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
-	Message *msg = memnew_placement(buffer_end, Message);
+	Message *msg = _construct_message(buffer_end);
 
 	msg->type = TYPE_NOTIFICATION;
 	msg->callable = Callable(p_id, CoreStringName(notification)); //name is meaningless but callable needs it
 	//msg->target;
 	msg->notification = p_notification;
 
-	page_bytes[pages_used - 1] += room_needed;
-	UNLOCK_MUTEX;
+	msg->ready.store(1, std::memory_order_release);
 
 	return OK;
 }
@@ -223,62 +261,112 @@ void CallQueue::_call_function(const Callable &p_callable, const Variant *p_args
 	}
 }
 
-Error CallQueue::flush() {
-	LOCK_MUTEX;
+// Returns the message at the given position once it's committed, or null if there are no more messages.
+// In that case, r_tail is set to the tail that was found to match the position.
+CallQueue::Message *CallQueue::_get_next_message(uint32_t &r_page, uint32_t &r_offset, uint64_t &r_tail) {
+	while (true) {
+		uint64_t curr_tail = tail.load(std::memory_order_acquire);
+		uint32_t tail_page = curr_tail >> 32;
+		uint32_t tail_offset = (uint32_t)curr_tail;
+
+		PageSlot &slot = _get_page_slot(r_page);
+		uint32_t page_end = slot.end.get();
+
+		if (r_offset == page_end) {
+			// Consumed the whole page.
+			if (tail_page > r_page) {
+				r_page++;
+				r_offset = 0;
+				continue;
+			}
+			if (r_page == max_pages - 1) {
+				// Out of pages, so this is as far as it goes.
+				r_tail = curr_tail;
+				return nullptr;
+			}
+			// The page switch is in progress.
+			stat_writer_waits.increment();
+			OS::get_singleton()->yield();
+			continue;
+		}
 
-	if (pages.size() == 0) {
-		// Never allocated
-		UNLOCK_MUTEX;
-		return OK; // Do nothing.
-	}
+		if (tail_page == r_page && tail_offset == r_offset) {
+			r_tail = curr_tail;
+			return nullptr;
+		}
 
-	if (flushing) {
-		UNLOCK_MUTEX;
-		return ERR_BUSY;
+		// Some message has been reserved here, or the page has just got full but its end hasn't been set yet.
+		if (r_offset + sizeof(Message) <= uint32_t(PAGE_SIZE_BYTES)) {
+			Message *message = (Message *)&slot.page->data[r_offset];
+			if (message->ready.load(std::memory_order_acquire)) {
+				return message;
+			}
+		}
+
+		// Wait for the pushing thread to finish writing.
+		stat_writer_waits.increment();
+		OS::get_singleton()->yield();
 	}
+}
 
-	flushing = true;
+// Rewinds the queue to the beginning, unless some message was reserved after the given tail.
+bool CallQueue::_try_reset(uint32_t p_page, uint64_t p_tail) {
+	_lock_counting_contention();
 
-	uint32_t i = 0;
-	uint32_t offset = 0;
+	stat_peak_pages_used = MAX(stat_peak_pages_used, p_page + 1);
 
-	while (i < pages_used && offset < page_bytes[i]) {
-		Page *page = pages[i];
+	if (p_page != 0) {
+		// No one can be pushing to the first page now, so it can be reopened.
+		_get_page_slot(0).end.set(PAGE_END_UNKNOWN);
+	}
+	bool reset = tail.compare_exchange_strong(p_tail, 0, std::memory_order_acq_rel);
 
-		//lock on each iteration, so a call can re-add itself to the message queue
+	mutex.unlock();
+	return reset;
+}
 
-		Message *message = (Message *)&page->data[offset];
+void CallQueue::_drain(bool p_call) {
+	uint32_t page = 0;
+	uint32_t offset = 0;
 
-		uint32_t advance = sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			advance += sizeof(Variant) * message->args;
+	while (true) {
+		uint64_t last_tail = 0;
+		Message *message = _get_next_message(page, offset, last_tail);
+		if (!message) {
+			if (_try_reset(page, last_tail)) {
+				break;
+			}
+			// More messages were pushed meanwhile.
+			continue;
 		}
 
+		uint32_t advance = _get_message_size(message);
+
 		//pre-advance so this function is reentrant
 		offset += advance;
 
-		Object *target = message->callable.get_object();
-
-		UNLOCK_MUTEX;
-
-		switch (message->type & FLAG_MASK) {
-			case TYPE_CALL: {
-				if (target || (message->type & FLAG_NULL_IS_OK)) {
-					Variant *args = (Variant *)(message + 1);
-					_call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
-				}
-			} break;
-			case TYPE_NOTIFICATION: {
-				if (target) {
-					target->notification(message->notification);
-				}
-			} break;
-			case TYPE_SET: {
-				if (target) {
-					Variant *arg = (Variant *)(message + 1);
-					target->set(message->callable.get_method(), *arg);
-				}
-			} break;
+		if (p_call) {
+			Object *target = message->callable.get_object();
+
+			switch (message->type & FLAG_MASK) {
+				case TYPE_CALL: {
+					if (target || (message->type & FLAG_NULL_IS_OK)) {
+						Variant *args = (Variant *)(message + 1);
+						_call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
+					}
+				} break;
+				case TYPE_NOTIFICATION: {
+					if (target) {
+						target->notification(message->notification);
+					}
+				} break;
+				case TYPE_SET: {
+					if (target) {
+						Variant *arg = (Variant *)(message + 1);
+						target->set(message->callable.get_method(), *arg);
+					}
+				} break;
+			}
 		}
 
 		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
@@ -288,85 +376,75 @@ Error CallQueue::flush() {
 			}
 		}
 
-		message->~Message();
+		message->callable.~Callable();
 
-		LOCK_MUTEX;
-		if (offset == page_bytes[i]) {
-			i++;
-			offset = 0;
-		}
+		// Leave the room as it was found, so ready flags of messages reserved here later start cleared.
+		memset((void *)message, 0, advance);
 	}
-
-	page_bytes[0] = 0;
-	pages_used = 1;
-
-	flushing = false;
-	UNLOCK_MUTEX;
-	return OK;
 }
 
-void CallQueue::clear() {
-	LOCK_MUTEX;
+Error CallQueue::flush() {
+	mutex.lock();
 
-	if (pages.size() == 0) {
-		UNLOCK_MUTEX;
-		return; // Nothing to clear.
+	if (!first_page_allocated.is_set()) {
+		// Never allocated
+		mutex.unlock();
+		return OK; // Do nothing.
 	}
 
-	for (uint32_t i = 0; i < pages_used; i++) {
-		uint32_t offset = 0;
-		while (offset < page_bytes[i]) {
-			Page *page = pages[i];
-
-			//lock on each iteration, so a call can re-add itself to the message queue
+	if (flushing.is_set()) {
+		mutex.unlock();
+		return ERR_BUSY;
+	}
 
-			Message *message = (Message *)&page->data[offset];
+	flushing.set();
+	mutex.unlock();
 
-			uint32_t advance = sizeof(Message);
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				advance += sizeof(Variant) * message->args;
-			}
+	_drain(true);
 
-			offset += advance;
+	flushing.clear();
+	return OK;
+}
 
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				Variant *args = (Variant *)(message + 1);
-				for (int k = 0; k < message->args; k++) {
-					args[k].~Variant();
-				}
-			}
+void CallQueue::clear() {
+	mutex.lock();
 
-			message->~Message();
-		}
+	if (!first_page_allocated.is_set() || flushing.is_set()) {
+		// Nothing to clear, or the messages are already being consumed.
+		mutex.unlock();
+		return;
 	}
 
-	pages_used = 1;
-	page_bytes[0] = 0;
+	flushing.set();
+	mutex.unlock();
+
+	_drain(false);
 
-	UNLOCK_MUTEX;
+	flushing.clear();
 }
 
 void CallQueue::statistics() {
-	LOCK_MUTEX;
+	mutex.lock();
+	// Messages can only be inspected if no other thread is consuming them.
+	bool can_inspect = first_page_allocated.is_set() && !flushing.is_set();
+	if (can_inspect) {
+		flushing.set();
+	}
+	uint32_t allocated = pages_allocated;
+	mutex.unlock();
+
 	HashMap<StringName, int> set_count;
 	HashMap<int, int> notify_count;
 	HashMap<Callable, int> call_count;
 	int null_count = 0;
+	uint32_t pages_used = 0;
 
-	for (uint32_t i = 0; i < pages_used; i++) {
+	if (can_inspect) {
+		uint32_t page = 0;
 		uint32_t offset = 0;
-		while (offset < page_bytes[i]) {
-			Page *page = pages[i];
-
-			//lock on each iteration, so a call can re-add itself to the message queue
-
-			Message *message = (Message *)&page->data[offset];
-
-			uint32_t advance = sizeof(Message);
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				advance += sizeof(Variant) * message->args;
-			}
+		uint64_t last_tail = 0;
 
+		while (Message *message = _get_next_message(page, offset, last_tail)) {
 			Object *target = message->callable.get_object();
 
 			bool null_target = true;
@@ -410,20 +488,19 @@ void CallQueue::statistics() {
 				null_count++;
 			}
 
-			offset += advance;
-
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				Variant *args = (Variant *)(message + 1);
-				for (int k = 0; k < message->args; k++) {
-					args[k].~Variant();
-				}
-			}
-
-			message->~Message();
+			offset += _get_message_size(message);
 		}
+
+		pages_used = page + 1;
+		flushing.clear();
 	}
 
 	fprintf(stdout, "TOTAL PAGES: %d (%d bytes).\n", pages_used, pages_used * PAGE_SIZE_BYTES);
+	fprintf(stdout, "ALLOCATED PAGES: %d (%d bytes), peak used: %d.\n", allocated, allocated * PAGE_SIZE_BYTES, stat_peak_pages_used);
+	fprintf(stdout, "PAGE SWITCHES: %d (%d collided).\n", stat_page_switches.get(), stat_page_switch_collisions.get());
+	fprintf(stdout, "LOCK CONTENTIONS: %d.\n", stat_lock_contentions.get());
+	fprintf(stdout, "WAITS FOR WRITERS: %d.\n", stat_writer_waits.get());
+	fprintf(stdout, "OUT OF MEMORY: %d.\n", stat_out_of_memory.get());
 	fprintf(stdout, "NULL count: %d.\n", null_count);
 
 	for (const KeyValue<StringName, int> &E : set_count) {
@@ -437,27 +514,18 @@ void CallQueue::statistics() {
 	for (const KeyValue<int, int> &E : notify_count) {
 		fprintf(stdout, "NOTIFY %d: %d.\n", E.key, E.value);
 	}
-
-	UNLOCK_MUTEX;
 }
 
 bool CallQueue::is_flushing() const {
-	return flushing;
+	return flushing.is_set();
 }
 
 bool CallQueue::has_messages() const {
-	if (pages_used == 0) {
-		return false;
-	}
-	if (pages_used == 1 && page_bytes[0] == 0) {
-		return false;
-	}
-
-	return true;
+	return tail.load(std::memory_order_acquire) != 0;
 }
 
 int CallQueue::get_max_buffer_usage() const {
-	return pages.size() * PAGE_SIZE_BYTES;
+	return pages_allocated * PAGE_SIZE_BYTES;
 }
 
 CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const String &p_error_text) {
@@ -468,15 +536,28 @@ CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const
 		allocator = memnew(Allocator(16)); // 16 elements per allocator page, 64kb per allocator page. Anything small will do, though.
 		allocator_is_custom = false;
 	}
-	max_pages = p_max_pages;
+	max_pages = MAX(p_max_pages, 2u); // Page switching logic relies on having more than one.
 	error_text = p_error_text;
+
+	page_chunks.resize((max_pages + PAGES_PER_CHUNK - 1) / PAGES_PER_CHUNK);
+	for (PageSlot *&chunk : page_chunks) {
+		chunk = nullptr;
+	}
 }
 
 CallQueue::~CallQueue() {
 	clear();
 	// Let go of pages.
-	for (uint32_t i = 0; i < pages.size(); i++) {
-		allocator->free(pages[i]);
+	for (PageSlot *chunk : page_chunks) {
+		if (!chunk) {
+			continue;
+		}
+		for (uint32_t i = 0; i < PAGES_PER_CHUNK; i++) {
+			if (chunk[i].page) {
+				allocator->free(chunk[i].page);
+			}
+		}
+		memdelete_arr(chunk);
 	}
 	if (!allocator_is_custom) {
 		memdelete(allocator);
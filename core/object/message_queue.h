@@ -35,6 +35,7 @@
 #include "core/os/thread_safe.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 
 class Object;
@@ -66,39 +67,88 @@ private:
 		FLAG_MASK = FLAG_NULL_IS_OK - 1,
 	};
 
+	// Pushing is lock-free: producers reserve room by atomically advancing the tail,
+	// which packs the page index (high 32 bits) and the offset in it (low 32 bits),
+	// and then commit each message by setting its ready flag once it's fully written.
+	// Since the tail is only ever advanced, the reservation order is the submission order,
+	// and the flushing thread consumes messages in that order. The mutex is only taken
+	// to switch pages, which happens once per page, and to reset the tail after a flush.
+	enum {
+		PAGES_PER_CHUNK = 64,
+		PAGE_END_UNKNOWN = UINT32_MAX,
+	};
+
+	struct PageSlot {
+		Page *page = nullptr;
+		// Set by the push whose reservation didn't fit, so the consumer knows where the page's data ends.
+		SafeNumeric<uint32_t> end;
+	};
+
 	Mutex mutex;
 
 	Allocator *allocator = nullptr;
 	bool allocator_is_custom = false;
 
-	LocalVector<Page *> pages;
-	LocalVector<uint32_t> page_bytes;
+	// Allocated on demand, but never moved, so pushing threads can read them without locking.
+	LocalVector<PageSlot *> page_chunks;
 	uint32_t max_pages = 0;
-	uint32_t pages_used = 0;
-	bool flushing = false;
+	uint32_t pages_allocated = 0;
+	SafeFlag first_page_allocated;
+
+	std::atomic<uint64_t> tail = 0;
+	SafeFlag flushing;
+
+	// Statistics.
+	SafeNumeric<uint32_t> stat_page_switches;
+	SafeNumeric<uint32_t> stat_page_switch_collisions;
+	SafeNumeric<uint32_t> stat_lock_contentions;
+	SafeNumeric<uint32_t> stat_writer_waits;
+	SafeNumeric<uint32_t> stat_out_of_memory;
+	uint32_t stat_peak_pages_used = 0;
 
 #ifdef DEV_ENABLED
 	bool is_current_thread_override = false;
 #endif
 
+	// Built in place by _construct_message(), never by its constructor.
 	struct Message {
-		Callable callable;
+		std::atomic<uint32_t> ready; // Must be first, so it lands on memory known to be zeroed.
 		int16_t type;
 		union {
 			int16_t notification;
 			int16_t args;
 		};
+		Callable callable;
 	};
 
-	_FORCE_INLINE_ void _ensure_first_page() {
-		if (unlikely(pages.is_empty())) {
-			pages.push_back(allocator->alloc());
-			page_bytes.push_back(0);
-			pages_used = 1;
-		}
+	_FORCE_INLINE_ PageSlot &_get_page_slot(uint32_t p_page) const {
+		return page_chunks[p_page / PAGES_PER_CHUNK][p_page % PAGES_PER_CHUNK];
+	}
+
+	// Only constructs the callable: the flushing thread may already be polling the ready flag,
+	// which stays zeroed until the message is published with a release store.
+	_FORCE_INLINE_ static Message *_construct_message(uint8_t *p_room) {
+		Message *message = (Message *)p_room;
+		memnew_placement(&message->callable, Callable);
+		return message;
 	}
 
-	void _add_page();
+	void _lock_counting_contention();
+	void _allocate_page(uint32_t p_page);
+	uint8_t *_reserve(uint32_t p_room_needed);
+	Error _advance_page(uint32_t p_full_page);
+
+	Message *_get_next_message(uint32_t &r_page, uint32_t &r_offset, uint64_t &r_tail);
+	bool _try_reset(uint32_t p_page, uint64_t p_tail);
+	void _drain(bool p_call);
+
+	_FORCE_INLINE_ static uint32_t _get_message_size(const Message *p_message) {
+		uint32_t size = sizeof(Message);
+		if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+			size += sizeof(Variant) * p_message->args;
+		}
+		return size;
+	}
 
 	void _call_function(const Callable &p_callable, const Variant *p_args, int p_argcount, bool p_show_error);
 
@@ -42,21 +42,6 @@
 
 #ifdef DEBUG_ENABLED
 
-struct _ObjectDebugLock {
-	ObjectID obj_id;
-
-	_ObjectDebugLock(Object *p_obj) {
-		obj_id = p_obj->get_instance_id();
-		p_obj->_lock_index.ref();
-	}
-	~_ObjectDebugLock() {
-		Object *obj_ptr = ObjectDB::get_instance(obj_id);
-		if (likely(obj_ptr)) {
-			obj_ptr->_lock_index.unref();
-		}
-	}
-};
-
 #define OBJ_DEBUG_LOCK _ObjectDebugLock _debug_lock(this);
 
 #else
@@ -2177,7 +2162,18 @@ Object::~Object() {
 }
 
 bool predelete_handler(Object *p_object) {
-	return p_object->_predelete();
+	if (!p_object->_predelete()) {
+		return false;
+	}
+	if (p_object->_pool) {
+		// Pooled memory must not reach Memory::free_static(), so the deletion is finished here
+		// and memdelete() is told to stop.
+		ObjectPool *pool = p_object->_pool;
+		p_object->~Object();
+		pool->free(p_object);
+		return false;
+	}
+	return true;
 }
 
 void postinitialize_handler(Object *p_object) {
@@ -2189,8 +2185,9 @@ void ObjectDB::debug_objects(DebugFunc p_func) {
 	spin_lock.lock();
 
 	for (uint32_t i = 0, count = slot_count; i < slot_max && count != 0; i++) {
-		if (object_slots[i].validator) {
-			p_func(object_slots[i].object);
+		ObjectSlot &object_slot = _get_slot(i);
+		if (ObjectSlot::get_validator(object_slot.header.load(std::memory_order_relaxed))) {
+			p_func(object_slot.object.load(std::memory_order_relaxed));
 			count--;
 		}
 	}
@@ -2246,41 +2243,56 @@ void Object::get_argument_options(const StringName &p_function, int p_idx, List<
 SpinLock ObjectDB::spin_lock;
 uint32_t ObjectDB::slot_count = 0;
 uint32_t ObjectDB::slot_max = 0;
-ObjectDB::ObjectSlot *ObjectDB::object_slots = nullptr;
+std::atomic<ObjectDB::ObjectSlot *> ObjectDB::object_chunks[OBJECTDB_CHUNK_MAX_COUNT] = {};
 uint64_t ObjectDB::validator_counter = 0;
 
 int ObjectDB::get_object_count() {
 	return slot_count;
 }
 
+void ObjectDB::_set_next_free(uint32_t p_slot, uint32_t p_next_free) {
+	ObjectSlot &object_slot = _get_slot(p_slot);
+	uint64_t header = object_slot.header.load(std::memory_order_relaxed);
+	header &= ~(uint64_t(OBJECTDB_SLOT_MAX_COUNT_MASK) << OBJECTDB_VALIDATOR_BITS);
+	header |= uint64_t(p_next_free) << OBJECTDB_VALIDATOR_BITS;
+	object_slot.header.store(header, std::memory_order_release);
+}
+
 ObjectID ObjectDB::add_instance(Object *p_object) {
 	spin_lock.lock();
 	if (unlikely(slot_count == slot_max)) {
 		CRASH_COND(slot_count == (1 << OBJECTDB_SLOT_MAX_COUNT_BITS));
 
-		uint32_t new_slot_max = slot_max > 0 ? slot_max * 2 : 1;
-		object_slots = (ObjectSlot *)memrealloc(object_slots, sizeof(ObjectSlot) * new_slot_max);
-		for (uint32_t i = slot_max; i < new_slot_max; i++) {
-			object_slots[i].object = nullptr;
-			object_slots[i].is_ref_counted = false;
-			object_slots[i].next_free = i;
-			object_slots[i].validator = 0;
+		ObjectSlot *chunk = memnew_arr(ObjectSlot, OBJECTDB_CHUNK_SIZE);
+		for (uint32_t i = 0; i < OBJECTDB_CHUNK_SIZE; i++) {
+			chunk[i].object.store(nullptr, std::memory_order_relaxed);
+			chunk[i].header.store(uint64_t(slot_max + i) << OBJECTDB_VALIDATOR_BITS, std::memory_order_relaxed);
 		}
-		slot_max = new_slot_max;
+		// Published after initialization, for lock-free readers.
+		object_chunks[slot_max >> OBJECTDB_CHUNK_BITS].store(chunk, std::memory_order_release);
+		slot_max += OBJECTDB_CHUNK_SIZE;
 	}
 
-	uint32_t slot = object_slots[slot_count].next_free;
-	if (object_slots[slot].object != nullptr) {
+	uint32_t slot = ObjectSlot::get_next_free(_get_slot(slot_count).header.load(std::memory_order_relaxed));
+	ObjectSlot &object_slot = _get_slot(slot);
+	if (object_slot.object.load(std::memory_order_relaxed) != nullptr) {
 		spin_lock.unlock();
-		ERR_FAIL_COND_V(object_slots[slot].object != nullptr, ObjectID());
+		ERR_FAIL_COND_V(object_slot.object.load(std::memory_order_relaxed) != nullptr, ObjectID());
 	}
-	object_slots[slot].object = p_object;
-	object_slots[slot].is_ref_counted = p_object->is_ref_counted();
 	validator_counter = (validator_counter + 1) & OBJECTDB_VALIDATOR_MASK;
 	if (unlikely(validator_counter == 0)) {
 		validator_counter = 1;
 	}
-	object_slots[slot].validator = validator_counter;
+
+	// The object is stored before the validator, so a reader matching the validator sees it.
+	object_slot.object.store(p_object, std::memory_order_release);
+	uint64_t header = object_slot.header.load(std::memory_order_relaxed);
+	header &= uint64_t(OBJECTDB_SLOT_MAX_COUNT_MASK) << OBJECTDB_VALIDATOR_BITS;
+	header |= validator_counter;
+	if (p_object->is_ref_counted()) {
+		header |= OBJECTDB_REFERENCE_BIT;
+	}
+	object_slot.header.store(header, std::memory_order_release);
 
 	uint64_t id = validator_counter;
 	id <<= OBJECTDB_SLOT_MAX_COUNT_BITS;
@@ -2303,33 +2315,41 @@ void ObjectDB::remove_instance(Object *p_object) {
 
 	spin_lock.lock();
 
+	ObjectSlot &object_slot = _get_slot(slot);
+
 #ifdef DEBUG_ENABLED
 
-	if (object_slots[slot].object != p_object) {
+	if (object_slot.object.load(std::memory_order_relaxed) != p_object) {
 		spin_lock.unlock();
-		ERR_FAIL_COND(object_slots[slot].object != p_object);
+		ERR_FAIL_COND(object_slot.object.load(std::memory_order_relaxed) != p_object);
 	}
 	{
 		uint64_t validator = (t >> OBJECTDB_SLOT_MAX_COUNT_BITS) & OBJECTDB_VALIDATOR_MASK;
-		if (object_slots[slot].validator != validator) {
+		if (ObjectSlot::get_validator(object_slot.header.load(std::memory_order_relaxed)) != validator) {
 			spin_lock.unlock();
-			ERR_FAIL_COND(object_slots[slot].validator != validator);
+			ERR_FAIL_COND(ObjectSlot::get_validator(object_slot.header.load(std::memory_order_relaxed)) != validator);
 		}
 	}
 
 #endif
+	//invalidate, so checks against it fail
+	uint64_t header = object_slot.header.load(std::memory_order_relaxed);
+	object_slot.header.store(header & (uint64_t(OBJECTDB_SLOT_MAX_COUNT_MASK) << OBJECTDB_VALIDATOR_BITS), std::memory_order_release);
+	object_slot.object.store(nullptr, std::memory_order_release);
 	//decrease slot count
 	slot_count--;
 	//set the free slot properly
-	object_slots[slot_count].next_free = slot;
-	//invalidate, so checks against it fail
-	object_slots[slot].validator = 0;
-	object_slots[slot].is_ref_counted = false;
-	object_slots[slot].object = nullptr;
+	_set_next_free(slot_count, slot);
 
 	spin_lock.unlock();
 }
 
+void ObjectDB::get_instances(const ObjectID *p_instance_ids, Object **r_objects, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_objects[i] = get_instance(p_instance_ids[i]);
+	}
+}
+
 void ObjectDB::setup() {
 	//nothing to do now
 }
@@ -2348,8 +2368,9 @@ void ObjectDB::cleanup() {
 			Callable::CallError call_error;
 
 			for (uint32_t i = 0, count = slot_count; i < slot_max && count != 0; i++) {
-				if (object_slots[i].validator) {
-					Object *obj = object_slots[i].object;
+				uint64_t header = _get_slot(i).header.load(std::memory_order_relaxed);
+				if (ObjectSlot::get_validator(header)) {
+					Object *obj = _get_slot(i).object.load(std::memory_order_relaxed);
 
 					String extra_info;
 					if (obj->is_class("Node")) {
@@ -2359,7 +2380,7 @@ void ObjectDB::cleanup() {
 						extra_info = " - Resource path: " + String(resource_get_path->call(obj, nullptr, 0, call_error));
 					}
 
-					uint64_t id = uint64_t(i) | (uint64_t(object_slots[i].validator) << OBJECTDB_SLOT_MAX_COUNT_BITS) | (object_slots[i].is_ref_counted ? OBJECTDB_REFERENCE_BIT : 0);
+					uint64_t id = uint64_t(i) | (ObjectSlot::get_validator(header) << OBJECTDB_SLOT_MAX_COUNT_BITS) | (ObjectSlot::is_ref_counted(header) ? OBJECTDB_REFERENCE_BIT : 0);
 					DEV_ASSERT(id == (uint64_t)obj->get_instance_id()); // We could just use the id from the object, but this check may help catching memory corruption catastrophes.
 					print_line("Leaked instance: " + String(obj->get_class()) + ":" + uitos(id) + extra_info);
 
@@ -2370,9 +2391,10 @@ void ObjectDB::cleanup() {
 		}
 	}
 
-	if (object_slots) {
-		memfree(object_slots);
+	for (uint32_t i = 0; i < slot_max; i += OBJECTDB_CHUNK_SIZE) {
+		memdelete_arr(object_chunks[i >> OBJECTDB_CHUNK_BITS].exchange(nullptr));
 	}
+	slot_max = 0;
 
 	spin_lock.unlock();
 }
@@ -562,6 +562,7 @@ public:                                                                 \
                                                                         \
 private:
 
+class ObjectPool;
 class ScriptInstance;
 
 class Object {
@@ -619,6 +620,7 @@ private:
 	bool _block_signals = false;
 	int _predelete_ok = 0;
 	ObjectID _instance_id;
+	ObjectPool *_pool = nullptr; // Set when ClassDB allocated the instance from its class pool.
 	bool _predelete();
 	void _initialize();
 	void _postinitialize();
@@ -857,6 +859,8 @@ public:
 	void get_method_list(List<MethodInfo> *p_list) const;
 	Variant callv(const StringName &p_method, const Array &p_args);
 	virtual Variant callp(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error);
+	// True when callp() resolves names that are not the methods registered in ClassDB.
+	virtual bool has_custom_callp() const { return false; }
 	virtual Variant call_const(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 
 	template <typename... VarArgs>
@@ -899,6 +903,8 @@ public:
 
 #ifdef TOOLS_ENABLED
 	void set_edited(bool p_edited);
+	// What set() does before assigning, for callers assigning through an already resolved setter.
+	_FORCE_INLINE_ void _mark_edited() { _edited = true; }
 	bool is_edited() const;
 	// This function is used to check when something changed beyond a point, it's used mainly for generating previews.
 	uint32_t get_edited_version() const;
@@ -1003,20 +1009,34 @@ class ObjectDB {
 #define OBJECTDB_SLOT_MAX_COUNT_BITS 24
 #define OBJECTDB_SLOT_MAX_COUNT_MASK ((uint64_t(1) << OBJECTDB_SLOT_MAX_COUNT_BITS) - 1)
 #define OBJECTDB_REFERENCE_BIT (uint64_t(1) << (OBJECTDB_SLOT_MAX_COUNT_BITS + OBJECTDB_VALIDATOR_BITS))
+// Slots are allocated in chunks that never move, so they can be read without locking.
+#define OBJECTDB_CHUNK_BITS 12
+#define OBJECTDB_CHUNK_SIZE (uint32_t(1) << OBJECTDB_CHUNK_BITS)
+#define OBJECTDB_CHUNK_MASK (OBJECTDB_CHUNK_SIZE - 1)
+#define OBJECTDB_CHUNK_MAX_COUNT (uint32_t(1) << (OBJECTDB_SLOT_MAX_COUNT_BITS - OBJECTDB_CHUNK_BITS))
 
 	struct ObjectSlot { // 128 bits per slot.
-		uint64_t validator : OBJECTDB_VALIDATOR_BITS;
-		uint64_t next_free : OBJECTDB_SLOT_MAX_COUNT_BITS;
-		uint64_t is_ref_counted : 1;
-		Object *object = nullptr;
+		// Packs the validator, the next free slot index and the reference flag, so readers
+		// can check the validator with a single atomic load. Only written with the lock held.
+		std::atomic<uint64_t> header;
+		std::atomic<Object *> object;
+
+		_FORCE_INLINE_ static uint64_t get_validator(uint64_t p_header) { return p_header & OBJECTDB_VALIDATOR_MASK; }
+		_FORCE_INLINE_ static uint32_t get_next_free(uint64_t p_header) { return (p_header >> OBJECTDB_VALIDATOR_BITS) & OBJECTDB_SLOT_MAX_COUNT_MASK; }
+		_FORCE_INLINE_ static bool is_ref_counted(uint64_t p_header) { return p_header & OBJECTDB_REFERENCE_BIT; }
 	};
 
 	static SpinLock spin_lock;
 	static uint32_t slot_count;
 	static uint32_t slot_max;
-	static ObjectSlot *object_slots;
+	static std::atomic<ObjectSlot *> object_chunks[OBJECTDB_CHUNK_MAX_COUNT];
 	static uint64_t validator_counter;
 
+	_FORCE_INLINE_ static ObjectSlot &_get_slot(uint32_t p_slot) {
+		return object_chunks[p_slot >> OBJECTDB_CHUNK_BITS].load(std::memory_order_relaxed)[p_slot & OBJECTDB_CHUNK_MASK];
+	}
+	static void _set_next_free(uint32_t p_slot, uint32_t p_next_free);
+
 	friend class Object;
 	friend void unregister_core_types();
 	static void cleanup();
@@ -1030,29 +1050,55 @@ class ObjectDB {
 public:
 	typedef void (*DebugFunc)(Object *p_obj);
 
+	// Lock-free. The slot is validated before and after reading the object pointer, so a slot
+	// recycled concurrently for another object is never mistaken for the requested one.
 	_ALWAYS_INLINE_ static Object *get_instance(ObjectID p_instance_id) {
 		uint64_t id = p_instance_id;
 		uint32_t slot = id & OBJECTDB_SLOT_MAX_COUNT_MASK;
 
-		ERR_FAIL_COND_V(slot >= slot_max, nullptr); // This should never happen unless RID is corrupted.
-
-		spin_lock.lock();
+		ObjectSlot *chunk = object_chunks[slot >> OBJECTDB_CHUNK_BITS].load(std::memory_order_acquire);
+		ERR_FAIL_NULL_V(chunk, nullptr); // This should never happen unless RID is corrupted.
+		ObjectSlot &object_slot = chunk[slot & OBJECTDB_CHUNK_MASK];
 
 		uint64_t validator = (id >> OBJECTDB_SLOT_MAX_COUNT_BITS) & OBJECTDB_VALIDATOR_MASK;
 
-		if (unlikely(object_slots[slot].validator != validator)) {
-			spin_lock.unlock();
+		if (unlikely(ObjectSlot::get_validator(object_slot.header.load(std::memory_order_acquire)) != validator)) {
 			return nullptr;
 		}
 
-		Object *object = object_slots[slot].object;
+		Object *object = object_slot.object.load(std::memory_order_relaxed);
 
-		spin_lock.unlock();
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (unlikely(ObjectSlot::get_validator(object_slot.header.load(std::memory_order_relaxed)) != validator)) {
+			return nullptr;
+		}
 
 		return object;
 	}
+	// Resolves p_count IDs at once into r_objects, setting nullptr for the invalid ones.
+	static void get_instances(const ObjectID *p_instance_ids, Object **r_objects, uint32_t p_count);
 	static void debug_objects(DebugFunc p_func);
 	static int get_object_count();
 };
 
+#ifdef DEBUG_ENABLED
+
+// Held while an object runs one of its methods, so it can't be freed from within (see Object::callp()).
+struct _ObjectDebugLock {
+	ObjectID obj_id;
+
+	_ObjectDebugLock(Object *p_obj) {
+		obj_id = p_obj->get_instance_id();
+		p_obj->_lock_index.ref();
+	}
+	~_ObjectDebugLock() {
+		Object *obj_ptr = ObjectDB::get_instance(obj_id);
+		if (likely(obj_ptr)) {
+			obj_ptr->_lock_index.unref();
+		}
+	}
+};
+
+#endif
+
 #endif // OBJECT_H
@@ -0,0 +1,95 @@
+/**************************************************************************/
+/*  object_pool.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "object_pool.h"
+
+void *ObjectPool::alloc() {
+	MutexLock lock(mutex);
+
+	if (unlikely(!free_slots)) {
+		uint8_t *page = (uint8_t *)memalloc(size_t(slot_size) * slots_per_page);
+		ERR_FAIL_NULL_V(page, nullptr);
+		pages.push_back(page);
+		// Linked in address order, so consecutive instances are adjacent in memory.
+		for (uint32_t i = slots_per_page; i > 0; i--) {
+			void *slot = page + size_t(slot_size) * (i - 1);
+			*(void **)slot = free_slots;
+			free_slots = slot;
+		}
+		pooled_count += slots_per_page;
+	}
+
+	void *slot = free_slots;
+	free_slots = *(void **)slot;
+	pooled_count--;
+	live_count++;
+	peak_live_count = MAX(peak_live_count, live_count);
+	return slot;
+}
+
+void ObjectPool::free(void *p_slot) {
+	MutexLock lock(mutex);
+
+	ERR_FAIL_COND(live_count == 0);
+	*(void **)p_slot = free_slots;
+	free_slots = p_slot;
+	pooled_count++;
+	live_count--;
+}
+
+uint32_t ObjectPool::get_live_count() const {
+	MutexLock lock(mutex);
+	return live_count;
+}
+
+uint32_t ObjectPool::get_pooled_count() const {
+	MutexLock lock(mutex);
+	return pooled_count;
+}
+
+uint32_t ObjectPool::get_peak_live_count() const {
+	MutexLock lock(mutex);
+	return peak_live_count;
+}
+
+ObjectPool::ObjectPool(uint32_t p_instance_size) {
+	const uint32_t align = alignof(max_align_t);
+	slot_size = MAX(p_instance_size, (uint32_t)sizeof(void *));
+	slot_size = (slot_size + align - 1) & ~(align - 1);
+	// Pages of about 64 KiB, but at least 16 slots for large classes.
+	slots_per_page = MAX(65536u / slot_size, 16u);
+}
+
+ObjectPool::~ObjectPool() {
+	ERR_FAIL_COND_MSG(live_count > 0, "Freeing an object pool that still has live instances.");
+	for (uint8_t *page : pages) {
+		memfree(page);
+	}
+}
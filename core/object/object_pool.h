@@ -0,0 +1,65 @@
+/**************************************************************************/
+/*  object_pool.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+
+#include "core/os/mutex.h"
+#include "core/templates/local_vector.h"
+
+// Fixed-size slots for the instances of one class, used by ClassDB when pooling
+// is enabled for it. Memory is allocated in pages that are kept for the whole
+// lifetime of the pool, and freed slots are reused by the next instances.
+class ObjectPool {
+	mutable BinaryMutex mutex;
+
+	uint32_t slot_size = 0;
+	uint32_t slots_per_page = 0;
+	LocalVector<uint8_t *> pages;
+	// Free slots are linked through their first bytes.
+	void *free_slots = nullptr;
+
+	uint32_t live_count = 0;
+	uint32_t pooled_count = 0;
+	uint32_t peak_live_count = 0;
+
+public:
+	void *alloc();
+	void free(void *p_slot);
+
+	uint32_t get_live_count() const;
+	uint32_t get_pooled_count() const;
+	uint32_t get_peak_live_count() const;
+
+	ObjectPool(uint32_t p_instance_size);
+	~ObjectPool();
+};
+
+#endif // OBJECT_POOL_H
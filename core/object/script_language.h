@@ -133,6 +133,7 @@ public:
 	virtual void reload_from_file() override;
 
 	virtual bool can_instantiate() const = 0;
+	virtual bool has_custom_callp() const override { return true; }
 
 	virtual Ref<Script> get_base_script() const = 0; //for script inheritance
 	virtual StringName get_global_name() const = 0;
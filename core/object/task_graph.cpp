@@ -0,0 +1,303 @@
+/**************************************************************************/
+/*  task_graph.cpp                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "task_graph.h"
+
+#include "core/os/os.h"
+
+void TaskGraph::_task_func(void *p_node) {
+	Node *node = (Node *)p_node;
+
+	node->start_usec = OS::get_singleton()->get_ticks_usec();
+	if (node->native_func) {
+		node->native_func(node->native_func_userdata);
+	} else {
+		node->callable.call();
+	}
+	node->end_usec = OS::get_singleton()->get_ticks_usec();
+
+	node->graph->_node_completed(node);
+}
+
+void TaskGraph::_group_task_func(void *p_node, uint32_t p_index) {
+	Node *node = (Node *)p_node;
+
+	if (node->started_elements.postincrement() == 0) {
+		node->start_usec = OS::get_singleton()->get_ticks_usec();
+	}
+	if (node->native_group_func) {
+		node->native_group_func(node->native_func_userdata, p_index);
+	} else {
+		node->callable.call(p_index);
+	}
+
+	// Whoever completes the last element, not the last thread to leave the group, completes the node.
+	if (node->completed_elements.increment() == (uint32_t)node->elements) {
+		node->end_usec = OS::get_singleton()->get_ticks_usec();
+		node->graph->_node_completed(node);
+	}
+}
+
+TaskGraph::NodeID TaskGraph::_add_node(Node *p_node, const Vector<NodeID> &p_predecessors) {
+	if (running) {
+		memdelete(p_node);
+		ERR_FAIL_V_MSG(INVALID_NODE_ID, "Can't add nodes to a running task graph.");
+	}
+
+	NodeID id = nodes.size();
+	for (NodeID predecessor : p_predecessors) {
+		// Only already added nodes can be predecessors, which makes cycles impossible.
+		if (predecessor < 0 || predecessor >= id) {
+			memdelete(p_node);
+			ERR_FAIL_V_MSG(INVALID_NODE_ID, vformat("Invalid predecessor node ID: %d.", predecessor));
+		}
+	}
+
+	p_node->graph = this;
+	p_node->self = id;
+	for (NodeID predecessor : p_predecessors) {
+		p_node->predecessors.push_back(predecessor);
+		nodes[predecessor]->successors.push_back(id);
+	}
+	nodes.push_back(p_node);
+
+	return id;
+}
+
+TaskGraph::NodeID TaskGraph::add_native_task(void (*p_func)(void *), void *p_userdata, const Vector<NodeID> &p_predecessors, bool p_high_priority, const String &p_description) {
+	Node *node = memnew(Node);
+	node->native_func = p_func;
+	node->native_func_userdata = p_userdata;
+	node->high_priority = p_high_priority;
+	node->description = p_description;
+	return _add_node(node, p_predecessors);
+}
+
+TaskGraph::NodeID TaskGraph::add_task(const Callable &p_action, const Vector<NodeID> &p_predecessors, bool p_high_priority, const String &p_description) {
+	Node *node = memnew(Node);
+	node->callable = p_action;
+	node->high_priority = p_high_priority;
+	node->description = p_description;
+	return _add_node(node, p_predecessors);
+}
+
+TaskGraph::NodeID TaskGraph::add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks, const Vector<NodeID> &p_predecessors, bool p_high_priority, const String &p_description) {
+	ERR_FAIL_COND_V(p_elements < 0, INVALID_NODE_ID);
+
+	Node *node = memnew(Node);
+	node->native_group_func = p_func;
+	node->native_func_userdata = p_userdata;
+	node->is_group = true;
+	node->elements = p_elements;
+	node->tasks = p_tasks;
+	node->high_priority = p_high_priority;
+	node->description = p_description;
+	return _add_node(node, p_predecessors);
+}
+
+TaskGraph::NodeID TaskGraph::add_group_task(const Callable &p_action, int p_elements, int p_tasks, const Vector<NodeID> &p_predecessors, bool p_high_priority, const String &p_description) {
+	ERR_FAIL_COND_V(p_elements < 0, INVALID_NODE_ID);
+
+	Node *node = memnew(Node);
+	node->callable = p_action;
+	node->is_group = true;
+	node->elements = p_elements;
+	node->tasks = p_tasks;
+	node->high_priority = p_high_priority;
+	node->description = p_description;
+	return _add_node(node, p_predecessors);
+}
+
+void TaskGraph::clear() {
+	ERR_FAIL_COND_MSG(running, "Can't clear a running task graph.");
+
+	for (Node *node : nodes) {
+		memdelete(node);
+	}
+	nodes.clear();
+	critical_path.clear();
+	critical_path_usec = 0;
+	start_usec = 0;
+	end_usec = 0;
+}
+
+void TaskGraph::_post_node(Node *p_node) {
+	if (p_node->is_group) {
+		if (p_node->elements == 0) {
+			// The pool would complete it right away anyway; don't make a round trip.
+			p_node->start_usec = OS::get_singleton()->get_ticks_usec();
+			p_node->end_usec = p_node->start_usec;
+			_node_completed(p_node);
+			return;
+		}
+		p_node->group_id = WorkerThreadPool::get_singleton()->add_native_group_task(&TaskGraph::_group_task_func, p_node, p_node->elements, p_node->tasks, p_node->high_priority, p_node->description);
+	} else {
+		p_node->task_id = WorkerThreadPool::get_singleton()->add_native_task(&TaskGraph::_task_func, p_node, p_node->high_priority, p_node->description);
+	}
+}
+
+void TaskGraph::_node_completed(Node *p_node) {
+	for (NodeID successor : p_node->successors) {
+		Node *successor_node = nodes[successor];
+		if (successor_node->pending_predecessors.decrement() == 0) {
+			_post_node(successor_node);
+		}
+	}
+	_release_node();
+}
+
+void TaskGraph::_release_node() {
+	if (remaining_nodes.decrement() == 0) {
+		end_usec = OS::get_singleton()->get_ticks_usec();
+		done_semaphore.post();
+	}
+}
+
+void TaskGraph::start() {
+	ERR_FAIL_COND_MSG(running, "Task graph is already running.");
+	running = true;
+
+	critical_path.clear();
+	critical_path_usec = 0;
+
+	for (Node *node : nodes) {
+		node->pending_predecessors.set(node->predecessors.size());
+		node->started_elements.set(0);
+		node->completed_elements.set(0);
+		node->start_usec = 0;
+		node->end_usec = 0;
+		node->task_id = WorkerThreadPool::INVALID_TASK_ID;
+		node->group_id = WorkerThreadPool::INVALID_TASK_ID;
+	}
+
+	// The extra count keeps the graph from completing before every root is posted,
+	// so the IDs stored here are visible to whoever waits.
+	remaining_nodes.set(nodes.size() + 1);
+	start_usec = OS::get_singleton()->get_ticks_usec();
+
+	for (Node *node : nodes) {
+		if (node->predecessors.is_empty()) {
+			_post_node(node);
+		}
+	}
+
+	_release_node();
+}
+
+bool TaskGraph::is_completed() const {
+	return running && remaining_nodes.get() == 0;
+}
+
+void TaskGraph::wait() {
+	ERR_FAIL_COND_MSG(!running, "Task graph is not running.");
+
+	// A pool thread must not sleep on the semaphore, as the nodes may need it to run. Instead it
+	// waits for the nodes in insertion order, which the pool does while running other tasks.
+	// Nodes are posted from within the task of their last predecessor, so by the time every
+	// earlier node has been waited for, the ID of the next one is known.
+	const bool pool_thread = WorkerThreadPool::get_thread_index() != -1;
+	if (!pool_thread) {
+		done_semaphore.wait();
+	}
+
+	// Either way, the pool keeps track of the tasks until they are awaited.
+	for (Node *node : nodes) {
+		if (node->task_id != WorkerThreadPool::INVALID_TASK_ID) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(node->task_id);
+		} else if (node->group_id != WorkerThreadPool::INVALID_TASK_ID) {
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(node->group_id);
+		}
+	}
+
+	if (pool_thread) {
+		// Already posted by the last node, which completed within the tasks waited for above.
+		done_semaphore.wait();
+	}
+
+	_compute_critical_path();
+	running = false;
+}
+
+void TaskGraph::_compute_critical_path() {
+	// Nodes can only depend on earlier ones, so the insertion order is a topological order.
+	LocalVector<uint64_t> path_usec;
+	LocalVector<NodeID> path_previous;
+	path_usec.resize(nodes.size());
+	path_previous.resize(nodes.size());
+
+	NodeID last = INVALID_NODE_ID;
+	critical_path_usec = 0;
+
+	for (uint32_t i = 0; i < nodes.size(); i++) {
+		const Node *node = nodes[i];
+		uint64_t longest_usec = 0;
+		NodeID previous = INVALID_NODE_ID;
+		for (NodeID predecessor : node->predecessors) {
+			if (previous == INVALID_NODE_ID || path_usec[predecessor] > longest_usec) {
+				longest_usec = path_usec[predecessor];
+				previous = predecessor;
+			}
+		}
+		path_usec[i] = longest_usec + (node->end_usec - node->start_usec);
+		path_previous[i] = previous;
+
+		if (last == INVALID_NODE_ID || path_usec[i] > critical_path_usec) {
+			critical_path_usec = path_usec[i];
+			last = i;
+		}
+	}
+
+	critical_path.clear();
+	for (NodeID id = last; id != INVALID_NODE_ID; id = path_previous[id]) {
+		critical_path.push_back(id);
+	}
+	critical_path.invert();
+}
+
+uint64_t TaskGraph::get_node_time_usec(NodeID p_node) const {
+	ERR_FAIL_INDEX_V(p_node, (NodeID)nodes.size(), 0);
+	return nodes[p_node]->end_usec - nodes[p_node]->start_usec;
+}
+
+Vector<TaskGraph::NodeID> TaskGraph::get_critical_path() const {
+	Vector<NodeID> ret;
+	ret.resize(critical_path.size());
+	for (uint32_t i = 0; i < critical_path.size(); i++) {
+		ret.write[i] = critical_path[i];
+	}
+	return ret;
+}
+
+TaskGraph::~TaskGraph() {
+	if (running) {
+		wait();
+	}
+	clear();
+}
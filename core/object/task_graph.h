@@ -0,0 +1,131 @@
+/**************************************************************************/
+/*  task_graph.h                                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TASK_GRAPH_H
+#define TASK_GRAPH_H
+
+#include "core/object/worker_thread_pool.h"
+#include "core/os/semaphore.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+// A directed acyclic graph of tasks and group tasks run on the WorkerThreadPool.
+// Nodes declare their predecessors when added, so the graph is acyclic by construction.
+// Once started, nodes without predecessors are posted to the pool, and every node is posted
+// by the thread completing its last predecessor, so no pool thread ever blocks waiting.
+// A graph can be started again after it has been waited for, so it can be built once and
+// run every frame.
+
+class TaskGraph {
+public:
+	typedef int32_t NodeID;
+
+	enum {
+		INVALID_NODE_ID = -1
+	};
+
+private:
+	struct Node {
+		TaskGraph *graph = nullptr;
+		NodeID self = INVALID_NODE_ID;
+
+		void (*native_func)(void *) = nullptr;
+		void (*native_group_func)(void *, uint32_t) = nullptr;
+		void *native_func_userdata = nullptr;
+		Callable callable;
+		bool is_group = false;
+		int elements = 0;
+		int tasks = -1;
+		bool high_priority = false;
+		String description;
+
+		LocalVector<NodeID> predecessors;
+		LocalVector<NodeID> successors;
+
+		SafeNumeric<uint32_t> pending_predecessors;
+		SafeNumeric<uint32_t> completed_elements;
+		SafeNumeric<uint32_t> started_elements;
+		uint64_t start_usec = 0;
+		uint64_t end_usec = 0;
+
+		WorkerThreadPool::TaskID task_id = WorkerThreadPool::INVALID_TASK_ID;
+		WorkerThreadPool::GroupID group_id = WorkerThreadPool::INVALID_TASK_ID;
+	};
+
+	LocalVector<Node *> nodes;
+
+	bool running = false;
+	// One extra count is held by start() until all the roots are posted.
+	SafeNumeric<uint32_t> remaining_nodes;
+	Semaphore done_semaphore;
+
+	uint64_t start_usec = 0;
+	uint64_t end_usec = 0;
+
+	uint64_t critical_path_usec = 0;
+	LocalVector<NodeID> critical_path;
+
+	static void _task_func(void *p_node);
+	static void _group_task_func(void *p_node, uint32_t p_index);
+
+	NodeID _add_node(Node *p_node, const Vector<NodeID> &p_predecessors);
+	void _post_node(Node *p_node);
+	void _node_completed(Node *p_node);
+	void _release_node();
+	void _compute_critical_path();
+
+public:
+	NodeID add_native_task(void (*p_func)(void *), void *p_userdata, const Vector<NodeID> &p_predecessors = Vector<NodeID>(), bool p_high_priority = false, const String &p_description = String());
+	NodeID add_task(const Callable &p_action, const Vector<NodeID> &p_predecessors = Vector<NodeID>(), bool p_high_priority = false, const String &p_description = String());
+	NodeID add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, const Vector<NodeID> &p_predecessors = Vector<NodeID>(), bool p_high_priority = false, const String &p_description = String());
+	NodeID add_group_task(const Callable &p_action, int p_elements, int p_tasks = -1, const Vector<NodeID> &p_predecessors = Vector<NodeID>(), bool p_high_priority = false, const String &p_description = String());
+
+	uint32_t get_node_count() const { return nodes.size(); }
+	void clear();
+
+	void start();
+	bool is_running() const { return running; }
+	bool is_completed() const;
+	// Blocks the calling thread until every node has run. Must be called before starting again.
+	// Pool threads run other tasks while they wait for task nodes, but block on group nodes.
+	void wait();
+
+	// Timings of the last completed run.
+	uint64_t get_node_time_usec(NodeID p_node) const;
+	uint64_t get_elapsed_time_usec() const { return end_usec - start_usec; }
+	// Longest chain of dependent nodes, weighted by how long each one took to run.
+	// This is the lower bound of the elapsed time no matter how many threads are available.
+	uint64_t get_critical_path_time_usec() const { return critical_path_usec; }
+	Vector<NodeID> get_critical_path() const;
+
+	~TaskGraph();
+};
+
+#endif // TASK_GRAPH_H
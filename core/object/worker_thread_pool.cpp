@@ -183,7 +183,16 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 
 	while (true) {
 		Task *task_to_process = nullptr;
-		{
+
+		if (singleton->use_work_stealing && thread_data->local_task_streak < MAX_LOCAL_TASK_STREAK) {
+			// Fast path: no need to touch the global lock as long as there's local or stealable work.
+			task_to_process = singleton->_pop_or_steal_task(thread_data);
+			if (task_to_process) {
+				thread_data->local_task_streak++;
+			}
+		}
+
+		if (!task_to_process) {
 			MutexLock lock(singleton->task_mutex);
 
 			bool exit = singleton->_handle_runlevel(thread_data, lock);
@@ -192,10 +201,21 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 			}
 
 			thread_data->signaled = false;
+			thread_data->local_task_streak = 0;
 
 			if (singleton->task_queue.first()) {
 				task_to_process = singleton->task_queue.first()->self();
 				singleton->task_queue.remove(singleton->task_queue.first());
+				if (singleton->use_work_stealing) {
+					singleton->_grab_global_tasks(thread_data);
+				}
+			} else if (singleton->use_work_stealing) {
+				// Local deques are only pushed to with the lock held, so checking them again here
+				// guarantees no task can be posted between this check and the wait below.
+				task_to_process = singleton->_pop_or_steal_task(thread_data);
+				if (!task_to_process) {
+					thread_data->cond_var.wait(lock);
+				}
 			} else {
 				thread_data->cond_var.wait(lock);
 			}
@@ -230,10 +250,17 @@ void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high
 
 	ThreadData *caller_pool_thread = thread_ids.has(Thread::get_caller_id()) ? &threads[thread_ids[Thread::get_caller_id()]] : nullptr;
 
+	// In work-stealing mode, tasks posted from a pool thread go to its own deque, from where
+	// that thread will pop them and any idle one can steal them without taking the lock.
+	// Tasks posted from other threads, or overflowing a full deque, go to the global queue.
+	LocalQueue *local_queue = caller_pool_thread ? caller_pool_thread->local_queue : nullptr;
+
 	for (uint32_t i = 0; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
 		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
-			task_queue.add_last(&p_tasks[i]->task_elem);
+			if (!local_queue || !local_queue->push(p_tasks[i])) {
+				task_queue.add_last(&p_tasks[i]->task_elem);
+			}
 			if (!p_high_priority) {
 				low_priority_threads_used++;
 			}
@@ -324,6 +351,55 @@ bool WorkerThreadPool::_try_promote_low_priority_task() {
 	}
 }
 
+WorkerThreadPool::Task *WorkerThreadPool::_pop_or_steal_task(ThreadData *p_thread_data) {
+	Task *task = nullptr;
+	if (p_thread_data->local_queue->pop(task)) {
+		return task;
+	}
+
+	uint32_t thread_count = threads.size();
+	for (uint32_t i = 0; i < thread_count; i++) {
+		uint32_t victim_index = (p_thread_data->steal_index + i) % thread_count;
+		if (victim_index == p_thread_data->index) {
+			continue;
+		}
+		LocalQueue *victim_queue = threads[victim_index].local_queue;
+		// A failed steal with the deque still non-empty means another thread made progress, so retrying is bounded.
+		while (!victim_queue->is_empty()) {
+			if (victim_queue->steal(task)) {
+				p_thread_data->steal_index = victim_index;
+				return task;
+			}
+		}
+	}
+	p_thread_data->steal_index = (p_thread_data->steal_index + 1) % thread_count;
+
+	return nullptr;
+}
+
+void WorkerThreadPool::_grab_global_tasks(ThreadData *p_thread_data) {
+	// Moving a batch to the local deque lets the lock be taken once per batch instead of once per task.
+	// Other threads were already notified about these tasks when they were posted and will steal the excess.
+	for (uint32_t i = 0; i < GLOBAL_QUEUE_BATCH_SIZE && task_queue.first(); i++) {
+		if (!p_thread_data->local_queue->push(task_queue.first()->self())) {
+			break;
+		}
+		task_queue.remove(task_queue.first());
+	}
+}
+
+bool WorkerThreadPool::_has_local_tasks() const {
+	if (!use_work_stealing) {
+		return false;
+	}
+	for (const ThreadData &th : threads) {
+		if (!th.local_queue->is_empty()) {
+			return true;
+		}
+	}
+	return false;
+}
+
 WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
 	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description);
 }
@@ -479,7 +555,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				if (was_signaled) {
 					// This thread was awaken for some additional reason, but it's about to exit.
 					// Let's find out what may be pending and forward the requests.
-					uint32_t to_process = task_queue.first() ? 1 : 0;
+					uint32_t to_process = (task_queue.first() || _has_local_tasks()) ? 1 : 0;
 					uint32_t to_promote = p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
 					if (to_process || to_promote) {
 						// This thread must be left alone since it won't loop again.
@@ -497,11 +573,20 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				}
 			}
 
-			if (singleton->task_queue.first()) {
+			if (use_work_stealing) {
+				// Prefer the own deque, which likely holds the tasks spawned by the one being awaited.
+				p_caller_pool_thread->local_queue->pop(task_to_process);
+			}
+
+			if (!task_to_process && singleton->task_queue.first()) {
 				task_to_process = task_queue.first()->self();
 				task_queue.remove(task_queue.first());
 			}
 
+			if (!task_to_process && use_work_stealing) {
+				task_to_process = _pop_or_steal_task(p_caller_pool_thread);
+			}
+
 			if (!task_to_process) {
 				p_caller_pool_thread->awaited_task = p_task;
 
@@ -543,7 +628,7 @@ bool WorkerThreadPool::_handle_runlevel(ThreadData *p_thread_data, MutexLock<Bin
 		} break;
 		case RUNLEVEL_PRE_EXIT_LANGUAGES: {
 			if (!p_thread_data->pre_exited_languages) {
-				if (!task_queue.first() && !low_priority_task_queue.first()) {
+				if (!task_queue.first() && !low_priority_task_queue.first() && !_has_local_tasks()) {
 					p_thread_data->pre_exited_languages = true;
 					runlevel_data.pre_exit_languages.num_idle_threads++;
 					control_cond_var.notify_all();
@@ -749,7 +834,7 @@ void WorkerThreadPool::thread_exit_unlock_allowance_zone(uint32_t p_zone_id) {
 }
 #endif
 
-void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio) {
+void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio, bool p_use_work_stealing) {
 	ERR_FAIL_COND(threads.size() > 0);
 
 	runlevel = RUNLEVEL_NORMAL;
@@ -759,13 +844,22 @@ void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio)
 	}
 
 	max_low_priority_threads = CLAMP(p_thread_count * p_low_priority_task_ratio, 1, p_thread_count - 1);
+	low_priority_threads_used = 0;
+	use_work_stealing = p_use_work_stealing && p_thread_count > 0;
 
-	print_verbose(vformat("WorkerThreadPool: %d threads, %d max low-priority.", p_thread_count, max_low_priority_threads));
+	print_verbose(vformat("WorkerThreadPool: %d threads, %d max low-priority%s.", p_thread_count, max_low_priority_threads, use_work_stealing ? ", work stealing" : ""));
 
 	threads.resize(p_thread_count);
 
 	for (uint32_t i = 0; i < threads.size(); i++) {
 		threads[i].index = i;
+		if (use_work_stealing) {
+			threads[i].local_queue = memnew(LocalQueue);
+			threads[i].steal_index = (i + 1) % threads.size();
+		}
+	}
+
+	for (uint32_t i = 0; i < threads.size(); i++) {
 		threads[i].thread.start(&WorkerThreadPool::_thread_function, &threads[i]);
 		thread_ids.insert(threads[i].thread.get_id(), i);
 	}
@@ -816,9 +910,18 @@ void WorkerThreadPool::finish() {
 		for (KeyValue<TaskID, Task *> &E : tasks) {
 			task_allocator.free(E.value);
 		}
+		tasks.clear();
+	}
+
+	for (ThreadData &data : threads) {
+		if (data.local_queue) {
+			memdelete(data.local_queue);
+		}
 	}
 
 	threads.clear();
+	thread_ids.clear();
+	use_work_stealing = false;
 }
 
 void WorkerThreadPool::_bind_methods() {
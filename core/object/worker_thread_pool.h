@@ -40,6 +40,7 @@
 #include "core/templates/paged_allocator.h"
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
+#include "core/templates/work_stealing_deque.h"
 
 class WorkerThreadPool : public Object {
 	GDCLASS(WorkerThreadPool, Object)
@@ -107,6 +108,14 @@ private:
 
 	BinaryMutex task_mutex;
 
+	static const uint32_t LOCAL_QUEUE_CAPACITY = 1024;
+	// After this many tasks taken from the local deques in a row, the global queue is checked first,
+	// so tasks posted from outside the pool can't be starved by workers feeding themselves.
+	static const uint32_t MAX_LOCAL_TASK_STREAK = 32;
+	static const uint32_t GLOBAL_QUEUE_BATCH_SIZE = 8;
+
+	typedef WorkStealingDeque<Task *, LOCAL_QUEUE_CAPACITY> LocalQueue;
+
 	struct ThreadData {
 		static Task *const YIELDING; // Too bad constexpr doesn't work here.
 
@@ -119,6 +128,10 @@ private:
 		Task *current_task = nullptr;
 		Task *awaited_task = nullptr; // Null if not awaiting the condition variable, or special value (YIELDING).
 		ConditionVariable cond_var;
+		// Work-stealing mode only.
+		LocalQueue *local_queue = nullptr; // Pushed to only by this thread, with task_mutex locked.
+		uint32_t steal_index = 0; // Rotates the first victim to try.
+		uint32_t local_task_streak = 0;
 
 		ThreadData() :
 				signaled(false),
@@ -166,6 +179,8 @@ private:
 
 	uint64_t last_task = 1;
 
+	bool use_work_stealing = false;
+
 	static void _thread_function(void *p_user);
 
 	void _process_task(Task *task);
@@ -175,6 +190,10 @@ private:
 
 	bool _try_promote_low_priority_task();
 
+	Task *_pop_or_steal_task(ThreadData *p_thread_data);
+	void _grab_global_tasks(ThreadData *p_thread_data);
+	bool _has_local_tasks() const;
+
 	static WorkerThreadPool *singleton;
 
 #ifdef THREADS_ENABLED
@@ -266,6 +285,8 @@ public:
 #endif
 	}
 
+	_FORCE_INLINE_ bool is_using_work_stealing() const { return use_work_stealing; }
+
 	static WorkerThreadPool *get_singleton() { return singleton; }
 	static int get_thread_index();
 	static TaskID get_caller_task_id();
@@ -282,7 +303,7 @@ public:
 	static void thread_exit_unlock_allowance_zone(uint32_t p_zone_id) {}
 #endif
 
-	void init(int p_thread_count = -1, float p_low_priority_task_ratio = 0.3);
+	void init(int p_thread_count = -1, float p_low_priority_task_ratio = 0.3, bool p_use_work_stealing = false);
 	void exit_languages_threads();
 	void finish();
 	WorkerThreadPool();
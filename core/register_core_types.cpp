@@ -309,6 +309,7 @@ void register_core_settings() {
 
 	GLOBAL_DEF("threading/worker_pool/max_threads", -1);
 	GLOBAL_DEF("threading/worker_pool/low_priority_thread_ratio", 0.3);
+	GLOBAL_DEF("threading/worker_pool/use_work_stealing", false);
 }
 
 void register_early_core_singletons() {
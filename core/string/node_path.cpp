@@ -30,6 +30,7 @@
 
 #include "node_path.h"
 
+#include "core/string/string_builder.h"
 #include "core/variant/variant.h"
 
 void NodePath::_update_hash_cache() const {
@@ -174,23 +175,24 @@ NodePath::operator String() const {
 		return String();
 	}
 
-	String ret;
+	StringBuilder ret(StringBuilder::STORAGE_SCRATCH_ARENA);
 	if (data->absolute) {
-		ret = "/";
+		ret += U'/';
 	}
 
 	for (int i = 0; i < data->path.size(); i++) {
 		if (i > 0) {
-			ret += "/";
+			ret += U'/';
 		}
 		ret += data->path[i].operator String();
 	}
 
 	for (int i = 0; i < data->subpath.size(); i++) {
-		ret += ":" + data->subpath[i].operator String();
+		ret += U':';
+		ret += data->subpath[i].operator String();
 	}
 
-	return ret;
+	return ret.as_string();
 }
 
 Vector<StringName> NodePath::get_names() const {
@@ -212,15 +214,15 @@ StringName NodePath::get_concatenated_names() const {
 
 	if (!data->concatenated_path) {
 		int pc = data->path.size();
-		String concatenated;
+		StringBuilder concatenated(StringBuilder::STORAGE_SCRATCH_ARENA);
 		const StringName *sn = data->path.ptr();
 		for (int i = 0; i < pc; i++) {
 			if (i > 0) {
-				concatenated += "/";
+				concatenated += U'/';
 			}
 			concatenated += sn[i].operator String();
 		}
-		data->concatenated_path = concatenated;
+		data->concatenated_path = concatenated.as_string();
 	}
 	return data->concatenated_path;
 }
@@ -230,15 +232,15 @@ StringName NodePath::get_concatenated_subnames() const {
 
 	if (!data->concatenated_subpath) {
 		int spc = data->subpath.size();
-		String concatenated;
+		StringBuilder concatenated(StringBuilder::STORAGE_SCRATCH_ARENA);
 		const StringName *ssn = data->subpath.ptr();
 		for (int i = 0; i < spc; i++) {
 			if (i > 0) {
-				concatenated += ":";
+				concatenated += U':';
 			}
 			concatenated += ssn[i].operator String();
 		}
-		data->concatenated_subpath = concatenated;
+		data->concatenated_subpath = concatenated.as_string();
 	}
 	return data->concatenated_subpath;
 }
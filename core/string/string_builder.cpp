@@ -32,30 +32,110 @@
 
 #include <string.h>
 
+thread_local StringBuilder::ScratchArena StringBuilder::scratch_arena;
+
+StringBuilder::ScratchArena::~ScratchArena() {
+	if (memory) {
+		memfree(memory);
+	}
+}
+
+void StringBuilder::_grow(uint32_t p_min_capacity) {
+	uint32_t new_capacity = capacity * 2;
+	while (new_capacity < p_min_capacity) {
+		new_capacity *= 2;
+	}
+
+	if (storage == STORAGE_SCRATCH_ARENA) {
+		ScratchArena &arena = scratch_arena;
+		if (!arena.memory) {
+			arena.memory = (char32_t *)memalloc(SCRATCH_ARENA_CAPACITY * sizeof(char32_t));
+		}
+
+		if (buffer_in_arena && buffer + capacity == arena.memory + arena.top) {
+			// Topmost allocation, extend it in place.
+			const uint32_t offset = buffer - arena.memory;
+			if (offset + new_capacity <= SCRATCH_ARENA_CAPACITY) {
+				arena.top = offset + new_capacity;
+				capacity = new_capacity;
+				return;
+			}
+		} else if (arena.top + new_capacity <= SCRATCH_ARENA_CAPACITY) {
+			char32_t *new_buffer = arena.memory + arena.top;
+			memcpy(new_buffer, _get_buffer(), string_length * sizeof(char32_t));
+			_release_buffer();
+			arena.top += new_capacity;
+			buffer = new_buffer;
+			buffer_in_arena = true;
+			capacity = new_capacity;
+			return;
+		}
+		// The arena is exhausted, continue on the heap.
+	}
+
+	if (buffer && !buffer_in_arena) {
+		buffer = (char32_t *)memrealloc(buffer, new_capacity * sizeof(char32_t));
+	} else {
+		char32_t *new_buffer = (char32_t *)memalloc(new_capacity * sizeof(char32_t));
+		memcpy(new_buffer, _get_buffer(), string_length * sizeof(char32_t));
+		_release_buffer();
+		buffer = new_buffer;
+	}
+	capacity = new_capacity;
+}
+
+void StringBuilder::_release_buffer() {
+	if (!buffer) {
+		return;
+	}
+
+	if (buffer_in_arena) {
+		// Only the topmost allocation can be given back; anything below it is
+		// reclaimed once the last scratch builder on this thread goes away.
+		ScratchArena &arena = scratch_arena;
+		if (buffer + capacity == arena.memory + arena.top) {
+			arena.top = buffer - arena.memory;
+		}
+		buffer_in_arena = false;
+	} else {
+		memfree(buffer);
+	}
+	buffer = nullptr;
+}
+
 StringBuilder &StringBuilder::append(const String &p_string) {
 	if (p_string.is_empty()) {
 		return *this;
 	}
 
-	strings.push_back(p_string);
-	appended_strings.push_back(-1);
-
-	string_length += p_string.length();
+	const uint32_t len = p_string.length();
+	memcpy(_append_space(len), p_string.ptr(), len * sizeof(char32_t));
 
 	return *this;
 }
 
 StringBuilder &StringBuilder::append(const char *p_cstring) {
-	int32_t len = strlen(p_cstring);
+	const uint32_t len = strlen(p_cstring);
+	char32_t *dst = _append_space(len);
+
+	for (uint32_t i = 0; i < len; i++) {
+		dst[i] = (uint8_t)p_cstring[i];
+	}
 
-	c_strings.push_back(p_cstring);
-	appended_strings.push_back(len);
+	return *this;
+}
 
-	string_length += len;
+StringBuilder &StringBuilder::append(char32_t p_char) {
+	*_append_space(1) = p_char;
 
 	return *this;
 }
 
+void StringBuilder::clear() {
+	string_length = 0;
+	appended_count = 0;
+}
+
 String StringBuilder::as_string() const {
 	if (string_length == 0) {
 		return "";
@@ -63,38 +143,46 @@ String StringBuilder::as_string() const {
 
 	String string;
 	string.resize(string_length + 1);
-	char32_t *buffer = string.ptrw();
-
-	int current_position = 0;
-
-	int godot_string_elem = 0;
-	int c_string_elem = 0;
+	char32_t *dst = string.ptrw();
 
-	for (uint32_t i = 0; i < appended_strings.size(); i++) {
-		const int32_t str_len = appended_strings[i];
+	memcpy(dst, _get_buffer(), string_length * sizeof(char32_t));
+	dst[string_length] = 0;
 
-		if (str_len == -1) {
-			// Godot string
-			const String &s = strings[godot_string_elem];
-
-			memcpy(buffer + current_position, s.ptr(), s.length() * sizeof(char32_t));
+	return string;
+}
 
-			current_position += s.length();
+void StringBuilder::operator=(const StringBuilder &p_from) {
+	if (this == &p_from) {
+		return;
+	}
 
-			godot_string_elem++;
-		} else {
-			const char *s = c_strings[c_string_elem];
+	clear();
+	if (p_from.string_length > capacity) {
+		_grow(p_from.string_length);
+	}
+	memcpy(_get_buffer(), p_from._get_buffer(), p_from.string_length * sizeof(char32_t));
+	string_length = p_from.string_length;
+	appended_count = p_from.appended_count;
+}
 
-			for (int32_t j = 0; j < str_len; j++) {
-				buffer[current_position + j] = s[j];
-			}
+StringBuilder::StringBuilder(const StringBuilder &p_from) {
+	*this = p_from;
+}
 
-			current_position += str_len;
+StringBuilder::StringBuilder(Storage p_storage) {
+	storage = p_storage;
+	if (storage == STORAGE_SCRATCH_ARENA) {
+		scratch_arena.builders++;
+	}
+}
 
-			c_string_elem++;
+StringBuilder::~StringBuilder() {
+	_release_buffer();
+	if (storage == STORAGE_SCRATCH_ARENA) {
+		ScratchArena &arena = scratch_arena;
+		arena.builders--;
+		if (arena.builders == 0) {
+			arena.top = 0;
 		}
 	}
-	buffer[current_position] = 0;
-
-	return string;
 }
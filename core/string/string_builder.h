@@ -32,21 +32,62 @@
 #define STRING_BUILDER_H
 
 #include "core/string/ustring.h"
-#include "core/templates/local_vector.h"
 
 class StringBuilder {
+public:
+	enum Storage {
+		// Characters spill over to the heap once the inline buffer is full.
+		STORAGE_HEAP,
+		// Characters spill over to a per-thread scratch arena, so no heap allocation
+		// happens before as_string(). Only use this for builders that live on the
+		// stack of a single function and never cross threads.
+		STORAGE_SCRATCH_ARENA,
+	};
+
+private:
+	static constexpr uint32_t INLINE_CAPACITY = 64;
+	static constexpr uint32_t SCRATCH_ARENA_CAPACITY = 16384; // In characters.
+
+	struct ScratchArena {
+		char32_t *memory = nullptr;
+		uint32_t top = 0;
+		uint32_t builders = 0;
+
+		~ScratchArena();
+	};
+
+	static thread_local ScratchArena scratch_arena;
+
+	// `buffer` is null while the characters live in `inline_buffer`, so the builder
+	// holds no pointer to itself and can be relocated by containers.
+	char32_t *buffer = nullptr;
+	uint32_t capacity = INLINE_CAPACITY;
 	uint32_t string_length = 0;
-
-	LocalVector<String> strings;
-	LocalVector<const char *> c_strings;
-
-	// -1 means it's a Godot String
-	// a natural number means C string.
-	LocalVector<int32_t> appended_strings;
+	int appended_count = 0;
+	Storage storage = STORAGE_HEAP;
+	bool buffer_in_arena = false;
+	char32_t inline_buffer[INLINE_CAPACITY];
+
+	_FORCE_INLINE_ char32_t *_get_buffer() { return buffer ? buffer : inline_buffer; }
+	_FORCE_INLINE_ const char32_t *_get_buffer() const { return buffer ? buffer : inline_buffer; }
+
+	void _grow(uint32_t p_min_capacity);
+	void _release_buffer();
+
+	_FORCE_INLINE_ char32_t *_append_space(uint32_t p_length) {
+		if (unlikely(string_length + p_length > capacity)) {
+			_grow(string_length + p_length);
+		}
+		char32_t *ret = _get_buffer() + string_length;
+		string_length += p_length;
+		appended_count++;
+		return ret;
+	}
 
 public:
 	StringBuilder &append(const String &p_string);
 	StringBuilder &append(const char *p_cstring);
+	StringBuilder &append(char32_t p_char);
 
 	_FORCE_INLINE_ StringBuilder &operator+(const String &p_string) {
 		return append(p_string);
@@ -64,21 +105,32 @@ public:
 		append(p_cstring);
 	}
 
+	_FORCE_INLINE_ void operator+=(char32_t p_char) {
+		append(p_char);
+	}
+
 	_FORCE_INLINE_ int num_strings_appended() const {
-		return appended_strings.size();
+		return appended_count;
 	}
 
 	_FORCE_INLINE_ uint32_t get_string_length() const {
 		return string_length;
 	}
 
+	void clear();
+
 	String as_string() const;
 
 	_FORCE_INLINE_ operator String() const {
 		return as_string();
 	}
 
-	StringBuilder() {}
+	void operator=(const StringBuilder &p_from);
+
+	// Copies always use heap storage, as they may outlive the scope of the original.
+	StringBuilder(const StringBuilder &p_from);
+	StringBuilder(Storage p_storage = STORAGE_HEAP);
+	~StringBuilder();
 };
 
 #endif // STRING_BUILDER_H
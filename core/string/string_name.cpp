@@ -70,7 +70,7 @@ StringName _scs_create(const char *p_chr, bool p_static) {
 void StringName::setup() {
 	ERR_FAIL_COND(configured);
 	for (int i = 0; i < STRING_TABLE_LEN; i++) {
-		_table[i] = nullptr;
+		_table[i].store(nullptr, std::memory_order_relaxed);
 	}
 	configured = true;
 }
@@ -82,10 +82,10 @@ void StringName::cleanup() {
 	if (unlikely(debug_stringname)) {
 		Vector<_Data *> data;
 		for (int i = 0; i < STRING_TABLE_LEN; i++) {
-			_Data *d = _table[i];
+			_Data *d = _table[i].load(std::memory_order_acquire);
 			while (d) {
 				data.push_back(d);
-				d = d->next;
+				d = d->next.load(std::memory_order_acquire);
 			}
 		}
 
@@ -109,9 +109,10 @@ void StringName::cleanup() {
 #endif
 	int lost_strings = 0;
 	for (int i = 0; i < STRING_TABLE_LEN; i++) {
-		while (_table[i]) {
-			_Data *d = _table[i];
-			if (d->static_count.get() != d->refcount.get()) {
+		_Data *d = _table[i].load(std::memory_order_acquire);
+		while (d) {
+			// Copies of immortal names are not counted, so they can't be told apart from leaks.
+			if (!d->immortal.is_set() && d->static_count.get() != d->refcount.get()) {
 				lost_strings++;
 
 				if (OS::get_singleton()->is_stdout_verbose()) {
@@ -121,9 +122,16 @@ void StringName::cleanup() {
 				}
 			}
 
-			_table[i] = _table[i]->next;
+			_Data *next = d->next.load(std::memory_order_acquire);
 			memdelete(d);
+			d = next;
 		}
+		_table[i].store(nullptr, std::memory_order_relaxed);
+	}
+	while (free_list) {
+		_Data *d = free_list;
+		free_list = d->prev;
+		memdelete(d);
 	}
 	if (lost_strings) {
 		print_verbose(vformat("StringName: %d unclaimed string names at exit.", lost_strings));
@@ -131,32 +139,137 @@ void StringName::cleanup() {
 	configured = false;
 }
 
-void StringName::unref() {
-	ERR_FAIL_COND(!configured);
-
-	if (_data && _data->refcount.unref()) {
-		MutexLock lock(mutex);
+template <typename T>
+StringName::_Data *StringName::_find(const T &p_name, uint32_t p_hash) {
+	_Data *d = _table[p_hash & STRING_TABLE_MASK].load(std::memory_order_acquire);
 
-		if (CoreGlobals::leak_reporting_enabled && _data->static_count.get() > 0) {
-			if (_data->cname) {
-				ERR_PRINT("BUG: Unreferenced static string to 0: " + String(_data->cname));
-			} else {
-				ERR_PRINT("BUG: Unreferenced static string to 0: " + String(_data->name));
+	for (int steps = 0; d && steps < LOCKLESS_MAX_STEPS; steps++) {
+		// Compare hash first.
+		if (d->hash.load(std::memory_order_relaxed) == p_hash && d->reference()) {
+			// Referenced entries are not recycled, so the name can be read safely now.
+			if (d->operator==(p_name)) {
+				return d;
 			}
+			// Hash collision, or the entry was recycled for another name while walking.
+			if (!d->immortal.is_set() && d->refcount.unref()) {
+				_release(d);
+			}
+		}
+		d = d->next.load(std::memory_order_acquire);
+	}
+
+	return nullptr;
+}
+
+template <typename T>
+StringName::_Data *StringName::_find_locked(const T &p_name, uint32_t p_hash) {
+	// With the lock held the chain can't change, so names can be compared before referencing.
+	_Data *d = _table[p_hash & STRING_TABLE_MASK].load(std::memory_order_relaxed);
+
+	while (d) {
+		// Compare hash first. An entry that fails to reference is being released.
+		if (d->hash.load(std::memory_order_relaxed) == p_hash && d->operator==(p_name) && d->reference()) {
+			return d;
+		}
+		d = d->next.load(std::memory_order_relaxed);
+	}
+
+	return nullptr;
+}
+
+StringName::_Data *StringName::_insert(const String &p_name, const char *p_cname, uint32_t p_hash, bool p_static) {
+	_Data *d = nullptr;
+	{
+		MutexLock free_lock(free_list_mutex);
+		if (free_list) {
+			d = free_list;
+			free_list = d->prev;
 		}
-		if (_data->prev) {
-			_data->prev->next = _data->next;
+	}
+	if (!d) {
+		d = memnew(_Data);
+	}
+
+	const uint32_t idx = p_hash & STRING_TABLE_MASK;
+
+	// Everything is set up before the reference count, as lock-free readers
+	// still walking through a recycled entry may reference it once it's non-zero.
+	d->name = p_name;
+	d->cname = p_cname;
+	d->hash.store(p_hash, std::memory_order_relaxed);
+	d->idx = idx;
+	d->static_count.set(p_static ? 1 : 0);
+	if (p_static) {
+		d->immortal.set();
+	}
+#ifdef DEBUG_ENABLED
+	if (unlikely(debug_stringname)) {
+		// Keep in memory, force static.
+		d->immortal.set();
+	}
+#endif
+	d->refcount.init();
+
+	_Data *head = _table[idx].load(std::memory_order_relaxed);
+	d->prev = nullptr;
+	d->next.store(head, std::memory_order_relaxed);
+	if (head) {
+		head->prev = d;
+	}
+	_table[idx].store(d, std::memory_order_release);
+
+	return d;
+}
+
+void StringName::_reference_found(_Data *p_data, bool p_static) {
+	if (p_static) {
+		p_data->static_count.increment();
+		p_data->immortal.set();
+	}
+#ifdef DEBUG_ENABLED
+	if (unlikely(debug_stringname)) {
+		p_data->debug_references++;
+	}
+#endif
+}
+
+void StringName::_release(_Data *p_data) {
+	const uint32_t idx = p_data->idx;
+	{
+		MutexLock lock(_get_table_lock(idx));
+
+		_Data *next = p_data->next.load(std::memory_order_relaxed);
+		if (p_data->prev) {
+			p_data->prev->next.store(next, std::memory_order_release);
 		} else {
-			if (_table[_data->idx] != _data) {
+			if (_table[idx].load(std::memory_order_relaxed) != p_data) {
 				ERR_PRINT("BUG!");
 			}
-			_table[_data->idx] = _data->next;
+			_table[idx].store(next, std::memory_order_release);
 		}
 
-		if (_data->next) {
-			_data->next->prev = _data->prev;
+		if (next) {
+			next->prev = p_data->prev;
 		}
-		memdelete(_data);
+	}
+
+	// `next` is left as is, lock-free readers may still be walking through this entry.
+	p_data->name = String();
+	p_data->cname = nullptr;
+#ifdef DEBUG_ENABLED
+	p_data->debug_references = 0;
+#endif
+
+	MutexLock free_lock(free_list_mutex);
+	p_data->prev = free_list;
+	free_list = p_data;
+}
+
+void StringName::unref() {
+	ERR_FAIL_COND(!configured);
+
+	if (_data && !_data->immortal.is_set() && _data->refcount.unref()) {
+		_release(_data);
 	}
 
 	_data = nullptr;
@@ -236,7 +349,7 @@ StringName &StringName::operator=(const StringName &p_name) {
 
 	unref();
 
-	if (p_name._data && p_name._data->refcount.ref()) {
+	if (p_name._data && p_name._data->reference()) {
 		_data = p_name._data;
 	}
 
@@ -248,7 +361,7 @@ StringName::StringName(const StringName &p_name) {
 
 	ERR_FAIL_COND(!configured);
 
-	if (p_name._data && p_name._data->refcount.ref()) {
+	if (p_name._data && p_name._data->reference()) {
 		_data = p_name._data;
 	}
 }
@@ -269,56 +382,20 @@ StringName::StringName(const char *p_name, bool p_static) {
 		return; //empty, ignore
 	}
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = String::hash(p_name);
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
+	const uint32_t hash = String::hash(p_name);
 
-	_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->operator==(p_name)) {
-			break;
+	_data = _find(p_name, hash);
+	if (!_data) {
+		MutexLock lock(_get_table_lock(hash));
+		_data = _find_locked(p_name, hash);
+		if (!_data) {
+			_data = _insert(String(p_name), nullptr, hash, p_static);
+			return;
 		}
-		_data = _data->next;
 	}
 
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return;
-	}
-
-	_data = memnew(_Data);
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = nullptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
-
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
-	}
-	_table[idx] = _data;
+	// exists
+	_reference_found(_data, p_static);
 }
 
 StringName::StringName(const StaticCString &p_static_string, bool p_static) {
@@ -328,55 +405,20 @@ StringName::StringName(const StaticCString &p_static_string, bool p_static) {
 
 	ERR_FAIL_COND(!p_static_string.ptr || !p_static_string.ptr[0]);
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = String::hash(p_static_string.ptr);
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
+	const uint32_t hash = String::hash(p_static_string.ptr);
 
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->operator==(p_static_string.ptr)) {
-			break;
+	_data = _find(p_static_string.ptr, hash);
+	if (!_data) {
+		MutexLock lock(_get_table_lock(hash));
+		_data = _find_locked(p_static_string.ptr, hash);
+		if (!_data) {
+			_data = _insert(String(), p_static_string.ptr, hash, p_static);
+			return;
 		}
-		_data = _data->next;
 	}
 
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return;
-	}
-
-	_data = memnew(_Data);
-
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = p_static_string.ptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
-	}
-	_table[idx] = _data;
+	// exists
+	_reference_found(_data, p_static);
 }
 
 StringName::StringName(const String &p_name, bool p_static) {
@@ -388,54 +430,20 @@ StringName::StringName(const String &p_name, bool p_static) {
 		return;
 	}
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = p_name.hash();
-	uint32_t idx = hash & STRING_TABLE_MASK;
+	const uint32_t hash = p_name.hash();
 
-	_data = _table[idx];
-
-	while (_data) {
-		if (_data->hash == hash && _data->operator==(p_name)) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
+	_data = _find(p_name, hash);
+	if (!_data) {
+		MutexLock lock(_get_table_lock(hash));
+		_data = _find_locked(p_name, hash);
+		if (!_data) {
+			_data = _insert(p_name, nullptr, hash, p_static);
+			return;
 		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return;
 	}
 
-	_data = memnew(_Data);
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = nullptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
-	}
-	_table[idx] = _data;
+	// exists
+	_reference_found(_data, p_static);
 }
 
 StringName StringName::search(const char *p_name) {
@@ -446,28 +454,17 @@ StringName StringName::search(const char *p_name) {
 		return StringName();
 	}
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = String::hash(p_name);
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
+	const uint32_t hash = String::hash(p_name);
 
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->operator==(p_name)) {
-			break;
-		}
-		_data = _data->next;
+	_Data *_data = _find(p_name, hash);
+	if (!_data) {
+		// The lock-free walk can miss entries while they are being recycled.
+		MutexLock lock(_get_table_lock(hash));
+		_data = _find_locked(p_name, hash);
 	}
 
-	if (_data && _data->refcount.ref()) {
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-
+	if (_data) {
+		_reference_found(_data, false);
 		return StringName(_data);
 	}
 
@@ -482,23 +479,16 @@ StringName StringName::search(const char32_t *p_name) {
 		return StringName();
 	}
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = String::hash(p_name);
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
+	const uint32_t hash = String::hash(p_name);
 
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->operator==(p_name)) {
-			break;
-		}
-		_data = _data->next;
+	_Data *_data = _find(p_name, hash);
+	if (!_data) {
+		// The lock-free walk can miss entries while they are being recycled.
+		MutexLock lock(_get_table_lock(hash));
+		_data = _find_locked(p_name, hash);
 	}
 
-	if (_data && _data->refcount.ref()) {
+	if (_data) {
 		return StringName(_data);
 	}
 
@@ -508,28 +498,17 @@ StringName StringName::search(const char32_t *p_name) {
 StringName StringName::search(const String &p_name) {
 	ERR_FAIL_COND_V(p_name.is_empty(), StringName());
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = p_name.hash();
+	const uint32_t hash = p_name.hash();
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->operator==(p_name)) {
-			break;
-		}
-		_data = _data->next;
+	_Data *_data = _find(p_name, hash);
+	if (!_data) {
+		// The lock-free walk can miss entries while they are being recycled.
+		MutexLock lock(_get_table_lock(hash));
+		_data = _find_locked(p_name, hash);
 	}
 
-	if (_data && _data->refcount.ref()) {
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
+	if (_data) {
+		_reference_found(_data, false);
 		return StringName(_data);
 	}
 
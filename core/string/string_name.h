@@ -48,12 +48,23 @@ class StringName {
 	enum {
 		STRING_TABLE_BITS = 16,
 		STRING_TABLE_LEN = 1 << STRING_TABLE_BITS,
-		STRING_TABLE_MASK = STRING_TABLE_LEN - 1
+		STRING_TABLE_MASK = STRING_TABLE_LEN - 1,
+		STRING_TABLE_LOCK_COUNT = 64,
+		// Chains are short; a longer lock-free walk means it strayed into recycled
+		// entries, and the lookup is retried under the lock.
+		LOCKLESS_MAX_STEPS = 64,
 	};
 
+	// Lookups walk the table without locking. To make that safe, entries are
+	// never freed while the table is configured: released entries are kept in a
+	// free list and reused for new names. A reader can only use an entry after
+	// taking a reference to it (which fails once it has been released), and
+	// compares the name afterwards.
 	struct _Data {
 		SafeRefCount refcount;
 		SafeNumeric<uint32_t> static_count;
+		// Static names are never released, so copies skip reference counting.
+		SafeFlag immortal;
 		const char *cname = nullptr;
 		String name;
 #ifdef DEBUG_ENABLED
@@ -65,18 +76,37 @@ class StringName {
 		bool operator==(const char *p_name) const;
 		bool operator!=(const char *p_name) const;
 
+		_FORCE_INLINE_ bool reference() { return immortal.is_set() || refcount.ref(); }
+
 		int idx = 0;
-		uint32_t hash = 0;
-		_Data *prev = nullptr;
-		_Data *next = nullptr;
+		std::atomic<uint32_t> hash = { 0 };
+		_Data *prev = nullptr; // Only accessed with the table lock held; links the free list too.
+		std::atomic<_Data *> next = { nullptr };
 		_Data() {}
 	};
 
-	static inline _Data *_table[STRING_TABLE_LEN];
+	static inline std::atomic<_Data *> _table[STRING_TABLE_LEN];
+	static inline BinaryMutex table_locks[STRING_TABLE_LOCK_COUNT];
+
+	static inline _Data *free_list = nullptr;
+	static inline BinaryMutex free_list_mutex;
 
 	_Data *_data = nullptr;
 
 	void unref();
+
+	_FORCE_INLINE_ static BinaryMutex &_get_table_lock(uint32_t p_hash) {
+		return table_locks[p_hash & (STRING_TABLE_LOCK_COUNT - 1)];
+	}
+
+	template <typename T>
+	static _Data *_find(const T &p_name, uint32_t p_hash);
+	template <typename T>
+	static _Data *_find_locked(const T &p_name, uint32_t p_hash);
+	static _Data *_insert(const String &p_name, const char *p_cname, uint32_t p_hash, bool p_static);
+	static void _reference_found(_Data *p_data, bool p_static);
+	static void _release(_Data *p_data);
+
 	friend void register_core_types();
 	friend void unregister_core_types();
 	friend class Main;
@@ -141,7 +171,7 @@ public:
 	}
 	_FORCE_INLINE_ uint32_t hash() const {
 		if (_data) {
-			return _data->hash;
+			return _data->hash.load(std::memory_order_relaxed);
 		} else {
 			return get_empty_hash();
 		}
@@ -0,0 +1,811 @@
+/**************************************************************************/
+/*  swiss_hash_map.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef SWISS_HASH_MAP_H
+#define SWISS_HASH_MAP_H
+
+#include "core/templates/hash_map.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SWISS_HASH_MAP_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define SWISS_HASH_MAP_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// Control bytes and group matching for SwissHashMap. A full slot stores the
+// top 7 bits of its hash (0..127); free slots have the sign bit set.
+struct SwissHashMapGroup {
+	static constexpr uint32_t SIZE = 16;
+	static constexpr int8_t CTRL_EMPTY = -128;
+	static constexpr int8_t CTRL_DELETED = -2;
+
+	// Set of matching slots in a group, lowest first.
+	struct Mask {
+#ifdef SWISS_HASH_MAP_NEON
+		// One bit every four, see _to_mask().
+		static constexpr uint32_t SHIFT = 2;
+#else
+		static constexpr uint32_t SHIFT = 0;
+#endif
+		uint64_t bits = 0;
+
+		_FORCE_INLINE_ explicit operator bool() const { return bits != 0; }
+		_FORCE_INLINE_ void clear_lowest() { bits &= bits - 1; }
+		_FORCE_INLINE_ uint32_t lowest() const {
+#if defined(__GNUC__) || defined(__clang__)
+			return uint32_t(__builtin_ctzll(bits)) >> SHIFT;
+#elif defined(_MSC_VER) && defined(_WIN64)
+			unsigned long index;
+			_BitScanForward64(&index, bits);
+			return uint32_t(index) >> SHIFT;
+#else
+			uint32_t index = 0;
+			while (!(bits & (uint64_t(1) << index))) {
+				index++;
+			}
+			return index >> SHIFT;
+#endif
+		}
+
+		_FORCE_INLINE_ explicit Mask(uint64_t p_bits) :
+				bits(p_bits) {}
+	};
+
+#if defined(SWISS_HASH_MAP_SSE2)
+	__m128i ctrl;
+
+	_FORCE_INLINE_ explicit SwissHashMapGroup(const int8_t *p_ctrl) {
+		ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_ctrl));
+	}
+	_FORCE_INLINE_ Mask match(int8_t p_h2) const {
+		return Mask(uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(p_h2), ctrl))));
+	}
+	_FORCE_INLINE_ Mask match_empty_or_deleted() const {
+		return Mask(uint32_t(_mm_movemask_epi8(ctrl)));
+	}
+#elif defined(SWISS_HASH_MAP_NEON)
+	int8x16_t ctrl;
+
+	// NEON has no movemask; narrowing by 4 bits leaves one nibble per byte.
+	static _FORCE_INLINE_ uint64_t _to_mask(uint8x16_t p_cmp) {
+		return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(p_cmp), 4)), 0) & 0x8888888888888888ull;
+	}
+
+	_FORCE_INLINE_ explicit SwissHashMapGroup(const int8_t *p_ctrl) {
+		ctrl = vld1q_s8(p_ctrl);
+	}
+	_FORCE_INLINE_ Mask match(int8_t p_h2) const {
+		return Mask(_to_mask(vceqq_s8(vdupq_n_s8(p_h2), ctrl)));
+	}
+	_FORCE_INLINE_ Mask match_empty_or_deleted() const {
+		return Mask(_to_mask(vcltzq_s8(ctrl)));
+	}
+#else
+	const int8_t *ctrl = nullptr;
+
+	_FORCE_INLINE_ explicit SwissHashMapGroup(const int8_t *p_ctrl) {
+		ctrl = p_ctrl;
+	}
+	_FORCE_INLINE_ Mask match(int8_t p_h2) const {
+		uint64_t bits = 0;
+		for (uint32_t i = 0; i < SIZE; i++) {
+			bits |= uint64_t(ctrl[i] == p_h2) << i;
+		}
+		return Mask(bits);
+	}
+	_FORCE_INLINE_ Mask match_empty_or_deleted() const {
+		uint64_t bits = 0;
+		for (uint32_t i = 0; i < SIZE; i++) {
+			bits |= uint64_t(ctrl[i] < 0) << i;
+		}
+		return Mask(bits);
+	}
+#endif
+
+	_FORCE_INLINE_ Mask match_empty() const {
+		return match(CTRL_EMPTY);
+	}
+};
+
+/**
+ * An open-addressing hash map in the style of Swiss tables. Slots are split
+ * in groups of 16, each with a byte of metadata, so that a single SSE2 or NEON
+ * comparison checks a whole group for candidates and only those go through
+ * the key comparator. This makes it well suited to lookup-heavy maps,
+ * especially when keys are expensive to compare or lookups often miss.
+ *
+ * Elements are kept in a dense array like AHashMap, and it has the same
+ * interface: iteration follows insertion order until an element is erased,
+ * in which case the last element takes its place, and elements can be
+ * accessed by index with `get_by_index`.
+ *
+ * Use HashMap if you need to keep an iterator or pointer to an element while
+ * adding or removing others, or need to preserve the insertion order when
+ * using erase.
+ */
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+class SwissHashMap {
+public:
+	// Must be a power of two, and no less than SwissHashMapGroup::SIZE.
+	static constexpr uint32_t INITIAL_CAPACITY = 16;
+	static_assert(INITIAL_CAPACITY >= SwissHashMapGroup::SIZE && (INITIAL_CAPACITY & (INITIAL_CAPACITY - 1)) == 0);
+
+private:
+	typedef KeyValue<TKey, TValue> MapKeyValue;
+	typedef SwissHashMapGroup Group;
+
+	MapKeyValue *elements = nullptr;
+	// Hash of each element, so rehashing and erasing don't have to hash keys again.
+	uint32_t *element_hashes = nullptr;
+	// Element index of each slot, followed in the same allocation by a control byte per slot.
+	uint32_t *slots = nullptr;
+	int8_t *ctrl = nullptr;
+
+	// Number of slots, a power of two.
+	uint32_t capacity = INITIAL_CAPACITY;
+	uint32_t num_elements = 0;
+	uint32_t num_deleted = 0;
+
+	static _FORCE_INLINE_ uint32_t _get_max_elements(uint32_t p_capacity) {
+		return p_capacity - p_capacity / 8; // 87.5% load factor.
+	}
+
+	static _FORCE_INLINE_ int8_t _get_h2(uint32_t p_hash) {
+		return int8_t(p_hash >> 25);
+	}
+
+	// Groups are visited in triangular order, which covers all of them since the group count is a power of two.
+	template <typename F>
+	_FORCE_INLINE_ void _probe(uint32_t p_hash, F &&p_visit) const {
+		const uint32_t group_mask = capacity / Group::SIZE - 1;
+		uint32_t group = p_hash & group_mask;
+		for (uint32_t step = 1;; step++) {
+			if (p_visit(group * Group::SIZE)) {
+				return;
+			}
+			group = (group + step) & group_mask;
+		}
+	}
+
+	bool _lookup_pos(const TKey &p_key, uint32_t &r_pos, uint32_t &r_slot) const {
+		if (unlikely(elements == nullptr)) {
+			return false; // Failed lookups, no elements.
+		}
+		return _lookup_pos_with_hash(p_key, r_pos, r_slot, Hasher::hash(p_key));
+	}
+
+	bool _lookup_pos_with_hash(const TKey &p_key, uint32_t &r_pos, uint32_t &r_slot, uint32_t p_hash) const {
+		if (unlikely(elements == nullptr)) {
+			return false; // Failed lookups, no elements.
+		}
+
+		const int8_t h2 = _get_h2(p_hash);
+		bool found = false;
+		_probe(p_hash, [&](uint32_t p_base) {
+			const Group group(ctrl + p_base);
+			for (Group::Mask match = group.match(h2); match; match.clear_lowest()) {
+				const uint32_t slot = p_base + match.lowest();
+				const uint32_t pos = slots[slot];
+				if (Comparator::compare(elements[pos].key, p_key)) {
+					r_pos = pos;
+					r_slot = slot;
+					found = true;
+					return true;
+				}
+			}
+			// A group with an empty slot ends every probe sequence going through it.
+			return bool(group.match_empty());
+		});
+		return found;
+	}
+
+	// Finds the slot pointing to the element at `p_pos`, without comparing keys.
+	uint32_t _find_slot_of(uint32_t p_pos) const {
+		const uint32_t hash = element_hashes[p_pos];
+		const int8_t h2 = _get_h2(hash);
+		uint32_t ret = 0;
+		_probe(hash, [&](uint32_t p_base) {
+			for (Group::Mask match = Group(ctrl + p_base).match(h2); match; match.clear_lowest()) {
+				const uint32_t slot = p_base + match.lowest();
+				if (slots[slot] == p_pos) {
+					ret = slot;
+					return true;
+				}
+			}
+			return false;
+		});
+		return ret;
+	}
+
+	// Takes the first free slot in the probe sequence. There must be room for it.
+	void _insert_slot(uint32_t p_hash, uint32_t p_pos) {
+		uint32_t slot = 0;
+		_probe(p_hash, [&](uint32_t p_base) {
+			const Group::Mask free = Group(ctrl + p_base).match_empty_or_deleted();
+			if (free) {
+				slot = p_base + free.lowest();
+				return true;
+			}
+			return false;
+		});
+
+		if (ctrl[slot] == Group::CTRL_DELETED) {
+			num_deleted--;
+		}
+		ctrl[slot] = _get_h2(p_hash);
+		slots[slot] = p_pos;
+	}
+
+	void _erase_slot(uint32_t p_slot) {
+		// If the group still has an empty slot, no probe sequence goes past it,
+		// so the slot can be freed without leaving a tombstone.
+		if (Group(ctrl + (p_slot & ~(Group::SIZE - 1))).match_empty()) {
+			ctrl[p_slot] = Group::CTRL_EMPTY;
+		} else {
+			ctrl[p_slot] = Group::CTRL_DELETED;
+			num_deleted++;
+		}
+	}
+
+	void _allocate_slots() {
+		slots = reinterpret_cast<uint32_t *>(Memory::alloc_static((sizeof(uint32_t) + sizeof(int8_t)) * capacity));
+		ctrl = reinterpret_cast<int8_t *>(slots + capacity);
+		memset(ctrl, Group::CTRL_EMPTY, capacity);
+		num_deleted = 0;
+	}
+
+	void _resize_and_rehash(uint32_t p_new_capacity) {
+		uint32_t *old_slots = slots;
+
+		if (p_new_capacity != capacity) {
+			capacity = p_new_capacity;
+			elements = reinterpret_cast<MapKeyValue *>(Memory::realloc_static(elements, sizeof(MapKeyValue) * _get_max_elements(capacity)));
+			element_hashes = reinterpret_cast<uint32_t *>(Memory::realloc_static(element_hashes, sizeof(uint32_t) * _get_max_elements(capacity)));
+		}
+
+		_allocate_slots();
+		for (uint32_t i = 0; i < num_elements; i++) {
+			_insert_slot(element_hashes[i], i);
+		}
+
+		Memory::free_static(old_slots);
+	}
+
+	int32_t _insert_element(const TKey &p_key, const TValue &p_value, uint32_t p_hash) {
+		if (unlikely(elements == nullptr)) {
+			// Allocate on demand to save memory.
+			elements = reinterpret_cast<MapKeyValue *>(Memory::alloc_static(sizeof(MapKeyValue) * _get_max_elements(capacity)));
+			element_hashes = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * _get_max_elements(capacity)));
+			_allocate_slots();
+		}
+
+		if (unlikely(num_elements + num_deleted + 1 > _get_max_elements(capacity))) {
+			// If tombstones take up enough of the space, clearing them is enough.
+			_resize_and_rehash(num_elements + 1 > capacity / 32 * 25 ? capacity * 2 : capacity);
+		}
+
+		memnew_placement(&elements[num_elements], MapKeyValue(p_key, p_value));
+		element_hashes[num_elements] = p_hash;
+
+		_insert_slot(p_hash, num_elements);
+		num_elements++;
+		return num_elements - 1;
+	}
+
+	void _init_from(const SwissHashMap &p_other) {
+		capacity = p_other.capacity;
+		num_elements = p_other.num_elements;
+		num_deleted = p_other.num_deleted;
+
+		if (p_other.elements == nullptr) {
+			return;
+		}
+
+		const uint32_t max_elements = _get_max_elements(capacity);
+		elements = reinterpret_cast<MapKeyValue *>(Memory::alloc_static(sizeof(MapKeyValue) * max_elements));
+		element_hashes = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * max_elements));
+		slots = reinterpret_cast<uint32_t *>(Memory::alloc_static((sizeof(uint32_t) + sizeof(int8_t)) * capacity));
+		ctrl = reinterpret_cast<int8_t *>(slots + capacity);
+
+		if constexpr (std::is_trivially_copyable_v<TKey> && std::is_trivially_copyable_v<TValue>) {
+			void *destination = elements;
+			const void *source = p_other.elements;
+			memcpy(destination, source, sizeof(MapKeyValue) * num_elements);
+		} else {
+			for (uint32_t i = 0; i < num_elements; i++) {
+				memnew_placement(&elements[i], MapKeyValue(p_other.elements[i]));
+			}
+		}
+
+		memcpy(element_hashes, p_other.element_hashes, sizeof(uint32_t) * num_elements);
+		memcpy(slots, p_other.slots, (sizeof(uint32_t) + sizeof(int8_t)) * capacity);
+	}
+
+public:
+	/* Standard Godot Container API */
+
+	_FORCE_INLINE_ uint32_t get_capacity() const { return capacity; }
+	_FORCE_INLINE_ uint32_t size() const { return num_elements; }
+
+	_FORCE_INLINE_ bool is_empty() const {
+		return num_elements == 0;
+	}
+
+	void clear() {
+		if (elements == nullptr || num_elements == 0) {
+			return;
+		}
+
+		memset(ctrl, Group::CTRL_EMPTY, capacity);
+		if constexpr (!(std::is_trivially_destructible_v<TKey> && std::is_trivially_destructible_v<TValue>)) {
+			for (uint32_t i = 0; i < num_elements; i++) {
+				elements[i].key.~TKey();
+				elements[i].value.~TValue();
+			}
+		}
+
+		num_elements = 0;
+		num_deleted = 0;
+	}
+
+	TValue &get(const TKey &p_key) {
+		uint32_t pos = 0;
+		uint32_t slot = 0;
+		bool exists = _lookup_pos(p_key, pos, slot);
+		CRASH_COND_MSG(!exists, "SwissHashMap key not found.");
+		return elements[pos].value;
+	}
+
+	const TValue &get(const TKey &p_key) const {
+		uint32_t pos = 0;
+		uint32_t slot = 0;
+		bool exists = _lookup_pos(p_key, pos, slot);
+		CRASH_COND_MSG(!exists, "SwissHashMap key not found.");
+		return elements[pos].value;
+	}
+
+	const TValue *getptr(const TKey &p_key) const {
+		uint32_t pos = 0;
+		uint32_t slot = 0;
+		bool exists = _lookup_pos(p_key, pos, slot);
+
+		if (exists) {
+			return &elements[pos].value;
+		}
+		return nullptr;
+	}
+
+	TValue *getptr(const TKey &p_key) {
+		uint32_t pos = 0;
+		uint32_t slot = 0;
+		bool exists = _lookup_pos(p_key, pos, slot);
+
+		if (exists) {
+			return &elements[pos].value;
+		}
+		return nullptr;
+	}
+
+	bool has(const TKey &p_key) const {
+		uint32_t pos = 0;
+		uint32_t slot = 0;
+		return _lookup_pos(p_key, pos, slot);
+	}
+
+	bool erase(const TKey &p_key) {
+		uint32_t element_pos = 0;
+		uint32_t slot = 0;
+		bool exists = _lookup_pos(p_key, element_pos, slot);
+
+		if (!exists) {
+			return false;
+		}
+
+		_erase_slot(slot);
+		elements[element_pos].key.~TKey();
+		elements[element_pos].value.~TValue();
+		num_elements--;
+
+		if (element_pos < num_elements) {
+			// Move the last element into the hole and repoint its slot.
+			void *destination = &elements[element_pos];
+			const void *source = &elements[num_elements];
+			memcpy(destination, source, sizeof(MapKeyValue));
+			element_hashes[element_pos] = element_hashes[num_elements];
+			slots[_find_slot_of(num_elements)] = element_pos;
+		}
+
+		return true;
+	}
+
+	// Replace the key of an entry in-place, without invalidating iterators or changing the entries position during iteration.
+	// p_old_key must exist in the map and p_new_key must not, unless it is equal to p_old_key.
+	bool replace_key(const TKey &p_old_key, const TKey &p_new_key) {
+		if (p_old_key == p_new_key) {
+			return true;
+		}
+		uint32_t element_pos = 0;
+		uint32_t slot = 0;
+		ERR_FAIL_COND_V(_lookup_pos(p_new_key, element_pos, slot), false);
+		ERR_FAIL_COND_V(!_lookup_pos(p_old_key, element_pos, slot), false);
+		MapKeyValue &element = elements[element_pos];
+		const_cast<TKey &>(element.key) = p_new_key;
+
+		_erase_slot(slot);
+		const uint32_t hash = Hasher::hash(p_new_key);
+		element_hashes[element_pos] = hash;
+		if (unlikely(num_elements + num_deleted > _get_max_elements(capacity))) {
+			_resize_and_rehash(capacity); // Reinserts the element as well.
+		} else {
+			_insert_slot(hash, element_pos);
+		}
+
+		return true;
+	}
+
+	// Reserves space for a number of elements, useful to avoid many resizes and rehashes.
+	// If adding a known (possibly large) number of elements at once, must be larger than old capacity.
+	void reserve(uint32_t p_new_capacity) {
+		ERR_FAIL_COND_MSG(p_new_capacity < get_capacity(), "It is impossible to reserve less capacity than is currently available.");
+		uint32_t new_capacity = capacity;
+		while (_get_max_elements(new_capacity) < p_new_capacity) {
+			new_capacity *= 2;
+		}
+		if (elements == nullptr) {
+			capacity = new_capacity;
+			return; // Unallocated yet.
+		}
+		if (new_capacity != capacity) {
+			_resize_and_rehash(new_capacity);
+		}
+	}
+
+	/** Iterator API **/
+
+	struct ConstIterator {
+		_FORCE_INLINE_ const MapKeyValue &operator*() const {
+			return *pair;
+		}
+		_FORCE_INLINE_ const MapKeyValue *operator->() const {
+			return pair;
+		}
+		_FORCE_INLINE_ ConstIterator &operator++() {
+			pair++;
+			return *this;
+		}
+
+		_FORCE_INLINE_ ConstIterator &operator--() {
+			pair--;
+			if (pair < begin) {
+				pair = end;
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const ConstIterator &b) const { return pair == b.pair; }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &b) const { return pair != b.pair; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return pair != end;
+		}
+
+		_FORCE_INLINE_ ConstIterator(MapKeyValue *p_key, MapKeyValue *p_begin, MapKeyValue *p_end) {
+			pair = p_key;
+			begin = p_begin;
+			end = p_end;
+		}
+		_FORCE_INLINE_ ConstIterator() {}
+		_FORCE_INLINE_ ConstIterator(const ConstIterator &p_it) {
+			pair = p_it.pair;
+			begin = p_it.begin;
+			end = p_it.end;
+		}
+		_FORCE_INLINE_ void operator=(const ConstIterator &p_it) {
+			pair = p_it.pair;
+			begin = p_it.begin;
+			end = p_it.end;
+		}
+
+	private:
+		MapKeyValue *pair = nullptr;
+		MapKeyValue *begin = nullptr;
+		MapKeyValue *end = nullptr;
+	};
+
+	struct Iterator {
+		_FORCE_INLINE_ MapKeyValue &operator*() const {
+			return *pair;
+		}
+		_FORCE_INLINE_ MapKeyValue *operator->() const {
+			return pair;
+		}
+		_FORCE_INLINE_ Iterator &operator++() {
+			pair++;
+			return *this;
+		}
+		_FORCE_INLINE_ Iterator &operator--() {
+			pair--;
+			if (pair < begin) {
+				pair = end;
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const Iterator &b) const { return pair == b.pair; }
+		_FORCE_INLINE_ bool operator!=(const Iterator &b) const { return pair != b.pair; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return pair != end;
+		}
+
+		_FORCE_INLINE_ Iterator(MapKeyValue *p_key, MapKeyValue *p_begin, MapKeyValue *p_end) {
+			pair = p_key;
+			begin = p_begin;
+			end = p_end;
+		}
+		_FORCE_INLINE_ Iterator() {}
+		_FORCE_INLINE_ Iterator(const Iterator &p_it) {
+			pair = p_it.pair;
+			begin = p_it.begin;
+			end = p_it.end;
+		}
+		_FORCE_INLINE_ void operator=(const Iterator &p_it) {
+			pair = p_it.pair;
+			begin = p_it.begin;
+			end = p_it.end;
+		}
+
+		operator ConstIterator() const {
+			return ConstIterator(pair, begin, end);
+		}
+
+	private:
+		MapKeyValue *pair = nullptr;
+		MapKeyValue *begin = nullptr;
+		MapKeyValue *end = nullptr;
+	};
+
+	_FORCE_INLINE_ Iterator begin() {
+		return Iterator(elements, elements, elements + num_elements);
+	}
+	_FORCE_INLINE_ Iterator end() {
+		return Iterator(elements + num_elements, elements, elements + num_elements);
+	}
+	_FORCE_INLINE_ Iterator last() {
+		if (unlikely(num_elements == 0)) {
+			return Iterator(nullptr, nullptr, nullptr);
+		}
+		return Iterator(elements + num_elements - 1, elements, elements + num_elements);
+	}
+
+	Iterator find(const TKey &p_key) {
+		uint32_t pos = 0;
+		uint32_t slot = 0;
+		bool exists = _lookup_pos(p_key, pos, slot);
+		if (!exists) {
+			return end();
+		}
+		return Iterator(elements + pos, elements, elements + num_elements);
+	}
+
+	void remove(const Iterator &p_iter) {
+		if (p_iter) {
+			erase(p_iter->key);
+		}
+	}
+
+	_FORCE_INLINE_ ConstIterator begin() const {
+		return ConstIterator(elements, elements, elements + num_elements);
+	}
+	_FORCE_INLINE_ ConstIterator end() const {
+		return ConstIterator(elements + num_elements, elements, elements + num_elements);
+	}
+	_FORCE_INLINE_ ConstIterator last() const {
+		if (unlikely(num_elements == 0)) {
+			return ConstIterator(nullptr, nullptr, nullptr);
+		}
+		return ConstIterator(elements + num_elements - 1, elements, elements + num_elements);
+	}
+
+	ConstIterator find(const TKey &p_key) const {
+		uint32_t pos = 0;
+		uint32_t slot = 0;
+		bool exists = _lookup_pos(p_key, pos, slot);
+		if (!exists) {
+			return end();
+		}
+		return ConstIterator(elements + pos, elements, elements + num_elements);
+	}
+
+	/* Indexing */
+
+	const TValue &operator[](const TKey &p_key) const {
+		uint32_t pos = 0;
+		uint32_t slot = 0;
+		bool exists = _lookup_pos(p_key, pos, slot);
+		CRASH_COND(!exists);
+		return elements[pos].value;
+	}
+
+	TValue &operator[](const TKey &p_key) {
+		uint32_t pos = 0;
+		uint32_t slot = 0;
+		uint32_t hash = Hasher::hash(p_key);
+		bool exists = _lookup_pos_with_hash(p_key, pos, slot, hash);
+
+		if (exists) {
+			return elements[pos].value;
+		} else {
+			pos = _insert_element(p_key, TValue(), hash);
+			return elements[pos].value;
+		}
+	}
+
+	/* Insert */
+
+	Iterator insert(const TKey &p_key, const TValue &p_value) {
+		uint32_t pos = 0;
+		uint32_t slot = 0;
+		uint32_t hash = Hasher::hash(p_key);
+		bool exists = _lookup_pos_with_hash(p_key, pos, slot, hash);
+
+		if (!exists) {
+			pos = _insert_element(p_key, p_value, hash);
+		} else {
+			elements[pos].value = p_value;
+		}
+		return Iterator(elements + pos, elements, elements + num_elements);
+	}
+
+	// Inserts an element without checking if it already exists.
+	Iterator insert_new(const TKey &p_key, const TValue &p_value) {
+		DEV_ASSERT(!has(p_key));
+		uint32_t hash = Hasher::hash(p_key);
+		uint32_t pos = _insert_element(p_key, p_value, hash);
+		return Iterator(elements + pos, elements, elements + num_elements);
+	}
+
+	/* Array methods. */
+
+	// Unsafe. Changing keys and going outside the bounds of an array can lead to undefined behavior.
+	KeyValue<TKey, TValue> *get_elements_ptr() {
+		return elements;
+	}
+
+	// Returns the element index. If not found, returns -1.
+	int get_index(const TKey &p_key) {
+		uint32_t pos = 0;
+		uint32_t slot = 0;
+		bool exists = _lookup_pos(p_key, pos, slot);
+		if (!exists) {
+			return -1;
+		}
+		return pos;
+	}
+
+	KeyValue<TKey, TValue> &get_by_index(uint32_t p_index) {
+		CRASH_BAD_UNSIGNED_INDEX(p_index, num_elements);
+		return elements[p_index];
+	}
+
+	bool erase_by_index(uint32_t p_index) {
+		if (p_index >= size()) {
+			return false;
+		}
+		return erase(elements[p_index].key);
+	}
+
+	/* Constructors */
+
+	SwissHashMap(const SwissHashMap &p_other) {
+		_init_from(p_other);
+	}
+
+	SwissHashMap(const HashMap<TKey, TValue> &p_other) {
+		reserve(p_other.size());
+		for (const KeyValue<TKey, TValue> &E : p_other) {
+			_insert_element(E.key, E.value, Hasher::hash(E.key));
+		}
+	}
+
+	void operator=(const SwissHashMap &p_other) {
+		if (this == &p_other) {
+			return; // Ignore self assignment.
+		}
+
+		reset();
+
+		_init_from(p_other);
+	}
+
+	void operator=(const HashMap<TKey, TValue> &p_other) {
+		reset();
+		if (p_other.size() > get_capacity()) {
+			reserve(p_other.size());
+		}
+		for (const KeyValue<TKey, TValue> &E : p_other) {
+			_insert_element(E.key, E.value, Hasher::hash(E.key));
+		}
+	}
+
+	SwissHashMap(uint32_t p_initial_capacity) {
+		// Capacity must be a power of two, and no less than a group.
+		capacity = next_power_of_2(MAX(INITIAL_CAPACITY, p_initial_capacity));
+	}
+	SwissHashMap() {}
+
+	SwissHashMap(std::initializer_list<KeyValue<TKey, TValue>> p_init) {
+		reserve(p_init.size());
+		for (const KeyValue<TKey, TValue> &E : p_init) {
+			insert(E.key, E.value);
+		}
+	}
+
+	void reset() {
+		if (elements != nullptr) {
+			if constexpr (!(std::is_trivially_destructible_v<TKey> && std::is_trivially_destructible_v<TValue>)) {
+				for (uint32_t i = 0; i < num_elements; i++) {
+					elements[i].key.~TKey();
+					elements[i].value.~TValue();
+				}
+			}
+			Memory::free_static(elements);
+			Memory::free_static(element_hashes);
+			Memory::free_static(slots);
+			elements = nullptr;
+			element_hashes = nullptr;
+			slots = nullptr;
+			ctrl = nullptr;
+		}
+		capacity = INITIAL_CAPACITY;
+		num_elements = 0;
+		num_deleted = 0;
+	}
+
+	~SwissHashMap() {
+		reset();
+	}
+};
+
+extern template class SwissHashMap<int, int>;
+extern template class SwissHashMap<String, int>;
+extern template class SwissHashMap<StringName, StringName>;
+extern template class SwissHashMap<StringName, Variant>;
+extern template class SwissHashMap<StringName, int>;
+
+#endif // SWISS_HASH_MAP_H
@@ -30,7 +30,9 @@
 
 #include "dictionary.h"
 
+#include "core/os/mutex.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/safe_refcount.h"
 #include "core/variant/container_type_validate.h"
 #include "core/variant/variant.h"
@@ -40,28 +42,327 @@
 #include "core/variant/type_info.h"
 #include "core/variant/variant_internal.h"
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Dictionaries that have the same string keys, inserted in the same order,
+// share a shape holding those keys and only store their values. Shapes form a
+// tree, inserting a new key moves a dictionary to a child shape.
+// A dictionary that diverges (erasing keys, sorting, non-string keys or too
+// many keys) moves its entries to its own hash map until it's cleared.
+struct DictionaryShape {
+	static constexpr uint32_t MAX_KEYS = 32;
+	// Limits the shapes created by dictionaries with unique keys. Not applied to the root.
+	static constexpr uint32_t MAX_CHILDREN = 64;
+
+	SafeRefCount refcount;
+	DictionaryShape *parent = nullptr;
+	LocalVector<Variant> keys;
+	LocalVector<uint32_t> key_hashes;
+
+	BinaryMutex children_mutex;
+	// By appended key, matched strictly so String and StringName keys are kept as inserted.
+	// Not referenced, children remove themselves when released.
+	HashMap<Variant, DictionaryShape *, VariantHasher, VariantComparator> children;
+
+	static DictionaryShape *get_root() {
+		// Never released, dictionaries can be destroyed at any point of the exit.
+		static DictionaryShape *root = memnew(DictionaryShape);
+		return root;
+	}
+
+	static _FORCE_INLINE_ bool is_valid_key(const Variant &p_key) {
+		return p_key.get_type() == Variant::STRING || p_key.get_type() == Variant::STRING_NAME;
+	}
+
+	int find(const Variant &p_key) const {
+		if (!is_valid_key(p_key)) {
+			return -1;
+		}
+		const uint32_t hash = p_key.hash();
+		for (uint32_t i = 0; i < keys.size(); i++) {
+			if (key_hashes[i] == hash && StringLikeVariantComparator::compare(keys[i], p_key)) {
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	// Returns a referenced shape with `p_key` appended, or null if this shape has too many children.
+	DictionaryShape *get_child(const Variant &p_key) {
+		const uint32_t hash = p_key.hash();
+
+		MutexLock lock(children_mutex);
+		DictionaryShape **existing = children.getptr(p_key);
+		// A child failing to reference is being released, and gets replaced.
+		if (existing && (*existing)->refcount.ref()) {
+			return *existing;
+		}
+		if (!existing && parent && children.size() >= MAX_CHILDREN) {
+			return nullptr;
+		}
+
+		DictionaryShape *child = memnew(DictionaryShape);
+		refcount.ref();
+		child->parent = this;
+		child->keys = keys;
+		child->keys.push_back(p_key);
+		child->key_hashes = key_hashes;
+		child->key_hashes.push_back(hash);
+		children[p_key] = child;
+		return child;
+	}
+
+	static void release(DictionaryShape *p_shape) {
+		while (p_shape->refcount.unref()) {
+			DictionaryShape *parent = p_shape->parent;
+			{
+				MutexLock lock(parent->children_mutex);
+				const Variant &key = p_shape->keys[p_shape->keys.size() - 1];
+				DictionaryShape **E = parent->children.getptr(key);
+				if (E && *E == p_shape) {
+					parent->children.erase(key);
+				}
+			}
+			memdelete(p_shape);
+			p_shape = parent;
+		}
+	}
+
+	DictionaryShape() {
+		refcount.init();
+	}
+};
+
 struct DictionaryPrivate {
 	SafeRefCount refcount;
 	Variant *read_only = nullptr; // If enabled, a pointer is used to a temporary value that is used to return read-only values.
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator> variant_map;
+	HashMap<Variant, Variant *, VariantHasher, StringLikeVariantComparator> variant_map;
 	ContainerTypeValidate typed_key;
 	ContainerTypeValidate typed_value;
 	Variant *typed_fallback = nullptr; // Allows a typed dictionary to return dummy values when attempting an invalid access.
+
+	// Unless `uses_map` is set, entries are the keys of `shape` (null when empty) and the first values.
+	bool uses_map = false;
+	DictionaryShape *shape = nullptr;
+
+	// Values live in pages, so they never move while in the dictionary, neither when it grows nor
+	// when it diverges to `variant_map`: `operator[]` and `getptr()` hand out pointers to them.
+	// Page `p` holds `2^p` values, so no more than about twice the values in use are allocated.
+	LocalVector<Variant *> value_pages;
+	uint32_t value_count = 0; // Values handed out, the value of the shape's key `i` is the `i`-th one.
+	LocalVector<Variant *> free_values; // Erased from `variant_map`, to be reused.
+
+	_FORCE_INLINE_ int size() const {
+		return uses_map ? variant_map.size() : value_count;
+	}
+
+	// The highest bit set in `p_index + 1`.
+	_FORCE_INLINE_ static uint32_t get_value_page(uint32_t p_index) {
+		const uint32_t position = p_index + 1;
+#if defined(__GNUC__)
+		return 31 - __builtin_clz(position);
+#elif defined(_MSC_VER)
+		unsigned long bit;
+		_BitScanReverse(&bit, position);
+		return bit;
+#else
+		uint32_t page = 0;
+		for (uint32_t rest = position >> 1; rest; rest >>= 1) {
+			page++;
+		}
+		return page;
+#endif
+	}
+
+	_FORCE_INLINE_ Variant *get_value(uint32_t p_index) const {
+		const uint32_t page = get_value_page(p_index);
+		return &value_pages[page][p_index + 1 - (1u << page)];
+	}
+
+	Variant *alloc_value() {
+		if (!free_values.is_empty()) {
+			Variant *value = free_values[free_values.size() - 1];
+			free_values.resize(free_values.size() - 1);
+			return value;
+		}
+		if (value_count == (1u << value_pages.size()) - 1) {
+			value_pages.push_back(memnew_arr(Variant, 1u << value_pages.size()));
+		}
+		return get_value(value_count++);
+	}
+
+	void pop_value() {
+		value_count--;
+		*get_value(value_count) = Variant();
+		if (value_count == (1u << (value_pages.size() - 1)) - 1) {
+			memdelete_arr(value_pages[value_pages.size() - 1]);
+			value_pages.resize(value_pages.size() - 1);
+		}
+	}
+
+	void reset_values() {
+		for (Variant *page : value_pages) {
+			memdelete_arr(page);
+		}
+		value_pages.clear();
+		free_values.clear();
+		value_count = 0;
+	}
+
+	Variant *find(const Variant &p_key) {
+		if (uses_map) {
+			Variant **value = variant_map.getptr(p_key);
+			return value ? *value : nullptr;
+		}
+		if (!shape) {
+			return nullptr;
+		}
+		const int index = shape->find(p_key);
+		return index >= 0 ? get_value(index) : nullptr;
+	}
+
+	// The key must not be in the dictionary yet. Returns the new value, which is null.
+	Variant *insert(const Variant &p_key) {
+		if (!uses_map) {
+			DictionaryShape *parent = shape ? shape : DictionaryShape::get_root();
+			DictionaryShape *child = nullptr;
+			if (parent->keys.size() < DictionaryShape::MAX_KEYS && DictionaryShape::is_valid_key(p_key)) {
+				child = parent->get_child(p_key);
+			}
+			if (child) {
+				if (shape) {
+					DictionaryShape::release(shape);
+				}
+				shape = child;
+				return alloc_value();
+			}
+			convert_to_map();
+		}
+		Variant *value = alloc_value();
+		variant_map.insert(p_key, value);
+		return value;
+	}
+
+	// The values stay where they are, only their keys move to the map.
+	void convert_to_map() {
+		if (uses_map) {
+			return;
+		}
+		uses_map = true;
+		if (!shape) {
+			return;
+		}
+		variant_map.reserve(value_count);
+		for (uint32_t i = 0; i < value_count; i++) {
+			variant_map.insert(shape->keys[i], get_value(i));
+		}
+		DictionaryShape::release(shape);
+		shape = nullptr;
+	}
+
+	bool erase(const Variant &p_key) {
+		if (!uses_map) {
+			const int index = shape ? shape->find(p_key) : -1;
+			if (index < 0) {
+				return false;
+			}
+			if (index + 1 < (int)value_count) {
+				convert_to_map();
+				return erase(p_key);
+			}
+			// Erasing the last key is going back to the parent shape.
+			DictionaryShape *parent = shape->parent;
+			if (parent == DictionaryShape::get_root()) {
+				parent = nullptr;
+			} else {
+				parent->refcount.ref();
+			}
+			DictionaryShape::release(shape);
+			shape = parent;
+			pop_value();
+			return true;
+		}
+		Variant **stored = variant_map.getptr(p_key);
+		if (!stored) {
+			return false;
+		}
+		Variant *value = *stored;
+		variant_map.erase(p_key);
+		*value = Variant();
+		free_values.push_back(value);
+		return true;
+	}
+
+	void clear() {
+		if (shape) {
+			DictionaryShape::release(shape);
+			shape = nullptr;
+		}
+		variant_map.clear();
+		reset_values();
+		uses_map = false;
+	}
+
+	void copy_entries(const DictionaryPrivate &p_from) {
+		if (this == &p_from) {
+			return;
+		}
+		clear();
+		uses_map = p_from.uses_map;
+		if (uses_map) {
+			variant_map.reserve(p_from.variant_map.size());
+			for (const KeyValue<Variant, Variant *> &E : p_from.variant_map) {
+				Variant *value = alloc_value();
+				*value = *E.value;
+				variant_map.insert(E.key, value);
+			}
+		} else if (p_from.shape) {
+			p_from.shape->refcount.ref();
+			shape = p_from.shape;
+			for (uint32_t i = 0; i < p_from.value_count; i++) {
+				*alloc_value() = *p_from.get_value(i);
+			}
+		}
+	}
+
+	~DictionaryPrivate() {
+		if (shape) {
+			DictionaryShape::release(shape);
+		}
+		variant_map.clear();
+		reset_values();
+	}
 };
 
 void Dictionary::get_key_list(List<Variant> *p_keys) const {
+	if (!_p->uses_map) {
+		for (uint32_t i = 0; i < _p->value_count; i++) {
+			p_keys->push_back(_p->shape->keys[i]);
+		}
+		return;
+	}
+
 	if (_p->variant_map.is_empty()) {
 		return;
 	}
 
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
+	for (const KeyValue<Variant, Variant *> &E : _p->variant_map) {
 		p_keys->push_back(E.key);
 	}
 }
 
 Variant Dictionary::get_key_at_index(int p_index) const {
+	if (!_p->uses_map) {
+		if (p_index >= 0 && p_index < _p->size()) {
+			return _p->shape->keys[p_index];
+		}
+		return Variant();
+	}
+
 	int index = 0;
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
+	for (const KeyValue<Variant, Variant *> &E : _p->variant_map) {
 		if (index == p_index) {
 			return E.key;
 		}
@@ -72,10 +373,17 @@ Variant Dictionary::get_key_at_index(int p_index) const {
 }
 
 Variant Dictionary::get_value_at_index(int p_index) const {
+	if (!_p->uses_map) {
+		if (p_index >= 0 && p_index < _p->size()) {
+			return *_p->get_value(p_index);
+		}
+		return Variant();
+	}
+
 	int index = 0;
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
+	for (const KeyValue<Variant, Variant *> &E : _p->variant_map) {
 		if (index == p_index) {
-			return E.value;
+			return *E.value;
 		}
 		index++;
 	}
@@ -94,17 +402,20 @@ Variant &Dictionary::operator[](const Variant &p_key) {
 		VariantInternal::initialize(_p->typed_fallback, _p->typed_value.type);
 		return *_p->typed_fallback;
 	} else if (unlikely(_p->read_only)) {
-		if (likely(_p->variant_map.has(key))) {
-			*_p->read_only = _p->variant_map[key];
+		const Variant *value = _p->find(key);
+		if (likely(value)) {
+			*_p->read_only = *value;
 		} else {
 			VariantInternal::initialize(_p->read_only, _p->typed_value.type);
 		}
 		return *_p->read_only;
 	} else {
-		if (unlikely(!_p->variant_map.has(key))) {
-			VariantInternal::initialize(&_p->variant_map[key], _p->typed_value.type);
+		Variant *value = _p->find(key);
+		if (unlikely(!value)) {
+			value = _p->insert(key);
+			VariantInternal::initialize(value, _p->typed_value.type);
 		}
-		return _p->variant_map[key];
+		return *value;
 	}
 }
 
@@ -118,7 +429,9 @@ const Variant &Dictionary::operator[](const Variant &p_key) const {
 		return *_p->typed_fallback;
 	} else {
 		// Will not insert key, so no initialization is necessary.
-		return _p->variant_map[key];
+		const Variant *value = _p->find(key);
+		CRASH_COND(!value);
+		return *value;
 	}
 }
 
@@ -127,11 +440,7 @@ const Variant *Dictionary::getptr(const Variant &p_key) const {
 	if (unlikely(!_p->typed_key.validate(key, "getptr"))) {
 		return nullptr;
 	}
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::ConstIterator E(_p->variant_map.find(key));
-	if (!E) {
-		return nullptr;
-	}
-	return &E->value;
+	return _p->find(key);
 }
 
 // WARNING: This method does not validate the value type.
@@ -140,27 +449,27 @@ Variant *Dictionary::getptr(const Variant &p_key) {
 	if (unlikely(!_p->typed_key.validate(key, "getptr"))) {
 		return nullptr;
 	}
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::Iterator E(_p->variant_map.find(key));
-	if (!E) {
+	Variant *value = _p->find(key);
+	if (!value) {
 		return nullptr;
 	}
 	if (unlikely(_p->read_only != nullptr)) {
-		*_p->read_only = E->value;
+		*_p->read_only = *value;
 		return _p->read_only;
 	} else {
-		return &E->value;
+		return value;
 	}
 }
 
 Variant Dictionary::get_valid(const Variant &p_key) const {
 	Variant key = p_key;
 	ERR_FAIL_COND_V(!_p->typed_key.validate(key, "get_valid"), Variant());
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::ConstIterator E(_p->variant_map.find(key));
+	const Variant *value = _p->find(key);
 
-	if (!E) {
+	if (!value) {
 		return Variant();
 	}
-	return E->value;
+	return *value;
 }
 
 Variant Dictionary::get(const Variant &p_key, const Variant &p_default) const {
@@ -193,22 +502,26 @@ bool Dictionary::set(const Variant &p_key, const Variant &p_value) {
 	ERR_FAIL_COND_V(!_p->typed_key.validate(key, "set"), false);
 	Variant value = p_value;
 	ERR_FAIL_COND_V(!_p->typed_value.validate(value, "set"), false);
-	_p->variant_map[key] = value;
+	Variant *stored = _p->find(key);
+	if (!stored) {
+		stored = _p->insert(key);
+	}
+	*stored = value;
 	return true;
 }
 
 int Dictionary::size() const {
-	return _p->variant_map.size();
+	return _p->size();
 }
 
 bool Dictionary::is_empty() const {
-	return !_p->variant_map.size();
+	return !_p->size();
 }
 
 bool Dictionary::has(const Variant &p_key) const {
 	Variant key = p_key;
 	ERR_FAIL_COND_V(!_p->typed_key.validate(key, "use 'has'"), false);
-	return _p->variant_map.has(p_key);
+	return _p->find(p_key) != nullptr;
 }
 
 bool Dictionary::has_all(const Array &p_keys) const {
@@ -225,8 +538,16 @@ bool Dictionary::has_all(const Array &p_keys) const {
 Variant Dictionary::find_key(const Variant &p_value) const {
 	Variant value = p_value;
 	ERR_FAIL_COND_V(!_p->typed_value.validate(value, "find_key"), Variant());
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
-		if (E.value == value) {
+	if (!_p->uses_map) {
+		for (uint32_t i = 0; i < _p->value_count; i++) {
+			if (*_p->get_value(i) == value) {
+				return _p->shape->keys[i];
+			}
+		}
+		return Variant();
+	}
+	for (const KeyValue<Variant, Variant *> &E : _p->variant_map) {
+		if (*E.value == value) {
 			return E.key;
 		}
 	}
@@ -237,7 +558,7 @@ bool Dictionary::erase(const Variant &p_key) {
 	Variant key = p_key;
 	ERR_FAIL_COND_V(!_p->typed_key.validate(key, "erase"), false);
 	ERR_FAIL_COND_V_MSG(_p->read_only, false, "Dictionary is in read-only state.");
-	return _p->variant_map.erase(key);
+	return _p->erase(key);
 }
 
 bool Dictionary::operator==(const Dictionary &p_dictionary) const {
@@ -253,7 +574,7 @@ bool Dictionary::recursive_equal(const Dictionary &p_dictionary, int recursion_c
 	if (_p == p_dictionary._p) {
 		return true;
 	}
-	if (_p->variant_map.size() != p_dictionary._p->variant_map.size()) {
+	if (_p->size() != p_dictionary._p->size()) {
 		return false;
 	}
 
@@ -263,9 +584,19 @@ bool Dictionary::recursive_equal(const Dictionary &p_dictionary, int recursion_c
 		return true;
 	}
 	recursion_count++;
-	for (const KeyValue<Variant, Variant> &this_E : _p->variant_map) {
-		HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::ConstIterator other_E(p_dictionary._p->variant_map.find(this_E.key));
-		if (!other_E || !this_E.value.hash_compare(other_E->value, recursion_count, false)) {
+	if (!_p->uses_map) {
+		const bool same_shape = !p_dictionary._p->uses_map && _p->shape == p_dictionary._p->shape;
+		for (uint32_t i = 0; i < _p->value_count; i++) {
+			const Variant *other_value = same_shape ? p_dictionary._p->get_value(i) : p_dictionary._p->find(_p->shape->keys[i]);
+			if (!other_value || !_p->get_value(i)->hash_compare(*other_value, recursion_count, false)) {
+				return false;
+			}
+		}
+		return true;
+	}
+	for (const KeyValue<Variant, Variant *> &this_E : _p->variant_map) {
+		const Variant *other_value = p_dictionary._p->find(this_E.key);
+		if (!other_value || !this_E.value->hash_compare(*other_value, recursion_count, false)) {
 			return false;
 		}
 	}
@@ -291,19 +622,32 @@ void Dictionary::_ref(const Dictionary &p_from) const {
 
 void Dictionary::clear() {
 	ERR_FAIL_COND_MSG(_p->read_only, "Dictionary is in read-only state.");
-	_p->variant_map.clear();
+	_p->clear();
 }
 
 void Dictionary::sort() {
 	ERR_FAIL_COND_MSG(_p->read_only, "Dictionary is in read-only state.");
+	_p->convert_to_map();
 	_p->variant_map.sort();
 }
 
 void Dictionary::merge(const Dictionary &p_dictionary, bool p_overwrite) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Dictionary is in read-only state.");
-	for (const KeyValue<Variant, Variant> &E : p_dictionary._p->variant_map) {
+	if (!p_dictionary._p->uses_map) {
+		for (uint32_t i = 0; i < p_dictionary._p->value_count; i++) {
+			Variant key = p_dictionary._p->shape->keys[i];
+			Variant value = *p_dictionary._p->get_value(i);
+			ERR_FAIL_COND(!_p->typed_key.validate(key, "merge"));
+			ERR_FAIL_COND(!_p->typed_value.validate(value, "merge"));
+			if (p_overwrite || !has(key)) {
+				operator[](key) = value;
+			}
+		}
+		return;
+	}
+	for (const KeyValue<Variant, Variant *> &E : p_dictionary._p->variant_map) {
 		Variant key = E.key;
-		Variant value = E.value;
+		Variant value = *E.value;
 		ERR_FAIL_COND(!_p->typed_key.validate(key, "merge"));
 		ERR_FAIL_COND(!_p->typed_value.validate(value, "merge"));
 		if (p_overwrite || !has(key)) {
@@ -345,9 +689,16 @@ uint32_t Dictionary::recursive_hash(int recursion_count) const {
 	uint32_t h = hash_murmur3_one_32(Variant::DICTIONARY);
 
 	recursion_count++;
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
+	if (!_p->uses_map) {
+		for (uint32_t i = 0; i < _p->value_count; i++) {
+			h = hash_murmur3_one_32(_p->shape->keys[i].recursive_hash(recursion_count), h);
+			h = hash_murmur3_one_32(_p->get_value(i)->recursive_hash(recursion_count), h);
+		}
+		return hash_fmix32(h);
+	}
+	for (const KeyValue<Variant, Variant *> &E : _p->variant_map) {
 		h = hash_murmur3_one_32(E.key.recursive_hash(recursion_count), h);
-		h = hash_murmur3_one_32(E.value.recursive_hash(recursion_count), h);
+		h = hash_murmur3_one_32(E.value->recursive_hash(recursion_count), h);
 	}
 
 	return hash_fmix32(h);
@@ -358,14 +709,21 @@ Array Dictionary::keys() const {
 	if (is_typed_key()) {
 		varr.set_typed(get_typed_key_builtin(), get_typed_key_class_name(), get_typed_key_script());
 	}
-	if (_p->variant_map.is_empty()) {
+	if (is_empty()) {
 		return varr;
 	}
 
 	varr.resize(size());
 
+	if (!_p->uses_map) {
+		for (uint32_t i = 0; i < _p->value_count; i++) {
+			varr[i] = _p->shape->keys[i];
+		}
+		return varr;
+	}
+
 	int i = 0;
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
+	for (const KeyValue<Variant, Variant *> &E : _p->variant_map) {
 		varr[i] = E.key;
 		i++;
 	}
@@ -378,15 +736,22 @@ Array Dictionary::values() const {
 	if (is_typed_value()) {
 		varr.set_typed(get_typed_value_builtin(), get_typed_value_class_name(), get_typed_value_script());
 	}
-	if (_p->variant_map.is_empty()) {
+	if (is_empty()) {
 		return varr;
 	}
 
 	varr.resize(size());
 
+	if (!_p->uses_map) {
+		for (uint32_t i = 0; i < _p->value_count; i++) {
+			varr[i] = *_p->get_value(i);
+		}
+		return varr;
+	}
+
 	int i = 0;
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
-		varr[i] = E.value;
+	for (const KeyValue<Variant, Variant *> &E : _p->variant_map) {
+		varr[i] = *E.value;
 		i++;
 	}
 
@@ -405,12 +770,20 @@ void Dictionary::assign(const Dictionary &p_dictionary) {
 		// From same to same or,
 		// from anything to variants or,
 		// from subclasses to base classes.
-		_p->variant_map = p_dictionary._p->variant_map;
+		_p->copy_entries(*p_dictionary._p);
 		return;
 	}
 
-	int size = p_dictionary._p->variant_map.size();
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator> variant_map = HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>(size);
+	// The conversions below go through a hash map, shaped sources are copied into a temporary one.
+	HashMap<Variant, Variant *, VariantHasher, StringLikeVariantComparator> shaped_source_map;
+	if (!p_dictionary._p->uses_map) {
+		for (uint32_t i = 0; i < p_dictionary._p->value_count; i++) {
+			shaped_source_map.insert(p_dictionary._p->shape->keys[i], p_dictionary._p->get_value(i));
+		}
+	}
+	const HashMap<Variant, Variant *, VariantHasher, StringLikeVariantComparator> &source_map = p_dictionary._p->uses_map ? p_dictionary._p->variant_map : shaped_source_map;
+
+	int size = source_map.size();
 
 	Vector<Variant> key_array;
 	key_array.resize(size);
@@ -425,7 +798,7 @@ void Dictionary::assign(const Dictionary &p_dictionary) {
 		// from anything to variants or,
 		// from subclasses to base classes.
 		int i = 0;
-		for (const KeyValue<Variant, Variant> &E : p_dictionary._p->variant_map) {
+		for (const KeyValue<Variant, Variant *> &E : source_map) {
 			const Variant *key = &E.key;
 			key_data[i++] = *key;
 		}
@@ -433,7 +806,7 @@ void Dictionary::assign(const Dictionary &p_dictionary) {
 		// From variants to objects or,
 		// from base classes to subclasses.
 		int i = 0;
-		for (const KeyValue<Variant, Variant> &E : p_dictionary._p->variant_map) {
+		for (const KeyValue<Variant, Variant *> &E : source_map) {
 			const Variant *key = &E.key;
 			if (key->get_type() != Variant::NIL && (key->get_type() != Variant::OBJECT || !typed_key.validate_object(*key, "assign"))) {
 				ERR_FAIL_MSG(vformat(R"(Unable to convert key from "%s" to "%s".)", Variant::get_type_name(key->get_type()), Variant::get_type_name(typed_key.type)));
@@ -446,7 +819,7 @@ void Dictionary::assign(const Dictionary &p_dictionary) {
 	} else if (typed_key_source.type == Variant::NIL && typed_key.type != Variant::OBJECT) {
 		// From variants to primitives.
 		int i = 0;
-		for (const KeyValue<Variant, Variant> &E : p_dictionary._p->variant_map) {
+		for (const KeyValue<Variant, Variant *> &E : source_map) {
 			const Variant *key = &E.key;
 			if (key->get_type() == typed_key.type) {
 				key_data[i++] = *key;
@@ -462,7 +835,7 @@ void Dictionary::assign(const Dictionary &p_dictionary) {
 	} else if (Variant::can_convert_strict(typed_key_source.type, typed_key.type)) {
 		// From primitives to different convertible primitives.
 		int i = 0;
-		for (const KeyValue<Variant, Variant> &E : p_dictionary._p->variant_map) {
+		for (const KeyValue<Variant, Variant *> &E : source_map) {
 			const Variant *key = &E.key;
 			Callable::CallError ce;
 			Variant::construct(typed_key.type, key_data[i++], &key, 1, ce);
@@ -478,16 +851,16 @@ void Dictionary::assign(const Dictionary &p_dictionary) {
 		// from anything to variants or,
 		// from subclasses to base classes.
 		int i = 0;
-		for (const KeyValue<Variant, Variant> &E : p_dictionary._p->variant_map) {
-			const Variant *value = &E.value;
+		for (const KeyValue<Variant, Variant *> &E : source_map) {
+			const Variant *value = E.value;
 			value_data[i++] = *value;
 		}
 	} else if (((typed_value_source.type == Variant::NIL && typed_value.type == Variant::OBJECT) || (typed_value_source.type == Variant::OBJECT && typed_value_source.can_reference(typed_value)))) {
 		// From variants to objects or,
 		// from base classes to subclasses.
 		int i = 0;
-		for (const KeyValue<Variant, Variant> &E : p_dictionary._p->variant_map) {
-			const Variant *value = &E.value;
+		for (const KeyValue<Variant, Variant *> &E : source_map) {
+			const Variant *value = E.value;
 			if (value->get_type() != Variant::NIL && (value->get_type() != Variant::OBJECT || !typed_value.validate_object(*value, "assign"))) {
 				ERR_FAIL_MSG(vformat(R"(Unable to convert value at key "%s" from "%s" to "%s".)", key_data[i], Variant::get_type_name(value->get_type()), Variant::get_type_name(typed_value.type)));
 			}
@@ -499,8 +872,8 @@ void Dictionary::assign(const Dictionary &p_dictionary) {
 	} else if (typed_value_source.type == Variant::NIL && typed_value.type != Variant::OBJECT) {
 		// From variants to primitives.
 		int i = 0;
-		for (const KeyValue<Variant, Variant> &E : p_dictionary._p->variant_map) {
-			const Variant *value = &E.value;
+		for (const KeyValue<Variant, Variant *> &E : source_map) {
+			const Variant *value = E.value;
 			if (value->get_type() == typed_value.type) {
 				value_data[i++] = *value;
 				continue;
@@ -515,8 +888,8 @@ void Dictionary::assign(const Dictionary &p_dictionary) {
 	} else if (Variant::can_convert_strict(typed_value_source.type, typed_value.type)) {
 		// From primitives to different convertible primitives.
 		int i = 0;
-		for (const KeyValue<Variant, Variant> &E : p_dictionary._p->variant_map) {
-			const Variant *value = &E.value;
+		for (const KeyValue<Variant, Variant *> &E : source_map) {
+			const Variant *value = E.value;
 			Callable::CallError ce;
 			Variant::construct(typed_value.type, value_data[i++], &value, 1, ce);
 			ERR_FAIL_COND_MSG(ce.error, vformat(R"(Unable to convert value at key "%s" from "%s" to "%s".)", key_data[i - 1], Variant::get_type_name(value->get_type()), Variant::get_type_name(typed_value.type)));
@@ -526,14 +899,32 @@ void Dictionary::assign(const Dictionary &p_dictionary) {
 				Variant::get_type_name(typed_key.type), Variant::get_type_name(typed_value.type)));
 	}
 
+	_p->clear();
 	for (int i = 0; i < size; i++) {
-		variant_map.insert(key_data[i], value_data[i]);
+		Variant *value = _p->find(key_data[i]);
+		if (!value) {
+			value = _p->insert(key_data[i]);
+		}
+		*value = value_data[i];
 	}
-
-	_p->variant_map = variant_map;
 }
 
 const Variant *Dictionary::next(const Variant *p_key) const {
+	if (!_p->uses_map) {
+		const int size = _p->size();
+		if (p_key == nullptr) {
+			// caller wants to get the first element
+			return size ? &_p->shape->keys[0] : nullptr;
+		}
+		Variant key = *p_key;
+		ERR_FAIL_COND_V(!_p->typed_key.validate(key, "next"), nullptr);
+		const int index = size ? _p->shape->find(key) : -1;
+		if (index < 0 || index + 1 >= size) {
+			return nullptr;
+		}
+		return &_p->shape->keys[index + 1];
+	}
+
 	if (p_key == nullptr) {
 		// caller wants to get the first element
 		if (_p->variant_map.begin()) {
@@ -543,7 +934,7 @@ const Variant *Dictionary::next(const Variant *p_key) const {
 	}
 	Variant key = *p_key;
 	ERR_FAIL_COND_V(!_p->typed_key.validate(key, "next"), nullptr);
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::Iterator E = _p->variant_map.find(key);
+	HashMap<Variant, Variant *, VariantHasher, StringLikeVariantComparator>::Iterator E = _p->variant_map.find(key);
 
 	if (!E) {
 		return nullptr;
@@ -581,14 +972,24 @@ Dictionary Dictionary::recursive_duplicate(bool p_deep, int recursion_count) con
 		return n;
 	}
 
-	if (p_deep) {
+	if (!_p->uses_map) {
+		// String keys are the same when duplicated, so the shape can be shared.
+		n._p->copy_entries(*_p);
+		if (p_deep) {
+			recursion_count++;
+			for (uint32_t i = 0; i < n._p->value_count; i++) {
+				Variant *value = n._p->get_value(i);
+				*value = value->recursive_duplicate(true, recursion_count);
+			}
+		}
+	} else if (p_deep) {
 		recursion_count++;
-		for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
-			n[E.key.recursive_duplicate(true, recursion_count)] = E.value.recursive_duplicate(true, recursion_count);
+		for (const KeyValue<Variant, Variant *> &E : _p->variant_map) {
+			n[E.key.recursive_duplicate(true, recursion_count)] = E.value->recursive_duplicate(true, recursion_count);
 		}
 	} else {
-		for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
-			n[E.key] = E.value;
+		for (const KeyValue<Variant, Variant *> &E : _p->variant_map) {
+			n[E.key] = *E.value;
 		}
 	}
 
@@ -601,7 +1002,7 @@ void Dictionary::set_typed(const ContainerType &p_key_type, const ContainerType
 
 void Dictionary::set_typed(uint32_t p_key_type, const StringName &p_key_class_name, const Variant &p_key_script, uint32_t p_value_type, const StringName &p_value_class_name, const Variant &p_value_script) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Dictionary is in read-only state.");
-	ERR_FAIL_COND_MSG(_p->variant_map.size() > 0, "Type can only be set when dictionary is empty.");
+	ERR_FAIL_COND_MSG(_p->size() > 0, "Type can only be set when dictionary is empty.");
 	ERR_FAIL_COND_MSG(_p->refcount.get() > 1, "Type can only be set when dictionary has no more than one user.");
 	ERR_FAIL_COND_MSG(_p->typed_key.type != Variant::NIL || _p->typed_value.type != Variant::NIL, "Type can only be set once.");
 	ERR_FAIL_COND_MSG((p_key_class_name != StringName() && p_key_type != Variant::OBJECT) || (p_value_class_name != StringName() && p_value_type != Variant::OBJECT), "Class names can only be set for type OBJECT.");
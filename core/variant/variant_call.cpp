@@ -34,6 +34,7 @@
 #include "core/debugger/engine_debugger.h"
 #include "core/io/compression.h"
 #include "core/io/marshalls.h"
+#include "core/math/bulk_math.h"
 #include "core/object/class_db.h"
 #include "core/os/os.h"
 #include "core/templates/local_vector.h"
@@ -1034,6 +1035,51 @@ struct _VariantCall {
 		return len;
 	}
 
+	static double func_PackedFloat32Array_sum(PackedFloat32Array *p_instance) {
+		return BulkMath::sum(p_instance->ptr(), p_instance->size());
+	}
+
+	static double func_PackedFloat32Array_min(PackedFloat32Array *p_instance) {
+		ERR_FAIL_COND_V_MSG(p_instance->is_empty(), 0.0, "Can't get the minimum of an empty array.");
+		float min = 0.0f;
+		float max = 0.0f;
+		BulkMath::get_min_max(p_instance->ptr(), p_instance->size(), min, max);
+		return min;
+	}
+
+	static double func_PackedFloat32Array_max(PackedFloat32Array *p_instance) {
+		ERR_FAIL_COND_V_MSG(p_instance->is_empty(), 0.0, "Can't get the maximum of an empty array.");
+		float min = 0.0f;
+		float max = 0.0f;
+		BulkMath::get_min_max(p_instance->ptr(), p_instance->size(), min, max);
+		return max;
+	}
+
+	static double func_PackedFloat32Array_dot(PackedFloat32Array *p_instance, const PackedFloat32Array &p_with) {
+		ERR_FAIL_COND_V_MSG(p_instance->size() != p_with.size(), 0.0, "Both arrays must have the same size.");
+		return BulkMath::dot(p_instance->ptr(), p_with.ptr(), p_instance->size());
+	}
+
+	static PackedFloat32Array func_PackedFloat32Array_lerp(PackedFloat32Array *p_instance, const PackedFloat32Array &p_to, double p_weight) {
+		ERR_FAIL_COND_V_MSG(p_instance->size() != p_to.size(), PackedFloat32Array(), "Both arrays must have the same size.");
+		PackedFloat32Array ret;
+		ret.resize(p_instance->size());
+		BulkMath::lerp(p_instance->ptr(), p_to.ptr(), p_weight, ret.ptrw(), p_instance->size());
+		return ret;
+	}
+
+	static AABB func_PackedVector3Array_get_aabb(PackedVector3Array *p_instance) {
+		return BulkMath::get_aabb(p_instance->ptr(), p_instance->size());
+	}
+
+	static PackedVector3Array func_PackedVector3Array_lerp(PackedVector3Array *p_instance, const PackedVector3Array &p_to, double p_weight) {
+		ERR_FAIL_COND_V_MSG(p_instance->size() != p_to.size(), PackedVector3Array(), "Both arrays must have the same size.");
+		PackedVector3Array ret;
+		ret.resize(p_instance->size());
+		BulkMath::lerp(p_instance->ptr(), p_to.ptr(), p_weight, ret.ptrw(), p_instance->size());
+		return ret;
+	}
+
 	static void func_Callable_call(Variant *v, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error) {
 		Callable *callable = VariantGetInternalPtr<Callable>::get_ptr(v);
 		callable->callp(p_args, p_argcount, r_ret, r_error);
@@ -2535,6 +2581,11 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedFloat32Array, find, sarray("value", "from"), varray(0));
 	bind_method(PackedFloat32Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedFloat32Array, count, sarray("value"), varray());
+	bind_function(PackedFloat32Array, sum, _VariantCall::func_PackedFloat32Array_sum, sarray(), varray());
+	bind_function(PackedFloat32Array, min, _VariantCall::func_PackedFloat32Array_min, sarray(), varray());
+	bind_function(PackedFloat32Array, max, _VariantCall::func_PackedFloat32Array_max, sarray(), varray());
+	bind_function(PackedFloat32Array, dot, _VariantCall::func_PackedFloat32Array_dot, sarray("with"), varray());
+	bind_function(PackedFloat32Array, lerp, _VariantCall::func_PackedFloat32Array_lerp, sarray("to", "weight"), varray());
 
 	/* Float64 Array */
 
@@ -2631,6 +2682,8 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedVector3Array, find, sarray("value", "from"), varray(0));
 	bind_method(PackedVector3Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedVector3Array, count, sarray("value"), varray());
+	bind_function(PackedVector3Array, get_aabb, _VariantCall::func_PackedVector3Array_get_aabb, sarray(), varray());
+	bind_function(PackedVector3Array, lerp, _VariantCall::func_PackedVector3Array_lerp, sarray("to", "weight"), varray());
 
 	/* Color Array */
 
@@ -37,6 +37,8 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <stdint.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -310,6 +312,48 @@ bool FileAccessUnix::store_buffer(const uint8_t *p_src, uint64_t p_length) {
 	return res;
 }
 
+#ifndef WEB_ENABLED
+class FileMappingUnix : public FileMapping {
+	void *data = nullptr;
+	uint64_t size = 0;
+
+public:
+	virtual const uint8_t *get_data() const override { return (const uint8_t *)data; }
+	virtual uint64_t get_size() const override { return size; }
+
+	FileMappingUnix(void *p_data, uint64_t p_size) :
+			data(p_data), size(p_size) {}
+	~FileMappingUnix() {
+		munmap(data, size);
+	}
+};
+#endif
+
+Ref<FileMapping> FileAccessUnix::map() const {
+	ERR_FAIL_NULL_V_MSG(f, Ref<FileMapping>(), "File must be opened before use.");
+#ifdef WEB_ENABLED
+	// Emscripten would copy the whole file into memory.
+	return Ref<FileMapping>();
+#else
+	if (flags != READ) {
+		return Ref<FileMapping>();
+	}
+
+	int fd = fileno(f);
+	struct stat st = {};
+	if (fstat(fd, &st) != 0 || st.st_size <= 0 || (uint64_t)st.st_size > (uint64_t)SIZE_MAX) {
+		return Ref<FileMapping>();
+	}
+
+	// The mapping stays valid after the file is closed.
+	void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	if (data == MAP_FAILED) {
+		return Ref<FileMapping>();
+	}
+	return memnew(FileMappingUnix(data, st.st_size));
+#endif
+}
+
 bool FileAccessUnix::file_exists(const String &p_path) {
 	int err;
 	struct stat st = {};
@@ -396,6 +396,46 @@ bool FileAccessWindows::store_buffer(const uint8_t *p_src, uint64_t p_length) {
 	return res;
 }
 
+class FileMappingWindows : public FileMapping {
+	void *data = nullptr;
+	uint64_t size = 0;
+
+public:
+	virtual const uint8_t *get_data() const override { return (const uint8_t *)data; }
+	virtual uint64_t get_size() const override { return size; }
+
+	FileMappingWindows(void *p_data, uint64_t p_size) :
+			data(p_data), size(p_size) {}
+	~FileMappingWindows() {
+		UnmapViewOfFile(data);
+	}
+};
+
+Ref<FileMapping> FileAccessWindows::map() const {
+	ERR_FAIL_NULL_V_MSG(f, Ref<FileMapping>(), "File must be opened before use.");
+	if (flags != READ) {
+		return Ref<FileMapping>();
+	}
+
+	HANDLE handle = (HANDLE)_get_osfhandle(_fileno(f));
+	LARGE_INTEGER file_size;
+	if (handle == INVALID_HANDLE_VALUE || !GetFileSizeEx(handle, &file_size) || file_size.QuadPart <= 0 || (uint64_t)file_size.QuadPart > (uint64_t)SIZE_MAX) {
+		return Ref<FileMapping>();
+	}
+
+	HANDLE mapping = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr) {
+		return Ref<FileMapping>();
+	}
+	// The view keeps the mapping object alive, and stays valid after the file is closed.
+	void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if (data == nullptr) {
+		return Ref<FileMapping>();
+	}
+	return memnew(FileMappingWindows(data, file_size.QuadPart));
+}
+
 bool FileAccessWindows::file_exists(const String &p_name) {
 	if (is_path_invalid(p_name)) {
 		return false;
@@ -34,7 +34,8 @@
 #include "core/crypto/crypto_core.h"
 #include "core/extension/gdextension.h"
 #include "core/io/file_access_encrypted.h"
-#include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
+#include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION, PACK_FORMAT_VERSION_COMPRESSED
+#include "core/io/pck_compression.h"
 #include "core/io/zip_io.h"
 #include "core/version.h"
 #include "editor/editor_file_system.h"
@@ -279,6 +280,7 @@ Error EditorExportPlatform::_save_pack_file(void *p_userdata, const String &p_pa
 		ftmp.unref();
 		fae.unref();
 	}
+	sd.stored_size = pd->f->get_position() - sd.ofs;
 
 	int pad = _get_pad(PCK_PADDING, pd->f->get_position());
 	for (int i = 0; i < pad; i++) {
@@ -1823,6 +1825,61 @@ Dictionary EditorExportPlatform::_save_zip_patch(const Ref<EditorExportPreset> &
 	return ret;
 }
 
+Error EditorExportPlatform::_compress_pack_files(Vector<SavedData> &r_files, const String &p_src_path, const String &p_dst_path, Vector<uint8_t> &r_dictionary) {
+	Ref<FileAccess> src = FileAccess::open(p_src_path, FileAccess::READ);
+	ERR_FAIL_COND_V(src.is_null(), ERR_FILE_CANT_OPEN);
+	Ref<FileAccess> dst = FileAccess::open(p_dst_path, FileAccess::WRITE);
+	ERR_FAIL_COND_V(dst.is_null(), ERR_CANT_CREATE);
+
+	Vector<Vector<uint8_t>> samples;
+	for (const SavedData &sd : r_files) {
+		if (!sd.removal && !sd.encrypted && PCKCompression::is_dictionary_sample(String::utf8(sd.path_utf8.get_data()))) {
+			src->seek(sd.ofs);
+			samples.push_back(src->get_buffer(MIN(sd.size, uint64_t(PCKCompression::SAMPLE_MAX_SIZE))));
+		}
+	}
+	r_dictionary = PCKCompression::train_dictionary(samples);
+
+	// The dictionary goes first, at the files base.
+	dst->store_buffer(r_dictionary);
+	int pad = _get_pad(PCK_PADDING, dst->get_position());
+	for (int i = 0; i < pad; i++) {
+		dst->store_8(0);
+	}
+
+	for (SavedData &sd : r_files) {
+		if (sd.removal) {
+			sd.ofs = dst->get_position();
+			continue;
+		}
+
+		src->seek(sd.ofs);
+		Vector<uint8_t> data = src->get_buffer(sd.stored_size);
+		ERR_FAIL_COND_V(uint64_t(data.size()) != sd.stored_size, ERR_FILE_CORRUPT);
+
+		Vector<uint8_t> compressed;
+		if (!sd.encrypted) {
+			compressed = PCKCompression::compress(data.ptr(), data.size(), r_dictionary);
+		}
+
+		sd.ofs = dst->get_position();
+		if (!compressed.is_empty()) {
+			sd.compressed = true;
+			sd.stored_size = compressed.size();
+			dst->store_buffer(compressed);
+		} else {
+			dst->store_buffer(data);
+		}
+
+		pad = _get_pad(PCK_PADDING, dst->get_position());
+		for (int i = 0; i < pad; i++) {
+			dst->store_8(0);
+		}
+	}
+
+	return OK;
+}
+
 Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, bool p_debug, const String &p_path, Vector<SharedObject> *p_so_files, EditorExportSaveFunction p_save_func, EditorExportRemoveFunction p_remove_func, bool p_embed, int64_t *r_embedded_start, int64_t *r_embedded_size) {
 	EditorProgress ep("savepack", TTR("Packing"), 102, true);
 
@@ -1866,6 +1923,21 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 
 	pd.file_ofs.sort(); //do sort, so we can do binary search later
 
+	Vector<uint8_t> dictionary;
+	if (p_preset->get_pck_compression()) {
+		ep.step(TTR("Compressing files..."), 101, true);
+
+		String compressed_path = EditorPaths::get_singleton()->get_temp_dir().path_join("packtmp_compressed");
+		err = _compress_pack_files(pd.file_ofs, tmppath, compressed_path, dictionary);
+		DirAccess::remove_file_or_error(tmppath);
+		tmppath = compressed_path;
+		if (err != OK) {
+			DirAccess::remove_file_or_error(tmppath);
+			add_message(EXPORT_MESSAGE_ERROR, TTR("Save PCK"), TTR("Failed to compress project files."));
+			return err;
+		}
+	}
+
 	Ref<FileAccess> f;
 	int64_t embed_pos = 0;
 	if (!p_embed) {
@@ -1901,8 +1973,16 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 
 	int64_t pck_start_pos = f->get_position();
 
+	bool compressed = false;
+	for (const SavedData &sd : pd.file_ofs) {
+		if (sd.compressed) {
+			compressed = true;
+			break;
+		}
+	}
+
 	f->store_32(PACK_HEADER_MAGIC);
-	f->store_32(PACK_FORMAT_VERSION);
+	f->store_32(compressed ? PACK_FORMAT_VERSION_COMPRESSED : PACK_FORMAT_VERSION);
 	f->store_32(VERSION_MAJOR);
 	f->store_32(VERSION_MINOR);
 	f->store_32(VERSION_PATCH);
@@ -1921,7 +2001,10 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 	uint64_t file_base_ofs = f->get_position();
 	f->store_64(0); // files base
 
-	for (int i = 0; i < 16; i++) {
+	f->store_64(0); // dictionary offset, from the files base
+	f->store_32(dictionary.size()); // dictionary size
+
+	for (int i = 0; i < 13; i++) {
 		//reserved
 		f->store_32(0);
 	}
@@ -2016,6 +2099,9 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 		if (pd.file_ofs[i].removal) {
 			flags |= PACK_FILE_REMOVAL;
 		}
+		if (pd.file_ofs[i].compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
 		fhead->store_32(flags);
 	}
 
@@ -82,8 +82,10 @@ private:
 	struct SavedData {
 		uint64_t ofs = 0;
 		uint64_t size = 0;
+		uint64_t stored_size = 0;
 		bool encrypted = false;
 		bool removal = false;
+		bool compressed = false;
 		Vector<uint8_t> md5;
 		CharString path_utf8;
 
@@ -119,6 +121,7 @@ private:
 	static Error _pack_add_shared_object(void *p_userdata, const SharedObject &p_so);
 
 	static Error _remove_pack_file(void *p_userdata, const String &p_path);
+	static Error _compress_pack_files(Vector<SavedData> &r_files, const String &p_src_path, const String &p_dst_path, Vector<uint8_t> &r_dictionary);
 
 	static Error _save_zip_file(void *p_userdata, const String &p_path, const Vector<uint8_t> &p_data, int p_file, int p_total, const Vector<String> &p_enc_in_filters, const Vector<String> &p_enc_ex_filters, const Vector<uint8_t> &p_key, uint64_t p_seed);
 	static Error _save_zip_patch_file(void *p_userdata, const String &p_path, const Vector<uint8_t> &p_data, int p_file, int p_total, const Vector<String> &p_enc_in_filters, const Vector<String> &p_enc_ex_filters, const Vector<uint8_t> &p_key, uint64_t p_seed);
@@ -94,6 +94,8 @@ private:
 	bool enc_directory = false;
 	uint64_t seed = 0;
 
+	bool pck_compression = false;
+
 	String script_key;
 	int script_mode = MODE_SCRIPT_BINARY_TOKENS_COMPRESSED;
 
@@ -175,6 +177,9 @@ public:
 	void set_enc_directory(bool p_enabled);
 	bool get_enc_directory() const;
 
+	void set_pck_compression(bool p_enabled);
+	bool get_pck_compression() const;
+
 	void set_script_encryption_key(const String &p_key);
 	String get_script_encryption_key() const;
 
@@ -93,6 +93,7 @@ class ProjectExportDialog : public ConfirmationDialog {
 	OptionButton *export_filter = nullptr;
 	LineEdit *include_filters = nullptr;
 	LineEdit *exclude_filters = nullptr;
+	CheckButton *pck_compression = nullptr;
 	Tree *include_files = nullptr;
 	Label *server_strip_message = nullptr;
 	PopupMenu *file_mode_popup = nullptr;
@@ -145,6 +146,7 @@ class ProjectExportDialog : public ConfirmationDialog {
 
 	void _export_type_changed(int p_which);
 	void _filter_changed(const String &p_filter);
+	void _pck_compression_changed(bool p_pressed);
 	String _get_resource_export_header(EditorExportPreset::ExportFilter p_filter) const;
 	void _fill_resource_tree();
 	void _setup_item_for_file_mode(TreeItem *p_item, EditorExportPreset::FileExportMode p_mode);
@@ -248,6 +248,7 @@ static int fixed_fps = -1;
 static MovieWriter *movie_writer = nullptr;
 static bool disable_vsync = false;
 static bool print_fps = false;
+static String prefetch_manifest_record_path;
 #ifdef TOOLS_ENABLED
 static bool editor_pseudolocalization = false;
 static bool dump_gdextension_interface = false;
@@ -611,6 +612,8 @@ void Main::print_help(const char *p_binary) {
 	print_help_option("", "--fixed-fps is forced when enabled, but it can be used to change movie FPS.\n");
 	print_help_option("", "--disable-vsync can speed up movie writing but makes interaction more difficult.\n");
 	print_help_option("", "--quit-after can be used to specify the number of frames to write.\n");
+	print_help_option("--record-prefetch-manifest <file>", "Record the resources loaded while running the project to a prefetch manifest, saved to the specified path on exit.\n");
+	print_help_option("", "<file> path should be absolute or relative to the project directory.\n");
 
 	print_help_title("Display options");
 	print_help_option("-f, --fullscreen", "Request fullscreen mode.\n");
@@ -630,6 +633,10 @@ void Main::print_help(const char *p_binary) {
 	print_help_option("-d, --debug", "Debug (local stdout debugger).\n");
 	print_help_option("-b, --breakpoints", "Breakpoint list as source::line comma-separated pairs, no spaces (use %%20 instead).\n");
 	print_help_option("--profiling", "Enable profiling in the script debugger.\n");
+#ifdef MODULE_GDSCRIPT_ENABLED
+	print_help_option("--gdscript-sample <file>", "Sample GDScript call stacks while running and save them to <file> on exit, as pprof if it ends with \".pprof\" or \".pb.gz\" and as collapsed stacks otherwise.\n");
+	print_help_option("--gdscript-sample-frequency <hz>", "Samples per second taken by --gdscript-sample (default: 1000).\n");
+#endif
 	print_help_option("--gpu-profile", "Show a GPU profile of the tasks that took the most time during frame rendering.\n");
 	print_help_option("--gpu-validation", "Enable graphics API validation layers for debugging.\n");
 #ifdef DEBUG_ENABLED
@@ -1739,6 +1746,14 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 				OS::get_singleton()->print("Missing write-movie argument, aborting.\n");
 				goto error;
 			}
+		} else if (arg == "--record-prefetch-manifest") {
+			if (N) {
+				prefetch_manifest_record_path = N->get();
+				N = N->next();
+			} else {
+				OS::get_singleton()->print("Missing record-prefetch-manifest argument, aborting.\n");
+				goto error;
+			}
 		} else if (arg == "--disable-vsync") {
 			disable_vsync = true;
 		} else if (arg == "--print-fps") {
@@ -1892,7 +1907,8 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 		} else {
 			int worker_threads = GLOBAL_GET("threading/worker_pool/max_threads");
 			float low_priority_ratio = GLOBAL_GET("threading/worker_pool/low_priority_thread_ratio");
-			WorkerThreadPool::get_singleton()->init(worker_threads, low_priority_ratio);
+			bool use_work_stealing = GLOBAL_GET("threading/worker_pool/use_work_stealing");
+			WorkerThreadPool::get_singleton()->init(worker_threads, low_priority_ratio, use_work_stealing);
 		}
 #else
 		WorkerThreadPool::get_singleton()->init(0, 0);
@@ -1939,6 +1955,7 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 			GLOBAL_DEF(PropertyInfo(Variant::INT, "application/run/low_processor_mode_sleep_usec", PROPERTY_HINT_RANGE, "0,33200,1,or_greater"), 6900)); // Roughly 144 FPS
 
 	GLOBAL_DEF("application/run/delta_smoothing", true);
+	GLOBAL_DEF(PropertyInfo(Variant::STRING, "application/run/prefetch_manifest", PROPERTY_HINT_FILE, "*.prefetch"), "");
 	if (!delta_smoothing_override) {
 		OS::get_singleton()->set_delta_smoothing(GLOBAL_GET("application/run/delta_smoothing"));
 	}
@@ -3651,6 +3668,10 @@ int Main::start() {
 				script = E->next()->get();
 			} else if (E->get() == "--main-loop") {
 				main_loop_type = E->next()->get();
+#ifdef MODULE_GDSCRIPT_ENABLED
+			} else if (E->get() == "--gdscript-sample" || E->get() == "--gdscript-sample-frequency") {
+				// Handled by the GDScript module, skip the value so it isn't taken as a path.
+#endif
 #ifdef TOOLS_ENABLED
 			} else if (E->get() == "--doctool") {
 				doc_tool_path = E->next()->get();
@@ -3979,6 +4000,16 @@ int Main::start() {
 		ResourceSaver::add_custom_savers();
 
 		if (!project_manager && !editor) { // game
+			// Starting before the autoloads so they are part of the recording, or of the prefetch.
+			if (!prefetch_manifest_record_path.is_empty()) {
+				ResourceLoader::start_prefetch_recording();
+			} else {
+				const String prefetch_manifest = GLOBAL_GET("application/run/prefetch_manifest");
+				if (!prefetch_manifest.is_empty()) {
+					ResourceLoader::prefetch(prefetch_manifest);
+				}
+			}
+
 			if (!game_path.is_empty() || !script.is_empty()) {
 				//autoload
 				OS::get_singleton()->benchmark_begin_measure("Startup", "Load Autoloads");
@@ -4621,6 +4652,13 @@ void Main::cleanup(bool p_force) {
 		movie_writer->end();
 	}
 
+	if (ResourceLoader::is_prefetch_recording()) {
+		ResourceLoader::stop_prefetch_recording();
+		if (!prefetch_manifest_record_path.is_empty()) {
+			ResourceLoader::save_prefetch_manifest(prefetch_manifest_record_path);
+		}
+	}
+
 	ResourceLoader::clear_thread_load_tasks();
 
 	ResourceLoader::remove_custom_loaders();
@@ -35,6 +35,7 @@
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 #include "gdscript_rpc_callable.h"
+#include "gdscript_sampler.h"
 #include "gdscript_tokenizer_buffer.h"
 #include "gdscript_warning.h"
 
@@ -52,6 +53,7 @@
 #include "core/io/file_access.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/os/os.h"
+#include "main/performance.h"
 
 #include "scene/resources/packed_scene.h"
 #include "scene/scene_string_names.h"
@@ -816,11 +818,20 @@ Error GDScript::reload(bool p_keep_state) {
 #endif
 
 	valid = false;
+	GDScriptCache::CompilationCacheEntry cache_entry;
+	if (binary_tokens.is_empty() && GDScriptCache::get_compilation_cache(path, source, cache_entry)) {
+		// Get what the analyzer will need ready in parallel.
+		GDScriptCache::parse_scripts(cache_entry.dependencies);
+	}
+
 	GDScriptParser parser;
 	Error err;
 	if (!binary_tokens.is_empty()) {
 		err = parser.parse_binary(binary_tokens, path);
+	} else if (!cache_entry.tokens.is_empty() && parser.parse_binary(cache_entry.tokens, path) == OK) {
+		err = OK;
 	} else {
+		cache_entry.tokens.clear(); // Stored again below if they were corrupted.
 		err = parser.parse(source, path, false);
 	}
 	if (err) {
@@ -850,6 +861,10 @@ Error GDScript::reload(bool p_keep_state) {
 		return ERR_PARSE_ERROR;
 	}
 
+	if (binary_tokens.is_empty()) {
+		GDScriptCache::update_compilation_cache(path, source, cache_entry, parser.get_depended_parsers());
+	}
+
 	can_run = ScriptServer::is_scripting_enabled() || parser.is_tool();
 
 	GDScriptCompiler compiler;
@@ -1561,6 +1576,7 @@ void GDScript::clear(ClearData *p_clear_data) {
 		return;
 	}
 	clearing = true;
+	GDScriptInlineCache::invalidate_scripts();
 
 	ClearData data;
 	ClearData *clear_data = p_clear_data;
@@ -2303,6 +2319,15 @@ void GDScriptLanguage::init() {
 	}
 #endif
 
+	GDScriptSampler::handle_command_line();
+
+	if (EngineDebugger::is_active() && Performance::get_singleton()) {
+		// Shown in the debugger's monitors, to spot coroutines piling up.
+		Performance::get_singleton()->add_custom_monitor("GDScript/Suspended Coroutines", callable_mp_static(&GDScriptFunctionState::get_suspended_count), Vector<Variant>());
+		Performance::get_singleton()->add_custom_monitor("GDScript/Coroutine Frames", callable_mp_static(&GDScriptFramePool::get_used_count), Vector<Variant>());
+		Performance::get_singleton()->add_custom_monitor("GDScript/Pooled Coroutine Frames", callable_mp_static(&GDScriptFramePool::get_pooled_count), Vector<Variant>());
+	}
+
 #ifdef TESTS_ENABLED
 	GDScriptTests::GDScriptTestRunner::handle_cmdline();
 #endif
@@ -2344,6 +2369,15 @@ void GDScriptLanguage::finish() {
 	}
 	finishing = true;
 
+	GDScriptSampler::finish();
+
+	if (Performance::get_singleton() && Performance::get_singleton()->has_custom_monitor("GDScript/Suspended Coroutines")) {
+		Performance::get_singleton()->remove_custom_monitor("GDScript/Suspended Coroutines");
+		Performance::get_singleton()->remove_custom_monitor("GDScript/Coroutine Frames");
+		Performance::get_singleton()->remove_custom_monitor("GDScript/Pooled Coroutine Frames");
+	}
+	GDScriptFunctionState::clear_frame_awaits();
+
 	_call_stack.free();
 
 	// Clear the cache before parsing the script_list
@@ -2379,6 +2413,7 @@ void GDScriptLanguage::finish() {
 	}
 	script_list.clear();
 	function_list.clear();
+	GDScriptFramePool::clear();
 
 	finishing = false;
 }
@@ -2971,6 +3006,10 @@ GDScriptLanguage::GDScriptLanguage() {
 		_debug_max_call_stack = 0;
 	}
 
+#ifdef TOOLS_ENABLED
+	GLOBAL_DEF("debug/gdscript/compilation_cache/enabled", true);
+#endif
+
 #ifdef DEBUG_ENABLED
 	GLOBAL_DEF("debug/gdscript/warnings/enable", true);
 	GLOBAL_DEF("debug/gdscript/warnings/exclude_addons", true);
@@ -55,6 +55,7 @@ public:
 	Variant _new();
 	Object *instantiate();
 	virtual Variant callp(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error) override;
+	virtual bool has_custom_callp() const override { return true; }
 	GDScriptNativeClass(const StringName &p_name);
 };
 
@@ -0,0 +1,65 @@
+/**************************************************************************/
+/*  gdscript_aot.cpp                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_aot.h"
+
+#include "core/templates/hashfuncs.h"
+
+HashMap<String, GDScriptAOT::Function> GDScriptAOT::functions;
+bool GDScriptAOT::enabled = true;
+
+String GDScriptAOT::_make_key(const String &p_path, uint32_t p_source_hash, const StringName &p_function) {
+	return p_path + "::" + String::num_uint64(p_source_hash, 16) + "::" + String(p_function);
+}
+
+void GDScriptAOT::register_function(const String &p_path, uint32_t p_source_hash, const StringName &p_function, Function p_native) {
+	ERR_FAIL_NULL(p_native);
+	functions[_make_key(p_path, p_source_hash, p_function)] = p_native;
+}
+
+GDScriptAOT::Function GDScriptAOT::get_function(const String &p_path, uint32_t p_source_hash, const StringName &p_function) {
+	if (!enabled || functions.is_empty()) {
+		return nullptr;
+	}
+	HashMap<String, Function>::ConstIterator E = functions.find(_make_key(p_path, p_source_hash, p_function));
+	return E ? E->value : nullptr;
+}
+
+void GDScriptAOT::clear() {
+	functions.clear();
+}
+
+uint32_t GDScriptAOT::hash_source(const String &p_source) {
+	return p_source.hash();
+}
+
+uint32_t GDScriptAOT::hash_source(const Vector<uint8_t> &p_binary_tokens) {
+	return hash_murmur3_buffer(p_binary_tokens.ptr(), p_binary_tokens.size());
+}
@@ -0,0 +1,66 @@
+/**************************************************************************/
+/*  gdscript_aot.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_AOT_H
+#define GDSCRIPT_AOT_H
+
+#include "core/string/string_name.h"
+#include "core/templates/hash_map.h"
+#include "core/variant/variant.h"
+
+// Registry of script functions compiled ahead of time to native code.
+// Functions are keyed by script path and a hash of the source they were
+// translated from, so a script edited after export falls back to bytecode.
+class GDScriptAOT {
+public:
+	// Arguments are guaranteed to have the exact declared types.
+	typedef void (*Function)(const Variant **p_args, Variant *r_ret);
+
+private:
+	static HashMap<String, Function> functions;
+	static bool enabled;
+
+	static String _make_key(const String &p_path, uint32_t p_source_hash, const StringName &p_function);
+
+public:
+	static void register_function(const String &p_path, uint32_t p_source_hash, const StringName &p_function, Function p_native);
+	static Function get_function(const String &p_path, uint32_t p_source_hash, const StringName &p_function);
+	static int get_function_count() { return functions.size(); }
+	static void clear();
+
+	// When disabled, scripts compiled from now on only use bytecode.
+	static void set_enabled(bool p_enabled) { enabled = p_enabled; }
+	static bool is_enabled() { return enabled; }
+
+	static uint32_t hash_source(const String &p_source);
+	static uint32_t hash_source(const Vector<uint8_t> &p_binary_tokens);
+};
+
+#endif // GDSCRIPT_AOT_H
@@ -34,6 +34,8 @@
 
 #include "core/debugger/engine_debugger.h"
 
+bool GDScriptByteCodeGenerator::bytecode_optimization_enabled = true;
+
 uint32_t GDScriptByteCodeGenerator::add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) {
 	function->_argument_count++;
 	function->argument_types.push_back(p_type);
@@ -148,9 +150,110 @@ void GDScriptByteCodeGenerator::pop_temporary() {
 	used_temporaries.pop_back();
 }
 
+static bool is_typed_operator_opcode(int p_opcode) {
+	return p_opcode >= GDScriptFunction::OPCODE_OPERATOR_ADD_INT && p_opcode <= GDScriptFunction::OPCODE_OPERATOR_DIVIDE_VECTOR3_FLOAT;
+}
+
+// Peephole pass over the finished bytecode, once temporaries have their final addresses.
+// Instructions are only rewritten in place and never moved, so jump targets, default
+// argument entry points and line opcodes stay valid without any patching.
+void GDScriptByteCodeGenerator::optimize() {
+	int *code = opcodes.ptrw();
+	const int code_size = opcodes.size();
+	const int *starts = instruction_starts.ptr();
+	const int instruction_count = instruction_starts.size();
+
+	// Jump threading: a jump landing on an unconditional jump goes straight to its destination.
+	// This is common at the end of `if` branches nested in loops.
+	for (int i = 0; i < instruction_count; i++) {
+		const int ip = starts[i];
+		int target_offset = 0;
+		switch (code[ip]) {
+			case GDScriptFunction::OPCODE_JUMP:
+				target_offset = 1;
+				break;
+			case GDScriptFunction::OPCODE_JUMP_IF:
+			case GDScriptFunction::OPCODE_JUMP_IF_NOT:
+				target_offset = 2;
+				break;
+			default:
+				continue;
+		}
+		int target = code[ip + target_offset];
+		// Bounded, since jumps can form a cycle (e.g. `while true: pass`).
+		for (int hops = 0; hops < 8 && target < code_size && code[target] == GDScriptFunction::OPCODE_JUMP; hops++) {
+			target = code[target + 1];
+		}
+		if (target != code[ip + target_offset]) {
+			code[ip + target_offset] = target;
+			function->_threaded_jump_count++;
+		}
+	}
+
+	// Superinstructions: fuse common pairs where the second instruction consumes the result of
+	// the first one. Only the opcode of the first instruction is replaced, so the second one
+	// can still be reached by jumps. Pairs are matched on the original opcodes, since the
+	// second instruction of a pair may be the first of the next one.
+	for (int i = 0; i + 1 < instruction_count; i++) {
+		const int first = starts[i];
+		const int second = starts[i + 1];
+		if (second - first != 5) {
+			continue; // Both first parts are five words long.
+		}
+
+		const int original_opcode = code[first];
+		int opcode = original_opcode;
+		if (is_typed_operator_opcode(opcode)) {
+			// Same layout, the fused instruction evaluates it through its evaluator.
+			opcode = GDScriptFunction::OPCODE_OPERATOR_VALIDATED;
+		}
+
+		switch (opcode) {
+			case GDScriptFunction::OPCODE_OPERATOR_VALIDATED: {
+				const int result = code[first + 3];
+				switch (code[second]) {
+					case GDScriptFunction::OPCODE_ASSIGN:
+						if (code[second + 2] == result) {
+							code[first] = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_ASSIGN;
+						}
+						break;
+					case GDScriptFunction::OPCODE_JUMP_IF:
+						if (code[second + 1] == result) {
+							code[first] = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF;
+						}
+						break;
+					case GDScriptFunction::OPCODE_JUMP_IF_NOT:
+						if (code[second + 1] == result) {
+							code[first] = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT;
+						}
+						break;
+					case GDScriptFunction::OPCODE_SET_INDEXED_VALIDATED:
+						if (code[second + 3] == result) {
+							code[first] = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_SET_INDEXED_VALIDATED;
+						}
+						break;
+					default:
+						break;
+				}
+			} break;
+			case GDScriptFunction::OPCODE_GET_INDEXED_VALIDATED: {
+				const int result = code[first + 3];
+				if ((code[second] == GDScriptFunction::OPCODE_OPERATOR_VALIDATED || is_typed_operator_opcode(code[second])) && (code[second + 1] == result || code[second + 2] == result)) {
+					code[first] = GDScriptFunction::OPCODE_GET_INDEXED_VALIDATED_OPERATOR_VALIDATED;
+				}
+			} break;
+			default:
+				break;
+		}
+		if (code[first] != original_opcode) {
+			function->_fused_instruction_count++;
+		}
+	}
+}
+
 void GDScriptByteCodeGenerator::start_parameters() {
 	if (function->_default_arg_count > 0) {
-		append(GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT);
+		append_opcode(GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT);
 		function->default_arguments.push_back(opcodes.size());
 	}
 }
@@ -196,6 +299,10 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		}
 	}
 
+	if (bytecode_optimization_enabled) {
+		optimize();
+	}
+
 	if (constant_map.size()) {
 		function->_constant_count = constant_map.size();
 		function->constants.resize(constant_map.size());
@@ -395,6 +502,14 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		function->_lambdas_count = 0;
 	}
 
+	if (inline_cache_count) {
+		function->_inline_caches_ptr = memnew_arr(GDScriptInlineCache, inline_cache_count);
+		function->_inline_caches_count = inline_cache_count;
+	} else {
+		function->_inline_caches_ptr = nullptr;
+		function->_inline_caches_count = 0;
+	}
+
 	if (debug_stack) {
 		function->stack_debug = stack_debug;
 	}
@@ -584,6 +699,88 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 	}
 }
 
+// Returns the opcode computing the operator inline for these operand types, if there is one.
+static GDScriptFunction::Opcode get_typed_operator_opcode(Variant::Operator p_operator, Variant::Type p_left_type, Variant::Type p_right_type) {
+	if (p_left_type == Variant::INT && p_right_type == Variant::INT) {
+		switch (p_operator) {
+			case Variant::OP_ADD:
+				return GDScriptFunction::OPCODE_OPERATOR_ADD_INT;
+			case Variant::OP_SUBTRACT:
+				return GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_INT;
+			case Variant::OP_MULTIPLY:
+				return GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_INT;
+			case Variant::OP_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_EQUAL_INT;
+			case Variant::OP_NOT_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_NOT_EQUAL_INT;
+			case Variant::OP_LESS:
+				return GDScriptFunction::OPCODE_OPERATOR_LESS_INT;
+			case Variant::OP_LESS_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_LESS_EQUAL_INT;
+			case Variant::OP_GREATER:
+				return GDScriptFunction::OPCODE_OPERATOR_GREATER_INT;
+			case Variant::OP_GREATER_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_INT;
+			default:
+				break;
+		}
+	} else if (p_left_type == Variant::FLOAT && p_right_type == Variant::FLOAT) {
+		switch (p_operator) {
+			case Variant::OP_ADD:
+				return GDScriptFunction::OPCODE_OPERATOR_ADD_FLOAT;
+			case Variant::OP_SUBTRACT:
+				return GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_FLOAT;
+			case Variant::OP_MULTIPLY:
+				return GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_FLOAT;
+			case Variant::OP_DIVIDE:
+				return GDScriptFunction::OPCODE_OPERATOR_DIVIDE_FLOAT;
+			case Variant::OP_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_EQUAL_FLOAT;
+			case Variant::OP_NOT_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_NOT_EQUAL_FLOAT;
+			case Variant::OP_LESS:
+				return GDScriptFunction::OPCODE_OPERATOR_LESS_FLOAT;
+			case Variant::OP_LESS_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_LESS_EQUAL_FLOAT;
+			case Variant::OP_GREATER:
+				return GDScriptFunction::OPCODE_OPERATOR_GREATER_FLOAT;
+			case Variant::OP_GREATER_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_FLOAT;
+			default:
+				break;
+		}
+	} else if (p_left_type == Variant::VECTOR2 && (p_right_type == Variant::VECTOR2 || p_right_type == Variant::FLOAT)) {
+		const bool by_float = p_right_type == Variant::FLOAT;
+		switch (p_operator) {
+			case Variant::OP_ADD:
+				return by_float ? GDScriptFunction::OPCODE_OPERATOR_VALIDATED : GDScriptFunction::OPCODE_OPERATOR_ADD_VECTOR2;
+			case Variant::OP_SUBTRACT:
+				return by_float ? GDScriptFunction::OPCODE_OPERATOR_VALIDATED : GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_VECTOR2;
+			case Variant::OP_MULTIPLY:
+				return by_float ? GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR2_FLOAT : GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR2;
+			case Variant::OP_DIVIDE:
+				return by_float ? GDScriptFunction::OPCODE_OPERATOR_DIVIDE_VECTOR2_FLOAT : GDScriptFunction::OPCODE_OPERATOR_VALIDATED;
+			default:
+				break;
+		}
+	} else if (p_left_type == Variant::VECTOR3 && (p_right_type == Variant::VECTOR3 || p_right_type == Variant::FLOAT)) {
+		const bool by_float = p_right_type == Variant::FLOAT;
+		switch (p_operator) {
+			case Variant::OP_ADD:
+				return by_float ? GDScriptFunction::OPCODE_OPERATOR_VALIDATED : GDScriptFunction::OPCODE_OPERATOR_ADD_VECTOR3;
+			case Variant::OP_SUBTRACT:
+				return by_float ? GDScriptFunction::OPCODE_OPERATOR_VALIDATED : GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_VECTOR3;
+			case Variant::OP_MULTIPLY:
+				return by_float ? GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT : GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR3;
+			case Variant::OP_DIVIDE:
+				return by_float ? GDScriptFunction::OPCODE_OPERATOR_DIVIDE_VECTOR3_FLOAT : GDScriptFunction::OPCODE_OPERATOR_VALIDATED;
+			default:
+				break;
+		}
+	}
+	return GDScriptFunction::OPCODE_OPERATOR_VALIDATED;
+}
+
 void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, Variant::Operator p_operator, const Address &p_left_operand, const Address &p_right_operand) {
 	bool valid = HAS_BUILTIN_TYPE(p_left_operand) && HAS_BUILTIN_TYPE(p_right_operand);
 
@@ -615,7 +812,7 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 
-		append_opcode(GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
+		append_opcode(bytecode_optimization_enabled ? get_typed_operator_opcode(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type) : GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
 		append(p_left_operand);
 		append(p_right_operand);
 		append(p_target);
@@ -790,7 +987,25 @@ void GDScriptByteCodeGenerator::write_end_ternary() {
 
 void GDScriptByteCodeGenerator::write_set(const Address &p_target, const Address &p_index, const Address &p_source) {
 	if (HAS_BUILTIN_TYPE(p_target)) {
-		if (IS_BUILTIN_TYPE(p_index, Variant::INT) && Variant::get_member_validated_indexed_setter(p_target.type.builtin_type) &&
+		if (p_target.type.builtin_type == Variant::ARRAY && IS_BUILTIN_TYPE(p_index, Variant::INT)) {
+			const GDScriptDataType element_type = p_target.type.get_container_element_type_or_variant(0);
+			if (element_type.has_type && element_type.kind == GDScriptDataType::BUILTIN && element_type.builtin_type != Variant::OBJECT && IS_BUILTIN_TYPE(p_source, element_type.builtin_type)) {
+				// Value of the element type, stored without going through the array type validation.
+				append_opcode(GDScriptFunction::OPCODE_SET_TYPED_ARRAY_INDEXED);
+				append(p_target);
+				append(p_index);
+				append(p_source);
+				append(element_type.builtin_type);
+				return;
+			}
+			// Any value is accepted, the array validates it against its element type.
+			append_opcode(GDScriptFunction::OPCODE_SET_INDEXED_VALIDATED);
+			append(p_target);
+			append(p_index);
+			append(p_source);
+			append(Variant::get_member_validated_indexed_setter(Variant::ARRAY));
+			return;
+		} else if (IS_BUILTIN_TYPE(p_index, Variant::INT) && Variant::get_member_validated_indexed_setter(p_target.type.builtin_type) &&
 				IS_BUILTIN_TYPE(p_source, Variant::get_indexed_element_type(p_target.type.builtin_type))) {
 			// Use indexed setter instead.
 			Variant::ValidatedIndexedSetter setter = Variant::get_member_validated_indexed_setter(p_target.type.builtin_type);
@@ -861,6 +1076,7 @@ void GDScriptByteCodeGenerator::write_set_named(const Address &p_target, const S
 	append(p_target);
 	append(p_source);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const StringName &p_name, const Address &p_source) {
@@ -879,6 +1095,7 @@ void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const S
 	append(p_source);
 	append(p_target);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_set_member(const Address &p_value, const StringName &p_name) {
@@ -1093,6 +1310,7 @@ void GDScriptByteCodeGenerator::write_call(const Address &p_target, const Addres
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1118,6 +1336,7 @@ void GDScriptByteCodeGenerator::write_call_async(const Address &p_target, const
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1352,6 +1571,7 @@ void GDScriptByteCodeGenerator::write_call_self(const Address &p_target, const S
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1365,6 +1585,7 @@ void GDScriptByteCodeGenerator::write_call_self_async(const Address &p_target, c
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1378,6 +1599,7 @@ void GDScriptByteCodeGenerator::write_call_script_function(const Address &p_targ
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
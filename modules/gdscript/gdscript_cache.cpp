@@ -34,10 +34,18 @@
 #include "gdscript_analyzer.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
+#include "gdscript_tokenizer_buffer.h"
 
+#include "core/config/engine.h"
+#include "core/config/project_settings.h"
+#include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/vector.h"
 
+#define COMPILATION_CACHE_MAGIC "GDCC"
+#define COMPILATION_CACHE_VERSION 1
+
 GDScriptParserRef::Status GDScriptParserRef::get_status() const {
 	return status;
 }
@@ -83,7 +91,13 @@ Error GDScriptParserRef::raise_status(Status p_new_status) {
 				} else {
 					String source = GDScriptCache::get_source_code(remapped_path);
 					source_hash = source.hash();
-					result = get_parser()->parse(source, path, false);
+					GDScriptCache::CompilationCacheEntry cache_entry;
+					if (GDScriptCache::get_compilation_cache(path, source, cache_entry) && !cache_entry.tokens.is_empty()) {
+						result = get_parser()->parse_binary(cache_entry.tokens, path);
+					}
+					if (cache_entry.tokens.is_empty() || result != OK) {
+						result = get_parser()->parse(source, path, false);
+					}
 				}
 			} break;
 			case PARSED: {
@@ -222,6 +236,7 @@ Ref<GDScriptParserRef> GDScriptCache::get_parser(const String &p_path, GDScriptP
 			r_error = ERR_INVALID_DATA;
 			return ref;
 		}
+		singleton->prepared_parsers.erase(p_path);
 	} else {
 		String remapped_path = ResourceLoader::path_remap(p_path);
 		if (!FileAccess::exists(remapped_path)) {
@@ -250,6 +265,7 @@ void GDScriptCache::remove_parser(const String &p_path) {
 		parser_ref->abandoned = true;
 		singleton->abandoned_parser_map[p_path].push_back(parser_ref->get_instance_id());
 	}
+	singleton->prepared_parsers.erase(p_path);
 
 	// Can't clear the parser because some other parser might be currently using it in the chain of calls.
 	singleton->parser_map.erase(p_path);
@@ -445,6 +461,198 @@ void GDScriptCache::remove_static_script(const String &p_fqcn) {
 	singleton->static_gdscript_cache.erase(p_fqcn);
 }
 
+bool GDScriptCache::_is_compilation_cache_enabled() {
+#ifdef TOOLS_ENABLED
+	return GLOBAL_GET("debug/gdscript/compilation_cache/enabled");
+#else
+	return false; // Exported projects are read-only and ship binary tokens already.
+#endif
+}
+
+String GDScriptCache::_get_compilation_cache_path(const String &p_path) {
+	return ProjectSettings::get_singleton()->get_project_data_path().path_join("gdscript_cache").path_join(p_path.md5_text() + ".cache");
+}
+
+Vector<String> GDScriptCache::_get_cached_dependencies(const String &p_path) {
+	Vector<String> dependencies;
+	Ref<FileAccess> f = FileAccess::open(_get_compilation_cache_path(p_path), FileAccess::READ);
+	if (f.is_null()) {
+		return dependencies;
+	}
+
+	uint8_t magic[4];
+	if (f->get_buffer(magic, 4) != 4 || memcmp(magic, COMPILATION_CACHE_MAGIC, 4) != 0 || f->get_32() != COMPILATION_CACHE_VERSION) {
+		return dependencies;
+	}
+	f->seek(f->get_position() + 16); // Source MD5.
+
+	uint32_t count = f->get_32();
+	for (uint32_t i = 0; i < count && !f->eof_reached(); i++) {
+		dependencies.push_back(f->get_pascal_string());
+	}
+	return dependencies;
+}
+
+bool GDScriptCache::get_compilation_cache(const String &p_path, const String &p_source, CompilationCacheEntry &r_entry) {
+	if (singleton == nullptr || !p_path.begins_with("res://") || !_is_compilation_cache_enabled()) {
+		return false;
+	}
+	r_entry.source_md5 = p_source.md5_buffer();
+
+	Ref<FileAccess> f = FileAccess::open(_get_compilation_cache_path(p_path), FileAccess::READ);
+	if (f.is_null()) {
+		return false;
+	}
+
+	uint8_t magic[4];
+	if (f->get_buffer(magic, 4) != 4 || memcmp(magic, COMPILATION_CACHE_MAGIC, 4) != 0 || f->get_32() != COMPILATION_CACHE_VERSION) {
+		return false;
+	}
+	uint8_t md5[16];
+	if (f->get_buffer(md5, 16) != 16 || memcmp(md5, r_entry.source_md5.ptr(), 16) != 0) {
+		return false; // The source changed.
+	}
+
+	uint32_t count = f->get_32();
+	for (uint32_t i = 0; i < count && !f->eof_reached(); i++) {
+		r_entry.dependencies.push_back(f->get_pascal_string());
+	}
+
+	uint32_t tokens_size = f->get_32();
+	if (tokens_size > f->get_length() - f->get_position()) {
+		r_entry.dependencies.clear();
+		return false; // Truncated or corrupt.
+	}
+	if (tokens_size > 0 && !Engine::get_singleton()->is_editor_hint()) {
+		r_entry.tokens.resize(tokens_size);
+		if (f->get_buffer(r_entry.tokens.ptrw(), tokens_size) != tokens_size) {
+			r_entry.tokens.clear();
+		}
+	}
+	if (f->eof_reached()) {
+		r_entry.dependencies.clear();
+		r_entry.tokens.clear();
+		return false; // Truncated.
+	}
+
+	r_entry.stored = true;
+	return true;
+}
+
+void GDScriptCache::update_compilation_cache(const String &p_path, const String &p_source, const CompilationCacheEntry &p_entry, const HashMap<String, Ref<GDScriptParserRef>> &p_dependencies) {
+	if (p_entry.source_md5.size() != 16) {
+		return; // Not enabled for this script.
+	}
+
+	Vector<String> dependencies;
+	for (const KeyValue<String, Ref<GDScriptParserRef>> &E : p_dependencies) {
+		if (E.key != p_path) {
+			dependencies.push_back(E.key);
+		}
+	}
+	dependencies.sort();
+
+	bool with_tokens = !Engine::get_singleton()->is_editor_hint();
+	if (p_entry.stored && p_entry.dependencies == dependencies && (!with_tokens || !p_entry.tokens.is_empty())) {
+		return; // Up to date.
+	}
+
+	Vector<uint8_t> tokens;
+	if (with_tokens) {
+		tokens = GDScriptTokenizerBuffer::parse_code_string(p_source, GDScriptTokenizerBuffer::COMPRESS_NONE);
+	}
+
+	const String cache_path = _get_compilation_cache_path(p_path);
+	DirAccess::make_dir_recursive_absolute(cache_path.get_base_dir());
+	Ref<FileAccess> f = FileAccess::open(cache_path, FileAccess::WRITE);
+	if (f.is_null()) {
+		return; // Not worth an error, the project folder might be read-only.
+	}
+
+	f->store_buffer((const uint8_t *)COMPILATION_CACHE_MAGIC, 4);
+	f->store_32(COMPILATION_CACHE_VERSION);
+	f->store_buffer(p_entry.source_md5.ptr(), 16);
+	f->store_32(dependencies.size());
+	for (const String &dependency : dependencies) {
+		f->store_pascal_string(dependency);
+	}
+	f->store_32(tokens.size());
+	f->store_buffer(tokens.ptr(), tokens.size());
+}
+
+void GDScriptCache::_parse_script(void *p_userdata, uint32_t p_index) {
+	Ref<GDScriptParserRef> *parsers = (Ref<GDScriptParserRef> *)p_userdata;
+	parsers[p_index]->raise_status(GDScriptParserRef::PARSED);
+}
+
+void GDScriptCache::parse_scripts(const Vector<String> &p_paths) {
+	if (singleton == nullptr) {
+		return;
+	}
+
+	// Follow the dependencies stored by previous runs, which may be stale but only
+	// decide what is parsed ahead of time.
+	LocalVector<Ref<GDScriptParserRef>> parsers;
+	HashSet<String> visited;
+	List<String> pending;
+	for (const String &path : p_paths) {
+		pending.push_back(path);
+	}
+	bool follow_dependencies = _is_compilation_cache_enabled();
+	while (!pending.is_empty()) {
+		const String path = pending.front()->get();
+		pending.pop_front();
+		if (visited.has(path)) {
+			continue;
+		}
+		visited.insert(path);
+
+		{
+			MutexLock lock(singleton->mutex);
+			if (singleton->cleared || singleton->parser_map.has(path)) {
+				continue;
+			}
+		}
+		if (!FileAccess::exists(ResourceLoader::path_remap(path))) {
+			continue;
+		}
+
+		Ref<GDScriptParserRef> ref;
+		ref.instantiate();
+		ref->path = path;
+		ref->abandoned = true; // Not in the parser map yet.
+		ref->get_parser(); // Constructed here, the first one sets up static data.
+		parsers.push_back(ref);
+
+		if (follow_dependencies) {
+			for (const String &dependency : _get_cached_dependencies(path)) {
+				pending.push_back(dependency);
+			}
+		}
+	}
+
+	if (parsers.is_empty()) {
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&_parse_script, parsers.ptr(), parsers.size(), -1, true, SNAME("GDScriptParseScripts"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	MutexLock lock(singleton->mutex);
+	if (singleton->cleared) {
+		return;
+	}
+	for (Ref<GDScriptParserRef> &ref : parsers) {
+		// Scripts with errors are parsed again when needed, so they are reported as usual.
+		if (ref->result != OK || singleton->parser_map.has(ref->path)) {
+			continue;
+		}
+		ref->abandoned = false;
+		singleton->parser_map[ref->path] = ref.ptr();
+		singleton->prepared_parsers[ref->path] = ref;
+	}
+}
+
 void GDScriptCache::clear() {
 	if (singleton == nullptr) {
 		return;
@@ -476,6 +684,7 @@ void GDScriptCache::clear() {
 	}
 
 	singleton->parser_map.clear();
+	singleton->prepared_parsers.clear();
 
 	for (Ref<GDScriptParserRef> &E : parser_map_refs) {
 		if (E.is_valid()) {
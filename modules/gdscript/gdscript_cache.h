@@ -86,6 +86,8 @@ class GDScriptCache {
 	HashMap<String, Ref<GDScript>> static_gdscript_cache;
 	HashMap<String, HashSet<String>> dependencies;
 	HashMap<String, HashSet<String>> parser_inverse_dependencies;
+	// Parsed ahead of time by parse_scripts(), held until first requested.
+	HashMap<String, Ref<GDScriptParserRef>> prepared_parsers;
 
 	friend class GDScript;
 	friend class GDScriptParserRef;
@@ -94,6 +96,10 @@ class GDScriptCache {
 	static GDScriptCache *singleton;
 
 	bool cleared = false;
+	static bool _is_compilation_cache_enabled();
+	static String _get_compilation_cache_path(const String &p_path);
+	static Vector<String> _get_cached_dependencies(const String &p_path);
+	static void _parse_script(void *p_userdata, uint32_t p_index);
 
 public:
 	static const int BINARY_MUTEX_TAG = 2;
@@ -103,6 +109,14 @@ private:
 	friend SafeBinaryMutex<BINARY_MUTEX_TAG> &_get_gdscript_cache_mutex();
 
 public:
+	// Kept in the project data folder between runs, for scripts whose source did not change.
+	struct CompilationCacheEntry {
+		Vector<uint8_t> source_md5;
+		Vector<uint8_t> tokens; // Only used outside the editor, which needs the comments.
+		Vector<String> dependencies; // Scripts the analyzer needed last time.
+		bool stored = false;
+	};
+
 	static void move_script(const String &p_from, const String &p_to);
 	static void remove_script(const String &p_path);
 	static Ref<GDScriptParserRef> get_parser(const String &p_path, GDScriptParserRef::Status status, Error &r_error, const String &p_owner = String());
@@ -117,6 +131,14 @@ public:
 	static void add_static_script(Ref<GDScript> p_script);
 	static void remove_static_script(const String &p_fqcn);
 
+	// Returns true when the stored entry matches `p_source`.
+	static bool get_compilation_cache(const String &p_path, const String &p_source, CompilationCacheEntry &r_entry);
+	// Stores the entry again if the dependencies changed or the tokens are missing.
+	static void update_compilation_cache(const String &p_path, const String &p_source, const CompilationCacheEntry &p_entry, const HashMap<String, Ref<GDScriptParserRef>> &p_dependencies);
+	// Parses the scripts in parallel, and those they depended on in previous runs, so the
+	// analyzer finds them ready. Errors are left to be reported when they are needed.
+	static void parse_scripts(const Vector<String> &p_paths);
+
 	static void clear();
 
 	GDScriptCache();
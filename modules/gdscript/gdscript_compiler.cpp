@@ -2458,6 +2458,10 @@ GDScriptFunction *GDScriptCompiler::_parse_function(Error &r_error, GDScript *p_
 
 	GDScriptFunction *gd_function = codegen.generator->write_end();
 
+	if (p_func && !p_for_lambda && p_class == parser->get_tree() && GDScriptAOT::get_function_count() > 0) {
+		gd_function->native_function = GDScriptAOT::get_function(p_script->path, aot_source_hash, func_name);
+	}
+
 	if (is_initializer) {
 		p_script->initializer = gd_function;
 	} else if (is_implicit_initializer) {
@@ -3262,6 +3266,13 @@ Error GDScriptCompiler::compile(const GDScriptParser *p_parser, GDScript *p_scri
 
 	source = p_script->get_path();
 
+	if (GDScriptAOT::get_function_count() > 0) {
+		aot_source_hash = p_script->binary_tokens.is_empty() ? GDScriptAOT::hash_source(p_script->source) : GDScriptAOT::hash_source(p_script->binary_tokens);
+	}
+
+	// Functions and members are about to be replaced.
+	GDScriptInlineCache::invalidate_scripts();
+
 	ScriptLambdaInfo old_lambda_info = _get_script_lambda_replacement_info(p_script);
 
 	// Create scripts for subclasses beforehand so they can be referenced
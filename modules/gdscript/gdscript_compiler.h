@@ -43,6 +43,7 @@ class GDScriptCompiler {
 	HashSet<GDScript *> parsed_classes;
 	HashSet<GDScript *> parsing_classes;
 	GDScript *main_script = nullptr;
+	uint32_t aot_source_hash = 0; // Only computed when ahead-of-time compiled functions are registered.
 
 	struct FunctionLambdaInfo {
 		GDScriptFunction *function = nullptr;
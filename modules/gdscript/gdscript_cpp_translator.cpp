@@ -0,0 +1,1074 @@
+/**************************************************************************/
+/*  gdscript_cpp_translator.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_cpp_translator.h"
+
+#include "gdscript_utility_functions.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+
+#include <stdio.h>
+
+namespace {
+
+struct UtilityFunctionInfo {
+	const char *name;
+	Variant::Type return_type;
+	Variant::Type argument_type;
+	int argument_count;
+};
+
+// Variant utility functions with fixed argument types, called directly through `VariantUtilityFunctions`.
+const UtilityFunctionInfo utility_functions[] = {
+	{ "sin", Variant::FLOAT, Variant::FLOAT, 1 },
+	{ "cos", Variant::FLOAT, Variant::FLOAT, 1 },
+	{ "tan", Variant::FLOAT, Variant::FLOAT, 1 },
+	{ "asin", Variant::FLOAT, Variant::FLOAT, 1 },
+	{ "acos", Variant::FLOAT, Variant::FLOAT, 1 },
+	{ "atan", Variant::FLOAT, Variant::FLOAT, 1 },
+	{ "atan2", Variant::FLOAT, Variant::FLOAT, 2 },
+	{ "sqrt", Variant::FLOAT, Variant::FLOAT, 1 },
+	{ "fmod", Variant::FLOAT, Variant::FLOAT, 2 },
+	{ "fposmod", Variant::FLOAT, Variant::FLOAT, 2 },
+	{ "posmod", Variant::INT, Variant::INT, 2 },
+	{ "floorf", Variant::FLOAT, Variant::FLOAT, 1 },
+	{ "floori", Variant::INT, Variant::FLOAT, 1 },
+	{ "ceilf", Variant::FLOAT, Variant::FLOAT, 1 },
+	{ "ceili", Variant::INT, Variant::FLOAT, 1 },
+	{ "roundf", Variant::FLOAT, Variant::FLOAT, 1 },
+	{ "roundi", Variant::INT, Variant::FLOAT, 1 },
+	{ "absf", Variant::FLOAT, Variant::FLOAT, 1 },
+	{ "absi", Variant::INT, Variant::INT, 1 },
+	{ "signf", Variant::FLOAT, Variant::FLOAT, 1 },
+	{ "signi", Variant::INT, Variant::INT, 1 },
+	{ "pow", Variant::FLOAT, Variant::FLOAT, 2 },
+	{ "log", Variant::FLOAT, Variant::FLOAT, 1 },
+	{ "exp", Variant::FLOAT, Variant::FLOAT, 1 },
+	{ "is_nan", Variant::BOOL, Variant::FLOAT, 1 },
+	{ "is_inf", Variant::BOOL, Variant::FLOAT, 1 },
+	{ "is_finite", Variant::BOOL, Variant::FLOAT, 1 },
+	{ "is_equal_approx", Variant::BOOL, Variant::FLOAT, 2 },
+	{ "is_zero_approx", Variant::BOOL, Variant::FLOAT, 1 },
+	{ "lerpf", Variant::FLOAT, Variant::FLOAT, 3 },
+	{ "inverse_lerp", Variant::FLOAT, Variant::FLOAT, 3 },
+	{ "remap", Variant::FLOAT, Variant::FLOAT, 5 },
+	{ "smoothstep", Variant::FLOAT, Variant::FLOAT, 3 },
+	{ "move_toward", Variant::FLOAT, Variant::FLOAT, 3 },
+	{ "deg_to_rad", Variant::FLOAT, Variant::FLOAT, 1 },
+	{ "rad_to_deg", Variant::FLOAT, Variant::FLOAT, 1 },
+	{ "wrapf", Variant::FLOAT, Variant::FLOAT, 3 },
+	{ "wrapi", Variant::INT, Variant::INT, 3 },
+	{ "minf", Variant::FLOAT, Variant::FLOAT, 2 },
+	{ "maxf", Variant::FLOAT, Variant::FLOAT, 2 },
+	{ "mini", Variant::INT, Variant::INT, 2 },
+	{ "maxi", Variant::INT, Variant::INT, 2 },
+	{ "clampf", Variant::FLOAT, Variant::FLOAT, 3 },
+	{ "clampi", Variant::INT, Variant::INT, 3 },
+	{ nullptr, Variant::NIL, Variant::NIL, 0 },
+};
+
+struct VectorMethodInfo {
+	const char *name;
+	Variant::Type return_type; // NIL returns the vector type itself.
+	int argument_count; // Arguments have the vector type.
+};
+
+const VectorMethodInfo vector_methods[] = {
+	{ "length", Variant::FLOAT, 0 },
+	{ "length_squared", Variant::FLOAT, 0 },
+	{ "normalized", Variant::NIL, 0 },
+	{ "dot", Variant::FLOAT, 1 },
+	{ "distance_to", Variant::FLOAT, 1 },
+	{ "distance_squared_to", Variant::FLOAT, 1 },
+	{ nullptr, Variant::NIL, 0 },
+};
+
+Error write_text_file(const String &p_path, const String &p_text) {
+	Error err = OK;
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat(R"(Cannot write "%s".)", p_path));
+	file->store_string(p_text);
+	return OK;
+}
+
+} // namespace
+
+bool GDScriptCppTranslator::_is_supported_type(Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::BOOL:
+		case Variant::INT:
+		case Variant::FLOAT:
+		case Variant::VECTOR2:
+		case Variant::VECTOR3:
+			return true;
+		default:
+			return false;
+	}
+}
+
+bool GDScriptCppTranslator::_is_numeric_type(Variant::Type p_type) {
+	return p_type == Variant::INT || p_type == Variant::FLOAT;
+}
+
+String GDScriptCppTranslator::_get_cpp_type(Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::NIL:
+			return "void";
+		case Variant::BOOL:
+			return "bool";
+		case Variant::INT:
+			return "int64_t";
+		case Variant::FLOAT:
+			return "double";
+		case Variant::VECTOR2:
+			return "Vector2";
+		case Variant::VECTOR3:
+			return "Vector3";
+		default:
+			ERR_FAIL_V(String());
+	}
+}
+
+bool GDScriptCppTranslator::_get_declared_type(const GDScriptParser::DataType &p_datatype, Variant::Type &r_type) {
+	if (p_datatype.kind != GDScriptParser::DataType::BUILTIN || !p_datatype.is_hard_type()) {
+		return false;
+	}
+	r_type = p_datatype.builtin_type;
+	return r_type == Variant::NIL || _is_supported_type(r_type);
+}
+
+String GDScriptCppTranslator::_make_identifier(const String &p_prefix, const StringName &p_name, int p_index) {
+	// GDScript identifiers may be Unicode, keep C++ ones ASCII.
+	const String name = p_name;
+	if (name.is_valid_ascii_identifier()) {
+		return p_prefix + name;
+	}
+	return p_prefix + itos(p_index);
+}
+
+String GDScriptCppTranslator::_make_indent(int p_indent) {
+	return String("\t").repeat(p_indent);
+}
+
+String GDScriptCppTranslator::_make_float_literal(double p_value) {
+	char buffer[64];
+	snprintf(buffer, sizeof(buffer), "%.17g", p_value);
+	String literal = buffer;
+	if (!literal.contains_char('.') && !literal.contains_char('e')) {
+		literal += ".0";
+	}
+	return literal;
+}
+
+bool GDScriptCppTranslator::_fail(const String &p_reason) {
+	if (error.is_empty()) {
+		error = p_reason;
+	}
+	return false;
+}
+
+bool GDScriptCppTranslator::_make_literal(const Variant &p_value, Value &r_value) {
+	r_value.type = p_value.get_type();
+	switch (p_value.get_type()) {
+		case Variant::BOOL: {
+			r_value.code = bool(p_value) ? "true" : "false";
+		} break;
+		case Variant::INT: {
+			const int64_t value = p_value;
+			r_value.code = value == INT64_MIN ? String("INT64_MIN") : "int64_t(" + itos(value) + "LL)";
+		} break;
+		case Variant::FLOAT: {
+			const double value = p_value;
+			if (!Math::is_finite(value)) {
+				return _fail("Non-finite constants are not translated.");
+			}
+			r_value.code = _make_float_literal(value);
+		} break;
+		case Variant::VECTOR2: {
+			const Vector2 value = p_value;
+			if (!value.is_finite()) {
+				return _fail("Non-finite constants are not translated.");
+			}
+			r_value.code = vformat("Vector2(%s, %s)", _make_float_literal(value.x), _make_float_literal(value.y));
+		} break;
+		case Variant::VECTOR3: {
+			const Vector3 value = p_value;
+			if (!value.is_finite()) {
+				return _fail("Non-finite constants are not translated.");
+			}
+			r_value.code = vformat("Vector3(%s, %s, %s)", _make_float_literal(value.x), _make_float_literal(value.y), _make_float_literal(value.z));
+		} break;
+		default:
+			return _fail(vformat("Constants of type %s are not translated.", Variant::get_type_name(p_value.get_type())));
+	}
+	return true;
+}
+
+bool GDScriptCppTranslator::_convert(const Value &p_value, Variant::Type p_type, String &r_code) {
+	if (p_value.type == p_type) {
+		r_code = p_value.code;
+		return true;
+	}
+	if (p_value.type == Variant::INT && p_type == Variant::FLOAT) {
+		r_code = "double(" + p_value.code + ")";
+		return true;
+	}
+	if (p_value.type == Variant::FLOAT && p_type == Variant::INT) {
+		r_code = "int64_t(" + p_value.code + ")";
+		return true;
+	}
+	if (p_value.type == Variant::NIL) {
+		return _fail("A void call is used as a value.");
+	}
+	return _fail(vformat("Cannot convert %s to %s.", Variant::get_type_name(p_value.type), Variant::get_type_name(p_type)));
+}
+
+bool GDScriptCppTranslator::_translate_expression(const GDScriptParser::ExpressionNode *p_expression, Value &r_value) {
+	if (p_expression->is_constant) {
+		return _make_literal(p_expression->reduced_value, r_value);
+	}
+
+	switch (p_expression->type) {
+		case GDScriptParser::Node::LITERAL: {
+			return _make_literal(static_cast<const GDScriptParser::LiteralNode *>(p_expression)->value, r_value);
+		}
+		case GDScriptParser::Node::IDENTIFIER: {
+			const GDScriptParser::IdentifierNode *identifier = static_cast<const GDScriptParser::IdentifierNode *>(p_expression);
+			const Local *local = locals.getptr(identifier->name);
+			if (!local) {
+				return _fail(vformat(R"(Identifier "%s" is not a typed local variable or parameter.)", identifier->name));
+			}
+			r_value.code = local->symbol;
+			r_value.type = local->type;
+			return true;
+		}
+		case GDScriptParser::Node::BINARY_OPERATOR: {
+			const GDScriptParser::BinaryOpNode *binary = static_cast<const GDScriptParser::BinaryOpNode *>(p_expression);
+			Value left;
+			Value right;
+			if (!_translate_expression(binary->left_operand, left) || !_translate_expression(binary->right_operand, right)) {
+				return false;
+			}
+			return _translate_binary(binary->variant_op, left, right, binary->right_operand, r_value);
+		}
+		case GDScriptParser::Node::UNARY_OPERATOR: {
+			const GDScriptParser::UnaryOpNode *unary = static_cast<const GDScriptParser::UnaryOpNode *>(p_expression);
+			Value operand;
+			if (!_translate_expression(unary->operand, operand)) {
+				return false;
+			}
+			return _translate_unary(unary->variant_op, operand, r_value);
+		}
+		case GDScriptParser::Node::TERNARY_OPERATOR: {
+			const GDScriptParser::TernaryOpNode *ternary = static_cast<const GDScriptParser::TernaryOpNode *>(p_expression);
+			String condition;
+			Value true_value;
+			Value false_value;
+			if (!_translate_condition(ternary->condition, condition) || !_translate_expression(ternary->true_expr, true_value) || !_translate_expression(ternary->false_expr, false_value)) {
+				return false;
+			}
+			// The result keeps the type of the chosen branch, so both must agree.
+			if (true_value.type != false_value.type || !_is_supported_type(true_value.type)) {
+				return _fail("Ternary operator branches have different types.");
+			}
+			r_value.code = "(" + condition + " ? " + true_value.code + " : " + false_value.code + ")";
+			r_value.type = true_value.type;
+			return true;
+		}
+		case GDScriptParser::Node::CALL: {
+			return _translate_call(static_cast<const GDScriptParser::CallNode *>(p_expression), r_value);
+		}
+		case GDScriptParser::Node::SUBSCRIPT: {
+			const GDScriptParser::SubscriptNode *subscript = static_cast<const GDScriptParser::SubscriptNode *>(p_expression);
+			if (!subscript->is_attribute) {
+				return _fail("Indexing is not translated.");
+			}
+			Value base;
+			if (!_translate_expression(subscript->base, base)) {
+				return false;
+			}
+			const StringName &attribute = subscript->attribute->name;
+			const bool is_component = (base.type == Variant::VECTOR2 && (attribute == "x" || attribute == "y")) || (base.type == Variant::VECTOR3 && (attribute == "x" || attribute == "y" || attribute == "z"));
+			if (!is_component) {
+				return _fail(vformat(R"(Property "%s" is not translated.)", attribute));
+			}
+			// Components are `real_t`, widen them like the Variant getter does.
+			r_value.code = "double(" + base.code + "." + String(attribute) + ")";
+			r_value.type = Variant::FLOAT;
+			return true;
+		}
+		default:
+			return _fail("Expression kind is not translated.");
+	}
+}
+
+bool GDScriptCppTranslator::_translate_binary(Variant::Operator p_operator, const Value &p_left, const Value &p_right, const GDScriptParser::ExpressionNode *p_right_node, Value &r_value) {
+	if (!_is_supported_type(p_left.type) || !_is_supported_type(p_right.type)) {
+		return _fail("A void call is used as an operand.");
+	}
+
+	const Variant::Type result_type = Variant::get_operator_return_type(p_operator, p_left.type, p_right.type);
+	if (!_is_supported_type(result_type)) {
+		return _fail(vformat(R"(Operator "%s" between %s and %s is not translated.)", Variant::get_operator_name(p_operator), Variant::get_type_name(p_left.type), Variant::get_type_name(p_right.type)));
+	}
+
+	const char *cpp_operator = nullptr;
+	switch (p_operator) {
+		case Variant::OP_ADD:
+			cpp_operator = "+";
+			break;
+		case Variant::OP_SUBTRACT:
+			cpp_operator = "-";
+			break;
+		case Variant::OP_MULTIPLY:
+			cpp_operator = "*";
+			break;
+		case Variant::OP_DIVIDE:
+		case Variant::OP_MODULE: {
+			if (p_operator == Variant::OP_MODULE && result_type != Variant::INT) {
+				return _fail("Modulo is only translated for integers.");
+			}
+			if (result_type == Variant::INT) {
+				// Integer division by zero is a runtime error in GDScript, only allow known divisors.
+				if (!p_right_node || !p_right_node->is_constant || p_right_node->reduced_value.get_type() != Variant::INT || int64_t(p_right_node->reduced_value) == 0) {
+					return _fail("Integer division by a value that is not a non-zero constant.");
+				}
+			}
+			cpp_operator = p_operator == Variant::OP_DIVIDE ? "/" : "%";
+		} break;
+		case Variant::OP_POWER: {
+			r_value.code = vformat("%s(Math::pow(double(%s), double(%s)))", _get_cpp_type(result_type), p_left.code, p_right.code);
+			r_value.type = result_type;
+			return true;
+		}
+		case Variant::OP_BIT_AND:
+		case Variant::OP_BIT_OR:
+		case Variant::OP_BIT_XOR: {
+			if (p_left.type != Variant::INT || p_right.type != Variant::INT) {
+				return _fail("Bitwise operators are only translated for integers.");
+			}
+			cpp_operator = p_operator == Variant::OP_BIT_AND ? "&" : (p_operator == Variant::OP_BIT_OR ? "|" : "^");
+		} break;
+		case Variant::OP_EQUAL:
+		case Variant::OP_NOT_EQUAL:
+		case Variant::OP_LESS:
+		case Variant::OP_LESS_EQUAL:
+		case Variant::OP_GREATER:
+		case Variant::OP_GREATER_EQUAL: {
+			if (p_left.type != p_right.type && !(_is_numeric_type(p_left.type) && _is_numeric_type(p_right.type))) {
+				return _fail("Comparison between different types is not translated.");
+			}
+			static const char *comparisons[] = { "==", "!=", "<", "<=", ">", ">=" };
+			cpp_operator = comparisons[p_operator - Variant::OP_EQUAL];
+		} break;
+		case Variant::OP_AND:
+		case Variant::OP_OR: {
+			if (p_left.type != Variant::BOOL || p_right.type != Variant::BOOL) {
+				return _fail("Logic operators are only translated for booleans.");
+			}
+			cpp_operator = p_operator == Variant::OP_AND ? "&&" : "||";
+		} break;
+		default:
+			return _fail(vformat(R"(Operator "%s" is not translated.)", Variant::get_operator_name(p_operator)));
+	}
+
+	r_value.code = "(" + p_left.code + " " + cpp_operator + " " + p_right.code + ")";
+	r_value.type = result_type;
+	return true;
+}
+
+bool GDScriptCppTranslator::_translate_unary(Variant::Operator p_operator, const Value &p_operand, Value &r_value) {
+	switch (p_operator) {
+		case Variant::OP_NEGATE:
+		case Variant::OP_POSITIVE: {
+			if (!_is_numeric_type(p_operand.type) && p_operand.type != Variant::VECTOR2 && p_operand.type != Variant::VECTOR3) {
+				return _fail("Sign operators are only translated for numbers and vectors.");
+			}
+			r_value.code = p_operator == Variant::OP_NEGATE ? "(-" + p_operand.code + ")" : p_operand.code;
+		} break;
+		case Variant::OP_BIT_NEGATE: {
+			if (p_operand.type != Variant::INT) {
+				return _fail("Bitwise operators are only translated for integers.");
+			}
+			r_value.code = "(~" + p_operand.code + ")";
+		} break;
+		case Variant::OP_NOT: {
+			if (p_operand.type != Variant::BOOL) {
+				return _fail("Logic operators are only translated for booleans.");
+			}
+			r_value.code = "(!" + p_operand.code + ")";
+		} break;
+		default:
+			return _fail(vformat(R"(Operator "%s" is not translated.)", Variant::get_operator_name(p_operator)));
+	}
+	r_value.type = p_operand.type;
+	return true;
+}
+
+bool GDScriptCppTranslator::_translate_call(const GDScriptParser::CallNode *p_call, Value &r_value) {
+	if (p_call->is_super || !p_call->callee) {
+		return _fail("Super calls are not translated.");
+	}
+
+	Vector<Value> arguments;
+	arguments.resize(p_call->arguments.size());
+	for (int i = 0; i < p_call->arguments.size(); i++) {
+		if (!_translate_expression(p_call->arguments[i], arguments.write[i])) {
+			return false;
+		}
+	}
+
+	const StringName &function_name = p_call->function_name;
+
+	if (p_call->callee->type == GDScriptParser::Node::SUBSCRIPT) {
+		const GDScriptParser::SubscriptNode *subscript = static_cast<const GDScriptParser::SubscriptNode *>(p_call->callee);
+		if (!subscript->is_attribute) {
+			return _fail("Calls through an index are not translated.");
+		}
+		Value base;
+		if (!_translate_expression(subscript->base, base)) {
+			return false;
+		}
+		if (base.type != Variant::VECTOR2 && base.type != Variant::VECTOR3) {
+			return _fail(vformat(R"(Method "%s" of %s is not translated.)", function_name, Variant::get_type_name(base.type)));
+		}
+
+		Variant::Type method_return = Variant::NIL;
+		int method_argument_count = -1;
+		if (function_name == "cross") {
+			// The 2D cross product is a scalar.
+			method_return = base.type == Variant::VECTOR2 ? Variant::FLOAT : Variant::VECTOR3;
+			method_argument_count = 1;
+		} else {
+			for (int i = 0; vector_methods[i].name; i++) {
+				if (function_name == vector_methods[i].name) {
+					method_return = vector_methods[i].return_type == Variant::NIL ? base.type : vector_methods[i].return_type;
+					method_argument_count = vector_methods[i].argument_count;
+					break;
+				}
+			}
+		}
+		if (method_argument_count < 0) {
+			return _fail(vformat(R"(Method "%s" of %s is not translated.)", function_name, Variant::get_type_name(base.type)));
+		}
+		if (arguments.size() != method_argument_count || (method_argument_count == 1 && arguments[0].type != base.type)) {
+			return _fail(vformat(R"(Arguments of method "%s" do not match.)", function_name));
+		}
+
+		String call = base.code + "." + String(function_name) + "(" + (method_argument_count == 1 ? arguments[0].code : String()) + ")";
+		r_value.code = method_return == Variant::FLOAT ? "double(" + call + ")" : call;
+		r_value.type = method_return;
+		return true;
+	}
+
+	if (p_call->callee->type != GDScriptParser::Node::IDENTIFIER) {
+		return _fail("Only direct calls are translated.");
+	}
+
+	// Same resolution order as `GDScriptCompiler`.
+	const Variant::Type constructed_type = GDScriptParser::get_builtin_type(function_name);
+	if (constructed_type < Variant::VARIANT_MAX) {
+		Vector<String> converted;
+		converted.resize(arguments.size());
+		for (int i = 0; i < arguments.size(); i++) {
+			if (!_is_numeric_type(arguments[i].type)) {
+				return _fail(vformat(R"(Constructor "%s" is only translated from numbers.)", function_name));
+			}
+			converted.write[i] = arguments[i].code;
+		}
+		switch (constructed_type) {
+			case Variant::INT:
+			case Variant::FLOAT: {
+				if (arguments.size() != 1) {
+					return _fail(vformat(R"(Constructor "%s" is only translated from one number.)", function_name));
+				}
+				r_value.code = _get_cpp_type(constructed_type) + "(" + converted[0] + ")";
+			} break;
+			case Variant::VECTOR2:
+			case Variant::VECTOR3: {
+				const int components = constructed_type == Variant::VECTOR2 ? 2 : 3;
+				if (arguments.size() != components && arguments.size() != 0) {
+					return _fail(vformat(R"(Constructor "%s" is only translated from components.)", function_name));
+				}
+				String components_code;
+				for (int i = 0; i < arguments.size(); i++) {
+					components_code += (i > 0 ? ", real_t(" : "real_t(") + converted[i] + ")";
+				}
+				r_value.code = _get_cpp_type(constructed_type) + "(" + components_code + ")";
+			} break;
+			default:
+				return _fail(vformat(R"(Constructor "%s" is not translated.)", function_name));
+		}
+		r_value.type = constructed_type;
+		return true;
+	}
+
+	if (Variant::has_utility_function(function_name)) {
+		for (int i = 0; utility_functions[i].name; i++) {
+			const UtilityFunctionInfo &info = utility_functions[i];
+			if (function_name != info.name) {
+				continue;
+			}
+			if (arguments.size() != info.argument_count) {
+				return _fail(vformat(R"(Arguments of function "%s" do not match.)", function_name));
+			}
+			String arguments_code;
+			for (int j = 0; j < arguments.size(); j++) {
+				String converted;
+				if (!_convert(arguments[j], info.argument_type, converted)) {
+					return false;
+				}
+				arguments_code += (j > 0 ? ", " : "") + converted;
+			}
+			r_value.code = "VariantUtilityFunctions::" + String(function_name) + "(" + arguments_code + ")";
+			r_value.type = info.return_type;
+			return true;
+		}
+		return _fail(vformat(R"(Utility function "%s" is not translated.)", function_name));
+	}
+
+	if (GDScriptUtilityFunctions::function_exists(function_name)) {
+		return _fail(vformat(R"(GDScript function "%s" is not translated.)", function_name));
+	}
+
+	const String *symbol = symbols.getptr(function_name);
+	if (!symbol) {
+		return _fail(vformat(R"(Function "%s" is not translated.)", function_name));
+	}
+	const GDScriptParser::FunctionNode *callee = candidates[function_name];
+	if (!callee->is_static) {
+		// Non-static calls dispatch on the instance, which may override them.
+		return _fail(vformat(R"(Function "%s" is not static.)", function_name));
+	}
+	if (ClassDB::has_method(current_class->base_type.native_type, function_name)) {
+		return _fail(vformat(R"(Function "%s" is resolved to a native method.)", function_name));
+	}
+	if (arguments.size() != callee->parameters.size()) {
+		return _fail(vformat(R"(Arguments of function "%s" do not match.)", function_name));
+	}
+	String arguments_code;
+	for (int i = 0; i < arguments.size(); i++) {
+		Variant::Type parameter_type = Variant::NIL;
+		_get_declared_type(callee->parameters[i]->get_datatype(), parameter_type);
+		String converted;
+		if (!_convert(arguments[i], parameter_type, converted)) {
+			return false;
+		}
+		arguments_code += (i > 0 ? ", " : "") + converted;
+	}
+	_get_declared_type(callee->get_datatype(), r_value.type);
+	r_value.code = *symbol + "(" + arguments_code + ")";
+	return true;
+}
+
+bool GDScriptCppTranslator::_translate_condition(const GDScriptParser::ExpressionNode *p_condition, String &r_code) {
+	Value condition;
+	if (!_translate_expression(p_condition, condition)) {
+		return false;
+	}
+	if (condition.type == Variant::BOOL) {
+		r_code = condition.code;
+	} else if (_is_numeric_type(condition.type)) {
+		r_code = "(" + condition.code + " != 0)";
+	} else {
+		return _fail(vformat("Conditions of type %s are not translated.", Variant::get_type_name(condition.type)));
+	}
+	return true;
+}
+
+bool GDScriptCppTranslator::_translate_for(const GDScriptParser::ForNode *p_for, StringBuilder &r_code, int p_indent) {
+	if (p_for->datatype_specifier) {
+		Variant::Type iterator_type = Variant::NIL;
+		if (!_get_declared_type(p_for->variable->get_datatype(), iterator_type) || iterator_type != Variant::INT) {
+			return _fail("Only loops with an integer iterator are translated.");
+		}
+	}
+
+	String from = "int64_t(0LL)";
+	String to;
+	int64_t step = 1;
+
+	const GDScriptParser::ExpressionNode *list = p_for->list;
+	const GDScriptParser::CallNode *range = nullptr;
+	if (list->type == GDScriptParser::Node::CALL && !list->is_constant) {
+		const GDScriptParser::CallNode *call = static_cast<const GDScriptParser::CallNode *>(list);
+		if (call->function_name == "range" && call->callee && call->callee->type == GDScriptParser::Node::IDENTIFIER && !call->is_super) {
+			range = call;
+		}
+	}
+
+	if (range) {
+		const int argument_count = range->arguments.size();
+		if (argument_count < 1 || argument_count > 3) {
+			return _fail("Invalid range() call.");
+		}
+		Vector<Value> arguments;
+		arguments.resize(argument_count);
+		for (int i = 0; i < argument_count; i++) {
+			if (!_translate_expression(range->arguments[i], arguments.write[i])) {
+				return false;
+			}
+			if (arguments[i].type != Variant::INT) {
+				return _fail("Only integer ranges are translated.");
+			}
+		}
+		if (argument_count == 1) {
+			to = arguments[0].code;
+		} else {
+			from = arguments[0].code;
+			to = arguments[1].code;
+		}
+		if (argument_count == 3) {
+			const GDScriptParser::ExpressionNode *step_node = range->arguments[2];
+			if (!step_node->is_constant || int64_t(step_node->reduced_value) == 0) {
+				return _fail("Only ranges with a constant non-zero step are translated.");
+			}
+			step = step_node->reduced_value;
+		}
+	} else {
+		Value count;
+		if (!_translate_expression(list, count)) {
+			return false;
+		}
+		if (count.type != Variant::INT) {
+			return _fail("Only loops over integer ranges are translated.");
+		}
+		to = count.code;
+	}
+
+	const String indent = _make_indent(p_indent);
+	const String iterator = _make_identifier("l_", p_for->variable->name, locals.size());
+	const String end = "t_" + itos(temp_count++);
+	r_code += indent + vformat("for (int64_t %s = %s, %s = %s; %s %s %s; %s += %s) {\n", iterator, from, end, to, iterator, step > 0 ? "<" : ">", end, iterator, itos(step) + "LL");
+
+	const HashMap<StringName, Local> outer_locals = locals;
+	Local local;
+	local.symbol = iterator;
+	local.type = Variant::INT;
+	// GDScript resets the iterator every iteration, so writes to it must not change the loop.
+	local.read_only = true;
+	locals.insert(p_for->variable->name, local);
+	const bool ok = _translate_suite(p_for->loop, r_code, p_indent + 1);
+	locals = outer_locals;
+	if (!ok) {
+		return false;
+	}
+	r_code += indent + "}\n";
+	return true;
+}
+
+bool GDScriptCppTranslator::_translate_assignment(const GDScriptParser::AssignmentNode *p_assignment, String &r_code) {
+	String target;
+	Variant::Type target_type = Variant::NIL;
+	bool is_component = false;
+
+	if (p_assignment->assignee->type == GDScriptParser::Node::IDENTIFIER) {
+		const StringName &name = static_cast<const GDScriptParser::IdentifierNode *>(p_assignment->assignee)->name;
+		const Local *local = locals.getptr(name);
+		if (!local) {
+			return _fail(vformat(R"(Assignment to "%s", which is not a typed local variable or parameter.)", name));
+		}
+		if (local->read_only) {
+			return _fail("Assignment to a loop iterator.");
+		}
+		target = local->symbol;
+		target_type = local->type;
+	} else if (p_assignment->assignee->type == GDScriptParser::Node::SUBSCRIPT) {
+		const GDScriptParser::SubscriptNode *subscript = static_cast<const GDScriptParser::SubscriptNode *>(p_assignment->assignee);
+		if (!subscript->is_attribute || subscript->base->type != GDScriptParser::Node::IDENTIFIER) {
+			return _fail("Only vector components of local variables are assigned.");
+		}
+		const Local *local = locals.getptr(static_cast<const GDScriptParser::IdentifierNode *>(subscript->base)->name);
+		const StringName &attribute = subscript->attribute->name;
+		if (!local || local->read_only || !((local->type == Variant::VECTOR2 && (attribute == "x" || attribute == "y")) || (local->type == Variant::VECTOR3 && (attribute == "x" || attribute == "y" || attribute == "z")))) {
+			return _fail("Only vector components of local variables are assigned.");
+		}
+		target = local->symbol + "." + String(attribute);
+		target_type = Variant::FLOAT;
+		is_component = true;
+	} else {
+		return _fail("Assignment target is not translated.");
+	}
+
+	Value value;
+	if (!_translate_expression(p_assignment->assigned_value, value)) {
+		return false;
+	}
+	if (p_assignment->operation != GDScriptParser::AssignmentNode::OP_NONE) {
+		Value current;
+		current.code = is_component ? "double(" + target + ")" : target;
+		current.type = target_type;
+		Value combined;
+		if (!_translate_binary(p_assignment->variant_op, current, value, p_assignment->assigned_value, combined)) {
+			return false;
+		}
+		value = combined;
+	}
+
+	String converted;
+	if (!_convert(value, target_type, converted)) {
+		return false;
+	}
+	r_code = target + " = " + (is_component ? "real_t(" + converted + ")" : converted) + ";";
+	return true;
+}
+
+bool GDScriptCppTranslator::_translate_suite(const GDScriptParser::SuiteNode *p_suite, StringBuilder &r_code, int p_indent) {
+	const HashMap<StringName, Local> outer_locals = locals;
+	for (const GDScriptParser::Node *statement : p_suite->statements) {
+		if (!_translate_statement(statement, r_code, p_indent)) {
+			return false;
+		}
+	}
+	locals = outer_locals;
+	return true;
+}
+
+bool GDScriptCppTranslator::_translate_statement(const GDScriptParser::Node *p_statement, StringBuilder &r_code, int p_indent) {
+	const String indent = _make_indent(p_indent);
+
+	switch (p_statement->type) {
+		case GDScriptParser::Node::VARIABLE: {
+			const GDScriptParser::VariableNode *variable = static_cast<const GDScriptParser::VariableNode *>(p_statement);
+			Variant::Type type = Variant::NIL;
+			if (!_get_declared_type(variable->get_datatype(), type) || type == Variant::NIL) {
+				return _fail(vformat(R"(Local variable "%s" has no supported static type.)", variable->identifier->name));
+			}
+			String initializer = _get_cpp_type(type) + "()";
+			if (variable->initializer) {
+				Value value;
+				if (!_translate_expression(variable->initializer, value) || !_convert(value, type, initializer)) {
+					return false;
+				}
+			}
+			Local local;
+			local.symbol = _make_identifier("l_", variable->identifier->name, locals.size());
+			local.type = type;
+			locals.insert(variable->identifier->name, local);
+			r_code += indent + _get_cpp_type(type) + " " + local.symbol + " = " + initializer + ";\n";
+		} break;
+		case GDScriptParser::Node::CONSTANT: {
+			// Uses of local constants are folded by the analyzer.
+		} break;
+		case GDScriptParser::Node::ASSIGNMENT: {
+			String assignment;
+			if (!_translate_assignment(static_cast<const GDScriptParser::AssignmentNode *>(p_statement), assignment)) {
+				return false;
+			}
+			r_code += indent + assignment + "\n";
+		} break;
+		case GDScriptParser::Node::CALL: {
+			Value call;
+			if (!_translate_expression(static_cast<const GDScriptParser::CallNode *>(p_statement), call)) {
+				return false;
+			}
+			r_code += indent + (call.type == Variant::NIL ? call.code : "(void)" + call.code) + ";\n";
+		} break;
+		case GDScriptParser::Node::IF: {
+			const GDScriptParser::IfNode *if_node = static_cast<const GDScriptParser::IfNode *>(p_statement);
+			String condition;
+			if (!_translate_condition(if_node->condition, condition)) {
+				return false;
+			}
+			r_code += indent + "if (" + condition + ") {\n";
+			if (!_translate_suite(if_node->true_block, r_code, p_indent + 1)) {
+				return false;
+			}
+			if (if_node->false_block) {
+				r_code += indent + "} else {\n";
+				if (!_translate_suite(if_node->false_block, r_code, p_indent + 1)) {
+					return false;
+				}
+			}
+			r_code += indent + "}\n";
+		} break;
+		case GDScriptParser::Node::WHILE: {
+			const GDScriptParser::WhileNode *while_node = static_cast<const GDScriptParser::WhileNode *>(p_statement);
+			String condition;
+			if (!_translate_condition(while_node->condition, condition)) {
+				return false;
+			}
+			r_code += indent + "while (" + condition + ") {\n";
+			if (!_translate_suite(while_node->loop, r_code, p_indent + 1)) {
+				return false;
+			}
+			r_code += indent + "}\n";
+		} break;
+		case GDScriptParser::Node::FOR: {
+			return _translate_for(static_cast<const GDScriptParser::ForNode *>(p_statement), r_code, p_indent);
+		}
+		case GDScriptParser::Node::RETURN: {
+			const GDScriptParser::ReturnNode *return_node = static_cast<const GDScriptParser::ReturnNode *>(p_statement);
+			if (!return_node->return_value) {
+				r_code += indent + "return;\n";
+				break;
+			}
+			Value value;
+			String converted;
+			if (!_translate_expression(return_node->return_value, value) || !_convert(value, return_type, converted)) {
+				return false;
+			}
+			r_code += indent + "return " + converted + ";\n";
+		} break;
+		case GDScriptParser::Node::BREAK: {
+			r_code += indent + "break;\n";
+		} break;
+		case GDScriptParser::Node::CONTINUE: {
+			r_code += indent + "continue;\n";
+		} break;
+		case GDScriptParser::Node::PASS: {
+		} break;
+		default:
+			return _fail("Statement kind is not translated.");
+	}
+	return true;
+}
+
+bool GDScriptCppTranslator::_check_signature(const GDScriptParser::FunctionNode *p_function) {
+	if (p_function->is_coroutine) {
+		return _fail("Coroutines are not translated.");
+	}
+	Variant::Type type = Variant::NIL;
+	if (!p_function->return_type || !_get_declared_type(p_function->get_datatype(), type)) {
+		return _fail("Return type is not a supported static type.");
+	}
+	for (const GDScriptParser::ParameterNode *parameter : p_function->parameters) {
+		if (parameter->initializer) {
+			return _fail("Functions with default arguments are not translated.");
+		}
+		if (!_get_declared_type(parameter->get_datatype(), type) || type == Variant::NIL) {
+			return _fail(vformat(R"(Parameter "%s" has no supported static type.)", parameter->identifier->name));
+		}
+	}
+	return true;
+}
+
+String GDScriptCppTranslator::_get_declaration(const GDScriptParser::FunctionNode *p_function, const String &p_symbol) const {
+	Variant::Type type = Variant::NIL;
+	_get_declared_type(p_function->get_datatype(), type);
+	String declaration = "static " + _get_cpp_type(type) + " " + p_symbol + "(";
+	for (int i = 0; i < p_function->parameters.size(); i++) {
+		_get_declared_type(p_function->parameters[i]->get_datatype(), type);
+		declaration += (i > 0 ? ", " : "") + _get_cpp_type(type) + " " + _make_identifier("p_", p_function->parameters[i]->identifier->name, i);
+	}
+	return declaration + ")";
+}
+
+bool GDScriptCppTranslator::_translate_function(const GDScriptParser::FunctionNode *p_function, const String &p_symbol, String &r_code) {
+	error = String();
+	locals.clear();
+	temp_count = 0;
+	_get_declared_type(p_function->get_datatype(), return_type);
+
+	String call_arguments;
+	for (int i = 0; i < p_function->parameters.size(); i++) {
+		Local local;
+		local.symbol = _make_identifier("p_", p_function->parameters[i]->identifier->name, i);
+		_get_declared_type(p_function->parameters[i]->get_datatype(), local.type);
+		locals.insert(p_function->parameters[i]->identifier->name, local);
+		call_arguments += vformat("%sp_args[%d]->operator %s()", i > 0 ? ", " : "", i, _get_cpp_type(local.type));
+	}
+
+	StringBuilder body;
+	if (!_translate_suite(p_function->body, body, 1)) {
+		return false;
+	}
+
+	r_code = "// " + String(p_function->identifier->name) + "\n";
+	r_code += _get_declaration(p_function, p_symbol) + " {\n" + body.as_string() + "}\n\n";
+	r_code += "static void " + p_symbol + "_call(const Variant **p_args, Variant *r_ret) {\n";
+	if (return_type == Variant::NIL) {
+		r_code += "\t" + p_symbol + "(" + call_arguments + ");\n";
+	} else {
+		r_code += "\t*r_ret = " + p_symbol + "(" + call_arguments + ");\n";
+	}
+	r_code += "}\n\n";
+	return true;
+}
+
+Vector<GDScriptCppTranslator::FunctionResult> GDScriptCppTranslator::translate(const String &p_path, uint32_t p_source_hash, const GDScriptParser &p_parser) {
+	Vector<FunctionResult> results;
+	current_class = p_parser.get_tree();
+	ERR_FAIL_NULL_V(current_class, results);
+
+	candidates.clear();
+	symbols.clear();
+
+	Vector<const GDScriptParser::FunctionNode *> functions;
+	HashMap<StringName, String> reasons;
+	for (const GDScriptParser::ClassNode::Member &member : current_class->members) {
+		if (member.type != GDScriptParser::ClassNode::Member::FUNCTION) {
+			continue;
+		}
+		const GDScriptParser::FunctionNode *function = member.function;
+		error = String();
+		if (_check_signature(function)) {
+			candidates.insert(function->identifier->name, function);
+			symbols.insert(function->identifier->name, vformat("gdaot_%d_%d", script_count, functions.size()));
+		} else {
+			reasons.insert(function->identifier->name, error);
+		}
+		functions.push_back(function);
+	}
+
+	// Functions calling ones that failed must be translated again, until nothing fails anymore.
+	HashMap<StringName, String> bodies;
+	bool changed = true;
+	while (changed) {
+		changed = false;
+		bodies.clear();
+		for (const GDScriptParser::FunctionNode *function : functions) {
+			const StringName &name = function->identifier->name;
+			if (!candidates.has(name)) {
+				continue;
+			}
+			String code;
+			if (_translate_function(function, symbols[name], code)) {
+				bodies.insert(name, code);
+			} else {
+				reasons.insert(name, error);
+				candidates.erase(name);
+				symbols.erase(name);
+				changed = true;
+			}
+		}
+	}
+
+	if (!bodies.is_empty()) {
+		functions_code += "// " + p_path + "\n\n";
+		for (const GDScriptParser::FunctionNode *function : functions) {
+			if (bodies.has(function->identifier->name)) {
+				functions_code += _get_declaration(function, symbols[function->identifier->name]) + ";\n";
+			}
+		}
+		functions_code += "\n";
+	}
+
+	for (const GDScriptParser::FunctionNode *function : functions) {
+		const StringName &name = function->identifier->name;
+		FunctionResult result;
+		result.name = name;
+		result.translated = bodies.has(name);
+		if (result.translated) {
+			functions_code += bodies[name];
+			Registration registration;
+			registration.path = p_path;
+			registration.source_hash = p_source_hash;
+			registration.function = name;
+			registration.symbol = symbols[name];
+			registrations.push_back(registration);
+		} else {
+			result.reason = reasons[name];
+		}
+		results.push_back(result);
+	}
+
+	script_count++;
+	current_class = nullptr;
+	return results;
+}
+
+String GDScriptCppTranslator::get_module_source(const String &p_module_name) const {
+	StringBuilder source;
+	source += "/* THIS FILE IS GENERATED DO NOT EDIT */\n\n";
+	source += "#include \"register_types.h\"\n\n";
+	source += "#include \"modules/gdscript/gdscript_aot.h\"\n\n";
+	source += "#include \"core/math/math_funcs.h\"\n";
+	source += "#include \"core/math/vector2.h\"\n";
+	source += "#include \"core/math/vector3.h\"\n";
+	source += "#include \"core/variant/variant_utility.h\"\n\n";
+	source += functions_code.as_string();
+
+	source += vformat("void initialize_%s_module(ModuleInitializationLevel p_level) {\n", p_module_name);
+	source += "\tif (p_level != MODULE_INITIALIZATION_LEVEL_SCENE) {\n\t\treturn;\n\t}\n";
+	for (const Registration &registration : registrations) {
+		source += vformat("\tGDScriptAOT::register_function(String::utf8(\"%s\"), 0x%sU, String::utf8(\"%s\"), &%s_call);\n",
+				registration.path.c_escape(), String::num_uint64(registration.source_hash, 16), String(registration.function).c_escape(), registration.symbol);
+	}
+	source += "}\n\n";
+
+	source += vformat("void uninitialize_%s_module(ModuleInitializationLevel p_level) {\n", p_module_name);
+	source += "\tif (p_level != MODULE_INITIALIZATION_LEVEL_SCENE) {\n\t\treturn;\n\t}\n";
+	source += "\tGDScriptAOT::clear();\n";
+	source += "}\n";
+	return source.as_string();
+}
+
+Error GDScriptCppTranslator::write_module(const String &p_dir) const {
+	const String module_name = p_dir.simplify_path().get_file();
+	ERR_FAIL_COND_V_MSG(!module_name.is_valid_ascii_identifier(), ERR_INVALID_PARAMETER, vformat(R"(The module directory name "%s" must be a valid identifier.)", module_name));
+
+	Error err = DirAccess::make_dir_recursive_absolute(p_dir);
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat(R"(Cannot create "%s".)", p_dir));
+
+	const String config = R"(def can_build(env, platform):
+    env.module_add_dependencies("{name}", ["gdscript"])
+    return True
+
+
+def configure(env):
+    pass
+)";
+
+	const String scsub = R"(#!/usr/bin/env python
+
+Import("env")
+Import("env_modules")
+
+env_{name} = env_modules.Clone()
+env_{name}.add_source_files(env.modules_sources, "*.cpp")
+)";
+
+	const String header = R"(/* THIS FILE IS GENERATED DO NOT EDIT */
+
+#ifndef {NAME}_REGISTER_TYPES_H
+#define {NAME}_REGISTER_TYPES_H
+
+#include "modules/register_module_types.h"
+
+void initialize_{name}_module(ModuleInitializationLevel p_level);
+void uninitialize_{name}_module(ModuleInitializationLevel p_level);
+
+#endif // {NAME}_REGISTER_TYPES_H
+)";
+
+	err = write_text_file(p_dir.path_join("config.py"), config.replace("{name}", module_name));
+	if (err == OK) {
+		err = write_text_file(p_dir.path_join("SCsub"), scsub.replace("{name}", module_name));
+	}
+	if (err == OK) {
+		err = write_text_file(p_dir.path_join("register_types.h"), header.replace("{name}", module_name).replace("{NAME}", module_name.to_upper()));
+	}
+	if (err == OK) {
+		err = write_text_file(p_dir.path_join("register_types.cpp"), get_module_source(module_name));
+	}
+	return err;
+}
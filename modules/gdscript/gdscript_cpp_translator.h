@@ -0,0 +1,120 @@
+/**************************************************************************/
+/*  gdscript_cpp_translator.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_CPP_TRANSLATOR_H
+#define GDSCRIPT_CPP_TRANSLATOR_H
+
+#include "gdscript_parser.h"
+
+#include "core/string/string_builder.h"
+#include "core/templates/hash_map.h"
+
+// Lowers analyzed GDScript functions to C++ for ahead-of-time compilation.
+// Only functions whose signature and whole body stay within bool, int, float,
+// Vector2 and Vector3 values are translated; anything dynamic is left to the
+// bytecode, with the reason reported back.
+class GDScriptCppTranslator {
+public:
+	struct FunctionResult {
+		StringName name;
+		bool translated = false;
+		String reason; // Why the function stays bytecode.
+	};
+
+private:
+	struct Registration {
+		String path;
+		uint32_t source_hash = 0;
+		StringName function;
+		String symbol;
+	};
+
+	struct Local {
+		String symbol;
+		Variant::Type type = Variant::NIL;
+		bool read_only = false;
+	};
+
+	struct Value {
+		String code;
+		Variant::Type type = Variant::NIL; // NIL for calls to void functions.
+	};
+
+	StringBuilder functions_code;
+	Vector<Registration> registrations;
+	int script_count = 0;
+
+	// State of the script and function being translated.
+	const GDScriptParser::ClassNode *current_class = nullptr;
+	HashMap<StringName, const GDScriptParser::FunctionNode *> candidates;
+	HashMap<StringName, String> symbols;
+	HashMap<StringName, Local> locals;
+	Variant::Type return_type = Variant::NIL;
+	int temp_count = 0;
+	String error;
+
+	static bool _is_supported_type(Variant::Type p_type);
+	static bool _is_numeric_type(Variant::Type p_type);
+	static String _get_cpp_type(Variant::Type p_type);
+	static bool _get_declared_type(const GDScriptParser::DataType &p_datatype, Variant::Type &r_type);
+	static String _make_identifier(const String &p_prefix, const StringName &p_name, int p_index);
+	static String _make_indent(int p_indent);
+	static String _make_float_literal(double p_value);
+
+	bool _fail(const String &p_reason);
+	bool _make_literal(const Variant &p_value, Value &r_value);
+	bool _convert(const Value &p_value, Variant::Type p_type, String &r_code);
+	bool _translate_expression(const GDScriptParser::ExpressionNode *p_expression, Value &r_value);
+	bool _translate_binary(Variant::Operator p_operator, const Value &p_left, const Value &p_right, const GDScriptParser::ExpressionNode *p_right_node, Value &r_value);
+	bool _translate_unary(Variant::Operator p_operator, const Value &p_operand, Value &r_value);
+	bool _translate_call(const GDScriptParser::CallNode *p_call, Value &r_value);
+	bool _translate_condition(const GDScriptParser::ExpressionNode *p_condition, String &r_code);
+	bool _translate_for(const GDScriptParser::ForNode *p_for, StringBuilder &r_code, int p_indent);
+	bool _translate_assignment(const GDScriptParser::AssignmentNode *p_assignment, String &r_code);
+	bool _translate_suite(const GDScriptParser::SuiteNode *p_suite, StringBuilder &r_code, int p_indent);
+	bool _translate_statement(const GDScriptParser::Node *p_statement, StringBuilder &r_code, int p_indent);
+	bool _check_signature(const GDScriptParser::FunctionNode *p_function);
+	bool _translate_function(const GDScriptParser::FunctionNode *p_function, const String &p_symbol, String &r_code);
+	String _get_declaration(const GDScriptParser::FunctionNode *p_function, const String &p_symbol) const;
+
+public:
+	// Translates the top-level functions of an analyzed script. `p_source_hash` must be
+	// `GDScriptAOT::hash_source()` of what the exported game loads for `p_path`.
+	Vector<FunctionResult> translate(const String &p_path, uint32_t p_source_hash, const GDScriptParser &p_parser);
+
+	int get_translated_count() const { return registrations.size(); }
+
+	// Source of an engine module registering every translated function.
+	String get_module_source(const String &p_module_name) const;
+	// Writes the module to `p_dir`, to be built with `custom_modules=<parent of p_dir>`.
+	Error write_module(const String &p_dir) const;
+};
+
+#endif // GDSCRIPT_CPP_TRANSLATOR_H
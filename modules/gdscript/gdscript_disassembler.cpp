@@ -141,6 +141,47 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+			case OPCODE_OPERATOR_ADD_INT:
+			case OPCODE_OPERATOR_SUBTRACT_INT:
+			case OPCODE_OPERATOR_MULTIPLY_INT:
+			case OPCODE_OPERATOR_EQUAL_INT:
+			case OPCODE_OPERATOR_NOT_EQUAL_INT:
+			case OPCODE_OPERATOR_LESS_INT:
+			case OPCODE_OPERATOR_LESS_EQUAL_INT:
+			case OPCODE_OPERATOR_GREATER_INT:
+			case OPCODE_OPERATOR_GREATER_EQUAL_INT:
+			case OPCODE_OPERATOR_ADD_FLOAT:
+			case OPCODE_OPERATOR_SUBTRACT_FLOAT:
+			case OPCODE_OPERATOR_MULTIPLY_FLOAT:
+			case OPCODE_OPERATOR_DIVIDE_FLOAT:
+			case OPCODE_OPERATOR_EQUAL_FLOAT:
+			case OPCODE_OPERATOR_NOT_EQUAL_FLOAT:
+			case OPCODE_OPERATOR_LESS_FLOAT:
+			case OPCODE_OPERATOR_LESS_EQUAL_FLOAT:
+			case OPCODE_OPERATOR_GREATER_FLOAT:
+			case OPCODE_OPERATOR_GREATER_EQUAL_FLOAT:
+			case OPCODE_OPERATOR_ADD_VECTOR2:
+			case OPCODE_OPERATOR_SUBTRACT_VECTOR2:
+			case OPCODE_OPERATOR_MULTIPLY_VECTOR2:
+			case OPCODE_OPERATOR_MULTIPLY_VECTOR2_FLOAT:
+			case OPCODE_OPERATOR_DIVIDE_VECTOR2_FLOAT:
+			case OPCODE_OPERATOR_ADD_VECTOR3:
+			case OPCODE_OPERATOR_SUBTRACT_VECTOR3:
+			case OPCODE_OPERATOR_MULTIPLY_VECTOR3:
+			case OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT:
+			case OPCODE_OPERATOR_DIVIDE_VECTOR3_FLOAT: {
+				text += "typed operator ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 4]];
+				text += " ";
+				text += DADDR(2);
+
+				incr += 5;
+			} break;
 			case OPCODE_TYPE_TEST_BUILTIN: {
 				text += "type test ";
 				text += DADDR(1);
@@ -267,6 +308,19 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+			case OPCODE_SET_TYPED_ARRAY_INDEXED: {
+				text += "set typed array indexed ";
+				text += DADDR(1);
+				text += "[";
+				text += DADDR(2);
+				text += "] = ";
+				text += DADDR(3);
+				text += " (";
+				text += Variant::get_type_name(Variant::Type(_code_ptr[ip + 4]));
+				text += ")";
+
+				incr += 5;
+			} break;
 			case OPCODE_GET_KEYED: {
 				text += "get keyed ";
 				text += DADDR(3);
@@ -308,7 +362,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += "\"] = ";
 				text += DADDR(2);
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_SET_NAMED_VALIDATED: {
 				text += "set_named validated ";
@@ -329,7 +383,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += _global_names_ptr[_code_ptr[ip + 3]];
 				text += "\"]";
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_GET_NAMED_VALIDATED: {
 				text += "get_named validated ";
@@ -708,7 +762,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				}
 				text += ")";
 
-				incr = 5 + argc;
+				incr = 6 + argc;
 			} break;
 			case OPCODE_CALL_METHOD_BIND:
 			case OPCODE_CALL_METHOD_BIND_RET: {
@@ -1272,6 +1326,37 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				DISASSEMBLE_TYPE_ADJUST(PACKED_COLOR_ARRAY);
 				DISASSEMBLE_TYPE_ADJUST(PACKED_VECTOR4_ARRAY);
 
+			// Superinstructions only replace the opcode of their first part, which is shown
+			// here. The second part is intact and shown as the next instruction.
+			case OPCODE_OPERATOR_VALIDATED_ASSIGN:
+			case OPCODE_OPERATOR_VALIDATED_JUMP_IF:
+			case OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT:
+			case OPCODE_OPERATOR_VALIDATED_SET_INDEXED_VALIDATED: {
+				text += "validated operator ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 4]];
+				text += " ";
+				text += DADDR(2);
+				text += " (fused with next)";
+
+				incr += 5;
+			} break;
+			case OPCODE_GET_INDEXED_VALIDATED_OPERATOR_VALIDATED: {
+				text += "get indexed validated ";
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += "[";
+				text += DADDR(2);
+				text += "] (fused with next)";
+
+				incr += 5;
+			} break;
+
 			case OPCODE_ASSERT: {
 				text += "assert (";
 				text += DADDR(1);
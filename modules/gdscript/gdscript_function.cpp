@@ -32,6 +32,21 @@
 
 #include "gdscript.h"
 
+#include "scene/main/scene_tree.h"
+
+uint32_t GDScriptFunction::_get_sampler_symbol() {
+	uint32_t symbol = sampler_symbol.load(std::memory_order_relaxed);
+	if (likely(symbol != 0)) {
+		return symbol;
+	}
+	symbol = GDScriptSampler::add_symbol(name, source, _initial_line);
+	uint32_t expected = 0;
+	if (!sampler_symbol.compare_exchange_strong(expected, symbol, std::memory_order_relaxed)) {
+		return expected; // Another thread registered it first.
+	}
+	return symbol;
+}
+
 Variant GDScriptFunction::get_constant(int p_idx) const {
 	ERR_FAIL_INDEX_V(p_idx, constants.size(), "<errconst>");
 	return constants[p_idx];
@@ -121,6 +136,10 @@ GDScriptFunction::~GDScriptFunction() {
 		memdelete(lambdas[i]);
 	}
 
+	if (_inline_caches_ptr) {
+		memdelete_arr(_inline_caches_ptr);
+	}
+
 	for (int i = 0; i < argument_types.size(); i++) {
 		argument_types.write[i].script_type_ref = Ref<Script>();
 	}
@@ -134,24 +153,45 @@ GDScriptFunction::~GDScriptFunction() {
 
 /////////////////////
 
+// Resumes a suspended function from the awaited signal. Holds the state while connected.
+class GDScriptAwaitCallable : public CallableCustom {
+	Ref<GDScriptFunctionState> state;
+
+	static bool compare_equal(const CallableCustom *p_a, const CallableCustom *p_b) {
+		return static_cast<const GDScriptAwaitCallable *>(p_a)->state == static_cast<const GDScriptAwaitCallable *>(p_b)->state;
+	}
+
+	static bool compare_less(const CallableCustom *p_a, const CallableCustom *p_b) {
+		return static_cast<const GDScriptAwaitCallable *>(p_a)->state.ptr() < static_cast<const GDScriptAwaitCallable *>(p_b)->state.ptr();
+	}
+
+public:
+	uint32_t hash() const override { return hash_one_uint64(uint64_t(state->get_instance_id())); }
+	String get_as_text() const override { return "GDScriptFunctionState::resume (await)"; }
+	CompareEqualFunc get_compare_equal_func() const override { return compare_equal; }
+	CompareLessFunc get_compare_less_func() const override { return compare_less; }
+	ObjectID get_object() const override { return state->get_instance_id(); }
+
+	void call(const Variant **p_arguments, int p_argcount, Variant &r_return_value, Callable::CallError &r_call_error) const override {
+		r_call_error.error = Callable::CallError::CALL_OK;
+		r_return_value = state->resume_from_signal(p_arguments, p_argcount);
+	}
+
+	GDScriptAwaitCallable(const Ref<GDScriptFunctionState> &p_state) :
+			state(p_state) {}
+};
+
+SafeNumeric<uint64_t> GDScriptFunctionState::suspended_count;
+Mutex GDScriptFunctionState::frame_awaits_mutex;
+HashMap<ObjectID, GDScriptFunctionState::FrameAwaits> GDScriptFunctionState::frame_awaits;
+
 Variant GDScriptFunctionState::_signal_callback(const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
-	Variant arg;
 	r_error.error = Callable::CallError::CALL_OK;
 
 	if (p_argcount == 0) {
 		r_error.error = Callable::CallError::CALL_ERROR_TOO_FEW_ARGUMENTS;
 		r_error.expected = 1;
 		return Variant();
-	} else if (p_argcount == 1) {
-		//noooneee
-	} else if (p_argcount == 2) {
-		arg = *p_args[0];
-	} else {
-		Array extra_args;
-		for (int i = 0; i < p_argcount - 1; i++) {
-			extra_args.push_back(*p_args[i]);
-		}
-		arg = extra_args;
 	}
 
 	Ref<GDScriptFunctionState> self = *p_args[p_argcount - 1];
@@ -163,9 +203,105 @@ Variant GDScriptFunctionState::_signal_callback(const Variant **p_args, int p_ar
 		return Variant();
 	}
 
+	return resume_from_signal(p_args, p_argcount - 1);
+}
+
+Variant GDScriptFunctionState::resume_from_signal(const Variant **p_args, int p_argcount) {
+	Variant arg;
+	if (p_argcount == 1) {
+		arg = *p_args[0];
+	} else if (p_argcount > 1) {
+		Array extra_args;
+		for (int i = 0; i < p_argcount; i++) {
+			extra_args.push_back(*p_args[i]);
+		}
+		arg = extra_args;
+	}
 	return resume(arg);
 }
 
+Error GDScriptFunctionState::await_signal(const Ref<GDScriptFunctionState> &p_state, const Signal &p_signal) {
+	p_state->suspended = true;
+	suspended_count.increment();
+
+	Object *object = p_signal.get_object();
+	ERR_FAIL_NULL_V(object, ERR_INVALID_PARAMETER);
+
+	if (object->is_class_ptr(SceneTree::get_class_ptr_static())) {
+		int index = -1;
+		if (p_signal.get_name() == SNAME("process_frame")) {
+			index = 0;
+		} else if (p_signal.get_name() == SNAME("physics_frame")) {
+			index = 1;
+		}
+
+		if (index >= 0) {
+			const ObjectID tree = object->get_instance_id();
+			MutexLock lock(frame_awaits_mutex);
+			FrameAwaits *awaits = frame_awaits.getptr(tree);
+			if (!awaits) {
+				// Drop the states left by freed trees, they can't be resumed anymore.
+				LocalVector<ObjectID> freed;
+				for (const KeyValue<ObjectID, FrameAwaits> &E : frame_awaits) {
+					if (!ObjectDB::get_instance(E.key)) {
+						freed.push_back(E.key);
+					}
+				}
+				for (const ObjectID &id : freed) {
+					frame_awaits.erase(id);
+				}
+				awaits = &frame_awaits.insert(tree, FrameAwaits())->value;
+			}
+			if (!awaits->connected[index]) {
+				// Still connected if the awaits were cleared while the tree was alive.
+				Callable resume = callable_mp_static(&GDScriptFunctionState::_resume_frame_awaits).bind(uint64_t(tree), index);
+				if (!object->is_connected(p_signal.get_name(), resume)) {
+					Error err = object->connect(p_signal.get_name(), resume);
+					if (err != OK) {
+						return err;
+					}
+				}
+				awaits->connected[index] = true;
+			}
+			awaits->states[index].push_back(p_state);
+			return OK;
+		}
+	}
+
+	return object->connect(p_signal.get_name(), Callable(memnew(GDScriptAwaitCallable(p_state))), Object::CONNECT_ONE_SHOT);
+}
+
+void GDScriptFunctionState::_resume_frame_awaits(uint64_t p_tree, int p_index) {
+	LocalVector<Ref<GDScriptFunctionState>> states;
+	{
+		MutexLock lock(frame_awaits_mutex);
+		FrameAwaits *awaits = frame_awaits.getptr(ObjectID(p_tree));
+		if (!awaits) {
+			return;
+		}
+		states = std::move(awaits->states[p_index]);
+	}
+
+	// Those awaiting again are queued for the next emission.
+	for (const Ref<GDScriptFunctionState> &state : states) {
+		// Skip states whose script or instance is gone, as disconnecting would.
+		if (state->is_valid(true)) {
+			state->resume();
+		}
+	}
+}
+
+void GDScriptFunctionState::clear_frame_awaits() {
+	LocalVector<LocalVector<Ref<GDScriptFunctionState>>> states;
+	MutexLock lock(frame_awaits_mutex);
+	for (KeyValue<ObjectID, FrameAwaits> &E : frame_awaits) {
+		for (LocalVector<Ref<GDScriptFunctionState>> &tree_states : E.value.states) {
+			states.push_back(std::move(tree_states));
+		}
+	}
+	frame_awaits.clear();
+}
+
 bool GDScriptFunctionState::is_valid(bool p_extended_check) const {
 	if (function == nullptr) {
 		return false;
@@ -210,6 +346,10 @@ Variant GDScriptFunctionState::resume(const Variant &p_arg) {
 		scripts_list.remove_from_list();
 		instances_list.remove_from_list();
 	}
+	if (suspended) {
+		suspended = false;
+		suspended_count.decrement();
+	}
 
 	state.result = p_arg;
 	Callable::CallError err;
@@ -251,7 +391,7 @@ Variant GDScriptFunctionState::resume(const Variant &p_arg) {
 
 void GDScriptFunctionState::_clear_stack() {
 	if (state.stack_size) {
-		Variant *stack = (Variant *)state.stack.ptr();
+		Variant *stack = (Variant *)state.stack;
 		// The first 3 are special addresses and not copied to the state, so we skip them here.
 		for (int i = 3; i < state.stack_size; i++) {
 			stack[i].~Variant();
@@ -288,4 +428,86 @@ GDScriptFunctionState::~GDScriptFunctionState() {
 		scripts_list.remove_from_list();
 		instances_list.remove_from_list();
 	}
+
+	if (suspended) {
+		suspended_count.decrement();
+	}
+	GDScriptFramePool::free(state.stack, state.alloca_size);
+}
+
+/////////////////////
+
+GDScriptFramePool::SizeClass GDScriptFramePool::size_classes[SIZE_CLASS_COUNT];
+SafeNumeric<uint64_t> GDScriptFramePool::used_count;
+
+uint8_t *GDScriptFramePool::alloc(uint32_t p_size) {
+	used_count.increment();
+
+	uint32_t size_class = _get_size_class(p_size);
+	if (size_class == SIZE_CLASS_COUNT) {
+		return (uint8_t *)memalloc(p_size);
+	}
+
+	SizeClass &sc = size_classes[size_class];
+	sc.lock.lock();
+	FreeFrame *frame = sc.free_frames;
+	if (frame) {
+		sc.free_frames = frame->next;
+		sc.free_count--;
+	}
+	sc.lock.unlock();
+
+	if (frame) {
+		return (uint8_t *)frame;
+	}
+	return (uint8_t *)memalloc(1u << (MIN_SIZE_SHIFT + size_class));
+}
+
+void GDScriptFramePool::free(uint8_t *p_frame, uint32_t p_size) {
+	if (p_frame == nullptr) {
+		return;
+	}
+	used_count.decrement();
+
+	uint32_t size_class = _get_size_class(p_size);
+	if (size_class < SIZE_CLASS_COUNT) {
+		SizeClass &sc = size_classes[size_class];
+		sc.lock.lock();
+		if (sc.free_count < (MAX_POOLED_BYTES >> (MIN_SIZE_SHIFT + size_class))) {
+			FreeFrame *frame = (FreeFrame *)p_frame;
+			frame->next = sc.free_frames;
+			sc.free_frames = frame;
+			sc.free_count++;
+			sc.lock.unlock();
+			return;
+		}
+		sc.lock.unlock();
+	}
+	memfree(p_frame);
+}
+
+void GDScriptFramePool::clear() {
+	for (SizeClass &sc : size_classes) {
+		sc.lock.lock();
+		FreeFrame *frame = sc.free_frames;
+		sc.free_frames = nullptr;
+		sc.free_count = 0;
+		sc.lock.unlock();
+
+		while (frame) {
+			FreeFrame *next = frame->next;
+			memfree(frame);
+			frame = next;
+		}
+	}
+}
+
+uint64_t GDScriptFramePool::get_pooled_count() {
+	uint64_t count = 0;
+	for (SizeClass &sc : size_classes) {
+		sc.lock.lock();
+		count += sc.free_count;
+		sc.lock.unlock();
+	}
+	return count;
 }
@@ -31,18 +31,24 @@
 #ifndef GDSCRIPT_FUNCTION_H
 #define GDSCRIPT_FUNCTION_H
 
+#include "gdscript_aot.h"
+#include "gdscript_sampler.h"
 #include "gdscript_utility_functions.h"
 
 #include "core/object/ref_counted.h"
 #include "core/object/script_language.h"
+#include "core/os/spin_lock.h"
 #include "core/os/thread.h"
 #include "core/string/string_name.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/pair.h"
 #include "core/templates/self_list.h"
 #include "core/variant/variant.h"
 
 class GDScriptInstance;
 class GDScript;
+class GDScriptFunction;
 
 class GDScriptDataType {
 public:
@@ -252,11 +258,107 @@ public:
 	~GDScriptDataType() {}
 };
 
+// Cache of one OPCODE_CALL, OPCODE_GET_NAMED or OPCODE_SET_NAMED instruction, which
+// only knows the name it accesses. Remembers what the name resolved to for the last
+// few (native class, script) pairs seen on that instruction, so repeated accesses skip
+// the lookups through the script maps and ClassDB. Lookup and insertion are lock-free,
+// entries are immutable once published. See gdscript_vm.cpp.
+class GDScriptInlineCache {
+public:
+	enum Access {
+		ACCESS_CALL,
+		ACCESS_GET,
+		ACCESS_SET,
+	};
+
+	enum Kind {
+		NATIVE_METHOD, // Method bound in ClassDB, not defined by the script.
+		SCRIPT_FUNCTION, // Function of the script or one of its bases.
+		SCRIPT_MEMBER, // Member variable without setter or getter.
+		NATIVE_PROPERTY, // Property accessed through a bound setter or getter.
+	};
+
+	struct Entry {
+		StringName native_class;
+		const GDScript *script = nullptr; // nullptr for objects without script.
+		uint64_t revision = 0;
+		Kind kind = NATIVE_METHOD;
+		MethodBind *method = nullptr; // NATIVE_METHOD and NATIVE_PROPERTY.
+		GDScriptFunction *function = nullptr; // SCRIPT_FUNCTION.
+		const GDScriptDataType *member_type = nullptr; // SCRIPT_MEMBER.
+		int index = -1; // Member index for SCRIPT_MEMBER, property index for NATIVE_PROPERTY.
+		Entry *next_allocated = nullptr;
+	};
+
+	static constexpr int MAX_ENTRIES = 4;
+	// Lookups attempted before giving up on a megamorphic or uncacheable site.
+	static constexpr uint32_t MAX_RESOLVES = 16;
+
+private:
+	static std::atomic<uint32_t> script_revision;
+
+	std::atomic<const Entry *> entries[MAX_ENTRIES] = {};
+	std::atomic<Entry *> allocated = { nullptr }; // Kept until the site is freed, readers may still hold them.
+	std::atomic<uint32_t> resolves = { 0 };
+	std::atomic<uint64_t> resolves_revision = { 0 }; // Revision the resolves are counted for.
+
+public:
+	// Call whenever script functions or members may have changed, or a script is freed.
+	static void invalidate_scripts() { script_revision.fetch_add(1, std::memory_order_acq_rel); }
+	static uint64_t get_revision();
+
+	_FORCE_INLINE_ const Entry *lookup(const StringName &p_native_class, const GDScript *p_script, uint64_t p_revision) const {
+		for (int i = 0; i < MAX_ENTRIES; i++) {
+			const Entry *entry = entries[i].load(std::memory_order_acquire);
+			if (entry && entry->native_class == p_native_class && entry->script == p_script && entry->revision == p_revision) {
+				return entry;
+			}
+		}
+		return nullptr;
+	}
+
+	// Counts a lookup about to be resolved, false once the site gave up on this revision.
+	bool begin_resolve(uint64_t p_revision);
+	void insert(const Entry &p_entry);
+
+	~GDScriptInlineCache();
+};
+
 class GDScriptFunction {
 public:
 	enum Opcode {
 		OPCODE_OPERATOR,
 		OPCODE_OPERATOR_VALIDATED,
+		// Validated operators on typed operands, computed inline instead of through the evaluator.
+		OPCODE_OPERATOR_ADD_INT,
+		OPCODE_OPERATOR_SUBTRACT_INT,
+		OPCODE_OPERATOR_MULTIPLY_INT,
+		OPCODE_OPERATOR_EQUAL_INT,
+		OPCODE_OPERATOR_NOT_EQUAL_INT,
+		OPCODE_OPERATOR_LESS_INT,
+		OPCODE_OPERATOR_LESS_EQUAL_INT,
+		OPCODE_OPERATOR_GREATER_INT,
+		OPCODE_OPERATOR_GREATER_EQUAL_INT,
+		OPCODE_OPERATOR_ADD_FLOAT,
+		OPCODE_OPERATOR_SUBTRACT_FLOAT,
+		OPCODE_OPERATOR_MULTIPLY_FLOAT,
+		OPCODE_OPERATOR_DIVIDE_FLOAT,
+		OPCODE_OPERATOR_EQUAL_FLOAT,
+		OPCODE_OPERATOR_NOT_EQUAL_FLOAT,
+		OPCODE_OPERATOR_LESS_FLOAT,
+		OPCODE_OPERATOR_LESS_EQUAL_FLOAT,
+		OPCODE_OPERATOR_GREATER_FLOAT,
+		OPCODE_OPERATOR_GREATER_EQUAL_FLOAT,
+		OPCODE_OPERATOR_ADD_VECTOR2,
+		OPCODE_OPERATOR_SUBTRACT_VECTOR2,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR2,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR2_FLOAT,
+		OPCODE_OPERATOR_DIVIDE_VECTOR2_FLOAT,
+		OPCODE_OPERATOR_ADD_VECTOR3,
+		OPCODE_OPERATOR_SUBTRACT_VECTOR3,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR3,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT,
+		OPCODE_OPERATOR_DIVIDE_VECTOR3_FLOAT,
 		OPCODE_TYPE_TEST_BUILTIN,
 		OPCODE_TYPE_TEST_ARRAY,
 		OPCODE_TYPE_TEST_DICTIONARY,
@@ -265,6 +367,7 @@ public:
 		OPCODE_SET_KEYED,
 		OPCODE_SET_KEYED_VALIDATED,
 		OPCODE_SET_INDEXED_VALIDATED,
+		OPCODE_SET_TYPED_ARRAY_INDEXED,
 		OPCODE_GET_KEYED,
 		OPCODE_GET_KEYED_VALIDATED,
 		OPCODE_GET_INDEXED_VALIDATED,
@@ -407,6 +510,13 @@ public:
 		OPCODE_TYPE_ADJUST_PACKED_VECTOR3_ARRAY,
 		OPCODE_TYPE_ADJUST_PACKED_COLOR_ARRAY,
 		OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY,
+		// Superinstructions, written over the first instruction of a pair by the bytecode optimizer.
+		// The second instruction is left intact, so jumps to it remain valid.
+		OPCODE_OPERATOR_VALIDATED_ASSIGN,
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF,
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,
+		OPCODE_OPERATOR_VALIDATED_SET_INDEXED_VALIDATED,
+		OPCODE_GET_INDEXED_VALIDATED_OPERATOR_VALIDATED,
 		OPCODE_ASSERT,
 		OPCODE_BREAKPOINT,
 		OPCODE_LINE,
@@ -519,6 +629,18 @@ private:
 	MethodBind **_methods_ptr = nullptr;
 	GDScriptFunction **_lambdas_ptr = nullptr;
 
+	// Body compiled ahead of time, used instead of the bytecode when set.
+	GDScriptAOT::Function native_function = nullptr;
+
+	int _inline_caches_count = 0;
+	GDScriptInlineCache *_inline_caches_ptr = nullptr;
+
+	// Changes made by the bytecode optimizer.
+	int _threaded_jump_count = 0;
+	int _fused_instruction_count = 0;
+
+	std::atomic<uint32_t> sampler_symbol = { 0 }; // Registered on the first call while sampling.
+
 #ifdef DEBUG_ENABLED
 	CharString func_cname;
 	const char *_func_cname = nullptr;
@@ -553,7 +675,14 @@ private:
 #endif
 
 	_FORCE_INLINE_ String _get_call_error(const String &p_where, const Variant **p_argptrs, const Variant &p_ret, const Callable::CallError &p_err) const;
+
+	// Inline cache fast paths, they return false when the regular Variant path must run instead.
+	static bool _resolve_inline_cache(GDScriptInlineCache::Access p_access, const Object *p_object, const GDScript *p_script, const StringName &p_name, GDScriptInlineCache::Entry &r_entry);
+	static bool _call_cached(GDScriptInlineCache *p_cache, const Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error);
+	static bool _get_named_cached(GDScriptInlineCache *p_cache, const Variant *p_base, const StringName &p_name, Variant &r_value);
+	static bool _set_named_cached(GDScriptInlineCache *p_cache, const Variant *p_base, const StringName &p_name, const Variant &p_value, bool &r_valid);
 	Variant _get_default_variant_for_data_type(const GDScriptDataType &p_data_type);
+	uint32_t _get_sampler_symbol();
 
 public:
 	static constexpr int MAX_CALL_DEPTH = 2048; // Limit to try to avoid crash because of a stack overflow.
@@ -565,7 +694,7 @@ public:
 		StringName function_name;
 		String script_path;
 #endif
-		Vector<uint8_t> stack;
+		uint8_t *stack = nullptr; // From GDScriptFramePool, `alloca_size` bytes.
 		int stack_size = 0;
 		uint32_t alloca_size = 0;
 		int ip = 0;
@@ -582,6 +711,8 @@ public:
 	_FORCE_INLINE_ int get_argument_count() const { return _argument_count; }
 	_FORCE_INLINE_ Variant get_rpc_config() const { return rpc_config; }
 	_FORCE_INLINE_ int get_max_stack_size() const { return _stack_size; }
+	_FORCE_INLINE_ int get_threaded_jump_count() const { return _threaded_jump_count; }
+	_FORCE_INLINE_ int get_fused_instruction_count() const { return _fused_instruction_count; }
 
 	Variant get_constant(int p_idx) const;
 	StringName get_global_name(int p_idx) const;
@@ -609,18 +740,74 @@ class GDScriptFunctionState : public RefCounted {
 	SelfList<GDScriptFunctionState> scripts_list;
 	SelfList<GDScriptFunctionState> instances_list;
 
+	bool suspended = false; // Waiting to be resumed for the first time.
+	static SafeNumeric<uint64_t> suspended_count;
+
+	// Awaits on the SceneTree `process_frame` and `physics_frame` signals are resumed
+	// in order from a single connection per tree and signal, instead of one connection each.
+	struct FrameAwaits {
+		LocalVector<Ref<GDScriptFunctionState>> states[2]; // For `process_frame` and `physics_frame`.
+		bool connected[2] = {};
+	};
+	static Mutex frame_awaits_mutex;
+	static HashMap<ObjectID, FrameAwaits> frame_awaits; // By tree.
+	static void _resume_frame_awaits(uint64_t p_tree, int p_index);
+
 protected:
 	static void _bind_methods();
 
 public:
 	bool is_valid(bool p_extended_check = false) const;
 	Variant resume(const Variant &p_arg = Variant());
+	Variant resume_from_signal(const Variant **p_args, int p_argcount);
 
 	void _clear_stack();
 	void _clear_connections();
 
+	// Suspends the state until `p_signal` is emitted.
+	static Error await_signal(const Ref<GDScriptFunctionState> &p_state, const Signal &p_signal);
+	static void clear_frame_awaits();
+	static uint64_t get_suspended_count() { return suspended_count.get(); }
+
 	GDScriptFunctionState();
 	~GDScriptFunctionState();
 };
 
+// Memory for the stacks of functions suspended by `await`. Freed frames are kept
+// for reuse, in power of two size classes.
+class GDScriptFramePool {
+	static constexpr uint32_t MIN_SIZE_SHIFT = 8; // 256 bytes.
+	static constexpr uint32_t SIZE_CLASS_COUNT = 7; // Up to 16 KiB, larger frames aren't pooled.
+	static constexpr uint32_t MAX_POOLED_BYTES = 1024 * 1024; // For each size class.
+
+	struct FreeFrame {
+		FreeFrame *next = nullptr;
+	};
+
+	struct SizeClass {
+		SpinLock lock;
+		FreeFrame *free_frames = nullptr;
+		uint32_t free_count = 0;
+	};
+
+	static SizeClass size_classes[SIZE_CLASS_COUNT];
+	static SafeNumeric<uint64_t> used_count;
+
+	static _FORCE_INLINE_ uint32_t _get_size_class(uint32_t p_size) {
+		uint32_t size_class = 0;
+		while (size_class < SIZE_CLASS_COUNT && (1u << (MIN_SIZE_SHIFT + size_class)) < p_size) {
+			size_class++;
+		}
+		return size_class;
+	}
+
+public:
+	static uint8_t *alloc(uint32_t p_size);
+	static void free(uint8_t *p_frame, uint32_t p_size);
+	static void clear();
+
+	static uint64_t get_used_count() { return used_count.get(); }
+	static uint64_t get_pooled_count();
+};
+
 #endif // GDSCRIPT_FUNCTION_H
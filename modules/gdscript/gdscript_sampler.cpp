@@ -0,0 +1,449 @@
+/**************************************************************************/
+/*  gdscript_sampler.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_sampler.h"
+
+#include "core/io/compression.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/object/class_db.h"
+#include "core/object/method_bind.h"
+#include "core/os/os.h"
+#include "core/templates/hash_set.h"
+
+std::atomic<bool> GDScriptSampler::active = { false };
+thread_local GDScriptSampler::ThreadStack GDScriptSampler::thread_stack;
+
+Mutex GDScriptSampler::mutex;
+LocalVector<GDScriptSampler::Symbol> GDScriptSampler::symbols;
+LocalVector<GDScriptSampler::ThreadStack *> GDScriptSampler::threads;
+LocalVector<String> GDScriptSampler::thread_names;
+HashMap<Vector<uint32_t>, uint64_t, GDScriptSampler::StackHasher> GDScriptSampler::samples;
+uint64_t GDScriptSampler::sample_count = 0;
+uint64_t GDScriptSampler::start_time_usec = 0;
+uint64_t GDScriptSampler::duration_usec = 0;
+int GDScriptSampler::frequency = 0;
+
+Thread GDScriptSampler::thread;
+SafeFlag GDScriptSampler::exit_thread;
+String GDScriptSampler::output_path;
+
+GDScriptSampler::ThreadStack::~ThreadStack() {
+	if (index >= 0) {
+		MutexLock lock(mutex);
+		threads[index] = nullptr;
+	}
+}
+
+void GDScriptSampler::_register_thread() {
+	ThreadStack &stack = thread_stack;
+	Thread::ID id = Thread::get_caller_id();
+
+	MutexLock lock(mutex);
+	stack.index = threads.size();
+	threads.push_back(&stack);
+	thread_names.push_back(id == Thread::get_main_id() ? String("main") : vformat("thread %d", id));
+}
+
+uint32_t GDScriptSampler::_get_native_symbol(const MethodBind *p_method) {
+	ThreadStack &stack = thread_stack;
+	// Unregistering an extension class frees its method binds, so their addresses may be reused.
+	uint32_t revision = ClassDB::get_revision();
+	if (unlikely(stack.native_symbols_revision != revision)) {
+		stack.native_symbols.clear();
+		stack.native_symbols_revision = revision;
+	}
+
+	HashMap<const MethodBind *, uint32_t>::Iterator E = stack.native_symbols.find(p_method);
+	if (E) {
+		return E->value;
+	}
+
+	String name = p_method->get_name();
+	if (p_method->get_instance_class() != StringName()) {
+		name = String(p_method->get_instance_class()) + "::" + name;
+	}
+	uint32_t symbol = add_symbol(name, String(), 0);
+	stack.native_symbols.insert(p_method, symbol);
+	return symbol;
+}
+
+uint32_t GDScriptSampler::add_symbol(const String &p_name, const String &p_file, int p_line) {
+	Symbol symbol;
+	symbol.name = p_name;
+	symbol.file = p_file;
+	symbol.line = p_line;
+
+	MutexLock lock(mutex);
+	symbols.push_back(symbol);
+	return symbols.size();
+}
+
+GDScriptSampler::Symbol GDScriptSampler::get_symbol(uint32_t p_symbol) {
+	MutexLock lock(mutex);
+	ERR_FAIL_COND_V(p_symbol == 0 || p_symbol > symbols.size(), Symbol());
+	return symbols[p_symbol - 1];
+}
+
+String GDScriptSampler::_get_symbol_label(uint32_t p_symbol) {
+	const Symbol &symbol = symbols[p_symbol - 1];
+	if (symbol.file.is_empty()) {
+		return symbol.name;
+	}
+	return vformat("%s (%s:%d)", symbol.name, symbol.file, symbol.line);
+}
+
+void GDScriptSampler::_thread_func(void *p_userdata) {
+	uint64_t interval_usec = MAX(1000000 / frequency, 1);
+	while (!exit_thread.is_set()) {
+		OS::get_singleton()->delay_usec(interval_usec);
+		sample();
+	}
+}
+
+void GDScriptSampler::start(int p_frequency) {
+	ERR_FAIL_COND_MSG(is_active(), "The GDScript sampler is already running.");
+	ERR_FAIL_COND(p_frequency < 0);
+
+	{
+		MutexLock lock(mutex);
+		samples.clear();
+		sample_count = 0;
+		start_time_usec = uint64_t(OS::get_singleton()->get_unix_time() * 1000000.0);
+		duration_usec = OS::get_singleton()->get_ticks_usec();
+		frequency = p_frequency;
+	}
+	active.store(true, std::memory_order_relaxed);
+
+	if (p_frequency > 0) {
+		exit_thread.clear();
+		thread.start(_thread_func, nullptr);
+	}
+}
+
+void GDScriptSampler::stop() {
+	if (!is_active()) {
+		return;
+	}
+	active.store(false, std::memory_order_relaxed);
+
+	if (thread.is_started()) {
+		exit_thread.set();
+		thread.wait_to_finish();
+	}
+
+	MutexLock lock(mutex);
+	duration_usec = OS::get_singleton()->get_ticks_usec() - duration_usec;
+}
+
+void GDScriptSampler::sample() {
+	uint32_t frames[MAX_DEPTH];
+
+	MutexLock lock(mutex);
+	for (uint32_t i = 0; i < threads.size(); i++) {
+		ThreadStack *stack = threads[i];
+		if (stack == nullptr) {
+			continue;
+		}
+
+		// The owner may push or pop while the frames are copied, in which case the
+		// state changed and the copy is retried.
+		uint32_t depth = 0;
+		bool consistent = false;
+		for (int attempt = 0; attempt < 3 && !consistent; attempt++) {
+			uint64_t state = stack->state.load(std::memory_order_acquire);
+			depth = MIN(uint32_t(state & 0xFFFFFFFF), MAX_DEPTH);
+			for (uint32_t j = 0; j < depth; j++) {
+				frames[j] = stack->frames[j].load(std::memory_order_relaxed);
+			}
+			std::atomic_thread_fence(std::memory_order_acquire);
+			consistent = stack->state.load(std::memory_order_relaxed) == state;
+		}
+		if (!consistent || depth == 0) {
+			continue; // Busy or not running scripts.
+		}
+
+		Vector<uint32_t> key;
+		key.resize(depth + 1);
+		uint32_t *key_ptr = key.ptrw();
+		key_ptr[0] = i;
+		memcpy(key_ptr + 1, frames, depth * sizeof(uint32_t));
+
+		HashMap<Vector<uint32_t>, uint64_t, StackHasher>::Iterator E = samples.find(key);
+		if (E) {
+			E->value++;
+		} else {
+			samples.insert(key, 1);
+		}
+		sample_count++;
+	}
+}
+
+uint64_t GDScriptSampler::get_sample_count() {
+	MutexLock lock(mutex);
+	return sample_count;
+}
+
+String GDScriptSampler::get_collapsed_stacks() {
+	MutexLock lock(mutex);
+
+	Vector<String> lines;
+	for (const KeyValue<Vector<uint32_t>, uint64_t> &E : samples) {
+		const uint32_t *key = E.key.ptr();
+		String line = thread_names[key[0]];
+		for (int i = 1; i < E.key.size(); i++) {
+			line += ";" + _get_symbol_label(key[i]);
+		}
+		lines.push_back(line + " " + itos(E.value));
+	}
+	lines.sort();
+
+	String result;
+	for (const String &line : lines) {
+		result += line + "\n";
+	}
+	return result;
+}
+
+// Minimal protocol buffers writer for the profile.proto message.
+// See https://github.com/google/pprof/blob/main/proto/profile.proto.
+class GDScriptSamplerProtoWriter {
+	LocalVector<uint8_t> data;
+
+public:
+	void write_varint(uint64_t p_value) {
+		while (p_value >= 0x80) {
+			data.push_back(uint8_t(p_value) | 0x80);
+			p_value >>= 7;
+		}
+		data.push_back(uint8_t(p_value));
+	}
+
+	void write_int(int p_field, uint64_t p_value) {
+		write_varint(uint64_t(p_field) << 3);
+		write_varint(p_value);
+	}
+
+	void write_bytes(int p_field, const uint8_t *p_bytes, uint32_t p_size) {
+		write_varint((uint64_t(p_field) << 3) | 2);
+		write_varint(p_size);
+		for (uint32_t i = 0; i < p_size; i++) {
+			data.push_back(p_bytes[i]);
+		}
+	}
+
+	void write_string(int p_field, const String &p_string) {
+		CharString utf8 = p_string.utf8();
+		write_bytes(p_field, (const uint8_t *)utf8.get_data(), utf8.length());
+	}
+
+	void write_message(int p_field, const GDScriptSamplerProtoWriter &p_message) {
+		write_bytes(p_field, p_message.data.ptr(), p_message.data.size());
+	}
+
+	void write_packed(int p_field, const LocalVector<uint64_t> &p_values) {
+		GDScriptSamplerProtoWriter packed;
+		for (uint64_t value : p_values) {
+			packed.write_varint(value);
+		}
+		write_message(p_field, packed);
+	}
+
+	const LocalVector<uint8_t> &get_data() const { return data; }
+};
+
+Vector<uint8_t> GDScriptSampler::get_pprof() {
+	MutexLock lock(mutex);
+
+	LocalVector<String> strings;
+	HashMap<String, uint64_t> string_ids;
+	auto string_id = [&](const String &p_string) -> uint64_t {
+		HashMap<String, uint64_t>::Iterator E = string_ids.find(p_string);
+		if (E) {
+			return E->value;
+		}
+		uint64_t id = strings.size();
+		strings.push_back(p_string);
+		string_ids.insert(p_string, id);
+		return id;
+	};
+	string_id(String()); // The first string must be empty.
+
+	GDScriptSamplerProtoWriter profile;
+	auto write_value_type = [&](int p_field, const String &p_type, const String &p_unit) {
+		GDScriptSamplerProtoWriter value_type;
+		value_type.write_int(1, string_id(p_type));
+		value_type.write_int(2, string_id(p_unit));
+		profile.write_message(p_field, value_type);
+	};
+
+	uint64_t period = frequency > 0 ? 1000000000 / frequency : 1000000000 / DEFAULT_FREQUENCY;
+	write_value_type(1, "samples", "count");
+	write_value_type(1, "cpu", "nanoseconds");
+
+	// Locations and functions share IDs: symbols keep theirs, and threads follow
+	// as root frames.
+	HashSet<uint64_t> used_locations;
+	for (const KeyValue<Vector<uint32_t>, uint64_t> &E : samples) {
+		const uint32_t *key = E.key.ptr();
+
+		LocalVector<uint64_t> location_ids;
+		for (int i = E.key.size() - 1; i > 0; i--) {
+			location_ids.push_back(key[i]);
+		}
+		location_ids.push_back(symbols.size() + 1 + key[0]);
+		for (uint64_t id : location_ids) {
+			used_locations.insert(id);
+		}
+
+		LocalVector<uint64_t> values;
+		values.push_back(E.value);
+		values.push_back(E.value * period);
+
+		GDScriptSamplerProtoWriter sample;
+		sample.write_packed(1, location_ids);
+		sample.write_packed(2, values);
+		profile.write_message(2, sample);
+	}
+
+	for (uint64_t id : used_locations) {
+		String name;
+		String file;
+		int line = 0;
+		if (id <= symbols.size()) {
+			const Symbol &symbol = symbols[id - 1];
+			name = symbol.name;
+			file = symbol.file;
+			line = symbol.line;
+		} else {
+			name = thread_names[id - symbols.size() - 1];
+		}
+
+		GDScriptSamplerProtoWriter location_line;
+		location_line.write_int(1, id);
+		location_line.write_int(2, line);
+
+		GDScriptSamplerProtoWriter location;
+		location.write_int(1, id);
+		location.write_message(4, location_line);
+		profile.write_message(4, location);
+
+		GDScriptSamplerProtoWriter function;
+		function.write_int(1, id);
+		function.write_int(2, string_id(name));
+		function.write_int(3, string_id(name));
+		function.write_int(4, string_id(file));
+		function.write_int(5, line);
+		profile.write_message(5, function);
+	}
+
+	// Written last, as the fields above may still add strings.
+	GDScriptSamplerProtoWriter tail;
+	for (const String &string : strings) {
+		tail.write_string(6, string);
+	}
+	tail.write_int(9, start_time_usec * 1000);
+	tail.write_int(10, (is_active() ? OS::get_singleton()->get_ticks_usec() - duration_usec : duration_usec) * 1000);
+	GDScriptSamplerProtoWriter period_type;
+	period_type.write_int(1, string_id("cpu"));
+	period_type.write_int(2, string_id("nanoseconds"));
+	tail.write_message(11, period_type);
+	tail.write_int(12, period);
+
+	LocalVector<uint8_t> message = profile.get_data();
+	for (uint8_t byte : tail.get_data()) {
+		message.push_back(byte);
+	}
+
+	Vector<uint8_t> compressed;
+	compressed.resize(Compression::get_max_compressed_buffer_size(message.size(), Compression::MODE_GZIP));
+	int size = Compression::compress(compressed.ptrw(), message.ptr(), message.size(), Compression::MODE_GZIP);
+	ERR_FAIL_COND_V(size < 0, Vector<uint8_t>());
+	compressed.resize(size);
+	return compressed;
+}
+
+Error GDScriptSampler::save(const String &p_path) {
+	Error err;
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(file.is_null(), err, vformat("Cannot save GDScript samples to \"%s\".", p_path));
+
+	if (p_path.ends_with(".pprof") || p_path.ends_with(".pb.gz")) {
+		Vector<uint8_t> pprof = get_pprof();
+		file->store_buffer(pprof.ptr(), pprof.size());
+	} else {
+		file->store_string(get_collapsed_stacks());
+	}
+	return OK;
+}
+
+void GDScriptSampler::handle_command_line() {
+	List<String> args = OS::get_singleton()->get_cmdline_args();
+	for (const String &arg : OS::get_singleton()->get_cmdline_user_args()) {
+		args.push_back(arg);
+	}
+
+	String path;
+	int sample_frequency = DEFAULT_FREQUENCY;
+	for (List<String>::Element *E = args.front(); E; E = E->next()) {
+		if (E->get() == "--gdscript-sample") {
+			ERR_FAIL_COND_MSG(!E->next(), "Missing output file for --gdscript-sample.");
+			E = E->next();
+			path = E->get();
+		} else if (E->get() == "--gdscript-sample-frequency") {
+			ERR_FAIL_COND_MSG(!E->next() || !E->next()->get().is_valid_int(), "Missing frequency for --gdscript-sample-frequency.");
+			E = E->next();
+			sample_frequency = E->get().to_int();
+			ERR_FAIL_COND_MSG(sample_frequency <= 0, "The --gdscript-sample-frequency must be positive.");
+		}
+	}
+
+	if (path.is_empty()) {
+		return;
+	}
+	if (path.is_relative_path()) {
+		// Relative to where the engine was run from, not to the project.
+		Ref<DirAccess> da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+		path = da->get_current_dir().path_join(path);
+	}
+	output_path = path;
+	start(sample_frequency);
+}
+
+void GDScriptSampler::finish() {
+	stop();
+	if (output_path.is_empty()) {
+		return;
+	}
+	if (save(output_path) == OK) {
+		print_line(vformat("Saved %d GDScript samples to \"%s\".", get_sample_count(), output_path));
+	}
+	output_path = String();
+}
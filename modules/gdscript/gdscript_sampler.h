@@ -0,0 +1,184 @@
+/**************************************************************************/
+/*  gdscript_sampler.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_SAMPLER_H
+#define GDSCRIPT_SAMPLER_H
+
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+#include <atomic>
+
+class MethodBind;
+
+// Statistical profiler for GDScript, available in every build including release
+// exports. While it runs, threads executing scripts keep a stack of symbol IDs
+// and a background thread periodically records the stack of every thread.
+// Native methods called from scripts are leaf frames of those stacks, which
+// tells the time spent running script code apart from the time spent in the
+// engine calls it makes. Recorded stacks export as collapsed stacks (for
+// flamegraph.pl and compatible tools) or as a pprof profile.
+class GDScriptSampler {
+public:
+	static constexpr uint32_t MAX_DEPTH = 256; // Deeper frames are not recorded.
+	static constexpr int DEFAULT_FREQUENCY = 1000;
+
+	struct Symbol {
+		String name;
+		String file; // Empty for native methods.
+		int line = 0;
+	};
+
+	// Pushed by the owning code for the rest of the scope.
+	class Frame {
+		bool pushed = false;
+
+	public:
+		_FORCE_INLINE_ void push(uint32_t p_symbol) {
+			GDScriptSampler::push(p_symbol);
+			pushed = true;
+		}
+
+		_FORCE_INLINE_ ~Frame() {
+			if (unlikely(pushed)) {
+				GDScriptSampler::pop();
+			}
+		}
+	};
+
+	class NativeFrame : public Frame {
+	public:
+		_FORCE_INLINE_ NativeFrame(const MethodBind *p_method) {
+			if (unlikely(is_active())) {
+				push(_get_native_symbol(p_method));
+			}
+		}
+	};
+
+private:
+	struct ThreadStack {
+		// Sequence number in the high half and depth in the low half, so readers can
+		// tell if the stack changed while they copied it. Only the owner writes.
+		std::atomic<uint64_t> state = { 0 };
+		std::atomic<uint32_t> frames[MAX_DEPTH] = {};
+		uint32_t depth = 0;
+		uint32_t sequence = 0;
+		int index = -1; // In `threads`, -1 until registered.
+
+		HashMap<const MethodBind *, uint32_t> native_symbols;
+		uint32_t native_symbols_revision = 0;
+
+		~ThreadStack();
+	};
+
+	struct StackHasher {
+		static _FORCE_INLINE_ uint32_t hash(const Vector<uint32_t> &p_stack) {
+			return hash_murmur3_buffer(p_stack.ptr(), p_stack.size() * sizeof(uint32_t));
+		}
+	};
+
+	static std::atomic<bool> active;
+	static thread_local ThreadStack thread_stack;
+
+	// Guards everything below.
+	static Mutex mutex;
+	static LocalVector<Symbol> symbols; // A symbol ID is its index plus one.
+	static LocalVector<ThreadStack *> threads; // nullptr once the thread exits.
+	static LocalVector<String> thread_names;
+	// Recorded stacks as the thread index followed by symbol IDs from the root.
+	static HashMap<Vector<uint32_t>, uint64_t, StackHasher> samples;
+	static uint64_t sample_count;
+	static uint64_t start_time_usec;
+	static uint64_t duration_usec;
+	static int frequency;
+
+	static Thread thread;
+	static SafeFlag exit_thread;
+	static String output_path; // Set from the command line.
+
+	static void _register_thread();
+	static uint32_t _get_native_symbol(const MethodBind *p_method);
+	static void _thread_func(void *p_userdata);
+	static String _get_symbol_label(uint32_t p_symbol);
+
+public:
+	static _FORCE_INLINE_ bool is_active() { return active.load(std::memory_order_relaxed); }
+
+	static _FORCE_INLINE_ void push(uint32_t p_symbol) {
+		ThreadStack &stack = thread_stack;
+		if (unlikely(stack.index < 0)) {
+			_register_thread();
+		}
+		if (likely(stack.depth < MAX_DEPTH)) {
+			// Orders the write after the last state change, which readers check.
+			std::atomic_thread_fence(std::memory_order_release);
+			stack.frames[stack.depth].store(p_symbol, std::memory_order_relaxed);
+		}
+		stack.depth++;
+		stack.sequence++;
+		stack.state.store((uint64_t(stack.sequence) << 32) | stack.depth, std::memory_order_release);
+	}
+
+	static _FORCE_INLINE_ void pop() {
+		ThreadStack &stack = thread_stack;
+		stack.depth--;
+		stack.sequence++;
+		stack.state.store((uint64_t(stack.sequence) << 32) | stack.depth, std::memory_order_release);
+	}
+
+	// Symbols are never removed, so IDs stay valid for the whole run.
+	static uint32_t add_symbol(const String &p_name, const String &p_file, int p_line);
+	static Symbol get_symbol(uint32_t p_symbol);
+
+	// Starts recording, discarding previous samples. With a frequency of 0 no
+	// sampling thread is started and samples are only taken by calling sample().
+	static void start(int p_frequency = DEFAULT_FREQUENCY);
+	static void stop();
+	// Records the current stack of every thread running scripts.
+	static void sample();
+
+	static uint64_t get_sample_count();
+	// One "thread;root;...;leaf count" line per distinct stack.
+	static String get_collapsed_stacks();
+	// Gzip compressed profile.proto message, as read by `go tool pprof`.
+	static Vector<uint8_t> get_pprof();
+	// Saves as pprof when the extension is `.pprof` or `.pb.gz`, as collapsed stacks otherwise.
+	static Error save(const String &p_path);
+
+	// `--gdscript-sample <file>` samples the whole run and saves to <file> on exit,
+	// `--gdscript-sample-frequency <hz>` changes how often.
+	static void handle_command_line();
+	static void finish();
+};
+
+#endif // GDSCRIPT_SAMPLER_H
@@ -33,6 +33,7 @@
 #include "gdscript_lambda_callable.h"
 
 #include "core/os/os.h"
+#include "scene/scene_string_names.h"
 
 #ifdef DEBUG_ENABLED
 
@@ -185,6 +186,250 @@ String GDScriptFunction::_get_call_error(const String &p_where, const Variant **
 	return "Bug: Invalid call error code " + itos(p_err.error) + ".";
 }
 
+std::atomic<uint32_t> GDScriptInlineCache::script_revision = { 0 };
+
+uint64_t GDScriptInlineCache::get_revision() {
+	return (uint64_t(ClassDB::get_revision()) << 32) | script_revision.load(std::memory_order_acquire);
+}
+
+bool GDScriptInlineCache::begin_resolve(uint64_t p_revision) {
+	// Reloads invalidate every entry, so they don't count towards giving up.
+	uint64_t counted = resolves_revision.load(std::memory_order_relaxed);
+	if (counted != p_revision && resolves_revision.compare_exchange_strong(counted, p_revision, std::memory_order_relaxed)) {
+		resolves.store(0, std::memory_order_relaxed);
+	}
+	return resolves.fetch_add(1, std::memory_order_relaxed) < MAX_RESOLVES;
+}
+
+void GDScriptInlineCache::insert(const Entry &p_entry) {
+	Entry *entry = memnew(Entry(p_entry));
+	entry->next_allocated = allocated.load(std::memory_order_relaxed);
+	while (!allocated.compare_exchange_weak(entry->next_allocated, entry, std::memory_order_release, std::memory_order_relaxed)) {
+	}
+
+	// Take a free or stale slot, otherwise evict in round robin.
+	int slot = -1;
+	for (int i = 0; i < MAX_ENTRIES; i++) {
+		const Entry *current = entries[i].load(std::memory_order_acquire);
+		if (!current || current->revision != entry->revision) {
+			slot = i;
+			break;
+		}
+	}
+	if (slot < 0) {
+		slot = resolves.load(std::memory_order_relaxed) % MAX_ENTRIES;
+	}
+	entries[slot].store(entry, std::memory_order_release);
+}
+
+GDScriptInlineCache::~GDScriptInlineCache() {
+	Entry *entry = allocated.load(std::memory_order_acquire);
+	while (entry) {
+		Entry *next = entry->next_allocated;
+		memdelete(entry);
+		entry = next;
+	}
+}
+
+// Finds the object the inline caches can handle, with its GDScript instance if any. Lookups
+// on placeholders and instances of other script languages go through the regular path.
+static _FORCE_INLINE_ bool _get_inline_cache_receiver(const Variant *p_base, Object *&r_object, GDScriptInstance *&r_instance) {
+	if (p_base->get_type() != Variant::OBJECT) {
+		return false;
+	}
+	r_object = p_base->get_validated_object();
+	if (unlikely(!r_object)) {
+		return false;
+	}
+#ifdef TOOLS_ENABLED
+	if (unlikely(r_object->is_extension_placeholder())) {
+		return false;
+	}
+#endif
+
+	ScriptInstance *script_instance = r_object->get_script_instance();
+	if (!script_instance) {
+		r_instance = nullptr;
+		return true;
+	}
+	if (script_instance->get_language() != GDScriptLanguage::get_singleton() || script_instance->is_placeholder()) {
+		return false;
+	}
+	r_instance = static_cast<GDScriptInstance *>(script_instance);
+	return true;
+}
+
+bool GDScriptFunction::_resolve_inline_cache(GDScriptInlineCache::Access p_access, const Object *p_object, const GDScript *p_script, const StringName &p_name, GDScriptInlineCache::Entry &r_entry) {
+	if (p_object->has_custom_callp()) {
+		return false;
+	}
+	for (const GDScript *sptr = p_script; sptr; sptr = sptr->_base) {
+		if (!sptr->valid) {
+			return false;
+		}
+	}
+
+	const StringName &native_class = p_object->get_class_name();
+
+	if (p_access == GDScriptInlineCache::ACCESS_CALL) {
+		// `free()` must keep its checks, `_ready()` first runs the implicit initializers.
+		if (p_name == CoreStringName(free_) || (p_script && p_name == SceneStringName(_ready))) {
+			return false;
+		}
+		for (const GDScript *sptr = p_script; sptr; sptr = sptr->_base) {
+			GDScriptFunction *const *function = sptr->member_functions.getptr(p_name);
+			if (function) {
+				r_entry.kind = GDScriptInlineCache::SCRIPT_FUNCTION;
+				r_entry.function = *function;
+				return true;
+			}
+		}
+		MethodBind *method = ClassDB::get_method(native_class, p_name);
+		if (!method) {
+			return false;
+		}
+		r_entry.kind = GDScriptInlineCache::NATIVE_METHOD;
+		r_entry.method = method;
+		return true;
+	}
+
+	// Same precedence as GDScriptInstance::set() and GDScriptInstance::get(), which run before the native class.
+	const bool set = p_access == GDScriptInlineCache::ACCESS_SET;
+	if (p_script) {
+		const GDScript::MemberInfo *member = p_script->member_indices.getptr(p_name);
+		if (member) {
+			if (set ? member->setter != StringName() : member->getter != StringName()) {
+				return false;
+			}
+			r_entry.kind = GDScriptInlineCache::SCRIPT_MEMBER;
+			r_entry.index = member->index;
+			r_entry.member_type = &member->data_type;
+			return true;
+		}
+
+		const StringName &fallback = set ? GDScriptLanguage::get_singleton()->strings._set : GDScriptLanguage::get_singleton()->strings._get;
+		for (const GDScript *sptr = p_script; sptr; sptr = sptr->_base) {
+			if (sptr->static_variables_indices.has(p_name) || sptr->member_functions.has(fallback)) {
+				return false;
+			}
+			if (!set && (sptr->constants.has(p_name) || sptr->_signals.has(p_name) || sptr->member_functions.has(p_name) || sptr->subclasses.has(p_name))) {
+				return false;
+			}
+		}
+	}
+
+	int property_index = -1;
+	MethodBind *accessor = ClassDB::get_property_accessor(native_class, p_name, set, &property_index);
+	if (!accessor) {
+		return false;
+	}
+	if (!set && property_index >= 0) {
+		// Indexed getters are called by name, so the script could define them.
+		for (const GDScript *sptr = p_script; sptr; sptr = sptr->_base) {
+			if (sptr->member_functions.has(accessor->get_name())) {
+				return false;
+			}
+		}
+	}
+	r_entry.kind = GDScriptInlineCache::NATIVE_PROPERTY;
+	r_entry.method = accessor;
+	r_entry.index = property_index;
+	return true;
+}
+
+// Looks the receiver up in the cache, resolving and inserting it on a miss.
+#define INLINE_CACHE_LOOKUP(m_access, m_name)                                                                          \
+	Object *object;                                                                                                    \
+	GDScriptInstance *instance;                                                                                        \
+	if (!_get_inline_cache_receiver(p_base, object, instance)) {                                                       \
+		return false;                                                                                                  \
+	}                                                                                                                  \
+	const GDScript *script = instance ? instance->script.ptr() : nullptr;                                              \
+	const uint64_t revision = GDScriptInlineCache::get_revision();                                                     \
+	const GDScriptInlineCache::Entry *entry = p_cache->lookup(object->get_class_name(), script, revision);             \
+	GDScriptInlineCache::Entry resolved;                                                                               \
+	if (unlikely(!entry)) {                                                                                            \
+		if (!p_cache->begin_resolve(revision) || !_resolve_inline_cache(m_access, object, script, m_name, resolved)) { \
+			return false;                                                                                              \
+		}                                                                                                              \
+		resolved.native_class = object->get_class_name();                                                              \
+		resolved.script = script;                                                                                      \
+		resolved.revision = revision;                                                                                  \
+		p_cache->insert(resolved);                                                                                     \
+		entry = &resolved;                                                                                             \
+	}
+
+bool GDScriptFunction::_call_cached(GDScriptInlineCache *p_cache, const Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error) {
+	INLINE_CACHE_LOOKUP(GDScriptInlineCache::ACCESS_CALL, p_method);
+
+#ifdef DEBUG_ENABLED
+	// Like Object::callp(), so the object can't free itself while running.
+	_ObjectDebugLock debug_lock(object);
+#endif
+	r_error.error = Callable::CallError::CALL_OK;
+	if (entry->kind == GDScriptInlineCache::SCRIPT_FUNCTION) {
+		r_ret = entry->function->call(instance, p_args, p_argcount, r_error);
+	} else {
+		GDScriptSampler::NativeFrame native_frame(entry->method);
+		r_ret = entry->method->call(object, p_args, p_argcount, r_error);
+	}
+	return true;
+}
+
+bool GDScriptFunction::_get_named_cached(GDScriptInlineCache *p_cache, const Variant *p_base, const StringName &p_name, Variant &r_value) {
+	INLINE_CACHE_LOOKUP(GDScriptInlineCache::ACCESS_GET, p_name);
+
+	if (entry->kind == GDScriptInlineCache::SCRIPT_MEMBER) {
+		r_value = instance->members[entry->index];
+		return true;
+	}
+
+	// As in ClassDB::get_property().
+	Callable::CallError ce;
+	if (entry->index >= 0) {
+		Variant index = entry->index;
+		const Variant *args[1] = { &index };
+		const Variant value = entry->method->call(object, args, 1, ce);
+		r_value = (ce.error == Callable::CallError::CALL_OK) ? value : Variant();
+	} else {
+		r_value = entry->method->call(object, nullptr, 0, ce);
+	}
+	return true;
+}
+
+bool GDScriptFunction::_set_named_cached(GDScriptInlineCache *p_cache, const Variant *p_base, const StringName &p_name, const Variant &p_value, bool &r_valid) {
+	INLINE_CACHE_LOOKUP(GDScriptInlineCache::ACCESS_SET, p_name);
+
+	if (entry->kind == GDScriptInlineCache::SCRIPT_MEMBER && entry->member_type->has_type && !entry->member_type->is_type(p_value)) {
+		// Needs a conversion, which may fail and fall back to the native class.
+		return false;
+	}
+
+#ifdef TOOLS_ENABLED
+	object->_mark_edited();
+#endif
+	if (entry->kind == GDScriptInlineCache::SCRIPT_MEMBER) {
+		instance->members.write[entry->index] = p_value;
+		r_valid = true;
+		return true;
+	}
+
+	// As in ClassDB::set_property().
+	Callable::CallError ce;
+	if (entry->index >= 0) {
+		Variant index = entry->index;
+		const Variant *args[2] = { &index, &p_value };
+		entry->method->call(object, args, 2, ce);
+	} else {
+		const Variant *args[1] = { &p_value };
+		entry->method->call(object, args, 1, ce);
+	}
+	r_valid = ce.error == Callable::CallError::CALL_OK;
+	return true;
+}
+
+#undef INLINE_CACHE_LOOKUP
+
 void (*type_init_function_table[])(Variant *) = {
 	nullptr, // NIL (shouldn't be called).
 	&VariantInitializer<bool>::init, // BOOL.
@@ -228,165 +473,200 @@ void (*type_init_function_table[])(Variant *) = {
 };
 
 #if defined(__GNUC__) || defined(__clang__)
-#define OPCODES_TABLE                                    \
-	static const void *switch_table_ops[] = {            \
-		&&OPCODE_OPERATOR,                               \
-		&&OPCODE_OPERATOR_VALIDATED,                     \
-		&&OPCODE_TYPE_TEST_BUILTIN,                      \
-		&&OPCODE_TYPE_TEST_ARRAY,                        \
-		&&OPCODE_TYPE_TEST_DICTIONARY,                   \
-		&&OPCODE_TYPE_TEST_NATIVE,                       \
-		&&OPCODE_TYPE_TEST_SCRIPT,                       \
-		&&OPCODE_SET_KEYED,                              \
-		&&OPCODE_SET_KEYED_VALIDATED,                    \
-		&&OPCODE_SET_INDEXED_VALIDATED,                  \
-		&&OPCODE_GET_KEYED,                              \
-		&&OPCODE_GET_KEYED_VALIDATED,                    \
-		&&OPCODE_GET_INDEXED_VALIDATED,                  \
-		&&OPCODE_SET_NAMED,                              \
-		&&OPCODE_SET_NAMED_VALIDATED,                    \
-		&&OPCODE_GET_NAMED,                              \
-		&&OPCODE_GET_NAMED_VALIDATED,                    \
-		&&OPCODE_SET_MEMBER,                             \
-		&&OPCODE_GET_MEMBER,                             \
-		&&OPCODE_SET_STATIC_VARIABLE,                    \
-		&&OPCODE_GET_STATIC_VARIABLE,                    \
-		&&OPCODE_ASSIGN,                                 \
-		&&OPCODE_ASSIGN_NULL,                            \
-		&&OPCODE_ASSIGN_TRUE,                            \
-		&&OPCODE_ASSIGN_FALSE,                           \
-		&&OPCODE_ASSIGN_TYPED_BUILTIN,                   \
-		&&OPCODE_ASSIGN_TYPED_ARRAY,                     \
-		&&OPCODE_ASSIGN_TYPED_DICTIONARY,                \
-		&&OPCODE_ASSIGN_TYPED_NATIVE,                    \
-		&&OPCODE_ASSIGN_TYPED_SCRIPT,                    \
-		&&OPCODE_CAST_TO_BUILTIN,                        \
-		&&OPCODE_CAST_TO_NATIVE,                         \
-		&&OPCODE_CAST_TO_SCRIPT,                         \
-		&&OPCODE_CONSTRUCT,                              \
-		&&OPCODE_CONSTRUCT_VALIDATED,                    \
-		&&OPCODE_CONSTRUCT_ARRAY,                        \
-		&&OPCODE_CONSTRUCT_TYPED_ARRAY,                  \
-		&&OPCODE_CONSTRUCT_DICTIONARY,                   \
-		&&OPCODE_CONSTRUCT_TYPED_DICTIONARY,             \
-		&&OPCODE_CALL,                                   \
-		&&OPCODE_CALL_RETURN,                            \
-		&&OPCODE_CALL_ASYNC,                             \
-		&&OPCODE_CALL_UTILITY,                           \
-		&&OPCODE_CALL_UTILITY_VALIDATED,                 \
-		&&OPCODE_CALL_GDSCRIPT_UTILITY,                  \
-		&&OPCODE_CALL_BUILTIN_TYPE_VALIDATED,            \
-		&&OPCODE_CALL_SELF_BASE,                         \
-		&&OPCODE_CALL_METHOD_BIND,                       \
-		&&OPCODE_CALL_METHOD_BIND_RET,                   \
-		&&OPCODE_CALL_BUILTIN_STATIC,                    \
-		&&OPCODE_CALL_NATIVE_STATIC,                     \
-		&&OPCODE_CALL_NATIVE_STATIC_VALIDATED_RETURN,    \
-		&&OPCODE_CALL_NATIVE_STATIC_VALIDATED_NO_RETURN, \
-		&&OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN,      \
-		&&OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN,   \
-		&&OPCODE_AWAIT,                                  \
-		&&OPCODE_AWAIT_RESUME,                           \
-		&&OPCODE_CREATE_LAMBDA,                          \
-		&&OPCODE_CREATE_SELF_LAMBDA,                     \
-		&&OPCODE_JUMP,                                   \
-		&&OPCODE_JUMP_IF,                                \
-		&&OPCODE_JUMP_IF_NOT,                            \
-		&&OPCODE_JUMP_TO_DEF_ARGUMENT,                   \
-		&&OPCODE_JUMP_IF_SHARED,                         \
-		&&OPCODE_RETURN,                                 \
-		&&OPCODE_RETURN_TYPED_BUILTIN,                   \
-		&&OPCODE_RETURN_TYPED_ARRAY,                     \
-		&&OPCODE_RETURN_TYPED_DICTIONARY,                \
-		&&OPCODE_RETURN_TYPED_NATIVE,                    \
-		&&OPCODE_RETURN_TYPED_SCRIPT,                    \
-		&&OPCODE_ITERATE_BEGIN,                          \
-		&&OPCODE_ITERATE_BEGIN_INT,                      \
-		&&OPCODE_ITERATE_BEGIN_FLOAT,                    \
-		&&OPCODE_ITERATE_BEGIN_VECTOR2,                  \
-		&&OPCODE_ITERATE_BEGIN_VECTOR2I,                 \
-		&&OPCODE_ITERATE_BEGIN_VECTOR3,                  \
-		&&OPCODE_ITERATE_BEGIN_VECTOR3I,                 \
-		&&OPCODE_ITERATE_BEGIN_STRING,                   \
-		&&OPCODE_ITERATE_BEGIN_DICTIONARY,               \
-		&&OPCODE_ITERATE_BEGIN_ARRAY,                    \
-		&&OPCODE_ITERATE_BEGIN_PACKED_BYTE_ARRAY,        \
-		&&OPCODE_ITERATE_BEGIN_PACKED_INT32_ARRAY,       \
-		&&OPCODE_ITERATE_BEGIN_PACKED_INT64_ARRAY,       \
-		&&OPCODE_ITERATE_BEGIN_PACKED_FLOAT32_ARRAY,     \
-		&&OPCODE_ITERATE_BEGIN_PACKED_FLOAT64_ARRAY,     \
-		&&OPCODE_ITERATE_BEGIN_PACKED_STRING_ARRAY,      \
-		&&OPCODE_ITERATE_BEGIN_PACKED_VECTOR2_ARRAY,     \
-		&&OPCODE_ITERATE_BEGIN_PACKED_VECTOR3_ARRAY,     \
-		&&OPCODE_ITERATE_BEGIN_PACKED_COLOR_ARRAY,       \
-		&&OPCODE_ITERATE_BEGIN_PACKED_VECTOR4_ARRAY,     \
-		&&OPCODE_ITERATE_BEGIN_OBJECT,                   \
-		&&OPCODE_ITERATE,                                \
-		&&OPCODE_ITERATE_INT,                            \
-		&&OPCODE_ITERATE_FLOAT,                          \
-		&&OPCODE_ITERATE_VECTOR2,                        \
-		&&OPCODE_ITERATE_VECTOR2I,                       \
-		&&OPCODE_ITERATE_VECTOR3,                        \
-		&&OPCODE_ITERATE_VECTOR3I,                       \
-		&&OPCODE_ITERATE_STRING,                         \
-		&&OPCODE_ITERATE_DICTIONARY,                     \
-		&&OPCODE_ITERATE_ARRAY,                          \
-		&&OPCODE_ITERATE_PACKED_BYTE_ARRAY,              \
-		&&OPCODE_ITERATE_PACKED_INT32_ARRAY,             \
-		&&OPCODE_ITERATE_PACKED_INT64_ARRAY,             \
-		&&OPCODE_ITERATE_PACKED_FLOAT32_ARRAY,           \
-		&&OPCODE_ITERATE_PACKED_FLOAT64_ARRAY,           \
-		&&OPCODE_ITERATE_PACKED_STRING_ARRAY,            \
-		&&OPCODE_ITERATE_PACKED_VECTOR2_ARRAY,           \
-		&&OPCODE_ITERATE_PACKED_VECTOR3_ARRAY,           \
-		&&OPCODE_ITERATE_PACKED_COLOR_ARRAY,             \
-		&&OPCODE_ITERATE_PACKED_VECTOR4_ARRAY,           \
-		&&OPCODE_ITERATE_OBJECT,                         \
-		&&OPCODE_STORE_GLOBAL,                           \
-		&&OPCODE_STORE_NAMED_GLOBAL,                     \
-		&&OPCODE_TYPE_ADJUST_BOOL,                       \
-		&&OPCODE_TYPE_ADJUST_INT,                        \
-		&&OPCODE_TYPE_ADJUST_FLOAT,                      \
-		&&OPCODE_TYPE_ADJUST_STRING,                     \
-		&&OPCODE_TYPE_ADJUST_VECTOR2,                    \
-		&&OPCODE_TYPE_ADJUST_VECTOR2I,                   \
-		&&OPCODE_TYPE_ADJUST_RECT2,                      \
-		&&OPCODE_TYPE_ADJUST_RECT2I,                     \
-		&&OPCODE_TYPE_ADJUST_VECTOR3,                    \
-		&&OPCODE_TYPE_ADJUST_VECTOR3I,                   \
-		&&OPCODE_TYPE_ADJUST_TRANSFORM2D,                \
-		&&OPCODE_TYPE_ADJUST_VECTOR4,                    \
-		&&OPCODE_TYPE_ADJUST_VECTOR4I,                   \
-		&&OPCODE_TYPE_ADJUST_PLANE,                      \
-		&&OPCODE_TYPE_ADJUST_QUATERNION,                 \
-		&&OPCODE_TYPE_ADJUST_AABB,                       \
-		&&OPCODE_TYPE_ADJUST_BASIS,                      \
-		&&OPCODE_TYPE_ADJUST_TRANSFORM3D,                \
-		&&OPCODE_TYPE_ADJUST_PROJECTION,                 \
-		&&OPCODE_TYPE_ADJUST_COLOR,                      \
-		&&OPCODE_TYPE_ADJUST_STRING_NAME,                \
-		&&OPCODE_TYPE_ADJUST_NODE_PATH,                  \
-		&&OPCODE_TYPE_ADJUST_RID,                        \
-		&&OPCODE_TYPE_ADJUST_OBJECT,                     \
-		&&OPCODE_TYPE_ADJUST_CALLABLE,                   \
-		&&OPCODE_TYPE_ADJUST_SIGNAL,                     \
-		&&OPCODE_TYPE_ADJUST_DICTIONARY,                 \
-		&&OPCODE_TYPE_ADJUST_ARRAY,                      \
-		&&OPCODE_TYPE_ADJUST_PACKED_BYTE_ARRAY,          \
-		&&OPCODE_TYPE_ADJUST_PACKED_INT32_ARRAY,         \
-		&&OPCODE_TYPE_ADJUST_PACKED_INT64_ARRAY,         \
-		&&OPCODE_TYPE_ADJUST_PACKED_FLOAT32_ARRAY,       \
-		&&OPCODE_TYPE_ADJUST_PACKED_FLOAT64_ARRAY,       \
-		&&OPCODE_TYPE_ADJUST_PACKED_STRING_ARRAY,        \
-		&&OPCODE_TYPE_ADJUST_PACKED_VECTOR2_ARRAY,       \
-		&&OPCODE_TYPE_ADJUST_PACKED_VECTOR3_ARRAY,       \
-		&&OPCODE_TYPE_ADJUST_PACKED_COLOR_ARRAY,         \
-		&&OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY,       \
-		&&OPCODE_ASSERT,                                 \
-		&&OPCODE_BREAKPOINT,                             \
-		&&OPCODE_LINE,                                   \
-		&&OPCODE_END                                     \
-	};                                                   \
+#define OPCODES_TABLE                                      \
+	static const void *switch_table_ops[] = {              \
+		&&OPCODE_OPERATOR,                                 \
+		&&OPCODE_OPERATOR_VALIDATED,                       \
+		&&OPCODE_OPERATOR_ADD_INT,                         \
+		&&OPCODE_OPERATOR_SUBTRACT_INT,                    \
+		&&OPCODE_OPERATOR_MULTIPLY_INT,                    \
+		&&OPCODE_OPERATOR_EQUAL_INT,                       \
+		&&OPCODE_OPERATOR_NOT_EQUAL_INT,                   \
+		&&OPCODE_OPERATOR_LESS_INT,                        \
+		&&OPCODE_OPERATOR_LESS_EQUAL_INT,                  \
+		&&OPCODE_OPERATOR_GREATER_INT,                     \
+		&&OPCODE_OPERATOR_GREATER_EQUAL_INT,               \
+		&&OPCODE_OPERATOR_ADD_FLOAT,                       \
+		&&OPCODE_OPERATOR_SUBTRACT_FLOAT,                  \
+		&&OPCODE_OPERATOR_MULTIPLY_FLOAT,                  \
+		&&OPCODE_OPERATOR_DIVIDE_FLOAT,                    \
+		&&OPCODE_OPERATOR_EQUAL_FLOAT,                     \
+		&&OPCODE_OPERATOR_NOT_EQUAL_FLOAT,                 \
+		&&OPCODE_OPERATOR_LESS_FLOAT,                      \
+		&&OPCODE_OPERATOR_LESS_EQUAL_FLOAT,                \
+		&&OPCODE_OPERATOR_GREATER_FLOAT,                   \
+		&&OPCODE_OPERATOR_GREATER_EQUAL_FLOAT,             \
+		&&OPCODE_OPERATOR_ADD_VECTOR2,                     \
+		&&OPCODE_OPERATOR_SUBTRACT_VECTOR2,                \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR2,                \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR2_FLOAT,          \
+		&&OPCODE_OPERATOR_DIVIDE_VECTOR2_FLOAT,            \
+		&&OPCODE_OPERATOR_ADD_VECTOR3,                     \
+		&&OPCODE_OPERATOR_SUBTRACT_VECTOR3,                \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR3,                \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT,          \
+		&&OPCODE_OPERATOR_DIVIDE_VECTOR3_FLOAT,            \
+		&&OPCODE_TYPE_TEST_BUILTIN,                        \
+		&&OPCODE_TYPE_TEST_ARRAY,                          \
+		&&OPCODE_TYPE_TEST_DICTIONARY,                     \
+		&&OPCODE_TYPE_TEST_NATIVE,                         \
+		&&OPCODE_TYPE_TEST_SCRIPT,                         \
+		&&OPCODE_SET_KEYED,                                \
+		&&OPCODE_SET_KEYED_VALIDATED,                      \
+		&&OPCODE_SET_INDEXED_VALIDATED,                    \
+		&&OPCODE_SET_TYPED_ARRAY_INDEXED,                  \
+		&&OPCODE_GET_KEYED,                                \
+		&&OPCODE_GET_KEYED_VALIDATED,                      \
+		&&OPCODE_GET_INDEXED_VALIDATED,                    \
+		&&OPCODE_SET_NAMED,                                \
+		&&OPCODE_SET_NAMED_VALIDATED,                      \
+		&&OPCODE_GET_NAMED,                                \
+		&&OPCODE_GET_NAMED_VALIDATED,                      \
+		&&OPCODE_SET_MEMBER,                               \
+		&&OPCODE_GET_MEMBER,                               \
+		&&OPCODE_SET_STATIC_VARIABLE,                      \
+		&&OPCODE_GET_STATIC_VARIABLE,                      \
+		&&OPCODE_ASSIGN,                                   \
+		&&OPCODE_ASSIGN_NULL,                              \
+		&&OPCODE_ASSIGN_TRUE,                              \
+		&&OPCODE_ASSIGN_FALSE,                             \
+		&&OPCODE_ASSIGN_TYPED_BUILTIN,                     \
+		&&OPCODE_ASSIGN_TYPED_ARRAY,                       \
+		&&OPCODE_ASSIGN_TYPED_DICTIONARY,                  \
+		&&OPCODE_ASSIGN_TYPED_NATIVE,                      \
+		&&OPCODE_ASSIGN_TYPED_SCRIPT,                      \
+		&&OPCODE_CAST_TO_BUILTIN,                          \
+		&&OPCODE_CAST_TO_NATIVE,                           \
+		&&OPCODE_CAST_TO_SCRIPT,                           \
+		&&OPCODE_CONSTRUCT,                                \
+		&&OPCODE_CONSTRUCT_VALIDATED,                      \
+		&&OPCODE_CONSTRUCT_ARRAY,                          \
+		&&OPCODE_CONSTRUCT_TYPED_ARRAY,                    \
+		&&OPCODE_CONSTRUCT_DICTIONARY,                     \
+		&&OPCODE_CONSTRUCT_TYPED_DICTIONARY,               \
+		&&OPCODE_CALL,                                     \
+		&&OPCODE_CALL_RETURN,                              \
+		&&OPCODE_CALL_ASYNC,                               \
+		&&OPCODE_CALL_UTILITY,                             \
+		&&OPCODE_CALL_UTILITY_VALIDATED,                   \
+		&&OPCODE_CALL_GDSCRIPT_UTILITY,                    \
+		&&OPCODE_CALL_BUILTIN_TYPE_VALIDATED,              \
+		&&OPCODE_CALL_SELF_BASE,                           \
+		&&OPCODE_CALL_METHOD_BIND,                         \
+		&&OPCODE_CALL_METHOD_BIND_RET,                     \
+		&&OPCODE_CALL_BUILTIN_STATIC,                      \
+		&&OPCODE_CALL_NATIVE_STATIC,                       \
+		&&OPCODE_CALL_NATIVE_STATIC_VALIDATED_RETURN,      \
+		&&OPCODE_CALL_NATIVE_STATIC_VALIDATED_NO_RETURN,   \
+		&&OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN,        \
+		&&OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN,     \
+		&&OPCODE_AWAIT,                                    \
+		&&OPCODE_AWAIT_RESUME,                             \
+		&&OPCODE_CREATE_LAMBDA,                            \
+		&&OPCODE_CREATE_SELF_LAMBDA,                       \
+		&&OPCODE_JUMP,                                     \
+		&&OPCODE_JUMP_IF,                                  \
+		&&OPCODE_JUMP_IF_NOT,                              \
+		&&OPCODE_JUMP_TO_DEF_ARGUMENT,                     \
+		&&OPCODE_JUMP_IF_SHARED,                           \
+		&&OPCODE_RETURN,                                   \
+		&&OPCODE_RETURN_TYPED_BUILTIN,                     \
+		&&OPCODE_RETURN_TYPED_ARRAY,                       \
+		&&OPCODE_RETURN_TYPED_DICTIONARY,                  \
+		&&OPCODE_RETURN_TYPED_NATIVE,                      \
+		&&OPCODE_RETURN_TYPED_SCRIPT,                      \
+		&&OPCODE_ITERATE_BEGIN,                            \
+		&&OPCODE_ITERATE_BEGIN_INT,                        \
+		&&OPCODE_ITERATE_BEGIN_FLOAT,                      \
+		&&OPCODE_ITERATE_BEGIN_VECTOR2,                    \
+		&&OPCODE_ITERATE_BEGIN_VECTOR2I,                   \
+		&&OPCODE_ITERATE_BEGIN_VECTOR3,                    \
+		&&OPCODE_ITERATE_BEGIN_VECTOR3I,                   \
+		&&OPCODE_ITERATE_BEGIN_STRING,                     \
+		&&OPCODE_ITERATE_BEGIN_DICTIONARY,                 \
+		&&OPCODE_ITERATE_BEGIN_ARRAY,                      \
+		&&OPCODE_ITERATE_BEGIN_PACKED_BYTE_ARRAY,          \
+		&&OPCODE_ITERATE_BEGIN_PACKED_INT32_ARRAY,         \
+		&&OPCODE_ITERATE_BEGIN_PACKED_INT64_ARRAY,         \
+		&&OPCODE_ITERATE_BEGIN_PACKED_FLOAT32_ARRAY,       \
+		&&OPCODE_ITERATE_BEGIN_PACKED_FLOAT64_ARRAY,       \
+		&&OPCODE_ITERATE_BEGIN_PACKED_STRING_ARRAY,        \
+		&&OPCODE_ITERATE_BEGIN_PACKED_VECTOR2_ARRAY,       \
+		&&OPCODE_ITERATE_BEGIN_PACKED_VECTOR3_ARRAY,       \
+		&&OPCODE_ITERATE_BEGIN_PACKED_COLOR_ARRAY,         \
+		&&OPCODE_ITERATE_BEGIN_PACKED_VECTOR4_ARRAY,       \
+		&&OPCODE_ITERATE_BEGIN_OBJECT,                     \
+		&&OPCODE_ITERATE,                                  \
+		&&OPCODE_ITERATE_INT,                              \
+		&&OPCODE_ITERATE_FLOAT,                            \
+		&&OPCODE_ITERATE_VECTOR2,                          \
+		&&OPCODE_ITERATE_VECTOR2I,                         \
+		&&OPCODE_ITERATE_VECTOR3,                          \
+		&&OPCODE_ITERATE_VECTOR3I,                         \
+		&&OPCODE_ITERATE_STRING,                           \
+		&&OPCODE_ITERATE_DICTIONARY,                       \
+		&&OPCODE_ITERATE_ARRAY,                            \
+		&&OPCODE_ITERATE_PACKED_BYTE_ARRAY,                \
+		&&OPCODE_ITERATE_PACKED_INT32_ARRAY,               \
+		&&OPCODE_ITERATE_PACKED_INT64_ARRAY,               \
+		&&OPCODE_ITERATE_PACKED_FLOAT32_ARRAY,             \
+		&&OPCODE_ITERATE_PACKED_FLOAT64_ARRAY,             \
+		&&OPCODE_ITERATE_PACKED_STRING_ARRAY,              \
+		&&OPCODE_ITERATE_PACKED_VECTOR2_ARRAY,             \
+		&&OPCODE_ITERATE_PACKED_VECTOR3_ARRAY,             \
+		&&OPCODE_ITERATE_PACKED_COLOR_ARRAY,               \
+		&&OPCODE_ITERATE_PACKED_VECTOR4_ARRAY,             \
+		&&OPCODE_ITERATE_OBJECT,                           \
+		&&OPCODE_STORE_GLOBAL,                             \
+		&&OPCODE_STORE_NAMED_GLOBAL,                       \
+		&&OPCODE_TYPE_ADJUST_BOOL,                         \
+		&&OPCODE_TYPE_ADJUST_INT,                          \
+		&&OPCODE_TYPE_ADJUST_FLOAT,                        \
+		&&OPCODE_TYPE_ADJUST_STRING,                       \
+		&&OPCODE_TYPE_ADJUST_VECTOR2,                      \
+		&&OPCODE_TYPE_ADJUST_VECTOR2I,                     \
+		&&OPCODE_TYPE_ADJUST_RECT2,                        \
+		&&OPCODE_TYPE_ADJUST_RECT2I,                       \
+		&&OPCODE_TYPE_ADJUST_VECTOR3,                      \
+		&&OPCODE_TYPE_ADJUST_VECTOR3I,                     \
+		&&OPCODE_TYPE_ADJUST_TRANSFORM2D,                  \
+		&&OPCODE_TYPE_ADJUST_VECTOR4,                      \
+		&&OPCODE_TYPE_ADJUST_VECTOR4I,                     \
+		&&OPCODE_TYPE_ADJUST_PLANE,                        \
+		&&OPCODE_TYPE_ADJUST_QUATERNION,                   \
+		&&OPCODE_TYPE_ADJUST_AABB,                         \
+		&&OPCODE_TYPE_ADJUST_BASIS,                        \
+		&&OPCODE_TYPE_ADJUST_TRANSFORM3D,                  \
+		&&OPCODE_TYPE_ADJUST_PROJECTION,                   \
+		&&OPCODE_TYPE_ADJUST_COLOR,                        \
+		&&OPCODE_TYPE_ADJUST_STRING_NAME,                  \
+		&&OPCODE_TYPE_ADJUST_NODE_PATH,                    \
+		&&OPCODE_TYPE_ADJUST_RID,                          \
+		&&OPCODE_TYPE_ADJUST_OBJECT,                       \
+		&&OPCODE_TYPE_ADJUST_CALLABLE,                     \
+		&&OPCODE_TYPE_ADJUST_SIGNAL,                       \
+		&&OPCODE_TYPE_ADJUST_DICTIONARY,                   \
+		&&OPCODE_TYPE_ADJUST_ARRAY,                        \
+		&&OPCODE_TYPE_ADJUST_PACKED_BYTE_ARRAY,            \
+		&&OPCODE_TYPE_ADJUST_PACKED_INT32_ARRAY,           \
+		&&OPCODE_TYPE_ADJUST_PACKED_INT64_ARRAY,           \
+		&&OPCODE_TYPE_ADJUST_PACKED_FLOAT32_ARRAY,         \
+		&&OPCODE_TYPE_ADJUST_PACKED_FLOAT64_ARRAY,         \
+		&&OPCODE_TYPE_ADJUST_PACKED_STRING_ARRAY,          \
+		&&OPCODE_TYPE_ADJUST_PACKED_VECTOR2_ARRAY,         \
+		&&OPCODE_TYPE_ADJUST_PACKED_VECTOR3_ARRAY,         \
+		&&OPCODE_TYPE_ADJUST_PACKED_COLOR_ARRAY,           \
+		&&OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY,         \
+		&&OPCODE_OPERATOR_VALIDATED_ASSIGN,                \
+		&&OPCODE_OPERATOR_VALIDATED_JUMP_IF,               \
+		&&OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,           \
+		&&OPCODE_OPERATOR_VALIDATED_SET_INDEXED_VALIDATED, \
+		&&OPCODE_GET_INDEXED_VALIDATED_OPERATOR_VALIDATED, \
+		&&OPCODE_ASSERT,                                   \
+		&&OPCODE_BREAKPOINT,                               \
+		&&OPCODE_LINE,                                     \
+		&&OPCODE_END                                       \
+	};                                                     \
 	static_assert((sizeof(switch_table_ops) / sizeof(switch_table_ops[0]) == (OPCODE_END + 1)), "Opcodes in jump table aren't the same as opcodes in enum.");
 
 #define OPCODE(m_op) \
@@ -506,6 +786,31 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		return _get_default_variant_for_data_type(return_type);
 	}
 
+	GDScriptSampler::Frame sampler_frame;
+	if (unlikely(GDScriptSampler::is_active())) {
+		sampler_frame.push(_get_sampler_symbol());
+	}
+
+	if (native_function && !p_state && p_argcount == _argument_count) {
+		bool exact_types = true;
+		for (int i = 0; i < p_argcount; i++) {
+			if (!argument_types[i].is_type(*p_args[i], false)) {
+				exact_types = false;
+				break;
+			}
+		}
+#ifdef DEBUG_ENABLED
+		// Keep breakpoints and stepping working while a debugger is attached.
+		exact_types = exact_types && !EngineDebugger::is_active();
+#endif
+		if (exact_types) {
+			Variant native_ret;
+			native_function(p_args, &native_ret);
+			call_depth--;
+			return native_ret;
+		}
+	}
+
 	Variant retvalue;
 	Variant *stack = nullptr;
 	Variant **instruction_args = nullptr;
@@ -518,11 +823,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 	if (p_state) {
 		//use existing (supplied) state (awaited)
-		stack = (Variant *)p_state->stack.ptr();
-		instruction_args = (Variant **)&p_state->stack.ptr()[sizeof(Variant) * p_state->stack_size]; //ptr() to avoid bounds check
+		stack = (Variant *)p_state->stack;
+		instruction_args = (Variant **)&p_state->stack[sizeof(Variant) * p_state->stack_size];
 		line = p_state->line;
 		ip = p_state->ip;
-		alloca_size = p_state->stack.size();
+		alloca_size = p_state->alloca_size;
 		script = p_state->script;
 		p_instance = p_state->instance;
 		defarg = p_state->defarg;
@@ -816,6 +1121,49 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+// Same operands and requirements as OPCODE_OPERATOR_VALIDATED: the types of the operands are
+// known, and the destination already holds a value of the result type.
+#define OPCODE_OPERATOR_TYPED(m_name, m_left_type, m_right_type, m_result_type, m_op)                                                              \
+	OPCODE(OPCODE_OPERATOR_##m_name) {                                                                                                             \
+		CHECK_SPACE(5);                                                                                                                            \
+		GET_VARIANT_PTR(a, 0);                                                                                                                     \
+		GET_VARIANT_PTR(b, 1);                                                                                                                     \
+		GET_VARIANT_PTR(dst, 2);                                                                                                                   \
+		*VariantInternal::OP_GET_##m_result_type(dst) = *VariantInternal::OP_GET_##m_left_type(a) m_op *VariantInternal::OP_GET_##m_right_type(b); \
+		ip += 5;                                                                                                                                   \
+	}                                                                                                                                              \
+	DISPATCH_OPCODE
+
+			OPCODE_OPERATOR_TYPED(ADD_INT, INT, INT, INT, +);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_INT, INT, INT, INT, -);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_INT, INT, INT, INT, *);
+			OPCODE_OPERATOR_TYPED(EQUAL_INT, INT, INT, BOOL, ==);
+			OPCODE_OPERATOR_TYPED(NOT_EQUAL_INT, INT, INT, BOOL, !=);
+			OPCODE_OPERATOR_TYPED(LESS_INT, INT, INT, BOOL, <);
+			OPCODE_OPERATOR_TYPED(LESS_EQUAL_INT, INT, INT, BOOL, <=);
+			OPCODE_OPERATOR_TYPED(GREATER_INT, INT, INT, BOOL, >);
+			OPCODE_OPERATOR_TYPED(GREATER_EQUAL_INT, INT, INT, BOOL, >=);
+			OPCODE_OPERATOR_TYPED(ADD_FLOAT, FLOAT, FLOAT, FLOAT, +);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_FLOAT, FLOAT, FLOAT, FLOAT, -);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_FLOAT, FLOAT, FLOAT, FLOAT, *);
+			OPCODE_OPERATOR_TYPED(DIVIDE_FLOAT, FLOAT, FLOAT, FLOAT, /);
+			OPCODE_OPERATOR_TYPED(EQUAL_FLOAT, FLOAT, FLOAT, BOOL, ==);
+			OPCODE_OPERATOR_TYPED(NOT_EQUAL_FLOAT, FLOAT, FLOAT, BOOL, !=);
+			OPCODE_OPERATOR_TYPED(LESS_FLOAT, FLOAT, FLOAT, BOOL, <);
+			OPCODE_OPERATOR_TYPED(LESS_EQUAL_FLOAT, FLOAT, FLOAT, BOOL, <=);
+			OPCODE_OPERATOR_TYPED(GREATER_FLOAT, FLOAT, FLOAT, BOOL, >);
+			OPCODE_OPERATOR_TYPED(GREATER_EQUAL_FLOAT, FLOAT, FLOAT, BOOL, >=);
+			OPCODE_OPERATOR_TYPED(ADD_VECTOR2, VECTOR2, VECTOR2, VECTOR2, +);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_VECTOR2, VECTOR2, VECTOR2, VECTOR2, -);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_VECTOR2, VECTOR2, VECTOR2, VECTOR2, *);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_VECTOR2_FLOAT, VECTOR2, FLOAT, VECTOR2, *);
+			OPCODE_OPERATOR_TYPED(DIVIDE_VECTOR2_FLOAT, VECTOR2, FLOAT, VECTOR2, /);
+			OPCODE_OPERATOR_TYPED(ADD_VECTOR3, VECTOR3, VECTOR3, VECTOR3, +);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_VECTOR3, VECTOR3, VECTOR3, VECTOR3, -);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_VECTOR3, VECTOR3, VECTOR3, VECTOR3, *);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_VECTOR3_FLOAT, VECTOR3, FLOAT, VECTOR3, *);
+			OPCODE_OPERATOR_TYPED(DIVIDE_VECTOR3_FLOAT, VECTOR3, FLOAT, VECTOR3, /);
+
 			OPCODE(OPCODE_TYPE_TEST_BUILTIN) {
 				CHECK_SPACE(4);
 
@@ -1055,6 +1403,47 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_SET_TYPED_ARRAY_INDEXED) {
+				CHECK_SPACE(4);
+
+				GET_VARIANT_PTR(dst, 0);
+				GET_VARIANT_PTR(index, 1);
+				GET_VARIANT_PTR(value, 2);
+
+				Variant::Type element_type = (Variant::Type)_code_ptr[ip + 4];
+				GD_ERR_BREAK(element_type <= Variant::NIL || element_type >= Variant::VARIANT_MAX);
+
+				Array *array = VariantInternal::get_array(dst);
+				int64_t size = array->size();
+				int64_t int_index = *VariantInternal::get_int(index);
+				if (int_index < 0) {
+					int_index += size;
+				}
+
+				bool oob = int_index < 0 || int_index >= size || array->is_read_only();
+				if (likely(!oob)) {
+					if (likely(array->get_typed_builtin() == (uint32_t)element_type && value->get_type() == element_type)) {
+						// The slot already holds this type, so this is a plain payload copy with nothing to validate.
+						(*array)[int_index] = *value;
+					} else {
+						array->set(int_index, *value);
+					}
+				}
+
+#ifdef DEBUG_ENABLED
+				if (oob) {
+					if (array->is_read_only()) {
+						err_text = "Invalid assignment on read-only value (on base: '" + _get_var_type(dst) + "').";
+					} else {
+						err_text = "Out of bounds set index '" + itos(*VariantInternal::get_int(index)) + "' (on base: '" + _get_var_type(dst) + "')";
+					}
+					OPCODE_BREAK;
+				}
+#endif
+				ip += 5;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_GET_KEYED) {
 				CHECK_SPACE(3);
 
@@ -1160,7 +1549,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_SET_NAMED) {
-				CHECK_SPACE(3);
+				CHECK_SPACE(4);
 
 				GET_VARIANT_PTR(dst, 0);
 				GET_VARIANT_PTR(value, 1);
@@ -1170,8 +1559,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				int cache_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_caches_count);
+
 				bool valid;
-				dst->set_named(*index, *value, valid);
+				if (!_set_named_cached(&_inline_caches_ptr[cache_idx], dst, *index, *value, valid)) {
+					dst->set_named(*index, *value, valid);
+				}
 
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -1192,7 +1586,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					OPCODE_BREAK;
 				}
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1212,7 +1606,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_GET_NAMED) {
-				CHECK_SPACE(4);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(src, 0);
 				GET_VARIANT_PTR(dst, 1);
@@ -1222,13 +1616,23 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				int cache_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_caches_count);
+				GDScriptInlineCache *cache = &_inline_caches_ptr[cache_idx];
+
 				bool valid;
 #ifdef DEBUG_ENABLED
 				//allow better error message in cases where src and dst are the same stack position
-				Variant ret = src->get_named(*index, valid);
+				Variant ret;
+				valid = _get_named_cached(cache, src, *index, ret);
+				if (!valid) {
+					ret = src->get_named(*index, valid);
+				}
 
 #else
-				*dst = src->get_named(*index, valid);
+				if (!_get_named_cached(cache, src, *index, *dst)) {
+					*dst = src->get_named(*index, valid);
+				}
 #endif
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -1237,7 +1641,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 				*dst = ret;
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1856,7 +2260,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				bool call_async = (_code_ptr[ip]) == OPCODE_CALL_ASYNC;
 #endif
 				LOAD_INSTRUCTION_ARGS
-				CHECK_SPACE(3 + instr_arg_count);
+				CHECK_SPACE(4 + instr_arg_count);
 
 				ip += instr_arg_count;
 
@@ -1867,6 +2271,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(methodname_idx < 0 || methodname_idx >= _global_names_count);
 				const StringName *methodname = &_global_names_ptr[methodname_idx];
 
+				int cache_idx = _code_ptr[ip + 3];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_caches_count);
+				GDScriptInlineCache *cache = &_inline_caches_ptr[cache_idx];
+
 				GET_INSTRUCTION_ARG(base, argc);
 				Variant **argptrs = instruction_args;
 
@@ -1885,7 +2293,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				Callable::CallError err;
 				if (call_ret) {
 					GET_INSTRUCTION_ARG(ret, argc + 1);
-					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					if (!_call_cached(cache, base, *methodname, (const Variant **)argptrs, argc, temp_ret, err)) {
+						base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					}
 					*ret = temp_ret;
 #ifdef DEBUG_ENABLED
 					if (ret->get_type() == Variant::NIL) {
@@ -1915,7 +2325,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					}
 #endif
 				} else {
-					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					if (!_call_cached(cache, base, *methodname, (const Variant **)argptrs, argc, temp_ret, err)) {
+						base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					}
 				}
 #ifdef DEBUG_ENABLED
 
@@ -1965,7 +2377,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 #endif // DEBUG_ENABLED
 
-				ip += 3;
+				ip += 4;
 			}
 			DISPATCH_OPCODE;
 
@@ -2006,6 +2418,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 #endif
 
+				GDScriptSampler::NativeFrame native_frame(method);
 				Variant temp_ret;
 				Callable::CallError err;
 				if (call_ret) {
@@ -2111,6 +2524,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 #endif
 
+				GDScriptSampler::NativeFrame native_frame(method);
 				Callable::CallError err;
 				*ret = method->call(nullptr, argptrs, argc, err);
 
@@ -2153,6 +2567,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #endif
 
 				GET_INSTRUCTION_ARG(ret, argc);
+				GDScriptSampler::NativeFrame native_frame(method);
 				method->validated_call(nullptr, (const Variant **)argptrs, ret);
 
 #ifdef DEBUG_ENABLED
@@ -2189,6 +2604,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				GET_INSTRUCTION_ARG(ret, argc);
 				VariantInternal::initialize(ret, Variant::NIL);
+				GDScriptSampler::NativeFrame native_frame(method);
 				method->validated_call(nullptr, (const Variant **)argptrs, nullptr);
 
 #ifdef DEBUG_ENABLED
@@ -2241,6 +2657,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #endif
 
 				GET_INSTRUCTION_ARG(ret, argc + 1);
+				GDScriptSampler::NativeFrame native_frame(method);
 				method->validated_call(base_obj, (const Variant **)argptrs, ret);
 
 #ifdef DEBUG_ENABLED
@@ -2291,6 +2708,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				GET_INSTRUCTION_ARG(ret, argc + 1);
 				VariantInternal::initialize(ret, Variant::NIL);
+				GDScriptSampler::NativeFrame native_frame(method);
 				method->validated_call(base_obj, (const Variant **)argptrs, nullptr);
 
 #ifdef DEBUG_ENABLED
@@ -2531,11 +2949,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					Ref<GDScriptFunctionState> gdfs = memnew(GDScriptFunctionState);
 					gdfs->function = this;
 
-					gdfs->state.stack.resize(alloca_size);
+					gdfs->state.stack = GDScriptFramePool::alloc(alloca_size);
 
 					// First 3 stack addresses are special, so we just skip them here.
 					for (int i = 3; i < _stack_size; i++) {
-						memnew_placement(&gdfs->state.stack.write[sizeof(Variant) * i], Variant(stack[i]));
+						memnew_placement(&gdfs->state.stack[sizeof(Variant) * i], Variant(stack[i]));
 					}
 					gdfs->state.stack_size = _stack_size;
 					gdfs->state.alloca_size = alloca_size;
@@ -2561,7 +2979,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 					retvalue = gdfs;
 
-					Error err = sig.connect(Callable(gdfs.ptr(), "_signal_callback").bind(retvalue), Object::CONNECT_ONE_SHOT);
+					Error err = GDScriptFunctionState::await_signal(gdfs, sig);
 					if (err != OK) {
 						err_text = "Error connecting to signal: " + sig.get_name() + " during await.";
 						OPCODE_BREAK;
@@ -3731,6 +4149,174 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			OPCODE_TYPE_ADJUST(PACKED_COLOR_ARRAY, PackedColorArray);
 			OPCODE_TYPE_ADJUST(PACKED_VECTOR4_ARRAY, PackedVector4Array);
 
+			// Superinstructions. The first part is always at `ip`, the second part reads the
+			// operands of the untouched instruction that follows.
+
+			OPCODE(OPCODE_OPERATOR_VALIDATED_ASSIGN) {
+				CHECK_SPACE(8);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(op_dst, 2);
+
+				operator_func(a, b, op_dst);
+
+				GET_VARIANT_PTR(dst, 5);
+				GET_VARIANT_PTR(src, 6);
+
+				*dst = *src;
+
+				ip += 8;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_VALIDATED_JUMP_IF) {
+				CHECK_SPACE(8);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(op_dst, 2);
+
+				operator_func(a, b, op_dst);
+
+				GET_VARIANT_PTR(test, 5);
+
+				bool result = test->booleanize();
+
+				if (result) {
+					int to = _code_ptr[ip + 7];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 8;
+				}
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT) {
+				CHECK_SPACE(8);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(op_dst, 2);
+
+				operator_func(a, b, op_dst);
+
+				GET_VARIANT_PTR(test, 5);
+
+				bool result = test->booleanize();
+
+				if (!result) {
+					int to = _code_ptr[ip + 7];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 8;
+				}
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_VALIDATED_SET_INDEXED_VALIDATED) {
+				CHECK_SPACE(10);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(op_dst, 2);
+
+				operator_func(a, b, op_dst);
+
+				GET_VARIANT_PTR(dst, 5);
+				GET_VARIANT_PTR(index, 6);
+				GET_VARIANT_PTR(value, 7);
+
+				int index_setter = _code_ptr[ip + 9];
+				GD_ERR_BREAK(index_setter < 0 || index_setter >= _indexed_setters_count);
+				const Variant::ValidatedIndexedSetter setter = _indexed_setters_ptr[index_setter];
+
+				int64_t int_index = *VariantInternal::get_int(index);
+
+				bool oob;
+				setter(dst, int_index, value, &oob);
+
+#ifdef DEBUG_ENABLED
+				if (oob) {
+					if (dst->is_read_only()) {
+						err_text = "Invalid assignment on read-only value (on base: '" + _get_var_type(dst) + "').";
+					} else {
+						String v = index->operator String();
+						if (!v.is_empty()) {
+							v = "'" + v + "'";
+						} else {
+							v = "of type '" + _get_var_type(index) + "'";
+						}
+						err_text = "Out of bounds set index " + v + " (on base: '" + _get_var_type(dst) + "')";
+					}
+					OPCODE_BREAK;
+				}
+#endif
+				ip += 10;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_GET_INDEXED_VALIDATED_OPERATOR_VALIDATED) {
+				CHECK_SPACE(10);
+
+				GET_VARIANT_PTR(src, 0);
+				GET_VARIANT_PTR(index, 1);
+				GET_VARIANT_PTR(get_dst, 2);
+
+				int index_getter = _code_ptr[ip + 4];
+				GD_ERR_BREAK(index_getter < 0 || index_getter >= _indexed_getters_count);
+				const Variant::ValidatedIndexedGetter getter = _indexed_getters_ptr[index_getter];
+
+				int64_t int_index = *VariantInternal::get_int(index);
+
+				bool oob;
+				getter(src, int_index, get_dst, &oob);
+
+#ifdef DEBUG_ENABLED
+				if (oob) {
+					String v = index->operator String();
+					if (!v.is_empty()) {
+						v = "'" + v + "'";
+					} else {
+						v = "of type '" + _get_var_type(index) + "'";
+					}
+					err_text = "Out of bounds get index " + v + " (on base: '" + _get_var_type(src) + "')";
+					OPCODE_BREAK;
+				}
+#endif
+
+				int operator_idx = _code_ptr[ip + 9];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 5);
+				GET_VARIANT_PTR(b, 6);
+				GET_VARIANT_PTR(dst, 7);
+
+				operator_func(a, b, dst);
+
+				ip += 10;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_ASSERT) {
 				CHECK_SPACE(3);
 
@@ -38,6 +38,8 @@
 #include "gdscript_utility_functions.h"
 
 #ifdef TOOLS_ENABLED
+#include "gdscript_cpp_translator.h"
+
 #include "editor/gdscript_highlighter.h"
 #include "editor/gdscript_translation_parser_plugin.h"
 
@@ -85,7 +87,35 @@ class EditorExportGDScript : public EditorExportPlugin {
 	static constexpr int DEFAULT_SCRIPT_MODE = EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED;
 	int script_mode = DEFAULT_SCRIPT_MODE;
 
+	// Set when fully typed functions are also translated to a C++ module for the export template.
+	GDScriptCppTranslator *aot_translator = nullptr;
+	String aot_module_dir;
+
+	void _translate_ahead_of_time(const String &p_path, const String &p_source, uint32_t p_source_hash) {
+		GDScriptParser parser;
+		if (parser.parse(p_source, p_path, false) != OK) {
+			return;
+		}
+		GDScriptAnalyzer analyzer(&parser);
+		if (analyzer.analyze() != OK) {
+			return;
+		}
+		aot_translator->translate(p_path, p_source_hash, parser);
+	}
+
+	// Exports that abort skip _export_end(), so the next one frees the leftover.
+	void _free_aot_translator() {
+		if (aot_translator) {
+			memdelete(aot_translator);
+			aot_translator = nullptr;
+		}
+	}
+
 protected:
+	virtual void _get_export_options(const Ref<EditorExportPlatform> &p_export_platform, List<EditorExportPlatform::ExportOption> *r_options) const override {
+		r_options->push_back(EditorExportPlatform::ExportOption(PropertyInfo(Variant::STRING, "gdscript/aot_module_dir", PROPERTY_HINT_GLOBAL_DIR), ""));
+	}
+
 	virtual void _export_begin(const HashSet<String> &p_features, bool p_debug, const String &p_path, int p_flags) override {
 		script_mode = DEFAULT_SCRIPT_MODE;
 
@@ -93,10 +123,16 @@ protected:
 		if (preset.is_valid()) {
 			script_mode = preset->get_script_export_mode();
 		}
+
+		_free_aot_translator();
+		aot_module_dir = get_option("gdscript/aot_module_dir");
+		if (!aot_module_dir.is_empty()) {
+			aot_translator = memnew(GDScriptCppTranslator);
+		}
 	}
 
 	virtual void _export_file(const String &p_path, const String &p_type, const HashSet<String> &p_features) override {
-		if (p_path.get_extension() != "gd" || script_mode == EditorExportPreset::MODE_SCRIPT_TEXT) {
+		if (p_path.get_extension() != "gd" || (script_mode == EditorExportPreset::MODE_SCRIPT_TEXT && !aot_translator)) {
 			return;
 		}
 
@@ -107,6 +143,11 @@ protected:
 
 		String source;
 		source.parse_utf8(reinterpret_cast<const char *>(file.ptr()), file.size());
+		if (script_mode == EditorExportPreset::MODE_SCRIPT_TEXT) {
+			_translate_ahead_of_time(p_path, source, GDScriptAOT::hash_source(source));
+			return;
+		}
+
 		GDScriptTokenizerBuffer::CompressMode compress_mode = script_mode == EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED ? GDScriptTokenizerBuffer::COMPRESS_ZSTD : GDScriptTokenizerBuffer::COMPRESS_NONE;
 		file = GDScriptTokenizerBuffer::parse_code_string(source, compress_mode);
 		if (file.is_empty()) {
@@ -114,10 +155,29 @@ protected:
 		}
 
 		add_file(p_path.get_basename() + ".gdc", file, true);
+
+		if (aot_translator) {
+			// The exported game compiles the tokens, so that is what the functions are matched against.
+			_translate_ahead_of_time(p_path, source, GDScriptAOT::hash_source(file));
+		}
+	}
+
+	virtual void _export_end() override {
+		if (!aot_translator) {
+			return;
+		}
+		if (aot_translator->write_module(aot_module_dir) == OK) {
+			print_line(vformat(R"(GDScript: %d functions compiled ahead of time, build the export template with the module in "%s".)", aot_translator->get_translated_count(), aot_module_dir));
+		}
+		_free_aot_translator();
 	}
 
 public:
 	virtual String get_name() const override { return "GDScript"; }
+
+	~EditorExportGDScript() {
+		_free_aot_translator();
+	}
 };
 
 static void _editor_init() {
@@ -33,6 +33,7 @@
 #include "../gdscript.h"
 #include "../gdscript_analyzer.h"
 #include "../gdscript_compiler.h"
+#include "../gdscript_cpp_translator.h"
 #include "../gdscript_parser.h"
 #include "../gdscript_tokenizer_buffer.h"
 
@@ -142,6 +143,9 @@ GDScriptTestRunner::GDScriptTestRunner(const String &p_source_dir, bool p_init_l
 		source_dir += "/";
 	}
 
+	// Expected outputs come from parsing the source every time.
+	ProjectSettings::get_singleton()->set_setting("debug/gdscript/compilation_cache/enabled", false);
+
 	if (do_init_languages) {
 		init_language(p_source_dir);
 	}
@@ -252,6 +256,44 @@ bool GDScriptTestRunner::generate_outputs() {
 	return true;
 }
 
+bool GDScriptTestRunner::generate_aot_module(const String &p_module_dir) {
+	if (!make_tests()) {
+		print_line("Failed to collect the test scripts.");
+		return false;
+	}
+
+	if (!generate_class_index()) {
+		return false;
+	}
+
+	GDScriptCppTranslator translator;
+	int function_count = 0;
+	for (int i = 0; i < tests.size(); i++) {
+		const String &source_file = tests[i].get_source_file();
+		if (print_filenames) {
+			print_line(tests[i].get_source_relative_filepath());
+		}
+
+		// Same source string as `GDScript::load_source_code()`, so the hash matches at runtime.
+		const String source = FileAccess::get_file_as_string(source_file);
+		GDScriptParser parser;
+		if (parser.parse(source, source_file, false) != OK) {
+			continue;
+		}
+		GDScriptAnalyzer analyzer(&parser);
+		if (analyzer.analyze() != OK) {
+			continue;
+		}
+		function_count += translator.translate(source_file, GDScriptAOT::hash_source(source), parser).size();
+	}
+
+	if (translator.write_module(p_module_dir) != OK) {
+		return false;
+	}
+	print_line(vformat("Translated %d of %d functions into \"%s\".", translator.get_translated_count(), function_count, p_module_dir));
+	return true;
+}
+
 bool GDScriptTestRunner::make_tests_for_dir(const String &p_dir) {
 	Error err = OK;
 	Ref<DirAccess> dir(DirAccess::open(p_dir, &err));
@@ -424,6 +466,20 @@ void GDScriptTestRunner::handle_cmdline() {
 			int failed = completed ? 0 : -1;
 			exit(failed);
 		}
+		if (cmd == "--gdscript-generate-aot") {
+			ERR_FAIL_COND_MSG(!E->next(), "Missing the output module directory, e.g. `--gdscript-generate-aot ../aot_modules/gdscript_aot_tests`.");
+			const String module_dir = E->next()->get();
+			String path = "modules/gdscript/tests/scripts";
+			if (E->next()->next()) {
+				path = E->next()->next()->get();
+			}
+
+			GDScriptTestRunner runner(path, false, cmdline_args.find("--print-filenames") != nullptr);
+
+			bool completed = runner.generate_aot_module(module_dir);
+			int failed = completed ? 0 : -1;
+			exit(failed);
+		}
 	}
 }
 
@@ -130,6 +130,7 @@ public:
 	static void handle_cmdline();
 	int run_tests();
 	bool generate_outputs();
+	bool generate_aot_module(const String &p_module_dir);
 
 	GDScriptTestRunner(const String &p_source_dir, bool p_init_language, bool p_print_filenames = false, bool p_use_binary_tokens = false);
 	~GDScriptTestRunner();
@@ -33,6 +33,8 @@
 
 #include "gdscript_test_runner.h"
 
+#include "../gdscript_aot.h"
+
 #include "tests/test_macros.h"
 
 namespace GDScriptTests {
@@ -43,11 +45,27 @@ TEST_SUITE("[Modules][GDScript]") {
 	TEST_CASE("Script compilation and runtime") {
 		bool print_filenames = OS::get_singleton()->get_cmdline_args().find("--print-filenames") != nullptr;
 		bool use_binary_tokens = OS::get_singleton()->get_cmdline_args().find("--use-binary-tokens") != nullptr;
+		// Bytecode only, the pass below covers functions compiled ahead of time.
+		GDScriptAOT::set_enabled(false);
 		GDScriptTestRunner runner("modules/gdscript/tests/scripts", true, print_filenames, use_binary_tokens);
 		int fail_count = runner.run_tests();
+		GDScriptAOT::set_enabled(true);
 		INFO("Make sure `*.out` files have expected results.");
 		REQUIRE_MESSAGE(fail_count == 0, "All GDScript tests should pass.");
 	}
+
+	TEST_CASE("Script compilation and runtime with ahead-of-time compiled functions") {
+		// Needs a build with the module from `--gdscript-generate-aot <dir>` in `custom_modules`.
+		if (GDScriptAOT::get_function_count() == 0) {
+			MESSAGE("No ahead-of-time compiled functions in this build, skipping.");
+			return;
+		}
+		bool print_filenames = OS::get_singleton()->get_cmdline_args().find("--print-filenames") != nullptr;
+		GDScriptTestRunner runner("modules/gdscript/tests/scripts", true, print_filenames);
+		int fail_count = runner.run_tests();
+		INFO("Native and bytecode functions must give the output in the same `*.out` files.");
+		REQUIRE_MESSAGE(fail_count == 0, "All GDScript tests should pass with ahead-of-time compiled functions.");
+	}
 }
 
 TEST_CASE("[Modules][GDScript] Load source code dynamically and run it") {
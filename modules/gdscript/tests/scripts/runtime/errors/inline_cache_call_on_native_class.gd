@@ -0,0 +1,5 @@
+# Native class references only accept `new()` and static methods, even once a call site is cached.
+func test():
+	var N = Node
+	for i in 2:
+		print(N.get_class())
@@ -0,0 +1,31 @@
+signal step(value)
+
+var finished := 0
+
+func accumulate(limit):
+	var total = 0
+	for _i in limit:
+		total += await step
+	return total
+
+func report(limit):
+	var result = await accumulate(limit)
+	print("total: ", result)
+
+func wait_once(id):
+	var value = await step
+	finished += id * value
+
+func test():
+	report(3)
+	for i in range(1, 4):
+		step.emit(i)
+
+	for id in 100:
+		wait_once(id)
+	step.emit(2)
+	print("finished: ", finished)
+
+	# Nothing is waiting anymore.
+	step.emit(3)
+	print("finished: ", finished)
@@ -0,0 +1,99 @@
+# Calls and named accesses on untyped bases are cached per instruction, keyed on
+# the native class and script of the base. The same instruction must keep giving
+# the regular results when bases of different kinds go through it.
+
+class Base:
+	var value = 1
+	var number: int = 0
+	var doubled = 0:
+		set(new_value):
+			doubled = new_value * 2
+
+	func describe():
+		return "Base %d" % value
+
+class Derived extends Base:
+	func describe():
+		return "Derived %d" % value
+
+class Dynamic:
+	var stored = {}
+
+	func _get(property):
+		return stored.get(property, "missing")
+
+	func _set(property, new_value):
+		stored[property] = new_value
+		return true
+
+	func describe():
+		return "Dynamic"
+
+func describe(object):
+	return object.describe()
+
+func read(object, property):
+	match property:
+		&"value":
+			return object.value
+		&"number":
+			return object.number
+		&"doubled":
+			return object.doubled
+	return object.resource_name
+
+func write_value(object, new_value):
+	object.value = new_value
+
+func write_number(object, new_value):
+	object.number = new_value
+
+func write_doubled(object, new_value):
+	object.doubled = new_value
+
+func test():
+	var base = Base.new()
+	var derived = Derived.new()
+	derived.value = 2
+	var dynamic = Dynamic.new()
+
+	for i in 2:
+		for object in [base, derived, dynamic]:
+			print(describe(object))
+
+	for i in 2:
+		for object in [base, derived, dynamic]:
+			print(read(object, &"value"))
+
+	write_value(base, 10)
+	write_value(derived, 20)
+	write_value(dynamic, 30)
+	write_value(base, 11)
+	print(base.value, " ", derived.value, " ", dynamic.value)
+
+	# Typed members still convert, setters still run.
+	write_number(base, 3)
+	write_number(base, 4.5)
+	print(read(base, &"number"))
+	write_doubled(derived, 5)
+	write_doubled(derived, 6)
+	print(read(derived, &"doubled"))
+
+	# Native properties and methods, including indexed properties.
+	var resource = Resource.new()
+	var style = StyleBoxFlat.new()
+	for i in 2:
+		resource.resource_name = "resource %d" % i
+		print(read(resource, &"resource_name"))
+		style.corner_radius_top_left = i + 1
+		style.corner_radius_bottom_right = i + 2
+		print(style.corner_radius_top_left, " ", style.corner_radius_bottom_right)
+
+	# More receivers than a single instruction keeps.
+	var objects = [base, derived, dynamic, resource, style, RefCounted.new(), Node.new()]
+	for i in 2:
+		var names = []
+		for object in objects:
+			names.push_back(object.get_class())
+		print(names)
+	objects[-1].free()
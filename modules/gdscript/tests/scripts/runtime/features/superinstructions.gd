@@ -0,0 +1,49 @@
+# Instruction pairs that the bytecode optimizer fuses, and jumps it threads.
+
+func scale(values: PackedFloat64Array, k: float) -> PackedFloat64Array:
+	var result := PackedFloat64Array()
+	result.resize(values.size())
+	for i in range(values.size()):
+		result[i] = values[i] * k
+	return result
+
+func count_below(values: Array[int], limit: int) -> int:
+	var count := 0
+	var i := 0
+	while i < values.size():
+		if values[i] < limit:
+			count += 1
+		i += 1
+	return count
+
+func classify(n: int) -> String:
+	var label := ""
+	for i in n:
+		if i % 3 == 0:
+			label += "a"
+		elif i % 3 == 1:
+			label += "b"
+		else:
+			label += "c"
+	return label
+
+func test():
+	print(scale(PackedFloat64Array([1.0, 2.5, -4.0]), 2.0))
+	print(count_below([5, 1, 8, 3, 9, 2], 4))
+	print(classify(7))
+
+	var a := 3
+	var b := 4
+	var c := a * b
+	print(c)
+	var flag := a > b
+	print(flag)
+
+	var total := 0
+	var j := 10
+	while j > 0:
+		j -= 3
+		if j == 4:
+			continue
+		total += j
+	print(total)
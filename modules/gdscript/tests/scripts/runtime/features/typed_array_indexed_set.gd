@@ -0,0 +1,29 @@
+func test():
+	var ints: Array[int] = []
+	ints.resize(4)
+	for i in ints.size():
+		ints[i] = i * 10
+	ints[-1] = -1
+	print(ints)
+
+	var vectors: Array[Vector3] = [Vector3.ZERO, Vector3.ZERO]
+	var v := Vector3(1, 2, 3)
+	vectors[1] = v
+	v.x = 5.0
+	print(vectors)
+
+	var floats: Array[float] = [0.0, 0.0]
+	floats[0] = 2
+	var untyped_value: Variant = 3
+	floats[1] = untyped_value
+	print(floats)
+	print(typeof(floats[0]) == TYPE_FLOAT and typeof(floats[1]) == TYPE_FLOAT)
+
+	var names: Array[StringName] = [&"a"]
+	var name_string := "b"
+	names[0] = name_string
+	print(names[0] == &"b", " ", typeof(names[0]) == TYPE_STRING_NAME)
+
+	var untyped: Array = [1, "two"]
+	untyped[1] = 2.5
+	print(untyped)
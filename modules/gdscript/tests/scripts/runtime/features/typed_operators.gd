@@ -0,0 +1,30 @@
+# Operators on statically typed int, float and vector operands use opcodes
+# that compute the result inline, these must agree with the generic path.
+
+func test():
+	var i: int = 7
+	var j: int = -3
+	print(i + j, " ", i - j, " ", i * j)
+	print(i == j, " ", i != j, " ", i < j, " ", i <= j, " ", i > j, " ", i >= j)
+
+	var f: float = 2.5
+	var g: float = 0.5
+	print(f + g, " ", f - g, " ", f * g, " ", f / g)
+	print(f == g, " ", f != g, " ", f < g, " ", f <= g, " ", f > g, " ", f >= g)
+
+	var a := Vector2(1, 2)
+	var b := Vector2(3, -4)
+	print(a + b, " ", a - b, " ", a * b, " ", a * f, " ", a / g)
+
+	var c := Vector3(1, 2, 3)
+	var d := Vector3(-1, 0.5, 2)
+	print(c + d, " ", c - d, " ", c * d, " ", c * f, " ", c / g)
+
+	var total: int = 0
+	for k: int in 10:
+		total = total + k * k
+	print(total)
+
+	var untyped = 1
+	untyped = untyped + 0.5
+	print(untyped)
@@ -0,0 +1,204 @@
+/**************************************************************************/
+/*  test_bytecode_optimizer.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_BYTECODE_OPTIMIZER_H
+#define TEST_BYTECODE_OPTIMIZER_H
+
+#ifdef TOOLS_ENABLED
+
+#include "../gdscript.h"
+#include "../gdscript_byte_codegen.h"
+
+#include "core/os/os.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace GDScriptTests {
+
+// Kernels dominated by the instruction pairs fused by the optimizer.
+static const char *bytecode_optimizer_source = R"(
+extends RefCounted
+
+func scale(values: PackedFloat64Array, k: float) -> PackedFloat64Array:
+	for i in range(values.size()):
+		values[i] = values[i] * k
+	return values
+
+func count_below(values: PackedInt64Array, limit: int) -> int:
+	var count := 0
+	var i := 0
+	while i < values.size():
+		if values[i] < limit:
+			count += 1
+		i += 1
+	return count
+
+func polynomial(n: int) -> float:
+	var total := 0.0
+	for i in n:
+		var x := i * 0.001
+		var y := x * x - 2.0 * x + 1.0
+		if y > 0.5:
+			total += y
+		else:
+			total -= y
+	return total
+
+func threaded(n: int) -> int:
+	var total := 0
+	while total < n:
+		if total % 2 == 0:
+			total += 1
+		else:
+			total += 3
+	return total
+
+func run_scale(size: int, passes: int) -> float:
+	var values := PackedFloat64Array()
+	values.resize(size)
+	values.fill(1.0)
+	for i in passes:
+		values = scale(values, 1.0001)
+	return values[size - 1]
+
+func run_count_below(size: int, passes: int) -> int:
+	var values := PackedInt64Array()
+	values.resize(size)
+	for i in size:
+		values[i] = (i * 7919) % 1000
+	var count := 0
+	for i in passes:
+		count += count_below(values, 500)
+	return count
+
+func run_polynomial(size: int, passes: int) -> float:
+	var total := 0.0
+	for i in passes:
+		total += polynomial(size)
+	return total
+)";
+
+static Ref<GDScript> create_bytecode_optimizer_script(bool p_optimize) {
+	const bool was_enabled = GDScriptByteCodeGenerator::bytecode_optimization_enabled;
+	GDScriptByteCodeGenerator::bytecode_optimization_enabled = p_optimize;
+
+	Ref<GDScript> script;
+	script.instantiate();
+	script->set_source_code(bytecode_optimizer_source);
+	// A spurious `Condition "err" is true` message is printed, see "Load source code dynamically and run it".
+	ERR_PRINT_OFF;
+	const Error error = script->reload();
+	ERR_PRINT_ON;
+
+	GDScriptByteCodeGenerator::bytecode_optimization_enabled = was_enabled;
+	if (error != OK) {
+		return Ref<GDScript>();
+	}
+	return script;
+}
+
+static Ref<RefCounted> create_bytecode_optimizer_instance(bool p_optimize) {
+	Ref<GDScript> script = create_bytecode_optimizer_script(p_optimize);
+	if (script.is_null()) {
+		return Ref<RefCounted>();
+	}
+
+	Ref<RefCounted> instance = memnew(RefCounted);
+	instance->set_script(script);
+	return instance;
+}
+
+TEST_CASE("[Modules][GDScript] Bytecode optimizer fuses instructions and threads jumps") {
+	Ref<GDScript> plain = create_bytecode_optimizer_script(false);
+	Ref<GDScript> optimized = create_bytecode_optimizer_script(true);
+	REQUIRE(plain.is_valid());
+	REQUIRE(optimized.is_valid());
+
+	for (const KeyValue<StringName, GDScriptFunction *> &E : plain->get_member_functions()) {
+		CHECK_MESSAGE(E.value->get_fused_instruction_count() == 0, "Nothing should be fused without the optimizer.");
+		CHECK_MESSAGE(E.value->get_threaded_jump_count() == 0, "No jump should be threaded without the optimizer.");
+	}
+
+	const HashMap<StringName, GDScriptFunction *> &functions = optimized->get_member_functions();
+	REQUIRE(functions.has("scale"));
+	REQUIRE(functions.has("count_below"));
+	REQUIRE(functions.has("threaded"));
+	// `values[i] * k` then storing it back, and `values[i] < limit` then branching on it.
+	CHECK(functions["scale"]->get_fused_instruction_count() > 0);
+	CHECK(functions["count_below"]->get_fused_instruction_count() > 0);
+	// The jump over the `else` branch lands on the jump back to the `while` condition.
+	CHECK(functions["threaded"]->get_threaded_jump_count() > 0);
+}
+
+TEST_CASE("[Modules][GDScript] Optimized bytecode gives the same results") {
+	Ref<RefCounted> plain = create_bytecode_optimizer_instance(false);
+	Ref<RefCounted> optimized = create_bytecode_optimizer_instance(true);
+	REQUIRE(plain.is_valid());
+	REQUIRE(optimized.is_valid());
+
+	CHECK(double(optimized->call("run_scale", 100, 10)) == double(plain->call("run_scale", 100, 10)));
+	CHECK(int64_t(optimized->call("run_count_below", 1000, 2)) == int64_t(plain->call("run_count_below", 1000, 2)));
+	CHECK(int64_t(optimized->call("run_count_below", 1000, 2)) == 1000);
+	CHECK(double(optimized->call("run_polynomial", 1000, 2)) == double(plain->call("run_polynomial", 1000, 2)));
+	CHECK(int64_t(optimized->call("threaded", 1000)) == int64_t(plain->call("threaded", 1000)));
+}
+
+// Benchmark of the bytecode optimizer, comparing the same kernels compiled with and without it.
+// Run with `--test --no-skip`.
+
+static void benchmark_bytecode_kernel(const StringName &p_method, int p_size, int p_passes) {
+	Ref<RefCounted> plain = create_bytecode_optimizer_instance(false);
+	Ref<RefCounted> optimized = create_bytecode_optimizer_instance(true);
+	REQUIRE(plain.is_valid());
+	REQUIRE(optimized.is_valid());
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	const Variant plain_result = plain->call(p_method, p_size, p_passes);
+	const uint64_t plain_usec = TestUtils::get_elapsed_usec(begin);
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	const Variant optimized_result = optimized->call(p_method, p_size, p_passes);
+	const uint64_t optimized_usec = TestUtils::get_elapsed_usec(begin);
+
+	CHECK(plain_result == optimized_result);
+	print_line(vformat("%s: %d ms before, %d ms after (%.2fx)", p_method, plain_usec / 1000, optimized_usec / 1000, double(plain_usec) / optimized_usec));
+}
+
+TEST_CASE("[Modules][GDScript][Benchmark] Bytecode optimizer" * doctest::skip()) {
+	benchmark_bytecode_kernel("run_scale", 10000, 200);
+	benchmark_bytecode_kernel("run_count_below", 10000, 200);
+	benchmark_bytecode_kernel("run_polynomial", 10000, 200);
+}
+
+} // namespace GDScriptTests
+
+#endif // TOOLS_ENABLED
+
+#endif // TEST_BYTECODE_OPTIMIZER_H
@@ -0,0 +1,123 @@
+/**************************************************************************/
+/*  test_cpp_translator.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_CPP_TRANSLATOR_H
+#define TEST_CPP_TRANSLATOR_H
+
+#ifdef TOOLS_ENABLED
+
+#include "../gdscript_analyzer.h"
+#include "../gdscript_cpp_translator.h"
+#include "../gdscript_parser.h"
+
+#include "tests/test_macros.h"
+
+namespace GDScriptTests {
+
+static const char *cpp_translator_source = R"(
+extends RefCounted
+
+static func polynomial(x: float, n: int) -> float:
+	var result := 0.0
+	for i in range(n):
+		result = result * x + float(i)
+	return result
+
+static func twice_polynomial(x: float) -> float:
+	return polynomial(x, 4) * 2
+
+static func steer(position: Vector2, target: Vector2, speed: float) -> Vector2:
+	var offset := target - position
+	if offset.length() < 0.001:
+		return position
+	offset.x = clampf(offset.x, -1.0, 1.0)
+	return position + offset.normalized() * speed
+
+static func halve(value: int) -> int:
+	return value / 2
+
+static func divide_twice(a: int, b: int) -> int:
+	return divide(a, b) * 2
+
+static func divide(a: int, b: int) -> int:
+	return a / b
+
+static func count(values: Array) -> int:
+	return values.size()
+
+func untyped(a, b):
+	return a + b
+
+func instance_id() -> int:
+	return get_instance_id()
+)";
+
+static HashMap<StringName, GDScriptCppTranslator::FunctionResult> translate_for_test(GDScriptCppTranslator &p_translator, const String &p_source) {
+	HashMap<StringName, GDScriptCppTranslator::FunctionResult> results;
+	GDScriptParser parser;
+	REQUIRE(parser.parse(p_source, "res://cpp_translator_test.gd", false) == OK);
+	GDScriptAnalyzer analyzer(&parser);
+	REQUIRE(analyzer.analyze() == OK);
+	for (const GDScriptCppTranslator::FunctionResult &result : p_translator.translate("res://cpp_translator_test.gd", 0x1234, parser)) {
+		results.insert(result.name, result);
+	}
+	return results;
+}
+
+TEST_CASE("[Modules][GDScript] C++ translation of typed functions") {
+	GDScriptCppTranslator translator;
+	HashMap<StringName, GDScriptCppTranslator::FunctionResult> results = translate_for_test(translator, cpp_translator_source);
+
+	CHECK(results["polynomial"].translated);
+	CHECK(results["twice_polynomial"].translated);
+	CHECK(results["steer"].translated);
+	CHECK_MESSAGE(results["halve"].translated, "Integer division by a non-zero constant can't fail.");
+
+	CHECK_MESSAGE(!results["divide"].translated, "Integer division by a variable may be a runtime error.");
+	CHECK_MESSAGE(!results["count"].translated, "Arrays are not translated.");
+	CHECK_MESSAGE(!results["divide_twice"].translated, "Calls to functions left as bytecode are not translated.");
+	CHECK(!results["untyped"].translated);
+	CHECK(!results["instance_id"].translated);
+	CHECK_FALSE(results["count"].reason.is_empty());
+
+	CHECK(translator.get_translated_count() == 4);
+
+	const String source = translator.get_module_source("gdscript_aot_test");
+	CHECK(source.contains("void initialize_gdscript_aot_test_module(ModuleInitializationLevel p_level)"));
+	CHECK(source.contains("static double gdaot_0_0(double p_x, int64_t p_n)"));
+	CHECK(source.contains("for (int64_t l_i = int64_t(0LL), t_0 = p_n; l_i < t_0; l_i += 1LL) {"));
+	CHECK(source.contains("GDScriptAOT::register_function(String::utf8(\"res://cpp_translator_test.gd\"), 0x1234U, String::utf8(\"steer\"), &gdaot_0_2_call);"));
+}
+
+} // namespace GDScriptTests
+
+#endif // TOOLS_ENABLED
+
+#endif // TEST_CPP_TRANSLATOR_H
@@ -0,0 +1,216 @@
+/**************************************************************************/
+/*  test_gdscript_cache.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GDSCRIPT_CACHE_H
+#define TEST_GDSCRIPT_CACHE_H
+
+#ifdef TOOLS_ENABLED
+
+#include "gdscript_test_runner.h"
+
+#include "../gdscript.h"
+#include "../gdscript_cache.h"
+#include "../gdscript_parser.h"
+#include "../gdscript_tokenizer_buffer.h"
+
+#include "core/config/project_settings.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace GDScriptTests {
+
+static const char *compilation_cache_source = R"(
+extends RefCounted
+
+func value():
+	return 42
+)";
+
+static String get_compilation_cache_path(const String &p_path) {
+	return ProjectSettings::get_singleton()->get_project_data_path().path_join("gdscript_cache").path_join(p_path.md5_text() + ".cache");
+}
+
+// Sets up a project in a temporary folder, with the compilation cache enabled and no entry for `p_path`.
+static void init_compilation_cache_project(const String &p_path) {
+	const String root = TestUtils::get_temp_path("gdscript_compilation_cache");
+	DirAccess::make_dir_recursive_absolute(root);
+	{
+		Ref<FileAccess> f = FileAccess::open(root.path_join("project.godot"), FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string("config_version=5\n");
+	}
+	init_language(root);
+	ProjectSettings::get_singleton()->set_setting("debug/gdscript/compilation_cache/enabled", true);
+
+	DirAccess::remove_absolute(get_compilation_cache_path(p_path));
+}
+
+static void finish_compilation_cache_project() {
+	ProjectSettings::get_singleton()->set_setting("debug/gdscript/compilation_cache/enabled", false);
+	finish_language();
+}
+
+static void store_compilation_cache(const String &p_path, const String &p_source, const Vector<String> &p_dependencies) {
+	GDScriptCache::CompilationCacheEntry entry;
+	GDScriptCache::get_compilation_cache(p_path, p_source, entry);
+	HashMap<String, Ref<GDScriptParserRef>> dependencies;
+	for (const String &dependency : p_dependencies) {
+		dependencies.insert(dependency, Ref<GDScriptParserRef>());
+	}
+	GDScriptCache::update_compilation_cache(p_path, p_source, entry, dependencies);
+}
+
+TEST_CASE("[Modules][GDScript] Compilation cache stores tokens and dependencies") {
+	const String path = "res://cached.gd";
+	const String source = compilation_cache_source;
+	init_compilation_cache_project(path);
+
+	GDScriptCache::CompilationCacheEntry entry;
+	CHECK_FALSE_MESSAGE(GDScriptCache::get_compilation_cache(path, source, entry), "Nothing should be stored yet.");
+	CHECK(entry.source_md5.size() == 16);
+	CHECK_FALSE(entry.stored);
+
+	store_compilation_cache(path, source, { "res://b.gd", "res://a.gd" });
+	CHECK(FileAccess::exists(get_compilation_cache_path(path)));
+
+	entry = GDScriptCache::CompilationCacheEntry();
+	REQUIRE(GDScriptCache::get_compilation_cache(path, source, entry));
+	CHECK(entry.stored);
+	CHECK(entry.dependencies == Vector<String>({ "res://a.gd", "res://b.gd" }));
+	CHECK(entry.tokens == GDScriptTokenizerBuffer::parse_code_string(source, GDScriptTokenizerBuffer::COMPRESS_NONE));
+
+	GDScriptParser parser;
+	CHECK(parser.parse_binary(entry.tokens, path) == OK);
+
+	finish_compilation_cache_project();
+}
+
+TEST_CASE("[Modules][GDScript] Compilation cache is invalidated by changes") {
+	const String path = "res://cached.gd";
+	const String source = compilation_cache_source;
+	init_compilation_cache_project(path);
+
+	store_compilation_cache(path, source, { "res://a.gd" });
+
+	SUBCASE("Source changes") {
+		GDScriptCache::CompilationCacheEntry entry;
+		CHECK_FALSE(GDScriptCache::get_compilation_cache(path, source + "\nfunc other():\n\tpass\n", entry));
+		CHECK(entry.dependencies.is_empty());
+		CHECK(entry.tokens.is_empty());
+	}
+
+	SUBCASE("Dependency changes") {
+		GDScriptCache::CompilationCacheEntry entry;
+		REQUIRE(GDScriptCache::get_compilation_cache(path, source, entry));
+		HashMap<String, Ref<GDScriptParserRef>> dependencies;
+		dependencies.insert("res://a.gd", Ref<GDScriptParserRef>());
+		dependencies.insert("res://c.gd", Ref<GDScriptParserRef>());
+		dependencies.insert(path, Ref<GDScriptParserRef>());
+		GDScriptCache::update_compilation_cache(path, source, entry, dependencies);
+
+		entry = GDScriptCache::CompilationCacheEntry();
+		REQUIRE(GDScriptCache::get_compilation_cache(path, source, entry));
+		CHECK_MESSAGE(entry.dependencies == Vector<String>({ "res://a.gd", "res://c.gd" }), "The new dependencies should be stored, without the script itself.");
+	}
+
+	finish_compilation_cache_project();
+}
+
+TEST_CASE("[Modules][GDScript] Compilation cache rejects damaged files") {
+	const String path = "res://cached.gd";
+	const String source = compilation_cache_source;
+	init_compilation_cache_project(path);
+
+	store_compilation_cache(path, source, { "res://a.gd" });
+	const String cache_path = get_compilation_cache_path(path);
+	const Vector<uint8_t> data = FileAccess::get_file_as_bytes(cache_path);
+	REQUIRE(data.size() > 32);
+
+	SUBCASE("Truncated") {
+		for (int64_t size : { data.size() - 1, data.size() / 2, int64_t(6) }) {
+			Ref<FileAccess> f = FileAccess::open(cache_path, FileAccess::WRITE);
+			f->store_buffer(data.ptr(), size);
+			f.unref();
+
+			GDScriptCache::CompilationCacheEntry entry;
+			CHECK_FALSE_MESSAGE(GDScriptCache::get_compilation_cache(path, source, entry), vformat("A file truncated to %d bytes should be rejected.", size));
+			CHECK(entry.dependencies.is_empty());
+			CHECK(entry.tokens.is_empty());
+		}
+	}
+
+	SUBCASE("Wrong magic") {
+		Vector<uint8_t> corrupt = data;
+		corrupt.write[0] = 'X';
+		Ref<FileAccess> f = FileAccess::open(cache_path, FileAccess::WRITE);
+		f->store_buffer(corrupt);
+		f.unref();
+
+		GDScriptCache::CompilationCacheEntry entry;
+		CHECK_FALSE(GDScriptCache::get_compilation_cache(path, source, entry));
+	}
+
+	SUBCASE("Corrupt tokens fall back to parsing") {
+		// Keep the header valid so only the tokens, stored last, fail to load.
+		Vector<uint8_t> corrupt = data;
+		corrupt.write[data.size() - GDScriptTokenizerBuffer::parse_code_string(source, GDScriptTokenizerBuffer::COMPRESS_NONE).size()] = 'X';
+		{
+			Ref<FileAccess> f = FileAccess::open(cache_path, FileAccess::WRITE);
+			f->store_buffer(corrupt);
+			Ref<FileAccess> script_file = FileAccess::open(path, FileAccess::WRITE);
+			script_file->store_string(source);
+		}
+
+		Error err = OK;
+		ERR_PRINT_OFF;
+		Ref<GDScript> script = GDScriptCache::get_full_script(path, err);
+		ERR_PRINT_ON;
+		CHECK(err == OK);
+		REQUIRE(script.is_valid());
+		CHECK(script->is_valid());
+
+		GDScriptCache::CompilationCacheEntry entry;
+		REQUIRE(GDScriptCache::get_compilation_cache(path, source, entry));
+		CHECK_MESSAGE(entry.tokens == GDScriptTokenizerBuffer::parse_code_string(source, GDScriptTokenizerBuffer::COMPRESS_NONE), "The corrupt tokens should be replaced.");
+
+		GDScriptCache::remove_script(path);
+		DirAccess::remove_absolute(path);
+	}
+
+	finish_compilation_cache_project();
+}
+
+} // namespace GDScriptTests
+
+#endif // TOOLS_ENABLED
+
+#endif // TEST_GDSCRIPT_CACHE_H
@@ -0,0 +1,132 @@
+/**************************************************************************/
+/*  test_gdscript_coroutines.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GDSCRIPT_COROUTINES_H
+#define TEST_GDSCRIPT_COROUTINES_H
+
+#include "../gdscript.h"
+#include "../gdscript_function.h"
+
+#include "scene/main/scene_tree.h"
+#include "tests/test_macros.h"
+
+namespace GDScriptTests {
+
+TEST_CASE("[Modules][GDScript] Coroutine frames are reused") {
+	GDScriptFramePool::clear();
+	const uint64_t used = GDScriptFramePool::get_used_count();
+
+	uint8_t *first = GDScriptFramePool::alloc(300);
+	uint8_t *second = GDScriptFramePool::alloc(300);
+	CHECK(GDScriptFramePool::get_used_count() == used + 2);
+	CHECK(GDScriptFramePool::get_pooled_count() == 0);
+
+	GDScriptFramePool::free(first, 300);
+	GDScriptFramePool::free(second, 300);
+	CHECK(GDScriptFramePool::get_used_count() == used);
+	CHECK(GDScriptFramePool::get_pooled_count() == 2);
+
+	uint8_t *reused = GDScriptFramePool::alloc(400);
+	CHECK_MESSAGE((reused == first || reused == second), "Frames of the same size class should be reused.");
+	CHECK(GDScriptFramePool::get_pooled_count() == 1);
+	GDScriptFramePool::free(reused, 400);
+
+	const uint32_t large_size = 64 * 1024;
+	uint8_t *large = GDScriptFramePool::alloc(large_size);
+	GDScriptFramePool::free(large, large_size);
+	CHECK_MESSAGE(GDScriptFramePool::get_pooled_count() == 2, "Large frames should not be pooled.");
+
+	GDScriptFramePool::clear();
+	CHECK(GDScriptFramePool::get_pooled_count() == 0);
+	CHECK(GDScriptFramePool::get_used_count() == used);
+}
+
+TEST_CASE("[SceneTree][Modules][GDScript] Frame awaits are resumed in order for each tree") {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+var events := PackedStringArray()
+
+func wait_process(tree: SceneTree, tag: String, frames: int) -> void:
+	for i in frames:
+		await tree.process_frame
+		events.append(tag + str(i))
+
+func wait_physics(tree: SceneTree, tag: String) -> void:
+	await tree.physics_frame
+	events.append(tag)
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should parse successfully.");
+
+	Ref<RefCounted> object = memnew(RefCounted);
+	object->set_script(gdscript);
+	SceneTree *tree = SceneTree::get_singleton();
+	SceneTree *other_tree = memnew(SceneTree);
+
+	GDScriptFramePool::clear();
+	const uint64_t suspended = GDScriptFunctionState::get_suspended_count();
+	const uint64_t used = GDScriptFramePool::get_used_count();
+
+	// Alternate between the trees, awaits on one must not drop those on the other.
+	object->call("wait_process", tree, "a", 2);
+	object->call("wait_process", other_tree, "b", 1);
+	object->call("wait_process", tree, "c", 1);
+	object->call("wait_physics", tree, "p");
+	CHECK(GDScriptFunctionState::get_suspended_count() == suspended + 4);
+	CHECK(GDScriptFramePool::get_used_count() == used + 4);
+
+	tree->emit_signal(SNAME("process_frame"));
+	CHECK(String(",").join(object->get("events")) == "a0,c0");
+	CHECK_MESSAGE(GDScriptFunctionState::get_suspended_count() == suspended + 3, "Awaiting again during the pass should wait for the next emission.");
+
+	other_tree->emit_signal(SNAME("process_frame"));
+	tree->emit_signal(SNAME("physics_frame"));
+	tree->emit_signal(SNAME("process_frame"));
+	CHECK(String(",").join(object->get("events")) == "a0,c0,b0,p,a1");
+	CHECK(GDScriptFunctionState::get_suspended_count() == suspended);
+	CHECK(GDScriptFramePool::get_used_count() == used);
+
+	const uint64_t pooled = GDScriptFramePool::get_pooled_count();
+	CHECK(pooled > 0);
+	object->call("wait_physics", tree, "q");
+	CHECK_MESSAGE(GDScriptFramePool::get_pooled_count() == pooled - 1, "Frames freed by finished coroutines should be reused.");
+	tree->emit_signal(SNAME("physics_frame"));
+	CHECK(String(",").join(object->get("events")) == "a0,c0,b0,p,a1,q");
+
+	memdelete(other_tree);
+}
+
+} // namespace GDScriptTests
+
+#endif // TEST_GDSCRIPT_COROUTINES_H
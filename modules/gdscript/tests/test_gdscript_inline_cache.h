@@ -0,0 +1,57 @@
+/**************************************************************************/
+/*  test_gdscript_inline_cache.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GDSCRIPT_INLINE_CACHE_H
+#define TEST_GDSCRIPT_INLINE_CACHE_H
+
+#include "../gdscript_function.h"
+
+#include "tests/test_macros.h"
+
+namespace GDScriptTests {
+
+TEST_CASE("[Modules][GDScript] Inline caches give up per revision") {
+	GDScriptInlineCache cache;
+	const uint64_t revision = GDScriptInlineCache::get_revision();
+
+	for (uint32_t i = 0; i < GDScriptInlineCache::MAX_RESOLVES; i++) {
+		CHECK(cache.begin_resolve(revision));
+	}
+	CHECK_MESSAGE(!cache.begin_resolve(revision), "Megamorphic sites should stop resolving.");
+
+	GDScriptInlineCache::invalidate_scripts();
+	const uint64_t reloaded = GDScriptInlineCache::get_revision();
+	CHECK(reloaded != revision);
+	CHECK_MESSAGE(cache.begin_resolve(reloaded), "Misses caused by reloads should not disable the site.");
+}
+
+} // namespace GDScriptTests
+
+#endif // TEST_GDSCRIPT_INLINE_CACHE_H
@@ -0,0 +1,105 @@
+/**************************************************************************/
+/*  test_gdscript_sampler.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GDSCRIPT_SAMPLER_H
+#define TEST_GDSCRIPT_SAMPLER_H
+
+#include "../gdscript_sampler.h"
+
+#include "tests/test_macros.h"
+
+namespace GDScriptTests {
+
+TEST_CASE("[Modules][GDScript] Sampler records collapsed stacks") {
+	uint32_t outer = GDScriptSampler::add_symbol("outer", "res://sampler_test.gd", 3);
+	uint32_t inner = GDScriptSampler::add_symbol("inner", "res://sampler_test.gd", 10);
+	uint32_t native = GDScriptSampler::add_symbol("Node::get_child", String(), 0);
+
+	GDScriptSampler::start(0);
+	CHECK(GDScriptSampler::is_active());
+
+	GDScriptSampler::sample();
+	CHECK_MESSAGE(GDScriptSampler::get_sample_count() == 0, "Threads not running scripts should not be sampled.");
+
+	{
+		GDScriptSampler::Frame outer_frame;
+		outer_frame.push(outer);
+		GDScriptSampler::sample();
+		{
+			GDScriptSampler::Frame inner_frame;
+			inner_frame.push(inner);
+			GDScriptSampler::sample();
+			GDScriptSampler::sample();
+			{
+				GDScriptSampler::Frame native_frame;
+				native_frame.push(native);
+				GDScriptSampler::sample();
+			}
+		}
+	}
+
+	GDScriptSampler::sample();
+	GDScriptSampler::stop();
+	CHECK_FALSE(GDScriptSampler::is_active());
+	CHECK(GDScriptSampler::get_sample_count() == 4);
+
+	CHECK(GDScriptSampler::get_collapsed_stacks() ==
+			"main;outer (res://sampler_test.gd:3) 1\n"
+			"main;outer (res://sampler_test.gd:3);inner (res://sampler_test.gd:10) 2\n"
+			"main;outer (res://sampler_test.gd:3);inner (res://sampler_test.gd:10);Node::get_child 1\n");
+
+	GDScriptSampler::Symbol symbol = GDScriptSampler::get_symbol(inner);
+	CHECK(symbol.name == "inner");
+	CHECK(symbol.line == 10);
+
+	const Vector<uint8_t> pprof = GDScriptSampler::get_pprof();
+	REQUIRE(pprof.size() > 2);
+	CHECK_MESSAGE(pprof[0] == 0x1f, "The pprof profile should be gzip compressed.");
+	CHECK(pprof[1] == 0x8b);
+
+	GDScriptSampler::start(0);
+	CHECK_MESSAGE(GDScriptSampler::get_collapsed_stacks().is_empty(), "Starting again should discard previous samples.");
+	GDScriptSampler::stop();
+}
+
+TEST_CASE("[Modules][GDScript] Sampler ignores native frames while stopped") {
+	REQUIRE_FALSE(GDScriptSampler::is_active());
+	{
+		GDScriptSampler::NativeFrame native_frame(nullptr);
+		GDScriptSampler::start(0);
+		GDScriptSampler::sample();
+		GDScriptSampler::stop();
+	}
+	CHECK(GDScriptSampler::get_sample_count() == 0);
+}
+
+} // namespace GDScriptTests
+
+#endif // TEST_GDSCRIPT_SAMPLER_H
@@ -197,6 +197,7 @@ protected:
 
 public:
 	virtual Variant callp(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error) override;
+	virtual bool has_custom_callp() const override { return true; }
 
 	String get_java_class_name() const;
 	TypedArray<Dictionary> get_java_method_list() const;
@@ -225,6 +226,7 @@ protected:
 
 public:
 	virtual Variant callp(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error) override;
+	virtual bool has_custom_callp() const override { return true; }
 
 	Ref<JavaClass> get_java_class() const;
 
@@ -72,6 +72,8 @@ public:
 		return Object::callp(p_method, p_args, p_argcount, r_error);
 	}
 
+	virtual bool has_custom_callp() const override { return true; }
+
 	Ref<JavaObject> get_wrapped_object() const {
 		return wrapped_object;
 	}
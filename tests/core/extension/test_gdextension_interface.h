@@ -0,0 +1,166 @@
+/**************************************************************************/
+/*  test_gdextension_interface.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GDEXTENSION_INTERFACE_H
+#define TEST_GDEXTENSION_INTERFACE_H
+
+#include "core/extension/gdextension.h"
+#include "core/io/resource.h"
+#include "core/object/class_db.h"
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestGDExtensionInterface {
+
+static Vector<Ref<Resource>> make_resources(int p_count) {
+	Vector<Ref<Resource>> ret;
+	for (int i = 0; i < p_count; i++) {
+		Ref<Resource> res;
+		res.instantiate();
+		ret.push_back(res);
+	}
+	return ret;
+}
+
+static Vector<GDExtensionObjectPtr> get_instances(const Vector<Ref<Resource>> &p_resources) {
+	Vector<GDExtensionObjectPtr> ret;
+	for (const Ref<Resource> &res : p_resources) {
+		ret.push_back(res.ptr());
+	}
+	return ret;
+}
+
+TEST_CASE("[GDExtensionInterface] Batched ptrcall") {
+	GDExtensionInterfaceObjectMethodBindPtrcallBatch ptrcall_batch = (GDExtensionInterfaceObjectMethodBindPtrcallBatch)GDExtension::get_interface_function("object_method_bind_ptrcall_batch");
+	REQUIRE(ptrcall_batch != nullptr);
+
+	MethodBind *set_name = ClassDB::get_method("Resource", "set_name");
+	MethodBind *get_name = ClassDB::get_method("Resource", "get_name");
+	REQUIRE(set_name != nullptr);
+	REQUIRE(get_name != nullptr);
+
+	const int count = 37;
+	Vector<Ref<Resource>> resources = make_resources(count);
+	Vector<GDExtensionObjectPtr> instances = get_instances(resources);
+
+	SUBCASE("Strided arguments") {
+		Vector<String> names;
+		for (int i = 0; i < count; i++) {
+			names.push_back(itos(i * 3));
+		}
+		GDExtensionConstTypePtr args[] = { names.ptr() };
+		GDExtensionInt strides[] = { sizeof(String) };
+		ptrcall_batch(set_name, instances.ptr(), count, args, strides, nullptr, 0);
+
+		for (int i = 0; i < count; i++) {
+			CHECK(resources[i]->get_name() == names[i]);
+		}
+	}
+
+	SUBCASE("Shared arguments") {
+		const String name = "shared";
+		GDExtensionConstTypePtr args[] = { &name };
+		ptrcall_batch(set_name, instances.ptr(), count, args, nullptr, nullptr, 0);
+
+		for (int i = 0; i < count; i++) {
+			CHECK(resources[i]->get_name() == name);
+		}
+	}
+
+	SUBCASE("Strided return values") {
+		for (int i = 0; i < count; i++) {
+			resources.write[i]->set_name("res_" + itos(i));
+		}
+		Vector<String> names;
+		names.resize(count);
+		ptrcall_batch(get_name, instances.ptr(), count, nullptr, nullptr, names.ptrw(), sizeof(String));
+
+		for (int i = 0; i < count; i++) {
+			CHECK(names[i] == "res_" + itos(i));
+		}
+	}
+
+	SUBCASE("Empty batch") {
+		ptrcall_batch(set_name, instances.ptr(), 0, nullptr, nullptr, nullptr, 0);
+		CHECK(resources[0]->get_name().is_empty());
+	}
+
+	SUBCASE("Invalid batches") {
+		const String name = "unused";
+		GDExtensionConstTypePtr args[] = { &name };
+		ERR_PRINT_OFF;
+		ptrcall_batch(set_name, nullptr, count, args, nullptr, nullptr, 0);
+		ptrcall_batch(get_name, instances.ptr(), count, nullptr, nullptr, nullptr, 0);
+		ERR_PRINT_ON;
+		CHECK_MESSAGE(resources[0]->get_name().is_empty(), "A non-static method without instances should not be called.");
+	}
+}
+
+// Benchmark comparing one ptrcall per object with a single batch. Run with `--test --no-skip`.
+TEST_CASE("[GDExtensionInterface][Benchmark] Per-call vs. batched ptrcall" * doctest::skip()) {
+	GDExtensionInterfaceObjectMethodBindPtrcall ptrcall = (GDExtensionInterfaceObjectMethodBindPtrcall)GDExtension::get_interface_function("object_method_bind_ptrcall");
+	GDExtensionInterfaceObjectMethodBindPtrcallBatch ptrcall_batch = (GDExtensionInterfaceObjectMethodBindPtrcallBatch)GDExtension::get_interface_function("object_method_bind_ptrcall_batch");
+	MethodBind *set_name = ClassDB::get_method("Resource", "set_name");
+
+	const int count = 10000;
+	const int iterations = 100;
+	Vector<Ref<Resource>> resources = make_resources(count);
+	Vector<GDExtensionObjectPtr> instances = get_instances(resources);
+	Vector<String> names;
+	for (int i = 0; i < count; i++) {
+		names.push_back(itos(i));
+	}
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int it = 0; it < iterations; it++) {
+		for (int i = 0; i < count; i++) {
+			GDExtensionConstTypePtr args[] = { &names[i] };
+			ptrcall(set_name, instances[i], args, nullptr);
+		}
+	}
+	const uint64_t per_call_usec = TestUtils::get_elapsed_usec(begin);
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	GDExtensionConstTypePtr args[] = { names.ptr() };
+	GDExtensionInt strides[] = { sizeof(String) };
+	for (int it = 0; it < iterations; it++) {
+		ptrcall_batch(set_name, instances.ptr(), count, args, strides, nullptr, 0);
+	}
+	const uint64_t batched_usec = TestUtils::get_elapsed_usec(begin);
+
+	print_line(vformat("%d x %d calls: per-call %d usec, batched %d usec.", iterations, count, per_call_usec, batched_usec));
+	CHECK(resources[count - 1]->get_name() == names[count - 1]);
+}
+
+} // namespace TestGDExtensionInterface
+
+#endif // TEST_GDEXTENSION_INTERFACE_H
@@ -0,0 +1,224 @@
+/**************************************************************************/
+/*  test_file_access_pack.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_FILE_ACCESS_PACK_H
+#define TEST_FILE_ACCESS_PACK_H
+
+#include "core/io/file_access_pack.h"
+#include "core/io/marshalls.h"
+#include "core/io/pck_packer.h"
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestFileAccessPack {
+
+static Vector<uint8_t> make_data(uint64_t p_size, uint8_t p_seed) {
+	Vector<uint8_t> data;
+	data.resize(p_size);
+	uint8_t *w = data.ptrw();
+	for (uint64_t i = 0; i < p_size; i++) {
+		w[i] = uint8_t(i * 31 + p_seed);
+	}
+	return data;
+}
+
+static String write_source(const String &p_name, const Vector<uint8_t> &p_data) {
+	const String path = TestUtils::get_temp_path(p_name);
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+	f->store_buffer(p_data);
+	return path;
+}
+
+// Adds the pack with memory mapping toggled, restoring the previous setting.
+static Error add_pack(const String &p_path, bool p_mapped) {
+	PackedData *packed_data = PackedData::get_singleton();
+	const bool was_mapped = packed_data->is_memory_mapping_enabled();
+	packed_data->set_memory_mapping_enabled(p_mapped);
+	Error err = packed_data->add_pack(p_path, true, 0);
+	packed_data->set_memory_mapping_enabled(was_mapped);
+	return err;
+}
+
+TEST_CASE("[FileAccessPack] Read files from a mapped and an unmapped pack") {
+	const Vector<uint8_t> first = make_data(1000, 1);
+	const Vector<uint8_t> second = make_data(70000, 2);
+
+	PCKPacker packer;
+	const String pck_path = TestUtils::get_temp_path("file_access_pack.pck");
+	REQUIRE(packer.pck_start(pck_path) == OK);
+	REQUIRE(packer.add_file("res://file_access_pack_test/first.bin", write_source("file_access_pack_first.bin", first)) == OK);
+	REQUIRE(packer.add_file("res://file_access_pack_test/second.bin", write_source("file_access_pack_second.bin", second)) == OK);
+	REQUIRE(packer.flush() == OK);
+
+	{
+		Ref<FileAccess> f = FileAccess::open(pck_path, FileAccess::READ);
+		REQUIRE(f.is_valid());
+		CHECK(f->get_32() == PACK_HEADER_MAGIC);
+		CHECK(f->get_32() == PACK_FORMAT_VERSION);
+	}
+
+	for (int mapped = 1; mapped >= 0; mapped--) {
+		REQUIRE(add_pack(pck_path, mapped) == OK);
+
+		Ref<FileAccess> f = FileAccess::open("res://file_access_pack_test/first.bin", FileAccess::READ);
+		REQUIRE(f.is_valid());
+		CHECK(f->get_length() == 1000);
+		CHECK(f->get_buffer(1000) == first);
+		CHECK_FALSE(f->eof_reached());
+		CHECK(f->get_8() == 0);
+		CHECK(f->eof_reached());
+
+		f = FileAccess::open("res://file_access_pack_test/second.bin", FileAccess::READ);
+		REQUIRE(f.is_valid());
+		f->seek(69990);
+		CHECK(f->get_buffer(100) == second.slice(69990));
+		CHECK(f->eof_reached());
+
+		f->seek(10);
+		const uint8_t *view = f->get_buffer_view(16);
+		if (mapped) {
+			REQUIRE_MESSAGE(view != nullptr, "Files from a mapped pack should provide views.");
+			CHECK(memcmp(view, second.ptr() + 10, 16) == 0);
+			CHECK(f->get_position() == 26);
+			CHECK(f->get_buffer_view(70000) == nullptr);
+			CHECK(f->get_position() == 26);
+		} else {
+			CHECK(view == nullptr);
+			CHECK(f->get_position() == 10);
+		}
+		// Reading carries on after the view.
+		const uint32_t expected = decode_uint32(second.ptr() + f->get_position());
+		CHECK(f->get_32() == expected);
+	}
+}
+
+TEST_CASE("[FileAccessPack] Read compressed files") {
+	PCKPacker packer;
+	packer.set_compression_enabled(true);
+	const String pck_path = TestUtils::get_temp_path("file_access_pack_compressed.pck");
+	REQUIRE(packer.pck_start(pck_path) == OK);
+
+	// Enough resources to train a dictionary, and a file spanning several frames.
+	Vector<Vector<uint8_t>> resources;
+	uint64_t total_size = 0;
+	for (int i = 0; i < 16; i++) {
+		resources.push_back(make_data(3000 + i * 100, i));
+		total_size += resources[i].size();
+		REQUIRE(packer.add_file(vformat("res://file_access_pack_compressed/%d.res", i), write_source(vformat("file_access_pack_compressed_%d.res", i), resources[i])) == OK);
+	}
+	const Vector<uint8_t> large = make_data(PCKCompression::FRAME_SIZE * 3 + 1000, 99);
+	total_size += large.size();
+	REQUIRE(packer.add_file("res://file_access_pack_compressed/large.bin", write_source("file_access_pack_compressed_large.bin", large)) == OK);
+	REQUIRE(packer.flush() == OK);
+
+	{
+		Ref<FileAccess> f = FileAccess::open(pck_path, FileAccess::READ);
+		REQUIRE(f.is_valid());
+		CHECK_MESSAGE(f->get_length() < total_size, "The pack should be smaller than the files it holds.");
+		CHECK(f->get_32() == PACK_HEADER_MAGIC);
+		CHECK_MESSAGE(f->get_32() == PACK_FORMAT_VERSION_COMPRESSED, "Engines unable to read compressed files should reject the pack.");
+	}
+
+	for (int mapped = 1; mapped >= 0; mapped--) {
+		REQUIRE(add_pack(pck_path, mapped) == OK);
+
+		for (int i = 0; i < resources.size(); i++) {
+			CHECK(FileAccess::get_file_as_bytes(vformat("res://file_access_pack_compressed/%d.res", i)) == resources[i]);
+		}
+
+		Ref<FileAccess> f = FileAccess::open("res://file_access_pack_compressed/large.bin", FileAccess::READ);
+		REQUIRE(f.is_valid());
+		CHECK(f->get_length() == uint64_t(large.size()));
+
+		// Across the second and third frames, before the first one is decoded.
+		const int64_t ofs = PCKCompression::FRAME_SIZE * 2 - 10;
+		f->seek(ofs);
+		CHECK(f->get_buffer(20) == large.slice(ofs, ofs + 20));
+		const uint8_t *view = f->get_buffer_view(100);
+		REQUIRE_MESSAGE(view != nullptr, "Compressed files should provide views of what they decoded.");
+		CHECK(memcmp(view, large.ptr() + ofs + 20, 100) == 0);
+
+		f->seek(0);
+		CHECK(f->get_buffer(large.size()) == large);
+		CHECK_FALSE(f->eof_reached());
+	}
+}
+
+// Reads every file of a large pack twice, once through views and once through `get_buffer()`.
+// The first pass is only cold if the page cache was dropped before running it, e.g. with
+// `sync; echo 3 > /proc/sys/vm/drop_caches` on Linux. Run with `--test --no-skip`.
+TEST_CASE("[FileAccessPack][Benchmark] Mapped vs. read pack entries" * doctest::skip()) {
+	const uint64_t pack_size = uint64_t(2) << 30; // 2 GiB, lower it when disk space is tight.
+	const uint64_t file_size = 64 << 20;
+	const int file_count = pack_size / file_size;
+
+	const String pck_path = TestUtils::get_temp_path("file_access_pack_benchmark.pck");
+	{
+		const String source_path = write_source("file_access_pack_benchmark.bin", make_data(file_size, 3));
+		PCKPacker packer;
+		REQUIRE(packer.pck_start(pck_path) == OK);
+		for (int i = 0; i < file_count; i++) {
+			REQUIRE(packer.add_file(vformat("res://file_access_pack_benchmark/%d.bin", i), source_path) == OK);
+		}
+		REQUIRE(packer.flush() == OK);
+	}
+
+	Vector<uint8_t> buffer;
+	buffer.resize(file_size);
+
+	for (int mapped = 1; mapped >= 0; mapped--) {
+		REQUIRE(add_pack(pck_path, mapped) == OK);
+
+		for (int pass = 0; pass < 2; pass++) {
+			uint64_t checksum = 0;
+			const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			for (int i = 0; i < file_count; i++) {
+				Ref<FileAccess> f = FileAccess::open(vformat("res://file_access_pack_benchmark/%d.bin", i), FileAccess::READ);
+				const uint8_t *data = mapped ? f->get_buffer_view(file_size) : nullptr;
+				if (!data) {
+					f->get_buffer(buffer.ptrw(), file_size);
+					data = buffer.ptr();
+				}
+				// Touch every cache line, as a loader would.
+				for (uint64_t j = 0; j < file_size; j += 64) {
+					checksum += data[j];
+				}
+			}
+			const uint64_t usec = TestUtils::get_elapsed_usec(begin);
+			print_line(vformat("%s, %s pass: %d MiB in %d usec (checksum %d).", mapped ? "mapped" : "read", pass == 0 ? "first" : "second", pack_size >> 20, usec, checksum));
+		}
+	}
+}
+
+} // namespace TestFileAccessPack
+
+#endif // TEST_FILE_ACCESS_PACK_H
@@ -0,0 +1,281 @@
+/**************************************************************************/
+/*  test_json_stream_parser.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_JSON_STREAM_PARSER_H
+#define TEST_JSON_STREAM_PARSER_H
+
+#include "core/io/json.h"
+#include "core/io/json_stream_parser.h"
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestJSONStreamParser {
+
+// Parses `p_json` from memory and through stream peers handing out a few bytes
+// at a time, and checks the results against JSON::parse(). With `p_bom`, the
+// bytes start with a UTF-8 byte order mark.
+void check_same_as_json(const String &p_json, bool p_bom = false) {
+	INFO("JSON: ", p_json);
+
+	JSON json;
+	const Error expected = json.parse(p_json);
+	PackedByteArray utf8;
+	if (p_bom) {
+		utf8.push_back(0xef);
+		utf8.push_back(0xbb);
+		utf8.push_back(0xbf);
+	}
+	utf8.append_array(p_json.to_utf8_buffer());
+
+	JSONStreamParser parser;
+	Variant data;
+	Error err = parser.parse_buffer(utf8.ptr(), utf8.size(), data);
+	CHECK(err == expected);
+	if (expected == OK) {
+		CHECK(data == json.get_data());
+	} else {
+		CHECK(parser.get_error_line() == json.get_error_line());
+		CHECK(parser.get_error_message() == json.get_error_message());
+	}
+
+	const uint32_t chunk_sizes[] = { 1, 2, 5, 16, 17 };
+	for (uint32_t chunk_size : chunk_sizes) {
+		INFO("Chunk size: ", chunk_size);
+		Ref<StreamPeerBuffer> stream;
+		stream.instantiate();
+		stream->set_data_array(utf8);
+		parser.set_chunk_size(chunk_size);
+		err = parser.parse_stream(stream, data);
+		CHECK(err == expected);
+		if (expected == OK) {
+			CHECK(data == json.get_data());
+		} else {
+			CHECK(parser.get_error_line() == json.get_error_line());
+			CHECK(parser.get_error_message() == json.get_error_message());
+		}
+	}
+}
+
+// Records the events as text.
+class EventRecorder : public JSONStreamParser::Handler {
+public:
+	PackedStringArray events;
+	String stop_at_key;
+
+	virtual Error begin_object() override {
+		events.push_back("{");
+		return OK;
+	}
+	virtual Error key(const String &p_key) override {
+		events.push_back("key " + p_key);
+		return p_key == stop_at_key ? ERR_SKIP : OK;
+	}
+	virtual Error end_object() override {
+		events.push_back("}");
+		return OK;
+	}
+	virtual Error begin_array() override {
+		events.push_back("[");
+		return OK;
+	}
+	virtual Error end_array() override {
+		events.push_back("]");
+		return OK;
+	}
+	virtual Error value(const Variant &p_value) override {
+		events.push_back(Variant::get_type_name(p_value.get_type()) + " " + String(p_value));
+		return OK;
+	}
+};
+
+TEST_CASE("[JSONStreamParser] Parsing the same values as JSON") {
+	check_same_as_json("null");
+	check_same_as_json("true");
+	check_same_as_json("false");
+	check_same_as_json("123456");
+	check_same_as_json("-0.5");
+	check_same_as_json("1.5e3");
+	check_same_as_json("-2E-2");
+	check_same_as_json("12e+2");
+	check_same_as_json("\"\"");
+	check_same_as_json("\"hello\"");
+	check_same_as_json("  \n\t[ ]  \n");
+	check_same_as_json("{}");
+	check_same_as_json("[1, 2.5, \"three\", true, false, null, [], {}]");
+	check_same_as_json("{\"a\": {\"b\": [1, {\"c\": \"d\"}]}, \"e\": -1}");
+	check_same_as_json("{\"key\": 1, \"key\": 2}");
+	// Accepted by JSON::parse(), see the note in test_json.h.
+	check_same_as_json("[1, 2,]");
+	check_same_as_json("{\"a\": 1,}");
+	// Byte order marks spanning the chunks.
+	check_same_as_json("[1, 2]", true);
+	check_same_as_json("{\"a\": \"b\"}", true);
+	check_same_as_json("7", true);
+}
+
+TEST_CASE("[JSONStreamParser] Parsing strings") {
+	check_same_as_json("\"\\\" \\\\ \\/ \\b \\f \\n \\r \\t\"");
+	check_same_as_json("\"\\u00e9\\u6F22 \\ud83d\\ude00\"");
+	check_same_as_json(String::utf8("\"é 漢字 😀\""));
+	check_same_as_json(String::utf8("\"\xef\xbb\xbfstarts with U+FEFF\""));
+	check_same_as_json("\"A string longer than a few blocks of sixteen bytes,\nwith line breaks\nin it, and \\\"escapes\\\" too.\"");
+	check_same_as_json("[\"a\", \"\", \"bc\", \"d\\ne\"]");
+}
+
+TEST_CASE("[JSONStreamParser] Reporting the same errors as JSON") {
+	ERR_PRINT_OFF;
+	check_same_as_json("[1 2]");
+	check_same_as_json("[\n1\n\n2]");
+	check_same_as_json("[,]");
+	check_same_as_json("[");
+	check_same_as_json("[1,");
+	check_same_as_json("{\"a\" 1}");
+	check_same_as_json("{1: 2}");
+	check_same_as_json("{\"a\": 1 \"b\": 2}");
+	check_same_as_json("{\"a\": 1");
+	check_same_as_json("[tru]");
+	check_same_as_json("[1] 2");
+	check_same_as_json("\n\n  @");
+	check_same_as_json("\"unterminated");
+	check_same_as_json("\"multi\nline\nunterminated");
+	check_same_as_json("\"\\x\"");
+	check_same_as_json("\"\\u12g4\"");
+	check_same_as_json("\"\\ud800\"");
+	check_same_as_json("\"\\ud800\\u0041\"");
+	check_same_as_json("\"\\udc00\"");
+	check_same_as_json(String("[").repeat(Variant::MAX_RECURSION_DEPTH + 10));
+	ERR_PRINT_ON;
+
+	JSONStreamParser parser;
+	Variant data;
+	const char *malformed = "[1e]";
+	CHECK(parser.parse_buffer((const uint8_t *)malformed, strlen(malformed), data) == ERR_PARSE_ERROR);
+	CHECK(parser.get_error_message() == "Malformed number.");
+	CHECK(data == Variant());
+}
+
+TEST_CASE("[JSONStreamParser] Handler events") {
+	const char *json = "{\"a\": [1, \"two\", null], \"b\": {\"c\": false}, \"d\": 3}";
+
+	JSONStreamParser parser;
+	EventRecorder recorder;
+	CHECK(parser.parse_buffer((const uint8_t *)json, strlen(json), &recorder) == OK);
+	CHECK(String(" | ").join(recorder.events) == "{ | key a | [ | float 1.0 | String two | Nil <null> | ] | key b | { | key c | bool false | } | key d | float 3.0 | }");
+
+	// Returning an error from a callback stops parsing.
+	EventRecorder stopping;
+	stopping.stop_at_key = "b";
+	CHECK(parser.parse_buffer((const uint8_t *)json, strlen(json), &stopping) == ERR_SKIP);
+	CHECK(stopping.events[stopping.events.size() - 1] == "key b");
+	CHECK(parser.get_error_message() == "Parsing stopped by the handler.");
+}
+
+TEST_CASE("[JSONStreamParser] Parsing files") {
+	Array array;
+	for (int i = 0; i < 100; i++) {
+		Dictionary item;
+		item["id"] = i;
+		item["name"] = vformat("Item %d with a name longer than a chunk", i);
+		Array tags;
+		tags.push_back("a");
+		tags.push_back("b");
+		item["tags"] = tags;
+		array.push_back(item);
+	}
+	const String text = JSON::stringify(array, "\t");
+	const String path = TestUtils::get_temp_path("stream_parser.json");
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string(text);
+	}
+
+	JSONStreamParser parser;
+	parser.set_chunk_size(7);
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+	Variant data;
+	CHECK(parser.parse_file(f, data) == OK);
+	CHECK(data == JSON::parse_string(text));
+
+	// JSON resources are loaded through the stream parser outside the editor.
+	Ref<JSON> resource = ResourceLoader::load(path);
+	REQUIRE(resource.is_valid());
+	CHECK(resource->get_data() == JSON::parse_string(text));
+}
+
+// Benchmark comparing JSON::parse() on the decoded text with parsing the UTF-8 file
+// as it's read. Run with `--test --no-skip`.
+TEST_CASE("[JSONStreamParser][Benchmark] Throughput against JSON" * doctest::skip()) {
+	Array array;
+	for (int i = 0; i < 100000; i++) {
+		Dictionary item;
+		item["id"] = i;
+		item["name"] = vformat("Item %d", i);
+		item["description"] = "A longer description, as found in localization or dialogue files, with an \"escape\".";
+		Array position;
+		position.push_back(i * 0.5);
+		position.push_back(-i * 0.25);
+		position.push_back(1e-3);
+		item["position"] = position;
+		item["enabled"] = (i % 2) == 0;
+		item["parent"] = Variant();
+		array.push_back(item);
+	}
+	const String path = TestUtils::get_temp_path("stream_parser_benchmark.json");
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string(JSON::stringify(array, "\t"));
+	}
+	const double megabytes = FileAccess::get_file_as_bytes(path).size() / (1024.0 * 1024.0);
+
+	for (int pass = 0; pass < 2; pass++) {
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		JSON json;
+		REQUIRE(json.parse(FileAccess::get_file_as_string(path)) == OK);
+		const uint64_t json_usec = TestUtils::get_elapsed_usec(begin);
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		JSONStreamParser parser;
+		Variant data;
+		REQUIRE(parser.parse_file(FileAccess::open(path, FileAccess::READ), data) == OK);
+		const uint64_t stream_usec = TestUtils::get_elapsed_usec(begin);
+
+		CHECK(Array(data).size() == array.size());
+		print_line(vformat("Pass %d, %.1f MiB: JSON %d usec (%.1f MiB/s), stream parser %d usec (%.1f MiB/s).", pass + 1, megabytes, json_usec, megabytes * 1e6 / json_usec, stream_usec, megabytes * 1e6 / stream_usec));
+	}
+}
+
+} // namespace TestJSONStreamParser
+
+#endif // TEST_JSON_STREAM_PARSER_H
@@ -0,0 +1,133 @@
+/**************************************************************************/
+/*  test_pck_compression.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PCK_COMPRESSION_H
+#define TEST_PCK_COMPRESSION_H
+
+#include "core/io/pck_compression.h"
+#include "core/math/random_pcg.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPCKCompression {
+
+// Alike but not identical, as the resources of a project are.
+static Vector<uint8_t> make_resource(int p_seed) {
+	RandomPCG rng(p_seed);
+	String text = "RSRC";
+	for (int i = 0; i < 40; i++) {
+		text += vformat("[sub_resource type=\"StandardMaterial3D\" id=\"StandardMaterial3D_%d\"]\nalbedo_color = Color(%d, %d, %d, 1)\nmetallic = %d\n", rng.rand() % 100000, rng.rand() % 256, rng.rand() % 256, rng.rand() % 256, rng.rand() % 100);
+	}
+	return text.to_utf8_buffer();
+}
+
+static Vector<Vector<uint8_t>> make_resources(int p_count) {
+	Vector<Vector<uint8_t>> resources;
+	for (int i = 0; i < p_count; i++) {
+		resources.push_back(make_resource(i + 1));
+	}
+	return resources;
+}
+
+static Vector<uint8_t> decompress(const Vector<uint8_t> &p_compressed, uint64_t p_size, const Vector<uint8_t> &p_dictionary) {
+	const uint32_t table_size = PCKCompression::get_seek_table_size(p_compressed.ptr());
+	PCKCompression::SeekTable table;
+	if (table_size == 0 || PCKCompression::parse_seek_table(p_compressed.ptr(), table_size, p_size, table) != OK) {
+		return Vector<uint8_t>();
+	}
+
+	Vector<uint8_t> data;
+	data.resize(p_size);
+	for (uint32_t i = 0; i < table.get_frame_count(); i++) {
+		const uint64_t ofs = uint64_t(i) * table.frame_size;
+		const uint32_t size = MIN(p_size - ofs, uint64_t(table.frame_size));
+		if (!PCKCompression::decompress_frame(data.ptrw() + ofs, size, p_compressed.ptr() + table.frame_offsets[i], table.frame_offsets[i + 1] - table.frame_offsets[i], p_dictionary)) {
+			return Vector<uint8_t>();
+		}
+	}
+	return data;
+}
+
+TEST_CASE("[PCKCompression] Dictionary samples") {
+	CHECK(PCKCompression::is_dictionary_sample("res://level.scn"));
+	CHECK(PCKCompression::is_dictionary_sample("res://.godot/exported/133200997/export-material.RES"));
+	CHECK_FALSE(PCKCompression::is_dictionary_sample("res://level.tscn"));
+	CHECK_FALSE(PCKCompression::is_dictionary_sample("res://icon.png"));
+}
+
+TEST_CASE("[PCKCompression] Train a dictionary") {
+	CHECK_MESSAGE(PCKCompression::train_dictionary(make_resources(3)).is_empty(), "A handful of samples shouldn't be enough.");
+
+	const Vector<uint8_t> dictionary = PCKCompression::train_dictionary(make_resources(64), 4096);
+	CHECK(!dictionary.is_empty());
+	CHECK(dictionary.size() <= 4096);
+	CHECK_MESSAGE(dictionary == PCKCompression::train_dictionary(make_resources(64), 4096), "Training should be deterministic.");
+}
+
+TEST_CASE("[PCKCompression] Compress and decompress") {
+	const Vector<uint8_t> dictionary = PCKCompression::train_dictionary(make_resources(64));
+	const Vector<uint8_t> resource = make_resource(1000);
+
+	const Vector<uint8_t> with_dictionary = PCKCompression::compress(resource.ptr(), resource.size(), dictionary);
+	const Vector<uint8_t> without_dictionary = PCKCompression::compress(resource.ptr(), resource.size(), Vector<uint8_t>());
+	REQUIRE(!with_dictionary.is_empty());
+	REQUIRE(!without_dictionary.is_empty());
+	CHECK_MESSAGE(with_dictionary.size() < without_dictionary.size(), "The dictionary should help small resources.");
+	CHECK(decompress(with_dictionary, resource.size(), dictionary) == resource);
+	CHECK(decompress(without_dictionary, resource.size(), Vector<uint8_t>()) == resource);
+
+	// Several frames, the last one partial.
+	Vector<uint8_t> large;
+	for (int i = 0; large.size() < PCKCompression::FRAME_SIZE * 3 + 100; i++) {
+		large.append_array(make_resource(i));
+	}
+	const Vector<uint8_t> large_compressed = PCKCompression::compress(large.ptr(), large.size(), dictionary);
+	REQUIRE(!large_compressed.is_empty());
+	CHECK(decompress(large_compressed, large.size(), dictionary) == large);
+
+	ERR_PRINT_OFF;
+	CHECK_MESSAGE(decompress(large_compressed, large.size() + PCKCompression::FRAME_SIZE, dictionary).is_empty(), "The seek table should be checked against the size.");
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[PCKCompression] Incompressible data is left alone") {
+	RandomPCG rng(7);
+	Vector<uint8_t> noise;
+	noise.resize(10000);
+	for (int i = 0; i < noise.size(); i++) {
+		noise.write[i] = rng.rand() % 256;
+	}
+	CHECK(PCKCompression::compress(noise.ptr(), noise.size(), Vector<uint8_t>()).is_empty());
+	CHECK(PCKCompression::compress(nullptr, 0, Vector<uint8_t>()).is_empty());
+}
+
+} // namespace TestPCKCompression
+
+#endif // TEST_PCK_COMPRESSION_H
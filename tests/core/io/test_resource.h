@@ -31,6 +31,8 @@
 #ifndef TEST_RESOURCE_H
 #define TEST_RESOURCE_H
 
+#include "core/config/project_settings.h"
+#include "core/io/file_access.h"
 #include "core/io/resource.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
@@ -39,6 +41,7 @@
 #include "thirdparty/doctest/doctest.h"
 
 #include "tests/test_macros.h"
+#include "tests/test_utils.h"
 
 namespace TestResource {
 
@@ -112,6 +115,149 @@ TEST_CASE("[Resource] Saving and loading") {
 			"The loaded child resource name should be equal to the expected value.");
 }
 
+TEST_CASE("[Resource] Prefetch manifest") {
+	const String path_a = TestUtils::get_temp_path("prefetch_a.res");
+	const String path_b = TestUtils::get_temp_path("prefetch_b.tres");
+	const String manifest_path = TestUtils::get_temp_path("resources.prefetch");
+	{
+		Ref<Resource> resource_a = memnew(Resource);
+		resource_a->set_name("A");
+		ResourceSaver::save(resource_a, path_a);
+		Ref<Resource> resource_b = memnew(Resource);
+		resource_b->set_name("B");
+		ResourceSaver::save(resource_b, path_b);
+	}
+
+	ResourceLoader::start_prefetch_recording();
+	CHECK(ResourceLoader::is_prefetch_recording());
+	{
+		Ref<Resource> loaded_b = ResourceLoader::load(path_b);
+		Ref<Resource> loaded_a = ResourceLoader::load(path_a);
+		Ref<Resource> loaded_b_again = ResourceLoader::load(path_b, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	}
+	ResourceLoader::stop_prefetch_recording();
+	CHECK_FALSE(ResourceLoader::is_prefetch_recording());
+	REQUIRE(ResourceLoader::save_prefetch_manifest(manifest_path) == OK);
+
+	Vector<String> lines = FileAccess::get_file_as_string(manifest_path).strip_edges().split("\n");
+	REQUIRE_MESSAGE(lines.size() == 2, "Each resource should be listed once.");
+	CHECK_MESSAGE(lines[0].get_slice("\t", 2) == ProjectSettings::get_singleton()->localize_path(path_b), "Resources should be listed in order of first use.");
+	CHECK(lines[1].get_slice("\t", 2) == ProjectSettings::get_singleton()->localize_path(path_a));
+	CHECK(lines[0].get_slice("\t", 0).to_int() <= lines[1].get_slice("\t", 0).to_int());
+
+	CHECK_FALSE(ResourceCache::has(path_a));
+	REQUIRE(ResourceLoader::prefetch(manifest_path) == OK);
+	Ref<Resource> prefetched_a = ResourceLoader::load(path_a);
+	REQUIRE(prefetched_a.is_valid());
+	CHECK(prefetched_a->get_name() == "A");
+
+	// Clearing only releases what was not claimed.
+	ResourceLoader::clear_prefetch();
+	CHECK(ResourceCache::has(path_a));
+	Ref<Resource> loaded_b = ResourceLoader::load(path_b);
+	REQUIRE(loaded_b.is_valid());
+	CHECK(loaded_b->get_name() == "B");
+
+	{
+		Ref<FileAccess> f = FileAccess::open(manifest_path, FileAccess::WRITE);
+		f->store_line("not a manifest");
+	}
+	ERR_PRINT_OFF;
+	CHECK(ResourceLoader::prefetch(manifest_path) == ERR_PARSE_ERROR);
+	ERR_PRINT_ON;
+}
+
+// Resources holding mesh-like arrays, each referring to the previous one, under a single root.
+static Ref<Resource> make_resource_tree(int p_children, int p_vertices) {
+	Ref<Resource> root = memnew(Resource);
+	root->set_name("Root");
+	Array children;
+	Ref<Resource> previous;
+	for (int i = 0; i < p_children; i++) {
+		Ref<Resource> child = memnew(Resource);
+		child->set_name(vformat("Child %d", i));
+		PackedVector3Array vertices;
+		vertices.resize(p_vertices);
+		PackedInt32Array indices;
+		indices.resize(p_vertices);
+		for (int j = 0; j < p_vertices; j++) {
+			vertices.set(j, Vector3(i, j, i + j));
+			indices.set(j, p_vertices - j - 1);
+		}
+		child->set_meta("vertices", vertices);
+		child->set_meta("indices", indices);
+		if (previous.is_valid()) {
+			child->set_meta("previous", previous);
+		}
+		children.push_back(child);
+		previous = child;
+	}
+	root->set_meta("children", children);
+	return root;
+}
+
+static void check_resource_tree(const Ref<Resource> &p_root, int p_children, int p_vertices) {
+	REQUIRE(p_root.is_valid());
+	CHECK(p_root->get_name() == "Root");
+	Array children = p_root->get_meta("children");
+	REQUIRE(children.size() == p_children);
+	for (int i = 0; i < p_children; i++) {
+		Ref<Resource> child = children[i];
+		REQUIRE(child.is_valid());
+		CHECK(child->get_name() == vformat("Child %d", i));
+		PackedVector3Array vertices = child->get_meta("vertices");
+		PackedInt32Array indices = child->get_meta("indices");
+		REQUIRE(vertices.size() == p_vertices);
+		REQUIRE(indices.size() == p_vertices);
+		CHECK(vertices[p_vertices - 1] == Vector3(i, p_vertices - 1, i + p_vertices - 1));
+		CHECK(indices[0] == p_vertices - 1);
+		if (i > 0) {
+			CHECK(Ref<Resource>(child->get_meta("previous")) == Ref<Resource>(children[i - 1]));
+		}
+	}
+}
+
+TEST_CASE("[Resource] Loading binary resources with sub-threads") {
+	const String save_path = TestUtils::get_temp_path("resource_tree.res");
+	ResourceSaver::save(make_resource_tree(64, 100), save_path);
+
+	{
+		REQUIRE(ResourceLoader::load_threaded_request(save_path, "", true) == OK);
+		Ref<Resource> loaded = ResourceLoader::load_threaded_get(save_path);
+		check_resource_tree(loaded, 64, 100);
+	}
+	{
+		Ref<Resource> loaded = ResourceLoader::load(save_path);
+		check_resource_tree(loaded, 64, 100);
+	}
+}
+
+// Loads a synthetic file of 10,000 mesh-like sub-resources on the calling thread, then with sub-threads.
+// Run with `--test --no-skip`.
+TEST_CASE("[Resource][Benchmark] Loading binary resources with sub-threads" * doctest::skip()) {
+	const int children = 10000;
+	const int vertices = 500;
+	const String save_path = TestUtils::get_temp_path("resource_tree_benchmark.res");
+	ResourceSaver::save(make_resource_tree(children, vertices), save_path);
+
+	for (int sub_threads = 0; sub_threads <= 1; sub_threads++) {
+		for (int pass = 0; pass < 2; pass++) {
+			const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			Ref<Resource> loaded;
+			if (sub_threads) {
+				REQUIRE(ResourceLoader::load_threaded_request(save_path, "", true) == OK);
+				loaded = ResourceLoader::load_threaded_get(save_path);
+			} else {
+				loaded = ResourceLoader::load(save_path);
+			}
+			const uint64_t usec = TestUtils::get_elapsed_usec(begin);
+			REQUIRE(loaded.is_valid());
+			CHECK(Array(loaded->get_meta("children")).size() == children);
+			print_line(vformat("%s, pass %d: %d sub-resources in %d usec.", sub_threads ? "sub-threads" : "single thread", pass + 1, children, usec));
+		}
+	}
+}
+
 TEST_CASE("[Resource] Breaking circular references on save") {
 	Ref<Resource> resource_a = memnew(Resource);
 	resource_a->set_name("A");
@@ -0,0 +1,353 @@
+/**************************************************************************/
+/*  test_bulk_math.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_BULK_MATH_H
+#define TEST_BULK_MATH_H
+
+#include "core/math/bulk_math.h"
+#include "core/os/os.h"
+#include "core/variant/variant.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestBulkMath {
+
+// Sizes covering empty arrays, remainders and several full vector widths.
+static const int64_t test_sizes[] = { 0, 1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 33, 100 };
+
+static Vector<float> make_floats(int64_t p_count, float p_seed) {
+	Vector<float> ret;
+	ret.resize(p_count);
+	for (int64_t i = 0; i < p_count; i++) {
+		ret.write[i] = Math::sin(p_seed + i * 0.37f) * 100.0f;
+	}
+	return ret;
+}
+
+static Vector<Vector3> make_points(int64_t p_count, float p_seed) {
+	Vector<Vector3> ret;
+	ret.resize(p_count);
+	for (int64_t i = 0; i < p_count; i++) {
+		ret.write[i] = Vector3(Math::sin(p_seed + i * 0.37f), Math::cos(p_seed + i * 0.11f), Math::sin(p_seed - i * 0.23f)) * 50.0f;
+	}
+	return ret;
+}
+
+static Transform3D make_transform() {
+	// Non-orthogonal on purpose so rows and columns can't be mixed up.
+	return Transform3D(Basis(0.9, 0.2, -0.3, 0.1, 1.7, 0.4, -0.5, 0.3, 2.5), Vector3(5, -3, 2));
+}
+
+TEST_CASE("[BulkMath] Component-wise float operations") {
+	for (int64_t size : test_sizes) {
+		const Vector<float> a = make_floats(size, 1.0f);
+		const Vector<float> b = make_floats(size, 2.0f);
+		Vector<float> dst;
+		dst.resize(size);
+
+		BulkMath::add(a.ptr(), b.ptr(), dst.ptrw(), size);
+		for (int64_t i = 0; i < size; i++) {
+			CHECK(dst[i] == a[i] + b[i]);
+		}
+
+		BulkMath::multiply(a.ptr(), b.ptr(), dst.ptrw(), size);
+		for (int64_t i = 0; i < size; i++) {
+			CHECK(dst[i] == a[i] * b[i]);
+		}
+
+		BulkMath::scale(a.ptr(), 0.25f, dst.ptrw(), size);
+		for (int64_t i = 0; i < size; i++) {
+			CHECK(dst[i] == a[i] * 0.25f);
+		}
+
+		BulkMath::lerp(a.ptr(), b.ptr(), 0.3f, dst.ptrw(), size);
+		for (int64_t i = 0; i < size; i++) {
+			CHECK(dst[i] == doctest::Approx(Math::lerp(a[i], b[i], 0.3f)));
+		}
+	}
+}
+
+TEST_CASE("[BulkMath] Operations can write over their input") {
+	const int64_t size = 37;
+	const Vector<float> a = make_floats(size, 1.0f);
+	const Vector<float> b = make_floats(size, 2.0f);
+	Vector<float> dst = a;
+
+	BulkMath::add(dst.ptr(), b.ptr(), dst.ptrw(), size);
+	for (int64_t i = 0; i < size; i++) {
+		CHECK(dst[i] == a[i] + b[i]);
+	}
+
+	const Transform3D xform = make_transform();
+	const Vector<Vector3> points = make_points(size, 3.0f);
+	Vector<Vector3> transformed = points;
+	BulkMath::xform(xform, transformed.ptr(), transformed.ptrw(), size);
+	for (int64_t i = 0; i < size; i++) {
+		CHECK(transformed[i].is_equal_approx(xform.xform(points[i])));
+	}
+}
+
+TEST_CASE("[BulkMath] Float reductions") {
+	for (int64_t size : test_sizes) {
+		const Vector<float> a = make_floats(size, 1.0f);
+		const Vector<float> b = make_floats(size, 2.0f);
+
+		double sum = 0.0;
+		double dot = 0.0;
+		float min = size > 0 ? a[0] : 0.0f;
+		float max = min;
+		for (int64_t i = 0; i < size; i++) {
+			sum += a[i];
+			dot += (double)a[i] * b[i];
+			min = MIN(min, a[i]);
+			max = MAX(max, a[i]);
+		}
+
+		CHECK(BulkMath::sum(a.ptr(), size) == doctest::Approx(sum).epsilon(1e-4).scale(100.0));
+		CHECK(BulkMath::dot(a.ptr(), b.ptr(), size) == doctest::Approx(dot).epsilon(1e-4).scale(10000.0));
+
+		float r_min = 1234.0f;
+		float r_max = 1234.0f;
+		BulkMath::get_min_max(a.ptr(), size, r_min, r_max);
+		if (size > 0) {
+			CHECK(r_min == min);
+			CHECK(r_max == max);
+		} else {
+			CHECK_MESSAGE(r_min == 1234.0f, "An empty array should leave the results untouched.");
+			CHECK_MESSAGE(r_max == 1234.0f, "An empty array should leave the results untouched.");
+		}
+	}
+}
+
+TEST_CASE("[BulkMath] Vector3 operations") {
+	for (int64_t size : test_sizes) {
+		const Vector<Vector3> a = make_points(size, 1.0f);
+		const Vector<Vector3> b = make_points(size, 2.0f);
+		Vector<Vector3> dst;
+		dst.resize(size);
+
+		BulkMath::add(a.ptr(), b.ptr(), dst.ptrw(), size);
+		for (int64_t i = 0; i < size; i++) {
+			CHECK(dst[i] == a[i] + b[i]);
+		}
+
+		BulkMath::multiply(a.ptr(), b.ptr(), dst.ptrw(), size);
+		for (int64_t i = 0; i < size; i++) {
+			CHECK(dst[i] == a[i] * b[i]);
+		}
+
+		BulkMath::scale(a.ptr(), 2.0, dst.ptrw(), size);
+		for (int64_t i = 0; i < size; i++) {
+			CHECK(dst[i] == a[i] * 2.0);
+		}
+
+		BulkMath::lerp(a.ptr(), b.ptr(), 0.75, dst.ptrw(), size);
+		for (int64_t i = 0; i < size; i++) {
+			CHECK(dst[i].is_equal_approx(a[i].lerp(b[i], 0.75)));
+		}
+	}
+}
+
+TEST_CASE("[BulkMath] Transforming points") {
+	const Transform3D xform = make_transform();
+
+	for (int64_t size : test_sizes) {
+		const Vector<Vector3> points = make_points(size, 1.0f);
+		Vector<Vector3> dst;
+		dst.resize(size);
+
+		BulkMath::xform(xform, points.ptr(), dst.ptrw(), size);
+		for (int64_t i = 0; i < size; i++) {
+			CHECK(dst[i].is_equal_approx(xform.xform(points[i])));
+		}
+
+		BulkMath::xform_inv(xform, points.ptr(), dst.ptrw(), size);
+		for (int64_t i = 0; i < size; i++) {
+			CHECK(dst[i].is_equal_approx(xform.xform_inv(points[i])));
+		}
+	}
+
+	const Vector<Vector3> points = make_points(21, 4.0f);
+	const Vector<Vector3> transformed = xform.xform(points);
+	REQUIRE(transformed.size() == points.size());
+	for (int64_t i = 0; i < points.size(); i++) {
+		CHECK_MESSAGE(transformed[i].is_equal_approx(xform.xform(points[i])), "Transform3D array xform should use the same math as single points.");
+	}
+}
+
+TEST_CASE("[BulkMath] AABB of points") {
+	CHECK_MESSAGE(BulkMath::get_aabb(nullptr, 0) == AABB(), "An empty array should give an empty AABB.");
+
+	for (int64_t size : test_sizes) {
+		if (size == 0) {
+			continue;
+		}
+		const Vector<Vector3> points = make_points(size, 1.0f);
+
+		AABB expected(points[0], Vector3());
+		for (int64_t i = 1; i < size; i++) {
+			expected.expand_to(points[i]);
+		}
+
+		const AABB aabb = BulkMath::get_aabb(points.ptr(), size);
+		CHECK(aabb.is_equal_approx(expected));
+	}
+}
+
+TEST_CASE("[BulkMath] Packed array methods") {
+	PackedFloat32Array floats = { 3.0f, -1.0f, 4.0f, 1.5f, -5.0f };
+	Variant floats_variant = floats;
+
+	CHECK(double(floats_variant.call("sum")) == doctest::Approx(2.5));
+	CHECK(double(floats_variant.call("min")) == -5.0);
+	CHECK(double(floats_variant.call("max")) == 4.0);
+	CHECK(double(floats_variant.call("dot", floats)) == doctest::Approx(53.25));
+
+	PackedFloat32Array zeros;
+	zeros.resize(floats.size());
+	const PackedFloat32Array half = floats_variant.call("lerp", zeros, 0.5);
+	REQUIRE(half.size() == floats.size());
+	for (int64_t i = 0; i < floats.size(); i++) {
+		CHECK(half[i] == doctest::Approx(floats[i] * 0.5f));
+	}
+
+	ERR_PRINT_OFF;
+	CHECK_MESSAGE(PackedFloat32Array(floats_variant.call("lerp", PackedFloat32Array(), 0.5)).is_empty(), "Mismatched sizes should fail.");
+	CHECK_MESSAGE(double(Variant(PackedFloat32Array()).call("min")) == 0.0, "The minimum of an empty array should fail.");
+	CHECK_MESSAGE(double(Variant(PackedFloat32Array()).call("max")) == 0.0, "The maximum of an empty array should fail.");
+	ERR_PRINT_ON;
+
+	PackedVector3Array points = { Vector3(1, -2, 3), Vector3(-4, 5, 0), Vector3(2, 2, -6) };
+	Variant points_variant = points;
+	CHECK(AABB(points_variant.call("get_aabb")).is_equal_approx(AABB(Vector3(-4, -2, -6), Vector3(6, 7, 9))));
+	CHECK(AABB(Variant(PackedVector3Array()).call("get_aabb")) == AABB());
+}
+
+// Benchmark comparing the bulk kernels with per-element loops. Run with `--test --no-skip`.
+
+TEST_CASE("[BulkMath][Benchmark] Kernels vs. per-element loops" * doctest::skip()) {
+	const int64_t size = 1 << 16;
+	const int iterations = 200;
+
+	const Transform3D xform = make_transform();
+	const Vector<Vector3> points = make_points(size, 1.0f);
+	const Vector<Vector3> points_to = make_points(size, 2.0f);
+	const Vector<float> floats = make_floats(size, 1.0f);
+	Vector<Vector3> points_dst;
+	points_dst.resize(size);
+
+	print_line(vformat("Bulk math instruction set: %s, %d elements, %d iterations.", BulkMath::get_instruction_set(), size, iterations));
+
+	uint64_t loop_usec = 0;
+	uint64_t bulk_usec = 0;
+	double sink = 0.0;
+
+	// Transform3D.
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int it = 0; it < iterations; it++) {
+		const Vector3 *src = points.ptr();
+		Vector3 *dst = points_dst.ptrw();
+		for (int64_t i = 0; i < size; i++) {
+			dst[i] = xform.xform(src[i]);
+		}
+		sink += points_dst[it].x;
+	}
+	loop_usec = TestUtils::get_elapsed_usec(begin);
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int it = 0; it < iterations; it++) {
+		BulkMath::xform(xform, points.ptr(), points_dst.ptrw(), size);
+		sink += points_dst[it].x;
+	}
+	bulk_usec = TestUtils::get_elapsed_usec(begin);
+	print_line(vformat("xform: loop %d usec, bulk %d usec.", loop_usec, bulk_usec));
+
+	// Vector3 lerp.
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int it = 0; it < iterations; it++) {
+		const Vector3 *from = points.ptr();
+		const Vector3 *to = points_to.ptr();
+		Vector3 *dst = points_dst.ptrw();
+		for (int64_t i = 0; i < size; i++) {
+			dst[i] = from[i].lerp(to[i], 0.5);
+		}
+		sink += points_dst[it].x;
+	}
+	loop_usec = TestUtils::get_elapsed_usec(begin);
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int it = 0; it < iterations; it++) {
+		BulkMath::lerp(points.ptr(), points_to.ptr(), 0.5, points_dst.ptrw(), size);
+		sink += points_dst[it].x;
+	}
+	bulk_usec = TestUtils::get_elapsed_usec(begin);
+	print_line(vformat("lerp: loop %d usec, bulk %d usec.", loop_usec, bulk_usec));
+
+	// Sum.
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int it = 0; it < iterations; it++) {
+		const float *src = floats.ptr();
+		float sum = 0.0f;
+		for (int64_t i = 0; i < size; i++) {
+			sum += src[i];
+		}
+		sink += sum;
+	}
+	loop_usec = TestUtils::get_elapsed_usec(begin);
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int it = 0; it < iterations; it++) {
+		sink += BulkMath::sum(floats.ptr(), size);
+	}
+	bulk_usec = TestUtils::get_elapsed_usec(begin);
+	print_line(vformat("sum: loop %d usec, bulk %d usec.", loop_usec, bulk_usec));
+
+	// AABB.
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int it = 0; it < iterations; it++) {
+		const Vector3 *src = points.ptr();
+		AABB aabb(src[0], Vector3());
+		for (int64_t i = 1; i < size; i++) {
+			aabb.expand_to(src[i]);
+		}
+		sink += aabb.size.x;
+	}
+	loop_usec = TestUtils::get_elapsed_usec(begin);
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int it = 0; it < iterations; it++) {
+		sink += BulkMath::get_aabb(points.ptr(), size).size.x;
+	}
+	bulk_usec = TestUtils::get_elapsed_usec(begin);
+	print_line(vformat("get_aabb: loop %d usec, bulk %d usec.", loop_usec, bulk_usec));
+
+	CHECK(sink != 0.0);
+}
+
+} // namespace TestBulkMath
+
+#endif // TEST_BULK_MATH_H
@@ -32,8 +32,10 @@
 #define TEST_EXPRESSION_H
 
 #include "core/math/expression.h"
+#include "core/os/os.h"
 
 #include "tests/test_macros.h"
+#include "tests/test_utils.h"
 
 namespace TestExpression {
 
@@ -492,6 +494,169 @@ TEST_CASE("[Expression] Unusual expressions") {
 	//		int64_t(expression.execute()) == 0,
 	//		"`(-9223372036854775807 - 1) / -1` should return the expected result.");
 }
+
+template <typename... Args>
+static Array make_inputs(Args... p_args) {
+	Array inputs;
+	(inputs.push_back(p_args), ...);
+	return inputs;
+}
+
+TEST_CASE("[Expression] Compiled code matches the syntax tree") {
+	const char *sources[] = {
+		"a + b * 2",
+		"-a + ~b",
+		"a / b + a % b",
+		"x * 0.5 - sqrt(x)",
+		"(1 + 2) * 3 + a",
+		"Vector3(x, 1, 2).normalized().y",
+		"Vector2(3, 4).length() + a",
+		"max(a, b, 3) - min(x, 1.5)",
+		"[a, b, [x]][2][0]",
+		"{\"k\": a, 1: b}[1]",
+		"str(a) + \"_\" + str(b)",
+		"\"abc\".to_upper()[1]",
+		"a < b && !(x > 2.0) || a == 3",
+		"2 ** a",
+		"Color(0.5, 0.5, 0.5).r * x",
+	};
+	PackedStringArray names;
+	names.push_back("a");
+	names.push_back("b");
+	names.push_back("x");
+
+	Expression expression;
+	for (const char *source : sources) {
+		REQUIRE_MESSAGE(expression.parse(source, names) == OK, source);
+		for (int i = 0; i < 4; i++) {
+			Array inputs;
+			inputs.push_back(i + 3);
+			inputs.push_back(i * 2 + 1);
+			inputs.push_back(i * 1.25 + 0.5);
+			const Variant tree = expression.execute_tree(inputs);
+			const Variant compiled = expression.execute(inputs);
+			CHECK_MESSAGE(!expression.has_execute_failed(), source);
+			CHECK_MESSAGE(tree == compiled, source);
+		}
+	}
+}
+
+TEST_CASE("[Expression] Compiled code keeps errors and fresh containers") {
+	Expression expression;
+	PackedStringArray names;
+	names.push_back("a");
+	names.push_back("b");
+
+	// Integer division never uses a cached evaluator, so division by zero is still reported.
+	CHECK(expression.parse("a / b", names) == OK);
+	CHECK(int(expression.execute(make_inputs(8, 2))) == 4);
+	CHECK(int(expression.execute(make_inputs(9, 3))) == 3);
+	ERR_PRINT_OFF;
+	expression.execute(make_inputs(8, 0));
+	ERR_PRINT_ON;
+	CHECK(expression.has_execute_failed());
+
+	// Operand types changing between executions.
+	CHECK(expression.parse("a * b", names) == OK);
+	CHECK(int(expression.execute(make_inputs(3, 4))) == 12);
+	CHECK(double(expression.execute(make_inputs(1.5, 4))) == doctest::Approx(6.0));
+	CHECK(Vector2(expression.execute(make_inputs(Vector2(1, 2), 2))) == Vector2(2, 4));
+
+	// Errors in constant expressions are reported when executing, not when parsing.
+	CHECK(expression.parse("1 + \"a\"") == OK);
+	ERR_PRINT_OFF;
+	expression.execute();
+	ERR_PRINT_ON;
+	CHECK(expression.has_execute_failed());
+
+	CHECK(expression.parse("[1, 2]") == OK);
+	Array first = expression.execute();
+	Array second = expression.execute();
+	first.push_back(3);
+	CHECK(first.size() == 3);
+	CHECK(second.size() == 2);
+
+	CHECK(expression.parse("PackedInt32Array([1, 2])") == OK);
+	Variant first_packed = expression.execute();
+	Variant second_packed = expression.execute();
+	bool valid = false;
+	first_packed.set(0, 5, &valid);
+	CHECK(valid);
+	CHECK(int(second_packed.get(0)) == 1);
+}
+
+TEST_CASE("[Expression] Batch execution") {
+	Expression expression;
+	PackedStringArray names;
+	names.push_back("base_damage");
+	names.push_back("strength");
+	CHECK(expression.parse("base_damage * (1.0 + strength * 0.1)", names) == OK);
+
+	Array rows;
+	rows.push_back(make_inputs(10, 2));
+	rows.push_back(make_inputs(15, 0));
+	rows.push_back(make_inputs(8, 5));
+	Array results = expression.execute_batch(rows);
+	CHECK(!expression.has_execute_failed());
+	REQUIRE(results.size() == 3);
+	CHECK(double(results[0]) == doctest::Approx(12.0));
+	CHECK(double(results[1]) == doctest::Approx(15.0));
+	CHECK(double(results[2]) == doctest::Approx(12.0));
+
+	CHECK(expression.execute_batch(Array()).is_empty());
+
+	rows.push_back(make_inputs(1));
+	ERR_PRINT_OFF;
+	CHECK(expression.execute_batch(rows).is_empty());
+	ERR_PRINT_ON;
+	CHECK(expression.has_execute_failed());
+	CHECK(expression.get_error_text() == "Invalid input 1 (not passed) in expression");
+
+	rows.clear();
+	rows.push_back(5);
+	ERR_PRINT_OFF;
+	CHECK(expression.execute_batch(rows).is_empty());
+	ERR_PRINT_ON;
+	CHECK(expression.has_execute_failed());
+}
+
+// Benchmark comparing the syntax tree walker with the compiled code. Run with `--test --no-skip`.
+TEST_CASE("[Expression][Benchmark] Syntax tree vs. compiled code vs. batch" * doctest::skip()) {
+	Expression expression;
+	PackedStringArray names;
+	names.push_back("base_damage");
+	names.push_back("strength");
+	names.push_back("armor");
+	CHECK(expression.parse("max(base_damage * (1.0 + strength * 0.1) - armor * 0.5, 1.0) * (2.0 / 3.0)", names) == OK);
+
+	const int count = 100000;
+	Array rows;
+	rows.resize(count);
+	for (int i = 0; i < count; i++) {
+		rows[i] = make_inputs(10 + i % 7, i % 5, (i % 11) * 0.5);
+	}
+
+	double sink = 0.0;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < count; i++) {
+		sink += double(expression.execute_tree(rows[i]));
+	}
+	const uint64_t tree_usec = TestUtils::get_elapsed_usec(begin);
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < count; i++) {
+		sink -= double(expression.execute(rows[i]));
+	}
+	const uint64_t compiled_usec = TestUtils::get_elapsed_usec(begin);
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	Array results = expression.execute_batch(rows);
+	const uint64_t batch_usec = TestUtils::get_elapsed_usec(begin);
+
+	print_line(vformat("%d executions: syntax tree %d usec, compiled %d usec, batch %d usec.", count, tree_usec, compiled_usec, batch_usec));
+	CHECK(sink == doctest::Approx(0.0));
+	CHECK(results.size() == count);
+}
 } // namespace TestExpression
 
 #endif // TEST_EXPRESSION_H
@@ -0,0 +1,180 @@
+/**************************************************************************/
+/*  test_message_queue.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_MESSAGE_QUEUE_H
+#define TEST_MESSAGE_QUEUE_H
+
+#include "core/object/message_queue.h"
+#include "core/os/thread.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMessageQueue {
+
+static LocalVector<int> received;
+static CallQueue *reentrant_queue = nullptr;
+
+static void record(int p_value) {
+	received.push_back(p_value);
+}
+
+static void record_and_push(int p_value) {
+	received.push_back(p_value);
+	if (p_value < 10) {
+		reentrant_queue->push_callable(callable_mp_static(&record_and_push), p_value + 1);
+	}
+}
+
+TEST_CASE("[CallQueue] Flush calls in submission order across pages") {
+	CallQueue queue;
+	CHECK_FALSE(queue.has_messages());
+
+	received.clear();
+	// Plenty of messages with a varying number of arguments, so many pages are used and filled unevenly.
+	const int count = 10000;
+	for (int i = 0; i < count; i++) {
+		if (i % 3 == 0) {
+			CHECK(queue.push_callable(callable_mp_static(&record).bind(i)) == OK);
+		} else {
+			CHECK(queue.push_callable(callable_mp_static(&record), i) == OK);
+		}
+	}
+	CHECK(queue.has_messages());
+	CHECK(queue.get_max_buffer_usage() > CallQueue::PAGE_SIZE_BYTES);
+
+	CHECK(queue.flush() == OK);
+	CHECK_FALSE(queue.has_messages());
+	REQUIRE(received.size() == count);
+	bool in_order = true;
+	for (int i = 0; i < count; i++) {
+		in_order &= received[i] == i;
+	}
+	CHECK(in_order);
+
+	// Pages are reused after flushing.
+	int max_buffer_usage = queue.get_max_buffer_usage();
+	received.clear();
+	for (int i = 0; i < count; i++) {
+		queue.push_callable(callable_mp_static(&record), i);
+	}
+	queue.flush();
+	CHECK(received.size() == count);
+	CHECK(queue.get_max_buffer_usage() == max_buffer_usage);
+}
+
+TEST_CASE("[CallQueue] Messages pushed while flushing are flushed too") {
+	CallQueue queue;
+	reentrant_queue = &queue;
+
+	received.clear();
+	queue.push_callable(callable_mp_static(&record_and_push), 0);
+	CHECK(queue.flush() == OK);
+	CHECK_FALSE(queue.has_messages());
+
+	REQUIRE(received.size() == 11);
+	for (int i = 0; i <= 10; i++) {
+		CHECK(received[i] == i);
+	}
+
+	// Clearing discards without calling.
+	received.clear();
+	queue.push_callable(callable_mp_static(&record), 1);
+	queue.clear();
+	CHECK_FALSE(queue.has_messages());
+	queue.flush();
+	CHECK(received.is_empty());
+
+	reentrant_queue = nullptr;
+}
+
+static const int PRODUCER_COUNT = 4;
+static const int MESSAGES_PER_PRODUCER = 20000;
+static LocalVector<int> last_received_per_producer;
+static SafeNumeric<int> out_of_order;
+static SafeNumeric<int> producers_done;
+
+static void record_from_producer(int p_producer, int p_sequence) {
+	if (last_received_per_producer[p_producer] + 1 != p_sequence) {
+		out_of_order.increment();
+	}
+	last_received_per_producer[p_producer] = p_sequence;
+}
+
+struct ProducerData {
+	CallQueue *queue = nullptr;
+	int index = 0;
+};
+
+static void producer_func(void *p_userdata) {
+	ProducerData *data = (ProducerData *)p_userdata;
+	for (int i = 0; i < MESSAGES_PER_PRODUCER; i++) {
+		data->queue->push_callable(callable_mp_static(&record_from_producer), data->index, i);
+	}
+	producers_done.increment();
+}
+
+TEST_CASE("[CallQueue] Pushing from several threads while flushing") {
+	CallQueue queue;
+
+	last_received_per_producer.resize(PRODUCER_COUNT);
+	for (int i = 0; i < PRODUCER_COUNT; i++) {
+		last_received_per_producer[i] = -1;
+	}
+	out_of_order.set(0);
+	producers_done.set(0);
+
+	Thread producers[PRODUCER_COUNT];
+	ProducerData producer_data[PRODUCER_COUNT];
+	for (int i = 0; i < PRODUCER_COUNT; i++) {
+		producer_data[i].queue = &queue;
+		producer_data[i].index = i;
+		producers[i].start(producer_func, &producer_data[i]);
+	}
+
+	while (producers_done.get() < PRODUCER_COUNT) {
+		queue.flush();
+	}
+	for (int i = 0; i < PRODUCER_COUNT; i++) {
+		producers[i].wait_to_finish();
+	}
+	queue.flush();
+
+	CHECK(out_of_order.get() == 0);
+	bool all_received = true;
+	for (int i = 0; i < PRODUCER_COUNT; i++) {
+		all_received &= last_received_per_producer[i] == MESSAGES_PER_PRODUCER - 1;
+	}
+	CHECK(all_received);
+	CHECK_FALSE(queue.has_messages());
+}
+
+} // namespace TestMessageQueue
+
+#endif // TEST_MESSAGE_QUEUE_H
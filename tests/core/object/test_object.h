@@ -34,8 +34,12 @@
 #include "core/object/class_db.h"
 #include "core/object/object.h"
 #include "core/object/script_language.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
 
 #include "tests/test_macros.h"
+#include "tests/test_utils.h"
 
 #ifdef SANITIZERS_ENABLED
 #ifdef __has_feature
@@ -602,6 +606,226 @@ TEST_CASE("[Object] Destruction at the end of the call chain is safe") {
 			"Object was tail-deleted without crashes.");
 }
 
+TEST_CASE("[Object] Pooled instances") {
+	ClassDB::set_class_pooled("Object", true);
+	CHECK(ClassDB::is_class_pooled("Object"));
+	CHECK_FALSE(ClassDB::is_class_pooled("RefCounted"));
+
+	const ClassDB::PoolCounters before = ClassDB::get_class_pool_counters("Object");
+
+	Object *object = ClassDB::instantiate("Object");
+	REQUIRE(object != nullptr);
+	const ObjectID first_id = object->get_instance_id();
+	CHECK(ObjectDB::get_instance(first_id) == object);
+	CHECK(ClassDB::get_class_pool_counters("Object").live == before.live + 1);
+
+	object->set_meta("test", 1);
+	memdelete(object);
+	CHECK_MESSAGE(
+			ObjectDB::get_instance(first_id) == nullptr,
+			"Freed pooled instance is no longer reachable through its ID.");
+	CHECK(ClassDB::get_class_pool_counters("Object").live == before.live);
+	CHECK(ClassDB::get_class_pool_counters("Object").pooled >= 1);
+
+	Object *reused = ClassDB::instantiate("Object");
+	REQUIRE(reused != nullptr);
+	CHECK_MESSAGE(
+			reused->get_instance_id() != first_id,
+			"Recycled slot gets a new instance ID.");
+	CHECK(ObjectDB::get_instance(first_id) == nullptr);
+	CHECK_MESSAGE(
+			!reused->has_meta("test"),
+			"Recycled slot is constructed from scratch.");
+	memdelete(reused);
+
+	// Instances created directly bypass the pool.
+	Object *direct = memnew(Object);
+	CHECK(ClassDB::get_class_pool_counters("Object").live == before.live);
+	memdelete(direct);
+
+	ClassDB::set_class_pooled("RefCounted", true);
+	const ClassDB::PoolCounters ref_before = ClassDB::get_class_pool_counters("RefCounted");
+	{
+		Ref<RefCounted> ref = Object::cast_to<RefCounted>(ClassDB::instantiate("RefCounted"));
+		REQUIRE(ref.is_valid());
+		CHECK(ClassDB::get_class_pool_counters("RefCounted").live == ref_before.live + 1);
+	}
+	CHECK_MESSAGE(
+			ClassDB::get_class_pool_counters("RefCounted").live == ref_before.live,
+			"Releasing the last reference returns the instance to the pool.");
+
+	ClassDB::set_class_pooled("RefCounted", false);
+	ClassDB::set_class_pooled("Object", false);
+	CHECK_FALSE(ClassDB::is_class_pooled("Object"));
+
+	// Disabling pooling keeps the counters, but new instances no longer use the pool.
+	const ClassDB::PoolCounters after = ClassDB::get_class_pool_counters("Object");
+	Object *unpooled = ClassDB::instantiate("Object");
+	CHECK(ClassDB::get_class_pool_counters("Object").live == after.live);
+	memdelete(unpooled);
+}
+
+TEST_CASE("[ObjectDB] Instance lookup") {
+	Object *object = memnew(Object);
+	Object *other = memnew(Object);
+	const ObjectID id = object->get_instance_id();
+	const ObjectID other_id = other->get_instance_id();
+
+	CHECK(ObjectDB::get_instance(id) == object);
+	CHECK(ObjectDB::get_instance(other_id) == other);
+	CHECK(ObjectDB::get_instance(ObjectID()) == nullptr);
+
+	memdelete(other);
+	CHECK(ObjectDB::get_instance(other_id) == nullptr);
+
+	const ObjectID ids[] = { id, other_id, ObjectID(), id };
+	Object *objects[4] = {};
+	ObjectDB::get_instances(ids, objects, 4);
+	CHECK(objects[0] == object);
+	CHECK(objects[1] == nullptr);
+	CHECK(objects[2] == nullptr);
+	CHECK(objects[3] == object);
+
+	memdelete(object);
+	CHECK(ObjectDB::get_instance(id) == nullptr);
+}
+
+struct ObjectDBTestData {
+	LocalVector<ObjectID> live_ids;
+	LocalVector<Object *> live_objects;
+	LocalVector<ObjectID> stale_ids;
+	SafeNumeric<uint32_t> errors;
+	SafeFlag done;
+	int iterations = 0;
+};
+
+static void objectdb_lookup_thread_func(void *p_userdata) {
+	ObjectDBTestData *data = (ObjectDBTestData *)p_userdata;
+	for (int i = 0; i < data->iterations; i++) {
+		for (uint32_t j = 0; j < data->live_ids.size(); j++) {
+			if (ObjectDB::get_instance(data->live_ids[j]) != data->live_objects[j]) {
+				data->errors.increment();
+			}
+			if (ObjectDB::get_instance(data->stale_ids[j]) != nullptr) {
+				data->errors.increment();
+			}
+		}
+	}
+}
+
+static void objectdb_churn_thread_func(void *p_userdata) {
+	ObjectDBTestData *data = (ObjectDBTestData *)p_userdata;
+	// Recycles slots, and grows the slot table, while the lookups run.
+	LocalVector<Object *> objects;
+	while (!data->done.is_set()) {
+		for (int i = 0; i < 5000; i++) {
+			objects.push_back(memnew(Object));
+		}
+		for (Object *object : objects) {
+			memdelete(object);
+		}
+		objects.clear();
+	}
+}
+
+TEST_CASE("[ObjectDB] Concurrent lookup") {
+	ObjectDBTestData data;
+	data.iterations = 200;
+	for (int i = 0; i < 1000; i++) {
+		Object *object = memnew(Object);
+		data.live_objects.push_back(object);
+		data.live_ids.push_back(object->get_instance_id());
+
+		Object *stale = memnew(Object);
+		data.stale_ids.push_back(stale->get_instance_id());
+		memdelete(stale);
+	}
+
+	Thread churn_thread;
+	churn_thread.start(objectdb_churn_thread_func, &data);
+	const int thread_count = 4;
+	Thread threads[thread_count];
+	for (int i = 0; i < thread_count; i++) {
+		threads[i].start(objectdb_lookup_thread_func, &data);
+	}
+	for (int i = 0; i < thread_count; i++) {
+		threads[i].wait_to_finish();
+	}
+	data.done.set();
+	churn_thread.wait_to_finish();
+
+	CHECK(data.errors.get() == 0);
+	for (Object *object : data.live_objects) {
+		memdelete(object);
+	}
+}
+
+// Benchmark of ObjectDB::get_instance() from several threads at once. Run with `--test --no-skip`.
+
+struct ObjectDBBenchmarkData {
+	LocalVector<ObjectID> ids;
+	SafeNumeric<uint64_t> found;
+	int iterations = 0;
+	bool batch = false;
+};
+
+static void objectdb_benchmark_thread_func(void *p_userdata) {
+	ObjectDBBenchmarkData *data = (ObjectDBBenchmarkData *)p_userdata;
+	LocalVector<Object *> objects;
+	objects.resize(data->ids.size());
+	uint64_t found = 0;
+
+	for (int i = 0; i < data->iterations; i++) {
+		if (data->batch) {
+			ObjectDB::get_instances(data->ids.ptr(), objects.ptr(), data->ids.size());
+		} else {
+			for (uint32_t j = 0; j < data->ids.size(); j++) {
+				objects[j] = ObjectDB::get_instance(data->ids[j]);
+			}
+		}
+		found += objects[i % objects.size()] != nullptr;
+	}
+	data->found.add(found);
+}
+
+static void benchmark_lookup(const char *p_label, ObjectDBBenchmarkData &p_data) {
+	const int thread_counts[] = { 1, 2, 4, 8 };
+	for (int thread_count : thread_counts) {
+		Thread threads[8];
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < thread_count; i++) {
+			threads[i].start(objectdb_benchmark_thread_func, &p_data);
+		}
+		for (int i = 0; i < thread_count; i++) {
+			threads[i].wait_to_finish();
+		}
+		const uint64_t usec = TestUtils::get_elapsed_usec(begin);
+		const double lookups = double(thread_count) * p_data.iterations * p_data.ids.size();
+
+		print_line(vformat("%s, %d threads: %d ms, %.1f M lookups/s", p_label, thread_count, usec / 1000, lookups / usec));
+	}
+	CHECK(p_data.found.get() == uint64_t(15 * p_data.iterations));
+	p_data.found.set(0);
+}
+
+TEST_CASE("[ObjectDB][Benchmark] Lookup from several threads" * doctest::skip()) {
+	ObjectDBBenchmarkData data;
+	data.iterations = 1000;
+	LocalVector<Object *> objects;
+	for (int i = 0; i < 10000; i++) {
+		objects.push_back(memnew(Object));
+		data.ids.push_back(objects[i]->get_instance_id());
+	}
+
+	benchmark_lookup("get_instance()", data);
+	data.batch = true;
+	benchmark_lookup("get_instances()", data);
+
+	for (Object *object : objects) {
+		memdelete(object);
+	}
+}
+
 } // namespace TestObject
 
 #endif // TEST_OBJECT_H
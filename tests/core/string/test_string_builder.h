@@ -0,0 +1,116 @@
+/**************************************************************************/
+/*  test_string_builder.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_STRING_BUILDER_H
+#define TEST_STRING_BUILDER_H
+
+#include "core/string/string_builder.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringBuilder {
+
+TEST_CASE("[StringBuilder] Append") {
+	StringBuilder sb;
+	CHECK(sb.as_string() == "");
+
+	sb.append("Hello");
+	sb.append(String());
+	sb.append(String::utf8(", wörld"));
+	sb += U'!';
+
+	CHECK(sb.as_string() == String::utf8("Hello, wörld!"));
+	CHECK(sb.get_string_length() == 13);
+	// Empty Godot strings are skipped, characters and C strings are not.
+	CHECK(sb.num_strings_appended() == 3);
+
+	sb.clear();
+	CHECK(sb.get_string_length() == 0);
+	CHECK(sb.as_string() == "");
+}
+
+TEST_CASE("[StringBuilder] Growth beyond the inline buffer") {
+	String expected;
+	StringBuilder heap;
+	StringBuilder arena(StringBuilder::STORAGE_SCRATCH_ARENA);
+	for (int i = 0; i < 1000; i++) {
+		const String number = itos(i);
+		expected += number;
+		heap += number;
+		arena += number;
+	}
+
+	CHECK(heap.as_string() == expected);
+	CHECK(arena.as_string() == expected);
+	CHECK(arena.get_string_length() == (uint32_t)expected.length());
+}
+
+TEST_CASE("[StringBuilder] Nested scratch builders") {
+	StringBuilder outer(StringBuilder::STORAGE_SCRATCH_ARENA);
+	outer += String("a").repeat(100);
+	{
+		StringBuilder inner(StringBuilder::STORAGE_SCRATCH_ARENA);
+		inner += String("b").repeat(200);
+		// Outer is no longer the topmost allocation and must move.
+		outer += String("c").repeat(100);
+		CHECK(inner.as_string() == String("b").repeat(200));
+	}
+	outer += U'd';
+	CHECK(outer.as_string() == String("a").repeat(100) + String("c").repeat(100) + "d");
+
+	// Larger than the whole arena, falls back to the heap.
+	StringBuilder huge(StringBuilder::STORAGE_SCRATCH_ARENA);
+	const String chunk = String("x").repeat(1000);
+	for (int i = 0; i < 100; i++) {
+		huge += chunk;
+	}
+	CHECK(huge.get_string_length() == 100000);
+	CHECK(huge.as_string() == chunk.repeat(100));
+	CHECK(outer.as_string().length() == 201);
+}
+
+TEST_CASE("[StringBuilder] Copy") {
+	StringBuilder arena(StringBuilder::STORAGE_SCRATCH_ARENA);
+	arena += String("z").repeat(500);
+
+	StringBuilder copy = arena;
+	arena += "tail";
+	CHECK(copy.as_string() == String("z").repeat(500));
+	CHECK(copy.num_strings_appended() == 1);
+
+	StringBuilder assigned;
+	assigned += "replaced";
+	assigned = arena;
+	CHECK(assigned.as_string() == String("z").repeat(500) + "tail");
+}
+
+} // namespace TestStringBuilder
+
+#endif // TEST_STRING_BUILDER_H
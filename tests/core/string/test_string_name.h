@@ -0,0 +1,194 @@
+/**************************************************************************/
+/*  test_string_name.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_STRING_NAME_H
+#define TEST_STRING_NAME_H
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Interning") {
+	const StringName from_cstring("test_string_name_interning");
+	const StringName from_string(String("test_string_name_interning"));
+	const StringName from_static_cstring(StaticCString::create("test_string_name_interning"));
+
+	CHECK(from_cstring == from_string);
+	CHECK(from_cstring == from_static_cstring);
+	CHECK(from_cstring.data_unique_pointer() == from_string.data_unique_pointer());
+	CHECK(from_cstring.hash() == String("test_string_name_interning").hash());
+	CHECK(String(from_cstring) == "test_string_name_interning");
+
+	CHECK(StringName::search("test_string_name_interning") == from_cstring);
+	CHECK(StringName::search(U"test_string_name_interning") == from_cstring);
+	CHECK(StringName::search(String("test_string_name_interning")) == from_cstring);
+
+	CHECK(from_cstring != StringName("test_string_name_interning_other"));
+	CHECK(StringName("") == StringName());
+}
+
+TEST_CASE("[StringName] Released names are removed from the table") {
+	{
+		StringName name("test_string_name_released");
+		StringName copy = name;
+		CHECK(StringName::search("test_string_name_released") == name);
+	}
+	CHECK(StringName::search("test_string_name_released") == StringName());
+
+	// The entry is recycled, interning works again.
+	const StringName name(String("test_string_name_released"));
+	CHECK(StringName::search("test_string_name_released") == name);
+	CHECK(String(name) == "test_string_name_released");
+}
+
+TEST_CASE("[StringName] Static names are kept") {
+	{
+		StringName name("test_string_name_static", true);
+		StringName copy = name;
+	}
+	// Static names are never released, even when no copy is left.
+	const StringName found = StringName::search("test_string_name_static");
+	CHECK(String(found) == "test_string_name_static");
+}
+
+struct ConcurrentTestData {
+	LocalVector<String> names;
+	SafeNumeric<uint32_t> errors;
+	int iterations = 0;
+};
+
+static void concurrent_intern_thread_func(void *p_userdata) {
+	ConcurrentTestData *data = (ConcurrentTestData *)p_userdata;
+	const uint32_t count = data->names.size();
+	const uint32_t offset = (uint32_t)Thread::get_caller_id() % count;
+
+	for (int i = 0; i < data->iterations; i++) {
+		for (uint32_t j = 0; j < count; j++) {
+			const String &string = data->names[(j + offset) % count];
+			// Short lived names, so entries keep being released and recycled.
+			const StringName name(string);
+			if (name != StringName(string.utf8().get_data()) || name != StringName::search(string) || String(name) != string) {
+				data->errors.increment();
+			}
+		}
+	}
+}
+
+TEST_CASE("[StringName] Concurrent interning") {
+	ConcurrentTestData data;
+	data.iterations = 20;
+	for (int i = 0; i < 1000; i++) {
+		data.names.push_back("test_string_name_concurrent_" + itos(i));
+	}
+
+	// Half of the names stay alive, the other half gets released and recycled.
+	LocalVector<StringName> kept;
+	for (uint32_t i = 0; i < data.names.size(); i += 2) {
+		kept.push_back(StringName(data.names[i]));
+	}
+
+	const int thread_count = 4;
+	Thread threads[thread_count];
+	for (int i = 0; i < thread_count; i++) {
+		threads[i].start(concurrent_intern_thread_func, &data);
+	}
+	for (int i = 0; i < thread_count; i++) {
+		threads[i].wait_to_finish();
+	}
+
+	CHECK(data.errors.get() == 0);
+	for (uint32_t i = 0; i < kept.size(); i++) {
+		CHECK(kept[i] == StringName(data.names[i * 2]));
+	}
+}
+
+// Benchmark of StringName construction from several threads at once. Run with `--test --no-skip`.
+
+struct BenchmarkData {
+	LocalVector<String> names;
+	int iterations = 0;
+};
+
+static void benchmark_thread_func(void *p_userdata) {
+	BenchmarkData *data = (BenchmarkData *)p_userdata;
+	const uint32_t count = data->names.size();
+
+	for (int i = 0; i < data->iterations; i++) {
+		for (uint32_t j = 0; j < count; j++) {
+			const StringName name(data->names[j]);
+		}
+	}
+}
+
+static void benchmark_interning(const char *p_label, BenchmarkData &p_data) {
+	const int thread_counts[] = { 1, 2, 4, 8 };
+	for (int thread_count : thread_counts) {
+		Thread threads[8];
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < thread_count; i++) {
+			threads[i].start(benchmark_thread_func, &p_data);
+		}
+		for (int i = 0; i < thread_count; i++) {
+			threads[i].wait_to_finish();
+		}
+		const uint64_t usec = TestUtils::get_elapsed_usec(begin);
+		const double constructions = double(thread_count) * p_data.iterations * p_data.names.size();
+
+		print_line(vformat("%s, %d threads: %d ms, %.1f M constructions/s", p_label, thread_count, usec / 1000, constructions / usec));
+	}
+}
+
+TEST_CASE("[StringName][Benchmark] Construction from several threads" * doctest::skip()) {
+	BenchmarkData data;
+	data.iterations = 200;
+	for (int i = 0; i < 10000; i++) {
+		data.names.push_back("test_string_name_benchmark_" + itos(i));
+	}
+
+	// Every name is released at the end of each construction.
+	benchmark_interning("Released names", data);
+
+	// Every name is already interned, which is the common case.
+	LocalVector<StringName> kept;
+	for (const String &name : data.names) {
+		kept.push_back(StringName(name));
+	}
+	benchmark_interning("Existing names", data);
+}
+
+} // namespace TestStringName
+
+#endif // TEST_STRING_NAME_H
@@ -0,0 +1,451 @@
+/**************************************************************************/
+/*  test_swiss_hash_map.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SWISS_HASH_MAP_H
+#define TEST_SWISS_HASH_MAP_H
+
+#include "core/os/os.h"
+#include "core/templates/a_hash_map.h"
+#include "core/templates/oa_hash_map.h"
+#include "core/templates/swiss_hash_map.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestSwissHashMap {
+
+TEST_CASE("[SwissHashMap] List initialization") {
+	SwissHashMap<int, String> map{ { 0, "A" }, { 1, "B" }, { 2, "C" }, { 3, "D" }, { 4, "E" } };
+
+	CHECK(map.size() == 5);
+	CHECK(map[0] == "A");
+	CHECK(map[1] == "B");
+	CHECK(map[2] == "C");
+	CHECK(map[3] == "D");
+	CHECK(map[4] == "E");
+}
+
+TEST_CASE("[SwissHashMap] List initialization with existing elements") {
+	SwissHashMap<int, String> map{ { 0, "A" }, { 0, "B" }, { 0, "C" }, { 0, "D" }, { 0, "E" } };
+
+	CHECK(map.size() == 1);
+	CHECK(map[0] == "E");
+}
+
+TEST_CASE("[SwissHashMap] Insert element") {
+	SwissHashMap<int, int> map;
+	SwissHashMap<int, int>::Iterator e = map.insert(42, 84);
+
+	CHECK(e);
+	CHECK(e->key == 42);
+	CHECK(e->value == 84);
+	CHECK(map[42] == 84);
+	CHECK(map.has(42));
+	CHECK(map.find(42));
+}
+
+TEST_CASE("[SwissHashMap] Overwrite element") {
+	SwissHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(42, 1234);
+
+	CHECK(map[42] == 1234);
+}
+
+TEST_CASE("[SwissHashMap] Erase via element") {
+	SwissHashMap<int, int> map;
+	SwissHashMap<int, int>::Iterator e = map.insert(42, 84);
+	map.remove(e);
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+}
+
+TEST_CASE("[SwissHashMap] Erase via key") {
+	SwissHashMap<int, int> map;
+	map.insert(42, 84);
+	map.erase(42);
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+}
+
+TEST_CASE("[SwissHashMap] Size") {
+	SwissHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(123, 84);
+	map.insert(123, 84);
+	map.insert(0, 84);
+	map.insert(123485, 84);
+
+	CHECK(map.size() == 4);
+}
+
+TEST_CASE("[SwissHashMap] Iteration") {
+	SwissHashMap<int, int> map;
+
+	map.insert(42, 84);
+	map.insert(123, 12385);
+	map.insert(0, 12934);
+	map.insert(123485, 1238888);
+	map.insert(123, 111111);
+
+	Vector<Pair<int, int>> expected;
+	expected.push_back(Pair<int, int>(42, 84));
+	expected.push_back(Pair<int, int>(123, 111111));
+	expected.push_back(Pair<int, int>(0, 12934));
+	expected.push_back(Pair<int, int>(123485, 1238888));
+
+	int idx = 0;
+	for (const KeyValue<int, int> &E : map) {
+		CHECK(expected[idx] == Pair<int, int>(E.key, E.value));
+		idx++;
+	}
+
+	idx--;
+	for (SwissHashMap<int, int>::Iterator it = map.last(); it; --it) {
+		CHECK(expected[idx] == Pair<int, int>(it->key, it->value));
+		idx--;
+	}
+}
+
+TEST_CASE("[SwissHashMap] Const iteration") {
+	SwissHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(123, 12385);
+	map.insert(0, 12934);
+	map.insert(123485, 1238888);
+	map.insert(123, 111111);
+
+	const SwissHashMap<int, int> const_map = map;
+
+	Vector<Pair<int, int>> expected;
+	expected.push_back(Pair<int, int>(42, 84));
+	expected.push_back(Pair<int, int>(123, 111111));
+	expected.push_back(Pair<int, int>(0, 12934));
+	expected.push_back(Pair<int, int>(123485, 1238888));
+	expected.push_back(Pair<int, int>(123, 111111));
+
+	int idx = 0;
+	for (const KeyValue<int, int> &E : const_map) {
+		CHECK(expected[idx] == Pair<int, int>(E.key, E.value));
+		idx++;
+	}
+
+	idx--;
+	for (SwissHashMap<int, int>::ConstIterator it = const_map.last(); it; --it) {
+		CHECK(expected[idx] == Pair<int, int>(it->key, it->value));
+		idx--;
+	}
+}
+
+TEST_CASE("[SwissHashMap] Replace key") {
+	SwissHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(0, 12934);
+	CHECK(map.replace_key(0, 1));
+	CHECK(map.has(1));
+	CHECK(map[1] == 12934);
+}
+
+TEST_CASE("[SwissHashMap] Clear") {
+	SwissHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(123, 12385);
+	map.insert(0, 12934);
+
+	map.clear();
+	CHECK(!map.has(42));
+	CHECK(map.size() == 0);
+	CHECK(map.is_empty());
+}
+
+TEST_CASE("[SwissHashMap] Get") {
+	SwissHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(123, 12385);
+	map.insert(0, 12934);
+
+	CHECK(map.get(123) == 12385);
+	map.get(123) = 10;
+	CHECK(map.get(123) == 10);
+
+	CHECK(*map.getptr(0) == 12934);
+	*map.getptr(0) = 1;
+	CHECK(*map.getptr(0) == 1);
+
+	CHECK(map.get(42) == 84);
+	CHECK(map.getptr(-10) == nullptr);
+}
+
+TEST_CASE("[SwissHashMap] Insert, iterate and remove many elements") {
+	const int elem_max = 1234;
+	SwissHashMap<int, int> map;
+	for (int i = 0; i < elem_max; i++) {
+		map.insert(i, i);
+	}
+
+	//insert order should have been kept
+	int idx = 0;
+	for (auto &K : map) {
+		CHECK(idx == K.key);
+		CHECK(idx == K.value);
+		CHECK(map.has(idx));
+		idx++;
+	}
+
+	Vector<int> elems_still_valid;
+
+	for (int i = 0; i < elem_max; i++) {
+		if ((i % 5) == 0) {
+			map.erase(i);
+		} else {
+			elems_still_valid.push_back(i);
+		}
+	}
+
+	CHECK(elems_still_valid.size() == map.size());
+
+	for (int i = 0; i < elems_still_valid.size(); i++) {
+		CHECK(map.has(elems_still_valid[i]));
+	}
+}
+
+TEST_CASE("[SwissHashMap] Insert, iterate and remove many strings") {
+	const int elem_max = 432;
+	SwissHashMap<String, String> map;
+	for (int i = 0; i < elem_max; i++) {
+		map.insert(itos(i), itos(i));
+	}
+
+	//insert order should have been kept
+	int idx = 0;
+	for (auto &K : map) {
+		CHECK(itos(idx) == K.key);
+		CHECK(itos(idx) == K.value);
+		CHECK(map.has(itos(idx)));
+		idx++;
+	}
+
+	Vector<String> elems_still_valid;
+
+	for (int i = 0; i < elem_max; i++) {
+		if ((i % 5) == 0) {
+			map.erase(itos(i));
+		} else {
+			elems_still_valid.push_back(itos(i));
+		}
+	}
+
+	CHECK(elems_still_valid.size() == map.size());
+
+	for (int i = 0; i < elems_still_valid.size(); i++) {
+		CHECK(map.has(elems_still_valid[i]));
+	}
+
+	elems_still_valid.clear();
+}
+
+TEST_CASE("[SwissHashMap] Copy constructor") {
+	SwissHashMap<int, int> map0;
+	const uint32_t count = 5;
+	for (uint32_t i = 0; i < count; i++) {
+		map0.insert(i, i);
+	}
+	SwissHashMap<int, int> map1(map0);
+	CHECK(map0.size() == map1.size());
+	CHECK(map0.get_capacity() == map1.get_capacity());
+	CHECK(*map0.getptr(0) == *map1.getptr(0));
+}
+
+TEST_CASE("[SwissHashMap] Operator =") {
+	SwissHashMap<int, int> map0;
+	SwissHashMap<int, int> map1;
+	const uint32_t count = 5;
+	map1.insert(1234, 1234);
+	for (uint32_t i = 0; i < count; i++) {
+		map0.insert(i, i);
+	}
+	map1 = map0;
+	CHECK(map0.size() == map1.size());
+	CHECK(map0.get_capacity() == map1.get_capacity());
+	CHECK(*map0.getptr(0) == *map1.getptr(0));
+}
+
+TEST_CASE("[SwissHashMap] Array methods") {
+	SwissHashMap<int, int> map;
+	for (int i = 0; i < 100; i++) {
+		map.insert(100 - i, i);
+	}
+	for (int i = 0; i < 100; i++) {
+		CHECK(map.get_by_index(i).value == i);
+	}
+	int index = map.get_index(1);
+	CHECK(map.get_by_index(index).value == 99);
+	CHECK(map.erase_by_index(index));
+	CHECK(!map.erase_by_index(index));
+	CHECK(map.get_index(1) == -1);
+}
+
+// Sends every key to one of a few hashes, so groups fill up and probing has to go past them.
+struct CollidingHasher {
+	static _FORCE_INLINE_ uint32_t hash(const int p_int) { return hash_fmix32(uint32_t(p_int % 5)); }
+};
+
+TEST_CASE("[SwissHashMap] Colliding hashes") {
+	SwissHashMap<int, int, CollidingHasher> map;
+	const int count = 200;
+	for (int i = 0; i < count; i++) {
+		map.insert(i, i * 10);
+	}
+	CHECK(map.size() == count);
+	for (int i = 0; i < count; i++) {
+		CHECK(map.has(i));
+		CHECK(map[i] == i * 10);
+	}
+	CHECK(!map.has(count));
+
+	for (int i = 0; i < count; i += 3) {
+		CHECK(map.erase(i));
+	}
+	for (int i = 0; i < count; i++) {
+		CHECK(map.has(i) == (i % 3 != 0));
+	}
+
+	// Reinsert over the freed slots.
+	for (int i = 0; i < count; i += 3) {
+		map.insert(i, -i);
+	}
+	CHECK(map.size() == count);
+	for (int i = 0; i < count; i++) {
+		CHECK(map[i] == (i % 3 == 0 ? -i : i * 10));
+	}
+}
+
+TEST_CASE("[SwissHashMap] Erase and insert cycles don't grow the map") {
+	SwissHashMap<int, int> map;
+	for (int i = 0; i < 64; i++) {
+		map.insert(i, i);
+	}
+	const uint32_t capacity = map.get_capacity();
+
+	// Keeps a constant number of elements while moving through many different keys.
+	for (int i = 64; i < 100000; i++) {
+		map.erase(i - 64);
+		map.insert(i, i);
+	}
+	CHECK(map.size() == 64);
+	CHECK_MESSAGE(map.get_capacity() == capacity, "Tombstones should be reclaimed without growing the map.");
+	for (int i = 100000 - 64; i < 100000; i++) {
+		CHECK(map[i] == i);
+	}
+}
+
+TEST_CASE("[SwissHashMap] Reserve") {
+	SwissHashMap<int, int> map;
+	map.insert(1, 1);
+	map.reserve(1000);
+	const uint32_t capacity = map.get_capacity();
+	CHECK(capacity >= 1000);
+	for (int i = 0; i < 1000; i++) {
+		map.insert(i, i);
+	}
+	CHECK_MESSAGE(map.get_capacity() == capacity, "Reserved space should fit the elements without growing.");
+	CHECK(map.size() == 1000);
+	CHECK(map[1] == 1);
+}
+
+// Benchmark comparing the hash maps. Run with `--test --no-skip`.
+
+template <typename TMap>
+static _FORCE_INLINE_ const int *benchmark_get(const TMap &p_map, int p_key) {
+	return p_map.getptr(p_key);
+}
+
+static _FORCE_INLINE_ const int *benchmark_get(const OAHashMap<int, int> &p_map, int p_key) {
+	return p_map.lookup_ptr(p_key);
+}
+
+template <typename TMap>
+static _FORCE_INLINE_ void benchmark_erase(TMap &p_map, int p_key) {
+	p_map.erase(p_key);
+}
+
+static _FORCE_INLINE_ void benchmark_erase(OAHashMap<int, int> &p_map, int p_key) {
+	p_map.remove(p_key);
+}
+
+template <typename TMap>
+static void benchmark_map(const char *p_name, int p_count) {
+	TMap *map = memnew(TMap);
+	uint64_t found = 0;
+
+	// Even keys are inserted, odd keys are used for misses.
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < p_count; i++) {
+		map->insert(i * 2, i);
+	}
+	const uint64_t insert_usec = TestUtils::get_elapsed_usec(begin);
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < p_count; i++) {
+		found += benchmark_get(*map, i * 2) != nullptr;
+	}
+	const uint64_t hit_usec = TestUtils::get_elapsed_usec(begin);
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < p_count; i++) {
+		found += benchmark_get(*map, i * 2 + 1) != nullptr;
+	}
+	const uint64_t miss_usec = TestUtils::get_elapsed_usec(begin);
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < p_count; i++) {
+		benchmark_erase(*map, i * 2);
+	}
+	const uint64_t erase_usec = TestUtils::get_elapsed_usec(begin);
+
+	memdelete(map);
+
+	CHECK(found == uint64_t(p_count));
+	print_line(vformat("%s, %d elements: insert %d usec, lookup hit %d usec, lookup miss %d usec, erase %d usec.", p_name, p_count, insert_usec, hit_usec, miss_usec, erase_usec));
+}
+
+TEST_CASE("[SwissHashMap][Benchmark] Against HashMap, AHashMap and OAHashMap" * doctest::skip()) {
+	const int counts[] = { 1000, 100000, 10000000 };
+	for (int count : counts) {
+		benchmark_map<HashMap<int, int>>("HashMap", count);
+		benchmark_map<AHashMap<int, int>>("AHashMap", count);
+		benchmark_map<OAHashMap<int, int>>("OAHashMap", count);
+		benchmark_map<SwissHashMap<int, int>>("SwissHashMap", count);
+	}
+}
+
+} // namespace TestSwissHashMap
+
+#endif // TEST_SWISS_HASH_MAP_H
@@ -0,0 +1,152 @@
+/**************************************************************************/
+/*  test_work_stealing_deque.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_WORK_STEALING_DEQUE_H
+#define TEST_WORK_STEALING_DEQUE_H
+
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+#include "core/templates/work_stealing_deque.h"
+
+#include "tests/test_macros.h"
+
+namespace TestWorkStealingDeque {
+
+TEST_CASE("[WorkStealingDeque] Owner pops LIFO, thieves steal FIFO") {
+	WorkStealingDeque<uint32_t, 16> deque;
+	uint32_t value = 0;
+
+	CHECK(deque.is_empty());
+	CHECK_FALSE(deque.pop(value));
+	CHECK_FALSE(deque.steal(value));
+
+	for (uint32_t i = 1; i <= 4; i++) {
+		CHECK(deque.push(i));
+	}
+	CHECK(deque.size() == 4);
+
+	CHECK(deque.pop(value));
+	CHECK(value == 4);
+	CHECK(deque.steal(value));
+	CHECK(value == 1);
+	CHECK(deque.pop(value));
+	CHECK(value == 3);
+	CHECK(deque.steal(value));
+	CHECK(value == 2);
+
+	CHECK(deque.is_empty());
+	CHECK_FALSE(deque.pop(value));
+	CHECK_FALSE(deque.steal(value));
+}
+
+TEST_CASE("[WorkStealingDeque] Push fails when full and wraps around after draining") {
+	WorkStealingDeque<uint32_t, 8> deque;
+	uint32_t value = 0;
+
+	for (uint32_t round = 0; round < 3; round++) {
+		for (uint32_t i = 0; i < 8; i++) {
+			CHECK(deque.push(round * 8 + i));
+		}
+		CHECK_FALSE(deque.push(12345));
+		CHECK(deque.size() == 8);
+
+		for (uint32_t i = 0; i < 8; i++) {
+			CHECK(deque.steal(value));
+			CHECK(value == round * 8 + i);
+		}
+		CHECK(deque.is_empty());
+	}
+}
+
+struct StealTestData {
+	WorkStealingDeque<uint32_t, 256> deque;
+	LocalVector<SafeNumeric<uint32_t>> taken;
+	SafeFlag owner_done;
+};
+
+static void steal_thread_func(void *p_userdata) {
+	StealTestData *data = (StealTestData *)p_userdata;
+	uint32_t value = 0;
+	while (true) {
+		// Read the flag before trying so that nothing pushed before it was set is missed.
+		bool owner_done = data->owner_done.is_set();
+		if (data->deque.steal(value)) {
+			data->taken[value].increment();
+		} else if (owner_done && data->deque.is_empty()) {
+			break;
+		}
+	}
+}
+
+TEST_CASE("[WorkStealingDeque] Every element is taken exactly once under concurrent stealing") {
+	const uint32_t element_count = 100000;
+	const int thief_count = 3;
+
+	StealTestData data;
+	data.taken.resize(element_count);
+
+	Thread thieves[thief_count];
+	for (int i = 0; i < thief_count; i++) {
+		thieves[i].start(steal_thread_func, &data);
+	}
+
+	uint32_t value = 0;
+	for (uint32_t i = 0; i < element_count; i++) {
+		while (!data.deque.push(i)) {
+			// Full; help draining so the thieves can't starve the owner.
+			if (data.deque.pop(value)) {
+				data.taken[value].increment();
+			}
+		}
+		if (i % 3 == 0 && data.deque.pop(value)) {
+			data.taken[value].increment();
+		}
+	}
+	while (data.deque.pop(value)) {
+		data.taken[value].increment();
+	}
+	data.owner_done.set();
+
+	for (int i = 0; i < thief_count; i++) {
+		thieves[i].wait_to_finish();
+	}
+
+	bool all_taken_once = true;
+	for (uint32_t i = 0; i < element_count; i++) {
+		// Reduce number of check messages.
+		all_taken_once &= data.taken[i].get() == 1;
+	}
+	CHECK(all_taken_once);
+}
+
+} // namespace TestWorkStealingDeque
+
+#endif // TEST_WORK_STEALING_DEQUE_H
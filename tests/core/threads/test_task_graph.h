@@ -0,0 +1,202 @@
+/**************************************************************************/
+/*  test_task_graph.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_TASK_GRAPH_H
+#define TEST_TASK_GRAPH_H
+
+#include "core/object/task_graph.h"
+
+#include "tests/test_macros.h"
+
+namespace TestTaskGraph {
+
+struct OrderData {
+	SafeNumeric<uint32_t> sequence;
+	uint32_t order[4] = {};
+	uint32_t delay_usec[4] = {};
+};
+
+struct OrderTaskData {
+	OrderData *data = nullptr;
+	uint32_t index = 0;
+};
+
+static void order_task(void *p_arg) {
+	OrderTaskData *task_data = (OrderTaskData *)p_arg;
+	if (task_data->data->delay_usec[task_data->index]) {
+		OS::get_singleton()->delay_usec(task_data->data->delay_usec[task_data->index]);
+	}
+	task_data->data->order[task_data->index] = task_data->data->sequence.increment();
+}
+
+TEST_CASE("[TaskGraph] Nodes run after their predecessors") {
+	OrderData data;
+	OrderTaskData task_data[4];
+	for (uint32_t i = 0; i < 4; i++) {
+		task_data[i].data = &data;
+		task_data[i].index = i;
+	}
+
+	// Diamond: 0 -> (1, 2) -> 3.
+	TaskGraph graph;
+	TaskGraph::NodeID a = graph.add_native_task(order_task, &task_data[0]);
+	TaskGraph::NodeID b = graph.add_native_task(order_task, &task_data[1], { a });
+	TaskGraph::NodeID c = graph.add_native_task(order_task, &task_data[2], { a }, true);
+	TaskGraph::NodeID d = graph.add_native_task(order_task, &task_data[3], { b, c });
+	CHECK(graph.get_node_count() == 4);
+
+	for (int iterations = 0; iterations < 100; iterations++) {
+		data.sequence.set(0);
+		graph.start();
+		graph.wait();
+
+		CHECK(data.order[a] == 1);
+		CHECK(data.order[b] > data.order[a]);
+		CHECK(data.order[c] > data.order[a]);
+		CHECK(data.order[d] == 4);
+	}
+}
+
+static SafeNumeric<uint32_t> group_elements_run;
+static SafeFlag group_complete_when_successor_ran;
+
+static void group_element(void *p_arg, uint32_t p_index) {
+	group_elements_run.increment();
+}
+
+static void group_successor(void *p_arg) {
+	group_complete_when_successor_ran.set_to(group_elements_run.get() == (uint32_t)(uintptr_t)p_arg);
+}
+
+TEST_CASE("[TaskGraph] Group tasks as nodes") {
+	const uint32_t element_count = 1000;
+
+	TaskGraph graph;
+	TaskGraph::NodeID group = graph.add_native_group_task(group_element, nullptr, element_count);
+	TaskGraph::NodeID empty_group = graph.add_native_group_task(group_element, nullptr, 0, -1, { group });
+	graph.add_native_task(group_successor, (void *)(uintptr_t)element_count, { empty_group });
+
+	for (int iterations = 0; iterations < 20; iterations++) {
+		group_elements_run.set(0);
+		group_complete_when_successor_ran.clear();
+
+		graph.start();
+		graph.wait();
+
+		CHECK(group_elements_run.get() == element_count);
+		CHECK(group_complete_when_successor_ran.is_set());
+	}
+}
+
+static void count_task(void *p_arg) {
+	((SafeNumeric<uint32_t> *)p_arg)->increment();
+}
+
+static void wait_for_chain(void *p_arg) {
+	TaskGraph graph;
+	TaskGraph::NodeID previous = graph.add_native_task(count_task, p_arg);
+	for (int i = 0; i < 3; i++) {
+		previous = graph.add_native_task(count_task, p_arg, { previous });
+	}
+	graph.start();
+	graph.wait();
+}
+
+TEST_CASE("[TaskGraph] Waiting from pool threads") {
+	// More waiting tasks than pool threads, which would starve the pool if they blocked.
+	const uint32_t waiter_count = WorkerThreadPool::get_singleton()->get_thread_count() * 2 + 1;
+	SafeNumeric<uint32_t> count;
+	LocalVector<WorkerThreadPool::TaskID> waiters;
+	for (uint32_t i = 0; i < waiter_count; i++) {
+		waiters.push_back(WorkerThreadPool::get_singleton()->add_native_task(wait_for_chain, &count));
+	}
+	for (WorkerThreadPool::TaskID waiter : waiters) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(waiter);
+	}
+	CHECK(count.get() == waiter_count * 4);
+}
+
+TEST_CASE("[TaskGraph] Critical path") {
+	OrderData data;
+	OrderTaskData task_data[4];
+	for (uint32_t i = 0; i < 4; i++) {
+		task_data[i].data = &data;
+		task_data[i].index = i;
+	}
+	data.delay_usec[0] = 2000;
+	data.delay_usec[1] = 2000;
+	data.delay_usec[2] = 100;
+	data.delay_usec[3] = 100;
+
+	// Two chains: 0 -> 1 and 2 -> 3, the first one being much longer.
+	TaskGraph graph;
+	TaskGraph::NodeID a = graph.add_native_task(order_task, &task_data[0]);
+	TaskGraph::NodeID b = graph.add_native_task(order_task, &task_data[1], { a });
+	TaskGraph::NodeID c = graph.add_native_task(order_task, &task_data[2]);
+	graph.add_native_task(order_task, &task_data[3], { c });
+
+	graph.start();
+	graph.wait();
+
+	Vector<TaskGraph::NodeID> critical_path = graph.get_critical_path();
+	REQUIRE(critical_path.size() == 2);
+	CHECK(critical_path[0] == a);
+	CHECK(critical_path[1] == b);
+	CHECK(graph.get_critical_path_time_usec() >= 4000);
+	CHECK(graph.get_critical_path_time_usec() == graph.get_node_time_usec(a) + graph.get_node_time_usec(b));
+	CHECK(graph.get_elapsed_time_usec() >= graph.get_critical_path_time_usec());
+}
+
+TEST_CASE("[TaskGraph] Invalid use") {
+	OrderData data;
+	OrderTaskData task_data;
+	task_data.data = &data;
+
+	TaskGraph graph;
+	TaskGraph::NodeID a = graph.add_native_task(order_task, &task_data);
+
+	ERR_PRINT_OFF;
+	CHECK(graph.add_native_task(order_task, &task_data, { a + 1 }) == TaskGraph::INVALID_NODE_ID);
+	CHECK(graph.add_native_task(order_task, &task_data, { -1 }) == TaskGraph::INVALID_NODE_ID);
+	CHECK(graph.add_native_group_task(group_element, nullptr, -1) == TaskGraph::INVALID_NODE_ID);
+
+	graph.start();
+	CHECK(graph.add_native_task(order_task, &task_data) == TaskGraph::INVALID_NODE_ID);
+	graph.wait();
+	graph.wait();
+	ERR_PRINT_ON;
+
+	CHECK(graph.get_node_count() == 1);
+	CHECK(graph.is_completed() == false);
+}
+
+} // namespace TestTaskGraph
+
+#endif // TEST_TASK_GRAPH_H
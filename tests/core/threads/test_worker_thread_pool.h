@@ -34,6 +34,7 @@
 #include "core/object/worker_thread_pool.h"
 
 #include "tests/test_macros.h"
+#include "tests/test_utils.h"
 
 namespace TestWorkerThreadPool {
 
@@ -173,6 +174,207 @@ TEST_CASE("[WorkerThreadPool] Run a yielding daemon as the only hope for other t
 	CHECK_MESSAGE(all_needed_yield, "All legit tasks should have needed the daemon yielding to run.");
 }
 
+static void restart_pool(bool p_use_work_stealing) {
+	WorkerThreadPool::get_singleton()->finish();
+	WorkerThreadPool::get_singleton()->init(-1, 0.3, p_use_work_stealing);
+}
+
+static void static_nested_test(void *p_arg) {
+	counter[(uint64_t)p_arg].increment();
+}
+
+static void static_nested_group_test(void *p_arg, uint32_t p_index) {
+	counter[p_index].increment();
+}
+
+struct SpawnerData {
+	uint32_t from = 0;
+	uint32_t count = 0;
+	WorkerThreadPool::GroupID group = WorkerThreadPool::INVALID_TASK_ID;
+};
+
+static void static_spawner_task(void *p_arg) {
+	SpawnerData *data = (SpawnerData *)p_arg;
+
+	LocalVector<WorkerThreadPool::TaskID> tasks;
+	tasks.resize(data->count);
+	for (uint32_t i = 0; i < data->count; i++) {
+		tasks[i] = WorkerThreadPool::get_singleton()->add_native_task(static_nested_test, (void *)(uintptr_t)(data->from + i), i % 2);
+	}
+	// The group is awaited by the main thread, since a pool thread can't wait for it collaboratively.
+	data->group = WorkerThreadPool::get_singleton()->add_native_group_task(static_nested_group_test, nullptr, data->from + data->count, -1, true);
+	for (uint32_t i = 0; i < data->count; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(tasks[i]);
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Process tasks added from tasks with work stealing") {
+	restart_pool(true);
+	CHECK(WorkerThreadPool::get_singleton()->is_using_work_stealing());
+
+	const int spawner_count = WorkerThreadPool::get_singleton()->get_thread_count() * 2;
+
+	for (int iterations = 0; iterations < 50; iterations++) {
+		const uint32_t count = Math::pow(2.0f, Math::random(0.0f, 10.0f));
+
+		counter.clear();
+		counter.resize(count * spawner_count);
+
+		LocalVector<SpawnerData> spawners;
+		LocalVector<WorkerThreadPool::TaskID> spawner_tasks;
+		spawners.resize(spawner_count);
+		spawner_tasks.resize(spawner_count);
+		for (int i = 0; i < spawner_count; i++) {
+			spawners[i].from = i * count;
+			spawners[i].count = count;
+			spawner_tasks[i] = WorkerThreadPool::get_singleton()->add_native_task(static_spawner_task, &spawners[i], true);
+		}
+		for (int i = 0; i < spawner_count; i++) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(spawner_tasks[i]);
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(spawners[i].group);
+		}
+
+		// Each element was hit once by its own task and once by the group of every spawner from its own one on.
+		bool all_run_expected = true;
+		for (uint32_t i = 0; i < count * spawner_count; i++) {
+			//Reduce number of check messages
+			all_run_expected &= counter[i].get() == (int)(1 + spawner_count - i / count);
+		}
+		CHECK(all_run_expected);
+	}
+
+	restart_pool(false);
+	CHECK_FALSE(WorkerThreadPool::get_singleton()->is_using_work_stealing());
+}
+
+// Benchmark comparing the single queue with work stealing. Run with `--test --no-skip`.
+
+struct BenchmarkTaskData {
+	uint64_t posted_usec = 0;
+	uint64_t latency_usec = 0;
+};
+
+static LocalVector<BenchmarkTaskData> benchmark_tasks;
+
+static void static_benchmark_task(void *p_arg) {
+	BenchmarkTaskData &data = benchmark_tasks[(uint64_t)p_arg];
+	data.latency_usec = OS::get_singleton()->get_ticks_usec() - data.posted_usec;
+}
+
+static void static_benchmark_spawner_task(void *p_arg) {
+	SpawnerData *data = (SpawnerData *)p_arg;
+
+	LocalVector<WorkerThreadPool::TaskID> tasks;
+	tasks.resize(data->count);
+	for (uint32_t i = 0; i < data->count; i++) {
+		benchmark_tasks[data->from + i].posted_usec = OS::get_singleton()->get_ticks_usec();
+		tasks[i] = WorkerThreadPool::get_singleton()->add_native_task(static_benchmark_task, (void *)(uintptr_t)(data->from + i), true);
+	}
+	for (uint32_t i = 0; i < data->count; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(tasks[i]);
+	}
+}
+
+static void static_benchmark_group_task(void *p_arg, uint32_t p_index) {
+	counter[p_index].increment();
+}
+
+static void print_benchmark_result(const String &p_name, uint32_t p_task_count, uint64_t p_elapsed_usec) {
+	LocalVector<uint64_t> latencies;
+	latencies.resize(benchmark_tasks.size());
+	for (uint32_t i = 0; i < benchmark_tasks.size(); i++) {
+		latencies[i] = benchmark_tasks[i].latency_usec;
+	}
+	latencies.sort();
+
+	print_line(vformat("%s: %d tasks in %d usec (%.1f tasks/ms), latency p50 %d usec, p99 %d usec, max %d usec.",
+			p_name, p_task_count, p_elapsed_usec, p_task_count * 1000.0 / p_elapsed_usec,
+			latencies[latencies.size() / 2], latencies[latencies.size() * 99 / 100], latencies[latencies.size() - 1]));
+}
+
+TEST_CASE("[WorkerThreadPool][Benchmark] Single queue vs. work stealing" * doctest::skip()) {
+	const uint32_t tasks_per_spawner = 10000;
+	const uint32_t group_count = 2000;
+	const uint32_t group_elements = 64;
+
+	for (int mode = 0; mode < 2; mode++) {
+		const bool use_work_stealing = mode == 1;
+		const String mode_name = use_work_stealing ? "Work stealing" : "Single queue";
+		restart_pool(use_work_stealing);
+
+		const uint32_t spawner_count = WorkerThreadPool::get_singleton()->get_thread_count();
+
+		// Many small tasks added from inside tasks.
+		{
+			benchmark_tasks.clear();
+			benchmark_tasks.resize(spawner_count * tasks_per_spawner);
+
+			LocalVector<SpawnerData> spawners;
+			LocalVector<WorkerThreadPool::TaskID> spawner_tasks;
+			spawners.resize(spawner_count);
+			spawner_tasks.resize(spawner_count);
+
+			uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+			for (uint32_t i = 0; i < spawner_count; i++) {
+				spawners[i].from = i * tasks_per_spawner;
+				spawners[i].count = tasks_per_spawner;
+				spawner_tasks[i] = WorkerThreadPool::get_singleton()->add_native_task(static_benchmark_spawner_task, &spawners[i], true);
+			}
+			for (uint32_t i = 0; i < spawner_count; i++) {
+				WorkerThreadPool::get_singleton()->wait_for_task_completion(spawner_tasks[i]);
+			}
+			uint64_t elapsed_usec = TestUtils::get_elapsed_usec(begin_usec);
+
+			print_benchmark_result(mode_name + ", nested tasks", benchmark_tasks.size(), elapsed_usec);
+		}
+
+		// Many small tasks added from a thread outside the pool.
+		{
+			benchmark_tasks.clear();
+			benchmark_tasks.resize(spawner_count * tasks_per_spawner);
+
+			LocalVector<WorkerThreadPool::TaskID> tasks;
+			tasks.resize(benchmark_tasks.size());
+
+			uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+			for (uint32_t i = 0; i < benchmark_tasks.size(); i++) {
+				benchmark_tasks[i].posted_usec = OS::get_singleton()->get_ticks_usec();
+				tasks[i] = WorkerThreadPool::get_singleton()->add_native_task(static_benchmark_task, (void *)(uintptr_t)i, true);
+			}
+			for (uint32_t i = 0; i < benchmark_tasks.size(); i++) {
+				WorkerThreadPool::get_singleton()->wait_for_task_completion(tasks[i]);
+			}
+			uint64_t elapsed_usec = TestUtils::get_elapsed_usec(begin_usec);
+
+			print_benchmark_result(mode_name + ", external tasks", benchmark_tasks.size(), elapsed_usec);
+		}
+
+		// Many small group tasks added from a thread outside the pool.
+		{
+			counter.clear();
+			counter.resize(group_elements);
+
+			LocalVector<WorkerThreadPool::GroupID> groups;
+			groups.resize(group_count);
+
+			uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+			for (uint32_t i = 0; i < group_count; i++) {
+				groups[i] = WorkerThreadPool::get_singleton()->add_native_group_task(static_benchmark_group_task, nullptr, group_elements, -1, true);
+			}
+			for (uint32_t i = 0; i < group_count; i++) {
+				WorkerThreadPool::get_singleton()->wait_for_group_task_completion(groups[i]);
+			}
+			uint64_t elapsed_usec = TestUtils::get_elapsed_usec(begin_usec);
+
+			print_line(vformat("%s, external groups: %d groups of %d elements in %d usec (%.1f groups/ms).",
+					mode_name, group_count, group_elements, elapsed_usec, group_count * 1000.0 / elapsed_usec));
+			CHECK(counter[0].get() == (int)group_count);
+		}
+	}
+
+	restart_pool(false);
+}
+
 } // namespace TestWorkerThreadPool
 
 #endif // TEST_WORKER_THREAD_POOL_H
@@ -31,8 +31,11 @@
 #ifndef TEST_DICTIONARY_H
 #define TEST_DICTIONARY_H
 
+#include "core/os/os.h"
+#include "core/templates/local_vector.h"
 #include "core/variant/typed_dictionary.h"
 #include "tests/test_macros.h"
+#include "tests/test_utils.h"
 
 namespace TestDictionary {
 
@@ -557,6 +560,113 @@ TEST_CASE("[Dictionary] Order and find") {
 	CHECK_EQ(d.find_key("does not exist"), Variant());
 }
 
+TEST_CASE("[Dictionary] Shared string keys") {
+	Dictionary a;
+	a["x"] = 1;
+	a["y"] = 2;
+	Dictionary b;
+	b["x"] = 3;
+	b["y"] = 4;
+
+	CHECK(a.keys() == b.keys());
+	CHECK(a["y"] == Variant(2));
+	CHECK(b["y"] == Variant(4));
+	CHECK(a.has(StringName("x")));
+	CHECK(a.get_key_at_index(1) == Variant("y"));
+	CHECK(a.get_value_at_index(1) == Variant(2));
+
+	// Keys keep the type they were inserted with.
+	Dictionary c;
+	c[StringName("x")] = 5;
+	CHECK(c.keys()[0].get_type() == Variant::STRING_NAME);
+	CHECK(a.keys()[0].get_type() == Variant::STRING);
+	CHECK(c.has("x"));
+
+	// Diverging keeps contents and order.
+	b[0] = 5;
+	CHECK(a.keys() == build_array("x", "y"));
+	CHECK(b.keys() == build_array("x", "y", 0));
+	b.erase(0);
+	CHECK(b.keys() == build_array("x", "y"));
+	b["x"] = 1;
+	b["y"] = 2;
+	CHECK(a == b);
+	CHECK(a.hash() == b.hash());
+
+	const Variant *key = a.next();
+	CHECK(*key == Variant("x"));
+	key = a.next(key);
+	CHECK(*key == Variant("y"));
+	CHECK(a.next(key) == nullptr);
+}
+
+TEST_CASE("[Dictionary] Erasing shared string keys") {
+	Dictionary a = build_dictionary("c", 3, "b", 2, "a", 1);
+	Dictionary b = a.duplicate();
+
+	// Last key.
+	CHECK(a.erase("c"));
+	CHECK(a.keys() == build_array("a", "b"));
+	CHECK_FALSE(a.erase("c"));
+	a["c"] = 4;
+	CHECK(a.values() == build_array(1, 2, 4));
+
+	// Key in the middle.
+	CHECK(b.erase("b"));
+	CHECK(b.keys() == build_array("a", "c"));
+	CHECK(b["c"] == Variant(3));
+	b["b"] = 5;
+	CHECK(b.keys() == build_array("a", "c", "b"));
+
+	b.clear();
+	CHECK(b.is_empty());
+	b["a"] = 6;
+	CHECK(b.keys() == build_array("a"));
+
+	Dictionary many;
+	for (int i = 0; i < 100; i++) {
+		many["key_" + itos(i)] = i;
+	}
+	CHECK(many.size() == 100);
+	CHECK(many["key_99"] == Variant(99));
+	CHECK(many.get_key_at_index(50) == Variant("key_50"));
+}
+
+TEST_CASE("[Dictionary] Values keep their address across insertions") {
+	Dictionary d;
+	Variant &first = d["first"];
+	first = 1;
+	const Variant *first_ptr = d.getptr("first");
+	REQUIRE(first_ptr == &first);
+
+	// Enough string keys to grow the shared storage several times, then diverge to the hash map.
+	for (int i = 0; i < 100; i++) {
+		d["key_" + itos(i)] = i;
+		CHECK(d.getptr("first") == first_ptr);
+	}
+	d[Vector2i(1, 2)] = "not a string key";
+	d.erase("key_50");
+	d["after_erase"] = 2;
+	CHECK(d.getptr("first") == first_ptr);
+	CHECK(first == Variant(1));
+
+	// The reference is taken before the new key is inserted.
+	Dictionary e;
+	e["a"] = "value";
+	for (int i = 0; i < 40; i++) {
+		e["copy_" + itos(i)] = e["a"];
+	}
+	CHECK(e["copy_39"] == Variant("value"));
+
+	Dictionary shared = build_dictionary("x", 1, "y", 2);
+	Variant &x = shared["x"];
+	for (int i = 0; i < 20; i++) {
+		shared["z_" + itos(i)] = i;
+	}
+	x = 10;
+	CHECK(shared["x"] == Variant(10));
+}
+
 TEST_CASE("[Dictionary] Typed copying") {
 	TypedDictionary<int, int> d1;
 	d1[0] = 1;
@@ -594,6 +704,53 @@ TEST_CASE("[Dictionary] Typed copying") {
 	d6.clear();
 }
 
+// Benchmark of dictionaries sharing the same string keys. Run with `--test --no-skip`.
+
+static void benchmark_dictionaries(const char *p_label, bool p_diverge) {
+	const int count = 100000;
+	const int key_count = 8;
+	String keys[key_count];
+	for (int i = 0; i < key_count; i++) {
+		keys[i] = "field_" + itos(i);
+	}
+
+	LocalVector<Dictionary> dictionaries;
+	dictionaries.resize(count);
+
+	const uint64_t memory_before = Memory::get_mem_usage();
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < count; i++) {
+		Dictionary &d = dictionaries[i];
+		for (int j = 0; j < key_count; j++) {
+			d[keys[j]] = i + j;
+		}
+		if (p_diverge) {
+			// Forces the dictionary to use its own hash map.
+			d[0] = 0;
+			d.erase(0);
+		}
+	}
+	const uint64_t build_usec = TestUtils::get_elapsed_usec(begin);
+	const uint64_t memory = Memory::get_mem_usage() - memory_before;
+
+	int64_t sum = 0;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < count; i++) {
+		for (int j = 0; j < key_count; j++) {
+			sum += int64_t(*dictionaries[i].getptr(keys[j]));
+		}
+	}
+	const uint64_t lookup_usec = TestUtils::get_elapsed_usec(begin);
+	CHECK(sum > 0);
+
+	print_line(vformat("%s: %d bytes per dictionary (debug builds only), built in %d ms, %d lookups in %d ms.", p_label, memory / count, build_usec / 1000, count * key_count, lookup_usec / 1000));
+}
+
+TEST_CASE("[Dictionary][Benchmark] Shared string keys against hash maps" * doctest::skip()) {
+	benchmark_dictionaries("Shared keys", false);
+	benchmark_dictionaries("Hash maps", true);
+}
+
 } // namespace TestDictionary
 
 #endif // TEST_DICTIONARY_H
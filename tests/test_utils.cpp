@@ -47,3 +47,7 @@ String TestUtils::get_temp_path(const String &p_suffix) {
 	DirAccess::make_dir_absolute(temp_base); // Ensure the directory exists.
 	return temp_base.path_join(p_suffix);
 }
+
+uint64_t TestUtils::get_elapsed_usec(uint64_t p_begin) {
+	return MAX(OS::get_singleton()->get_ticks_usec() - p_begin, uint64_t(1));
+}
@@ -31,6 +31,8 @@
 #ifndef TEST_UTILS_H
 #define TEST_UTILS_H
 
+#include <cstdint>
+
 class String;
 
 namespace TestUtils {
@@ -38,6 +40,8 @@ namespace TestUtils {
 String get_data_path(const String &p_file);
 String get_executable_dir();
 String get_temp_path(const String &p_suffix);
+// Microseconds since `p_begin`, from `OS::get_ticks_usec()`. At least 1, so benchmarks can divide by it.
+uint64_t get_elapsed_usec(uint64_t p_begin);
 } // namespace TestUtils
 
 #endif // TEST_UTILS_H